@@ -1,9 +1,13 @@
 #pragma once
 
+#include <iterator>
+#include "parallel_backend.hpp"
+#include "simd_backend.hpp"
+
 namespace Hx {
 
 template <typename ForwardIterator>
-ForwardIterator adjacent_find(ForwardIterator first, ForwardIterator last)
+ForwardIterator adjacent_find(std::false_type, ForwardIterator first, ForwardIterator last)
 {
     if (first == last)
         return last;
@@ -18,6 +22,21 @@ ForwardIterator adjacent_find(ForwardIterator first, ForwardIterator last)
     return last;
 }
 
+template <typename RandomAccessIterator>
+RandomAccessIterator adjacent_find(std::true_type, RandomAccessIterator first, RandomAccessIterator last)
+{
+    if (first == last)
+        return last;
+
+    return first + simd::adjacent_find(simd::address_of(first), last - first);
+}
+
+template <typename ForwardIterator>
+ForwardIterator adjacent_find(ForwardIterator first, ForwardIterator last)
+{
+    return Hx::adjacent_find(simd::is_vectorizable<ForwardIterator>(), first, last);
+}
+
 template <typename ForwardIterator, typename BinaryPredicate>
 ForwardIterator adjacent_find(ForwardIterator first, ForwardIterator last, BinaryPredicate pred)
 {
@@ -34,5 +53,45 @@ ForwardIterator adjacent_find(ForwardIterator first, ForwardIterator last, Binar
     return last;
 }
 
+template <typename ExecutionPolicy, typename ForwardIterator, typename BinaryPredicate>
+ForwardIterator adjacent_find(ExecutionPolicy& policy, ForwardIterator first, ForwardIterator last,
+        BinaryPredicate pred, std::forward_iterator_tag)
+{
+    return Hx::adjacent_find(first, last, pred);
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename BinaryPredicate>
+RandomAccessIterator adjacent_find(ExecutionPolicy& policy, RandomAccessIterator first,
+        RandomAccessIterator last, BinaryPredicate pred, std::random_access_iterator_tag)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::difference_type size_type;
+    size_type n = last - first;
+    if (n < 2)
+        return last;
+
+    size_type i = execution::find_first(policy, n - 1,
+        [&](size_type j) { return bool(pred(first[j], first[j + 1])); });
+    return (i == n - 1) ? last : first + i;
+}
+
+template <typename ExecutionPolicy, typename ForwardIterator, typename BinaryPredicate>
+typename execution::enable_if_execution_policy<ExecutionPolicy, ForwardIterator>::type
+adjacent_find(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last,
+        BinaryPredicate pred)
+{
+    return Hx::adjacent_find(policy, first, last, pred,
+        typename std::iterator_traits<ForwardIterator>::iterator_category());
+}
+
+template <typename ExecutionPolicy, typename ForwardIterator>
+typename execution::enable_if_execution_policy<ExecutionPolicy, ForwardIterator>::type
+adjacent_find(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last)
+{
+    typedef typename std::iterator_traits<ForwardIterator>::value_type value_type;
+    return Hx::adjacent_find(policy, first, last,
+        [](const value_type& a, const value_type& b) { return a == b; },
+        typename std::iterator_traits<ForwardIterator>::iterator_category());
+}
+
 }   // namespace Hx
 
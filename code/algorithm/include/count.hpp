@@ -0,0 +1,46 @@
+#pragma once
+
+#include <iterator>
+#include <type_traits>
+#include "simd_backend.hpp"
+
+namespace Hx {
+
+template <typename InputIterator, typename T>
+typename std::iterator_traits<InputIterator>::difference_type
+count(std::false_type, InputIterator first, InputIterator last, const T& val)
+{
+    typename std::iterator_traits<InputIterator>::difference_type ret = 0;
+    while (first != last) {
+        if (*first == val)
+            ++ret;
+        ++first;
+    }
+    return ret;
+}
+
+/**
+ * For is_vectorizable_value: the element type is the common type, or both
+ * are integers, so an integer value the element type cannot hold equals
+ * no element and any other is counted converted to it.
+ */
+template <typename RandomAccessIterator, typename T>
+typename std::iterator_traits<RandomAccessIterator>::difference_type
+count(std::true_type, RandomAccessIterator first, RandomAccessIterator last, const T& val)
+{
+    typedef typename std::remove_cv<typename std::iterator_traits<RandomAccessIterator>::value_type>::type value_type;
+    const value_type v = val;
+    if (first == last || !(v == val))
+        return 0;
+
+    return simd::count(simd::address_of(first), last - first, v);
+}
+
+template <typename InputIterator, typename T>
+typename std::iterator_traits<InputIterator>::difference_type
+count(InputIterator first, InputIterator last, const T& val)
+{
+    return Hx::count(simd::is_vectorizable_value<InputIterator, T>(), first, last, val);
+}
+
+}   // namespace Hx
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <iterator>
+#include <type_traits>
+#include "simd_backend.hpp"
+
+namespace Hx {
+
+template <typename InputIterator1, typename InputIterator2>
+bool equal(std::false_type, InputIterator1 first1, InputIterator1 last1, InputIterator2 first2)
+{
+    while (first1 != last1) {
+        if (!(*first1 == *first2))
+            return false;
+        ++first1;
+        ++first2;
+    }
+    return true;
+}
+
+template <typename RandomAccessIterator1, typename RandomAccessIterator2>
+bool equal(std::true_type, RandomAccessIterator1 first1, RandomAccessIterator1 last1, RandomAccessIterator2 first2)
+{
+    if (first1 == last1)
+        return true;
+
+    size_t n = last1 - first1;
+    return simd::mismatch(simd::address_of(first1), simd::address_of(first2), n) == n;
+}
+
+template <typename InputIterator1, typename InputIterator2>
+bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2)
+{
+    return Hx::equal(simd::is_vectorizable_pair<InputIterator1, InputIterator2>(), first1, last1, first2);
+}
+
+template <typename InputIterator1, typename InputIterator2, typename BinaryPredicate>
+bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, BinaryPredicate pred)
+{
+    while (first1 != last1) {
+        if (!pred(*first1, *first2))
+            return false;
+        ++first1;
+        ++first2;
+    }
+    return true;
+}
+
+}   // namespace Hx
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <iterator>
+#include <type_traits>
+#include "simd_backend.hpp"
+
+namespace Hx {
+
+template <typename InputIterator, typename T>
+InputIterator find(std::false_type, InputIterator first, InputIterator last, const T& val)
+{
+    while (first != last) {
+        if (*first == val)
+            return first;
+        ++first;
+    }
+    return last;
+}
+
+/**
+ * For is_vectorizable_value: the element type is the common type, or both
+ * are integers, so an integer value the element type cannot hold equals
+ * no element and any other is looked for converted to it.
+ */
+template <typename RandomAccessIterator, typename T>
+RandomAccessIterator find(std::true_type, RandomAccessIterator first, RandomAccessIterator last, const T& val)
+{
+    typedef typename std::remove_cv<typename std::iterator_traits<RandomAccessIterator>::value_type>::type value_type;
+    const value_type v = val;
+    if (first == last || !(v == val))
+        return last;
+
+    return first + simd::find(simd::address_of(first), last - first, v);
+}
+
+template <typename InputIterator, typename T>
+InputIterator find(InputIterator first, InputIterator last, const T& val)
+{
+    return Hx::find(simd::is_vectorizable_value<InputIterator, T>(), first, last, val);
+}
+
+}   // namespace Hx
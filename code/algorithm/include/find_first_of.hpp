@@ -0,0 +1,56 @@
+#pragma once
+
+#include <iterator>
+#include <type_traits>
+#include "simd_backend.hpp"
+
+namespace Hx {
+
+template <typename InputIterator, typename ForwardIterator>
+InputIterator find_first_of(std::false_type, InputIterator first1, InputIterator last1,
+        ForwardIterator first2, ForwardIterator last2)
+{
+    while (first1 != last1) {
+        for (ForwardIterator it = first2; it != last2; ++it) {
+            if (*it == *first1)
+                return first1;
+        }
+        ++first1;
+    }
+    return last1;
+}
+
+template <typename RandomAccessIterator1, typename RandomAccessIterator2>
+RandomAccessIterator1 find_first_of(std::true_type, RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+        RandomAccessIterator2 first2, RandomAccessIterator2 last2)
+{
+    if (first1 == last1 || first2 == last2)
+        return last1;
+
+    return first1 + simd::find_first_of(simd::address_of(first1), last1 - first1,
+        simd::address_of(first2), last2 - first2);
+}
+
+template <typename InputIterator, typename ForwardIterator>
+InputIterator find_first_of(InputIterator first1, InputIterator last1,
+        ForwardIterator first2, ForwardIterator last2)
+{
+    return Hx::find_first_of(simd::is_vectorizable_pair<InputIterator, ForwardIterator>(),
+        first1, last1, first2, last2);
+}
+
+template <typename InputIterator, typename ForwardIterator, typename BinaryPredicate>
+InputIterator find_first_of(InputIterator first1, InputIterator last1,
+        ForwardIterator first2, ForwardIterator last2, BinaryPredicate pred)
+{
+    while (first1 != last1) {
+        for (ForwardIterator it = first2; it != last2; ++it) {
+            if (pred(*it, *first1))
+                return first1;
+        }
+        ++first1;
+    }
+    return last1;
+}
+
+}   // namespace Hx
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include "simd_backend.hpp"
+
+namespace Hx {
+
+template <typename InputIterator1, typename InputIterator2>
+bool lexicographical_compare(std::false_type, InputIterator1 first1, InputIterator1 last1,
+        InputIterator2 first2, InputIterator2 last2)
+{
+    while (first1 != last1) {
+        if (first2 == last2 || *first2 < *first1)
+            return false;
+        else if (*first1 < *first2)
+            return true;
+        ++first1;
+        ++first2;
+    }
+    return (first2 != last2);
+}
+
+/**
+ * Integers only: the first element that differs decides. Floating point
+ * ranges keep the loop above, since a NaN differs from everything without
+ * being less or greater.
+ */
+template <typename RandomAccessIterator1, typename RandomAccessIterator2>
+bool lexicographical_compare(std::true_type, RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+        RandomAccessIterator2 first2, RandomAccessIterator2 last2)
+{
+    size_t n1 = last1 - first1;
+    size_t n2 = last2 - first2;
+    size_t n = std::min(n1, n2);
+    size_t i = (n == 0) ? 0 : simd::mismatch(simd::address_of(first1), simd::address_of(first2), n);
+    return (i < n) ? first1[i] < first2[i] : n1 < n2;
+}
+
+template <typename InputIterator1, typename InputIterator2>
+bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+        InputIterator2 first2, InputIterator2 last2)
+{
+    typedef typename std::iterator_traits<InputIterator1>::value_type value_type;
+    return Hx::lexicographical_compare(std::integral_constant<bool,
+            simd::is_vectorizable_pair<InputIterator1, InputIterator2>::value &&
+            std::is_integral<value_type>::value>(),
+        first1, last1, first2, last2);
+}
+
+template <typename InputIterator1, typename InputIterator2, typename Compare>
+bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+        InputIterator2 first2, InputIterator2 last2, Compare comp)
+{
+    while (first1 != last1) {
+        if (first2 == last2 || comp(*first2, *first1))
+            return false;
+        else if (comp(*first1, *first2))
+            return true;
+        ++first1;
+        ++first2;
+    }
+    return (first2 != last2);
+}
+
+}   // namespace Hx
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "simd_backend.hpp"
+
+namespace Hx {
+
+template <typename InputIterator1, typename InputIterator2>
+std::pair<InputIterator1, InputIterator2>
+mismatch(std::false_type, InputIterator1 first1, InputIterator1 last1, InputIterator2 first2)
+{
+    while ((first1 != last1) && (*first1 == *first2)) {
+        ++first1;
+        ++first2;
+    }
+    return std::make_pair(first1, first2);
+}
+
+template <typename RandomAccessIterator1, typename RandomAccessIterator2>
+std::pair<RandomAccessIterator1, RandomAccessIterator2>
+mismatch(std::true_type, RandomAccessIterator1 first1, RandomAccessIterator1 last1, RandomAccessIterator2 first2)
+{
+    if (first1 == last1)
+        return std::make_pair(first1, first2);
+
+    size_t i = simd::mismatch(simd::address_of(first1), simd::address_of(first2), last1 - first1);
+    return std::make_pair(first1 + i, first2 + i);
+}
+
+template <typename InputIterator1, typename InputIterator2>
+std::pair<InputIterator1, InputIterator2>
+mismatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2)
+{
+    return Hx::mismatch(simd::is_vectorizable_pair<InputIterator1, InputIterator2>(), first1, last1, first2);
+}
+
+template <typename InputIterator1, typename InputIterator2, typename BinaryPredicate>
+std::pair<InputIterator1, InputIterator2>
+mismatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, BinaryPredicate pred)
+{
+    while ((first1 != last1) && pred(*first1, *first2)) {
+        ++first1;
+        ++first2;
+    }
+    return std::make_pair(first1, first2);
+}
+
+}   // namespace Hx
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <iterator>
+#include "parallel_backend.hpp"
+#include "simd_backend.hpp"
+
 namespace Hx {
 
 template <typename InputIterator, typename UnaryPredicate>
-bool none_of(InputIterator first, InputIterator last, UnaryPredicate pred)
+bool none_of(std::false_type, InputIterator first, InputIterator last, UnaryPredicate pred)
 {
     while (first != last) {
         if (pred(*first)) return false;
@@ -12,5 +16,45 @@ bool none_of(InputIterator first, InputIterator last, UnaryPredicate pred)
     return true;
 }
 
+template <typename RandomAccessIterator, typename UnaryPredicate>
+bool none_of(std::true_type, RandomAccessIterator first, RandomAccessIterator last, UnaryPredicate pred)
+{
+    if (first == last)
+        return true;
+
+    size_t n = last - first;
+    return simd::find_pred<true>(simd::address_of(first), n, pred) == n;
+}
+
+template <typename InputIterator, typename UnaryPredicate>
+bool none_of(InputIterator first, InputIterator last, UnaryPredicate pred)
+{
+    return Hx::none_of(simd::is_vectorizable_predicate<InputIterator, UnaryPredicate>(), first, last, pred);
+}
+
+template <typename ExecutionPolicy, typename ForwardIterator, typename UnaryPredicate>
+bool none_of(ExecutionPolicy& policy, ForwardIterator first, ForwardIterator last,
+        UnaryPredicate pred, std::forward_iterator_tag)
+{
+    return Hx::none_of(first, last, pred);
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename UnaryPredicate>
+bool none_of(ExecutionPolicy& policy, RandomAccessIterator first, RandomAccessIterator last,
+        UnaryPredicate pred, std::random_access_iterator_tag)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::difference_type size_type;
+    size_type n = last - first;
+    return execution::find_first(policy, n, [&](size_type i) { return bool(pred(first[i])); }) == n;
+}
+
+template <typename ExecutionPolicy, typename ForwardIterator, typename UnaryPredicate>
+typename execution::enable_if_execution_policy<ExecutionPolicy, bool>::type
+none_of(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, UnaryPredicate pred)
+{
+    return Hx::none_of(policy, first, last, pred,
+        typename std::iterator_traits<ForwardIterator>::iterator_category());
+}
+
 }   // namespace Hx
 
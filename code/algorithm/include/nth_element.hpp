@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "parallel_backend.hpp"
+#include "sort.hpp"
+
+namespace Hx {
+
+/**
+ * Fallback of the introselect loop once its bad partitions are used up:
+ * keeps the nth + 1 least elements in a max-heap over [first, nth], so
+ * the top ends up being the nth, in O(n log(nth - first)) rather than
+ * the O(n log n) of sorting the range.
+ */
+template <typename RandomAccessIterator, typename Compare>
+void heap_select(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last,
+        Compare& comp)
+{
+    ptrdiff_t k = nth - first + 1;
+    for (ptrdiff_t i = k / 2 - 1; i >= 0; --i)
+        Hx::sift_down(first, i, k, comp);
+    for (RandomAccessIterator i = nth + 1; i != last; ++i) {
+        if (comp(*i, *first)) {
+            std::iter_swap(first, i);
+            Hx::sift_down(first, 0, k, comp);
+        }
+    }
+    std::iter_swap(first, nth);
+}
+
+/**
+ * Introselect: the introsort loop, following only the side that holds
+ * nth, with the same pivots, partitions, handling of duplicates and
+ * breaking of patterns.
+ */
+template <typename RandomAccessIterator, typename Compare>
+void nth_element(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last,
+        Compare comp)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    is_branchless_sortable<value_type> branchless;
+    if (nth == last || last - first < 2)
+        return;
+    if (Hx::sort_monotonic(first, last, comp))
+        return;
+
+    int bad_allowed = Hx::sort_depth_limit(last - first);
+    bool leftmost = true;
+    while (last - first > sort_threshold) {
+        if (bad_allowed == 0) {
+            Hx::heap_select(first, nth, last, comp);
+            return;
+        }
+
+        Hx::select_pivot(first, last, comp);
+        if (!leftmost && !comp(*(first - 1), *first)) {
+            RandomAccessIterator mid = Hx::partition_equal(first, last, comp, branchless);
+            if (nth < mid)
+                return;
+            first = mid;
+            continue;
+        }
+
+        RandomAccessIterator mid = Hx::partition_balanced(first, last, bad_allowed, comp, branchless);
+        if (nth == mid)
+            return;
+        if (nth < mid) {
+            last = mid;
+        } else {
+            first = mid + 1;
+            leftmost = false;
+        }
+    }
+    Hx::small_sort(branchless, first, last, comp);
+}
+
+template <typename RandomAccessIterator>
+void nth_element(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    Hx::nth_element(first, nth, last, std::less<value_type>());
+}
+
+/**
+ * Parallel quickselect: the pivot is the median of a sample; every
+ * thread counts the elements of its chunk that are less than, equal to
+ * and greater than it, and scatters them to their part of the range.
+ * The part holding nth is selected from next, until the range is small
+ * enough for the sequential introselect, or nth falls among the equal
+ * elements.
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename Compare>
+void nth_element(ExecutionPolicy& policy, RandomAccessIterator first, RandomAccessIterator nth,
+        RandomAccessIterator last, Compare comp, std::random_access_iterator_tag)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    if (last - first >= 2 && Hx::sort_monotonic(first, last, comp))
+        return;
+
+    for (;;) {
+        size_t n = last - first;
+        unsigned k = execution::chunk_count(policy, n);
+        if (k <= 1 || nth == last) {
+            Hx::nth_element(first, nth, last, comp);
+            return;
+        }
+
+        const size_t s = 3 * 32 * size_t(k);
+        std::vector<value_type> sample;
+        for (size_t i = 0; i < s; ++i)
+            sample.push_back(first[i * n / s]);
+        Hx::nth_element(sample.begin(), sample.begin() + s / 2, sample.end(), comp);
+        const value_type pivot = sample[s / 2];
+
+        std::vector<value_type> buf(std::make_move_iterator(first), std::make_move_iterator(last));
+        std::vector<size_t> count(3 * size_t(k), 0);    // [chunk][less, equal, greater]
+        execution::for_each_chunk(policy, n, [&](unsigned c, size_t lo, size_t hi) {
+            size_t* cnt = &count[3 * size_t(c)];
+            for (size_t i = lo; i < hi; ++i)
+                ++cnt[comp(buf[i], pivot) ? 0 : comp(pivot, buf[i]) ? 2 : 1];
+        });
+
+        size_t pos = 0, less = 0, equal = 0;
+        for (unsigned part = 0; part < 3; ++part) {
+            if (part == 1)
+                less = pos;
+            if (part == 2)
+                equal = pos - less;
+            for (unsigned c = 0; c < k; ++c) {
+                size_t cnt = count[3 * size_t(c) + part];
+                count[3 * size_t(c) + part] = pos;
+                pos += cnt;
+            }
+        }
+
+        execution::for_each_chunk(policy, n, [&](unsigned c, size_t lo, size_t hi) {
+            size_t* out = &count[3 * size_t(c)];
+            for (size_t i = lo; i < hi; ++i)
+                first[out[comp(buf[i], pivot) ? 0 : comp(pivot, buf[i]) ? 2 : 1]++] = std::move(buf[i]);
+        });
+
+        size_t i = nth - first;
+        if (i < less) {
+            last = first + less;
+        } else if (i < less + equal) {
+            return;
+        } else {
+            first += less + equal;
+        }
+    }
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename Compare>
+typename execution::enable_if_execution_policy<ExecutionPolicy, void>::type
+nth_element(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator nth,
+        RandomAccessIterator last, Compare comp)
+{
+    Hx::nth_element(policy, first, nth, last, comp,
+        typename std::iterator_traits<RandomAccessIterator>::iterator_category());
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator>
+typename execution::enable_if_execution_policy<ExecutionPolicy, void>::type
+nth_element(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator nth,
+        RandomAccessIterator last)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    Hx::nth_element(policy, first, nth, last, std::less<value_type>(),
+        typename std::iterator_traits<RandomAccessIterator>::iterator_category());
+}
+
+}   // namespace Hx
@@ -0,0 +1,438 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "parallel_backend.hpp"
+#include "stable_sort.hpp"
+
+namespace Hx {
+
+/**
+ * Maps a key to an unsigned integer of the same size that orders the same
+ * way: signed integers get their sign bit flipped, floating point numbers
+ * all their bits when negative and only the sign bit otherwise (so -0.0
+ * sorts before 0.0, and NaNs after infinity of their sign).
+ */
+template <typename T, typename Enable = void>
+struct radix_traits;
+
+template <typename T>
+struct radix_traits<T, typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type> {
+    typedef T unsigned_type;
+    static unsigned_type encode(T x) { return x; }
+};
+
+template <typename T>
+struct radix_traits<T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type> {
+    typedef typename std::make_unsigned<T>::type unsigned_type;
+    static unsigned_type encode(T x) { return unsigned_type(x) ^ (unsigned_type(1) << (8 * sizeof(T) - 1)); }
+};
+
+template <>
+struct radix_traits<float> {
+    typedef uint32_t unsigned_type;
+    static unsigned_type encode(float x)
+    {
+        uint32_t u;
+        memcpy(&u, &x, sizeof(u));
+        return (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+    }
+};
+
+template <>
+struct radix_traits<double> {
+    typedef uint64_t unsigned_type;
+    static unsigned_type encode(double x)
+    {
+        uint64_t u;
+        memcpy(&u, &x, sizeof(u));
+        return (u & 0x8000000000000000ull) ? ~u : (u | 0x8000000000000000ull);
+    }
+};
+
+/**
+ * Digits of an encoded key: 8 bits for keys of up to 16 bits, 11 bits
+ * (three passes for 32-bit keys, six for 64-bit ones) above that, so that
+ * the counts of one digit stay in L1.
+ */
+template <typename U>
+struct radix_digits {
+    static const unsigned bits = (sizeof(U) <= 2) ? 8 : 11;
+    static const unsigned passes = (8 * sizeof(U) + bits - 1) / bits;
+    static const size_t buckets = size_t(1) << bits;
+};
+
+/**
+ * Ranges up to this many elements are left to stable_sort.
+ */
+const ptrdiff_t radix_sort_threshold = 256;
+
+/**
+ * Ranges of strings up to this many elements are insertion sorted.
+ */
+const ptrdiff_t radix_string_threshold = 32;
+
+/**
+ * Elements ahead of the one being scattered whose destination is
+ * prefetched.
+ */
+const size_t radix_prefetch_distance = 16;
+
+template <typename T>
+struct is_radix_string: std::is_same<T, std::string> {};
+
+struct radix_identity {
+    template <typename T>
+    const T& operator()(const T& x) const { return x; }
+};
+
+/**
+ * The digit of an element in the pass whose digit starts at shift.
+ */
+template <typename Key, typename Traits, typename Digits>
+struct radix_digit {
+    Key& key;
+    unsigned shift;
+
+    template <typename T>
+    size_t operator()(const T& x) const
+    {
+        return size_t(Traits::encode(key(x)) >> shift) & (Digits::buckets - 1);
+    }
+};
+
+/**
+ * Adds the digits of src[lo, hi) to count.
+ */
+template <typename InputIterator, typename Digit>
+void radix_count(InputIterator src, size_t lo, size_t hi, size_t* count, Digit& digit)
+{
+    for (size_t i = lo; i < hi; ++i)
+        ++count[digit(src[i])];
+}
+
+/**
+ * Moves src[lo, hi) to dst, each element to the next slot of its digit's
+ * bucket, offset[digit]. The stream of stores goes to as many places as
+ * there are buckets, so the destination of an element some way ahead is
+ * prefetched.
+ */
+template <typename InputIterator, typename OutputIterator, typename Digit>
+void radix_scatter(InputIterator src, size_t lo, size_t hi, OutputIterator dst, size_t* offset, Digit& digit)
+{
+    for (size_t i = lo; i < hi; ++i) {
+#if defined(__GNUC__)
+        if (i + radix_prefetch_distance < hi)
+            __builtin_prefetch(&*(dst + offset[digit(src[i + radix_prefetch_distance])]), 1);
+#endif
+        dst[offset[digit(src[i])]++] = std::move(src[i]);
+    }
+}
+
+/**
+ * LSD radix sort by the key key(x) of every element: the counts of all
+ * digits are gathered in one pass, a pass whose digit is the same for
+ * every element is skipped, and the others scatter the elements back and
+ * forth between the range and a buffer. Stable.
+ */
+template <typename RandomAccessIterator, typename Key>
+void radix_sort_lsd(RandomAccessIterator first, RandomAccessIterator last, Key key)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    typedef typename std::decay<decltype(key(*first))>::type key_type;
+    typedef radix_traits<key_type> traits;
+    typedef radix_digits<typename traits::unsigned_type> digits;
+
+    size_t n = last - first;
+    if (ptrdiff_t(n) <= radix_sort_threshold) {
+        Hx::stable_sort(first, last, [&](const value_type& a, const value_type& b) {
+            return traits::encode(key(a)) < traits::encode(key(b));
+        });
+        return;
+    }
+
+    std::vector<size_t> count(digits::passes * digits::buckets, 0);
+    for (size_t i = 0; i < n; ++i) {
+        typename traits::unsigned_type u = traits::encode(key(first[i]));
+        for (unsigned p = 0; p < digits::passes; ++p)
+            ++count[p * digits::buckets + (size_t(u >> (p * digits::bits)) & (digits::buckets - 1))];
+    }
+
+    const typename traits::unsigned_type u0 = traits::encode(key(first[0]));
+    std::vector<value_type> buf;
+    bool in_buf = false;
+    for (unsigned p = 0; p < digits::passes; ++p) {
+        radix_digit<Key, traits, digits> digit = { key, p * digits::bits };
+        size_t* offset = &count[p * digits::buckets];
+        if (offset[size_t(u0 >> digit.shift) & (digits::buckets - 1)] == n)
+            continue;   // every element has the same digit
+
+        size_t pos = 0;
+        for (size_t d = 0; d < digits::buckets; ++d) {
+            size_t cnt = offset[d];
+            offset[d] = pos;
+            pos += cnt;
+        }
+        if (buf.empty()) {
+            buf.assign(std::make_move_iterator(first), std::make_move_iterator(last));
+            in_buf = true;
+        }
+        if (in_buf)
+            Hx::radix_scatter(buf.begin(), 0, n, first, offset, digit);
+        else
+            Hx::radix_scatter(first, 0, n, buf.begin(), offset, digit);
+        in_buf = !in_buf;
+    }
+    if (in_buf)
+        std::move(buf.begin(), buf.end(), first);
+}
+
+/**
+ * The byte of s at depth, plus one; 0 past its end.
+ */
+inline size_t radix_byte(const std::string& s, size_t depth)
+{
+    return depth < s.size() ? size_t((unsigned char) s[depth]) + 1 : 0;
+}
+
+/**
+ * MSD radix sort of strings that share their first depth bytes: each
+ * level is one in-place American flag pass on the byte at depth. The
+ * largest bucket is sorted by the loop and the others recursively, so the
+ * recursion is at most log2(n) deep, and a byte common to all the strings
+ * costs one counting pass.
+ */
+template <typename RandomAccessIterator>
+void radix_sort_msd(RandomAccessIterator first, RandomAccessIterator last, size_t depth)
+{
+    const size_t buckets = 257;
+    for (;;) {
+        size_t n = last - first;
+        if (ptrdiff_t(n) <= radix_string_threshold) {
+            auto comp = [depth](const std::string& a, const std::string& b) {
+                return a.compare(depth, std::string::npos, b, depth, std::string::npos) < 0;
+            };
+            Hx::insertion_sort(first, last, comp);
+            return;
+        }
+
+        size_t head[buckets + 1] = {0};
+        for (size_t i = 0; i < n; ++i)
+            ++head[Hx::radix_byte(first[i], depth) + 1];
+        if (head[Hx::radix_byte(first[0], depth) + 1] == n) {
+            if (first[0].size() <= depth)
+                return;     // all equal
+            ++depth;
+            continue;
+        }
+
+        size_t tail[buckets];
+        for (size_t d = 0; d < buckets; ++d) {
+            head[d + 1] += head[d];
+            tail[d] = head[d + 1];
+        }
+        size_t start[buckets];
+        std::copy(head, head + buckets, start);
+
+        for (size_t d = 0; d < buckets; ++d) {
+            while (head[d] < tail[d]) {
+                size_t b = Hx::radix_byte(first[head[d]], depth);
+                if (b == d)
+                    ++head[d];
+                else
+                    std::swap(first[head[d]], first[head[b]++]);
+            }
+        }
+
+        size_t largest = 1;
+        for (size_t d = 2; d < buckets; ++d) {
+            if (tail[d] - start[d] > tail[largest] - start[largest])
+                largest = d;
+        }
+        for (size_t d = 1; d < buckets; ++d) {
+            if (d != largest && tail[d] - start[d] > 1)
+                Hx::radix_sort_msd(first + start[d], first + tail[d], depth + 1);
+        }
+        last = first + tail[largest];
+        first += start[largest];
+        ++depth;
+    }
+}
+
+template <typename RandomAccessIterator>
+void radix_sort(std::false_type, RandomAccessIterator first, RandomAccessIterator last)
+{
+    Hx::radix_sort_lsd(first, last, radix_identity());
+}
+
+template <typename RandomAccessIterator>
+void radix_sort(std::true_type, RandomAccessIterator first, RandomAccessIterator last)
+{
+    Hx::radix_sort_msd(first, last, 0);
+}
+
+/**
+ * Sorts integers, floats and doubles with an LSD radix sort, and strings
+ * with an MSD one.
+ */
+template <typename RandomAccessIterator>
+void radix_sort(RandomAccessIterator first, RandomAccessIterator last)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    Hx::radix_sort(is_radix_string<value_type>(), first, last);
+}
+
+/**
+ * Stable sort of the elements by key(x), which must be an integer, a
+ * float or a double.
+ */
+template <typename RandomAccessIterator, typename Key>
+void radix_sort(RandomAccessIterator first, RandomAccessIterator last, Key key)
+{
+    Hx::radix_sort_lsd(first, last, key);
+}
+
+/**
+ * Parallel LSD radix sort: in every pass each thread counts the digits of
+ * its chunk, and then scatters its chunk to the slots that the counts of
+ * the chunks before it leave free in each bucket, which keeps the sort
+ * stable.
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename Key>
+void radix_sort_lsd(ExecutionPolicy& policy, RandomAccessIterator first, RandomAccessIterator last, Key key)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    typedef typename std::decay<decltype(key(*first))>::type key_type;
+    typedef radix_traits<key_type> traits;
+    typedef radix_digits<typename traits::unsigned_type> digits;
+
+    size_t n = last - first;
+    unsigned k = execution::chunk_count(policy, n);
+    if (k <= 1) {
+        Hx::radix_sort_lsd(first, last, key);
+        return;
+    }
+
+    std::vector<value_type> buf(std::make_move_iterator(first), std::make_move_iterator(last));
+    std::vector<size_t> count(size_t(k) * digits::buckets);     // [chunk][digit]
+    bool in_buf = true;
+    for (unsigned p = 0; p < digits::passes; ++p) {
+        radix_digit<Key, traits, digits> digit = { key, p * digits::bits };
+        execution::for_each_chunk(policy, n, [&](unsigned c, size_t lo, size_t hi) {
+            size_t* cnt = &count[c * digits::buckets];
+            std::fill(cnt, cnt + digits::buckets, 0);
+            if (in_buf)
+                Hx::radix_count(buf.begin(), lo, hi, cnt, digit);
+            else
+                Hx::radix_count(first, lo, hi, cnt, digit);
+        });
+
+        size_t pos = 0;
+        bool skip = false;
+        for (size_t d = 0; d < digits::buckets; ++d) {
+            size_t start = pos;
+            for (unsigned c = 0; c < k; ++c) {
+                size_t cnt = count[c * digits::buckets + d];
+                count[c * digits::buckets + d] = pos;
+                pos += cnt;
+            }
+            skip = skip || pos - start == n;
+        }
+        if (skip)
+            continue;   // every element has the same digit
+
+        execution::for_each_chunk(policy, n, [&](unsigned c, size_t lo, size_t hi) {
+            if (in_buf)
+                Hx::radix_scatter(buf.begin(), lo, hi, first, &count[c * digits::buckets], digit);
+            else
+                Hx::radix_scatter(first, lo, hi, buf.begin(), &count[c * digits::buckets], digit);
+        });
+        in_buf = !in_buf;
+    }
+    if (in_buf) {
+        execution::for_each_chunk(policy, n, [&](unsigned, size_t lo, size_t hi) {
+            std::move(buf.begin() + lo, buf.begin() + hi, first + lo);
+        });
+    }
+}
+
+/**
+ * Parallel MSD radix sort of strings: one American flag pass on the first
+ * byte, after which the threads take the buckets one by one.
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator>
+void radix_sort_msd(ExecutionPolicy& policy, RandomAccessIterator first, RandomAccessIterator last)
+{
+    const size_t buckets = 257;
+    size_t n = last - first;
+    unsigned k = execution::chunk_count(policy, n);
+    if (k <= 1) {
+        Hx::radix_sort_msd(first, last, 0);
+        return;
+    }
+
+    size_t head[buckets + 1] = {0};
+    for (size_t i = 0; i < n; ++i)
+        ++head[Hx::radix_byte(first[i], 0) + 1];
+    size_t tail[buckets];
+    for (size_t d = 0; d < buckets; ++d) {
+        head[d + 1] += head[d];
+        tail[d] = head[d + 1];
+    }
+    size_t start[buckets];
+    std::copy(head, head + buckets, start);
+    for (size_t d = 0; d < buckets; ++d) {
+        while (head[d] < tail[d]) {
+            size_t b = Hx::radix_byte(first[head[d]], 0);
+            if (b == d)
+                ++head[d];
+            else
+                std::swap(first[head[d]], first[head[b]++]);
+        }
+    }
+
+    std::atomic<size_t> next(1);
+    execution::fork_join_pool::instance().run(k, [&](unsigned) {
+        for (size_t d; (d = next.fetch_add(1)) < buckets; ) {
+            if (tail[d] - start[d] > 1)
+                Hx::radix_sort_msd(first + start[d], first + tail[d], 1);
+        }
+    });
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator>
+void radix_sort(ExecutionPolicy& policy, std::false_type, RandomAccessIterator first, RandomAccessIterator last)
+{
+    Hx::radix_sort_lsd(policy, first, last, radix_identity());
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator>
+void radix_sort(ExecutionPolicy& policy, std::true_type, RandomAccessIterator first, RandomAccessIterator last)
+{
+    Hx::radix_sort_msd(policy, first, last);
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator>
+typename execution::enable_if_execution_policy<ExecutionPolicy, void>::type
+radix_sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    Hx::radix_sort(policy, is_radix_string<value_type>(), first, last);
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename Key>
+typename execution::enable_if_execution_policy<ExecutionPolicy, void>::type
+radix_sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last, Key key)
+{
+    Hx::radix_sort_lsd(policy, first, last, key);
+}
+
+}   // namespace Hx
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <iterator>
+#include <type_traits>
+#include "simd_backend.hpp"
+
+namespace Hx {
+
+template <typename ForwardIterator1, typename ForwardIterator2>
+ForwardIterator1 search(std::false_type, ForwardIterator1 first1, ForwardIterator1 last1,
+        ForwardIterator2 first2, ForwardIterator2 last2)
+{
+    if (first2 == last2)
+        return first1;
+
+    while (first1 != last1) {
+        ForwardIterator1 it1 = first1;
+        ForwardIterator2 it2 = first2;
+        while (*it1 == *it2) {
+            ++it1;
+            ++it2;
+            if (it2 == last2)
+                return first1;
+            if (it1 == last1)
+                return last1;
+        }
+        ++first1;
+    }
+    return last1;
+}
+
+template <typename RandomAccessIterator1, typename RandomAccessIterator2>
+RandomAccessIterator1 search(std::true_type, RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+        RandomAccessIterator2 first2, RandomAccessIterator2 last2)
+{
+    if (first2 == last2)
+        return first1;
+    if (last2 - first2 > last1 - first1)
+        return last1;
+
+    return first1 + simd::search(simd::address_of(first1), last1 - first1,
+        simd::address_of(first2), last2 - first2);
+}
+
+template <typename ForwardIterator1, typename ForwardIterator2>
+ForwardIterator1 search(ForwardIterator1 first1, ForwardIterator1 last1,
+        ForwardIterator2 first2, ForwardIterator2 last2)
+{
+    return Hx::search(simd::is_vectorizable_pair<ForwardIterator1, ForwardIterator2>(),
+        first1, last1, first2, last2);
+}
+
+template <typename ForwardIterator1, typename ForwardIterator2, typename BinaryPredicate>
+ForwardIterator1 search(ForwardIterator1 first1, ForwardIterator1 last1,
+        ForwardIterator2 first2, ForwardIterator2 last2, BinaryPredicate pred)
+{
+    if (first2 == last2)
+        return first1;
+
+    while (first1 != last1) {
+        ForwardIterator1 it1 = first1;
+        ForwardIterator2 it2 = first2;
+        while (pred(*it1, *it2)) {
+            ++it1;
+            ++it2;
+            if (it2 == last2)
+                return first1;
+            if (it1 == last1)
+                return last1;
+        }
+        ++first1;
+    }
+    return last1;
+}
+
+}   // namespace Hx
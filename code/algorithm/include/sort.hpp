@@ -0,0 +1,551 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "parallel_backend.hpp"
+
+namespace Hx {
+
+/**
+ * Ranges up to this many elements are left to small_sort by the
+ * introsort loop.
+ */
+const ptrdiff_t sort_threshold = 16;
+
+/**
+ * True for element types whose comparisons are cheap enough that the
+ * branchless partition and the sorting networks pay off.
+ */
+template <typename T>
+struct is_branchless_sortable: std::integral_constant<bool,
+    std::is_arithmetic<T>::value || std::is_pointer<T>::value> {};
+
+template <typename RandomAccessIterator, typename Compare>
+void insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare& comp)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    if (first == last)
+        return;
+
+    for (RandomAccessIterator i = first + 1; i != last; ++i) {
+        value_type val = std::move(*i);
+        RandomAccessIterator j = i;
+        for ( ; j != first && comp(val, *(j - 1)); --j)
+            *j = std::move(*(j - 1));
+        *j = std::move(val);
+    }
+}
+
+/**
+ * Orders a and b with conditional moves instead of a branch.
+ */
+template <typename T, typename Compare>
+inline void compare_exchange(T& a, T& b, Compare& comp)
+{
+    bool c = comp(b, a);
+    T x = c ? b : a;
+    T y = c ? a : b;
+    a = x;
+    b = y;
+}
+
+/**
+ * Sorts the n <= 8 elements at first with a size-optimal sorting network.
+ */
+template <typename RandomAccessIterator, typename Compare>
+void network_sort(RandomAccessIterator first, ptrdiff_t n, Compare& comp)
+{
+    auto cx = [&](ptrdiff_t i, ptrdiff_t j) { Hx::compare_exchange(first[i], first[j], comp); };
+    switch (n) {
+    case 2:
+        cx(0, 1);
+        break;
+    case 3:
+        cx(0, 2); cx(0, 1); cx(1, 2);
+        break;
+    case 4:
+        cx(0, 2); cx(1, 3); cx(0, 1); cx(2, 3); cx(1, 2);
+        break;
+    case 5:
+        cx(0, 3); cx(1, 4); cx(0, 2); cx(1, 3); cx(0, 1);
+        cx(2, 4); cx(1, 2); cx(3, 4); cx(2, 3);
+        break;
+    case 6:
+        cx(0, 5); cx(1, 3); cx(2, 4); cx(1, 2); cx(3, 4); cx(0, 3);
+        cx(2, 5); cx(0, 1); cx(2, 3); cx(4, 5); cx(1, 2); cx(3, 4);
+        break;
+    case 7:
+        cx(0, 6); cx(2, 3); cx(4, 5); cx(0, 2); cx(1, 4); cx(3, 6); cx(0, 1); cx(2, 5);
+        cx(3, 4); cx(1, 2); cx(4, 6); cx(2, 3); cx(4, 5); cx(1, 2); cx(3, 4); cx(5, 6);
+        break;
+    case 8:
+        cx(0, 2); cx(1, 3); cx(4, 6); cx(5, 7); cx(0, 4); cx(1, 5); cx(2, 6);
+        cx(3, 7); cx(0, 1); cx(2, 3); cx(4, 5); cx(6, 7); cx(2, 4); cx(3, 5);
+        cx(1, 4); cx(3, 6); cx(1, 2); cx(3, 4); cx(5, 6);
+        break;
+    }
+}
+
+/**
+ * Sorts a range of at most sort_threshold elements: insertion sort in
+ * general; for cheap element types, networks on the two halves and a
+ * branchless merge.
+ */
+template <typename RandomAccessIterator, typename Compare>
+void small_sort(std::false_type, RandomAccessIterator first, RandomAccessIterator last, Compare& comp)
+{
+    Hx::insertion_sort(first, last, comp);
+}
+
+template <typename RandomAccessIterator, typename Compare>
+void small_sort(std::true_type, RandomAccessIterator first, RandomAccessIterator last, Compare& comp)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    ptrdiff_t n = last - first;
+    if (n <= 8) {
+        Hx::network_sort(first, n, comp);
+        return;
+    }
+
+    ptrdiff_t h = n / 2;
+    Hx::network_sort(first, h, comp);
+    Hx::network_sort(first + h, n - h, comp);
+
+    value_type buf[sort_threshold];
+    ptrdiff_t i = 0, j = h, k = 0;
+    while (i < h && j < n) {
+        bool right = comp(first[j], first[i]);
+        buf[k++] = right ? first[j] : first[i];
+        j += right;
+        i += !right;
+    }
+    while (i < h)
+        buf[k++] = first[i++];
+    while (j < n)
+        buf[k++] = first[j++];
+    for (k = 0; k < n; ++k)
+        first[k] = buf[k];
+}
+
+template <typename RandomAccessIterator, typename Compare>
+void sift_down(RandomAccessIterator first, ptrdiff_t i, ptrdiff_t n, Compare& comp)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    value_type val = std::move(first[i]);
+    for (;;) {
+        ptrdiff_t child = 2 * i + 1;
+        if (child >= n)
+            break;
+        if (child + 1 < n && comp(first[child], first[child + 1]))
+            ++child;
+        if (!comp(val, first[child]))
+            break;
+        first[i] = std::move(first[child]);
+        i = child;
+    }
+    first[i] = std::move(val);
+}
+
+/**
+ * Fallback of the introsort loop once its depth limit is exceeded.
+ */
+template <typename RandomAccessIterator, typename Compare>
+void heap_sort(RandomAccessIterator first, RandomAccessIterator last, Compare& comp)
+{
+    ptrdiff_t n = last - first;
+    for (ptrdiff_t i = n / 2 - 1; i >= 0; --i)
+        Hx::sift_down(first, i, n, comp);
+    for (ptrdiff_t e = n - 1; e > 0; --e) {
+        std::iter_swap(first, first + e);
+        Hx::sift_down(first, 0, e, comp);
+    }
+}
+
+template <typename RandomAccessIterator, typename Compare>
+void sort3(RandomAccessIterator a, RandomAccessIterator b, RandomAccessIterator c, Compare& comp)
+{
+    if (comp(*b, *a)) std::iter_swap(a, b);
+    if (comp(*c, *b)) std::iter_swap(b, c);
+    if (comp(*b, *a)) std::iter_swap(a, b);
+}
+
+/**
+ * Moves the pivot to *first: the median of three, or for larger ranges
+ * the median of three medians of three (Tukey's ninther).
+ */
+template <typename RandomAccessIterator, typename Compare>
+void select_pivot(RandomAccessIterator first, RandomAccessIterator last, Compare& comp)
+{
+    ptrdiff_t n = last - first;
+    RandomAccessIterator mid = first + n / 2;
+    if (n > 128) {
+        Hx::sort3(first, mid, last - 1, comp);
+        Hx::sort3(first + 1, mid - 1, last - 2, comp);
+        Hx::sort3(first + 2, mid + 1, last - 3, comp);
+        Hx::sort3(mid - 1, mid, mid + 1, comp);
+        std::iter_swap(first, mid);
+    } else {
+        Hx::sort3(mid, first, last - 1, comp);
+    }
+}
+
+/**
+ * Moves the elements for which pred is true before the others, and
+ * returns the first of the others.
+ */
+template <typename RandomAccessIterator, typename Predicate>
+RandomAccessIterator partition_scalar(RandomAccessIterator first, RandomAccessIterator last, Predicate& pred)
+{
+    for (;;) {
+        while (first != last && pred(*first))
+            ++first;
+        if (first == last)
+            return first;
+        --last;
+        while (first != last && !pred(*last))
+            --last;
+        if (first == last)
+            return first;
+        std::iter_swap(first, last);
+        ++first;
+    }
+}
+
+/**
+ * Same as partition_scalar, but block by block (Edelkamp and Weiss,
+ * BlockQuicksort): the offsets of the misplaced elements of a block on
+ * each side are first collected without branching on pred, then swapped
+ * pairwise. The leftover of less than two blocks is done by
+ * partition_scalar.
+ */
+template <typename RandomAccessIterator, typename Predicate>
+RandomAccessIterator partition_branchless(RandomAccessIterator first, RandomAccessIterator last, Predicate& pred)
+{
+    const size_t block = 64;
+    unsigned char off_l[block], off_r[block];
+    size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+    while (last - first >= ptrdiff_t(2 * block)) {
+        if (num_l == 0) {
+            start_l = 0;
+            for (size_t i = 0; i < block; ++i) {
+                off_l[num_l] = (unsigned char) i;
+                num_l += !pred(first[i]);
+            }
+        }
+        if (num_r == 0) {
+            start_r = 0;
+            for (size_t i = 0; i < block; ++i) {
+                off_r[num_r] = (unsigned char) (i + 1);
+                num_r += bool(pred(*(last - (i + 1))));
+            }
+        }
+
+        size_t num = std::min(num_l, num_r);
+        for (size_t i = 0; i < num; ++i)
+            std::iter_swap(first + off_l[start_l + i], last - off_r[start_r + i]);
+        num_l -= num;
+        num_r -= num;
+        start_l += num;
+        start_r += num;
+        if (num_l == 0)
+            first += block;
+        if (num_r == 0)
+            last -= block;
+    }
+    return Hx::partition_scalar(first, last, pred);
+}
+
+template <typename RandomAccessIterator, typename Predicate>
+RandomAccessIterator partition(std::false_type, RandomAccessIterator first, RandomAccessIterator last,
+        Predicate pred)
+{
+    return Hx::partition_scalar(first, last, pred);
+}
+
+template <typename RandomAccessIterator, typename Predicate>
+RandomAccessIterator partition(std::true_type, RandomAccessIterator first, RandomAccessIterator last,
+        Predicate pred)
+{
+    return Hx::partition_branchless(first, last, pred);
+}
+
+/**
+ * Partitions [first, last) around the pivot at *first, and returns the
+ * pivot's final position: the elements before it are less, the ones
+ * after it are not. A cheap pivot is copied, so that the compiler can
+ * keep it in a register across the swaps.
+ */
+template <typename RandomAccessIterator, typename Compare, typename Branchless>
+RandomAccessIterator partition_pivot(RandomAccessIterator first, RandomAccessIterator last,
+        Compare& comp, Branchless branchless)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    typename std::conditional<Branchless::value, const value_type, const value_type&>::type pivot = *first;
+    RandomAccessIterator mid = Hx::partition(branchless, first + 1, last,
+        [&](const value_type& x) { return bool(comp(x, pivot)); }) - 1;
+    std::iter_swap(first, mid);
+    return mid;
+}
+
+/**
+ * Partitions [first, last), whose elements are not less than the pivot
+ * at *first, into the elements equal to it and the greater ones, and
+ * returns the first of the greater ones.
+ */
+template <typename RandomAccessIterator, typename Compare, typename Branchless>
+RandomAccessIterator partition_equal(RandomAccessIterator first, RandomAccessIterator last,
+        Compare& comp, Branchless branchless)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    typename std::conditional<Branchless::value, const value_type, const value_type&>::type pivot = *first;
+    return Hx::partition(branchless, first + 1, last,
+        [&](const value_type& x) { return !comp(pivot, x); });
+}
+
+/**
+ * Swaps a few elements of a range left behind by an unbalanced partition
+ * into the places that select_pivot samples, so that a pattern in the
+ * input (organ pipes, sawtooth, ...) which gave one bad pivot does not
+ * give the next one too (as in pdqsort).
+ */
+template <typename RandomAccessIterator>
+void break_patterns(RandomAccessIterator first, RandomAccessIterator last)
+{
+    ptrdiff_t n = last - first;
+    if (n <= sort_threshold)
+        return;
+
+    std::iter_swap(first, first + n / 4);
+    std::iter_swap(last - 1, last - n / 4);
+    if (n > 128) {
+        std::iter_swap(first + 1, first + (n / 4 + 1));
+        std::iter_swap(first + 2, first + (n / 4 + 2));
+        std::iter_swap(last - 2, last - (n / 4 + 1));
+        std::iter_swap(last - 3, last - (n / 4 + 2));
+    }
+}
+
+/**
+ * Partitions [first, last) around the pivot at *first as
+ * partition_pivot does, and on an unbalanced split (one side shorter
+ * than an eighth of the range) breaks the patterns of both sides and
+ * counts it against bad_allowed.
+ */
+template <typename RandomAccessIterator, typename Compare, typename Branchless>
+RandomAccessIterator partition_balanced(RandomAccessIterator first, RandomAccessIterator last,
+        int& bad_allowed, Compare& comp, Branchless branchless)
+{
+    RandomAccessIterator mid = Hx::partition_pivot(first, last, comp, branchless);
+    ptrdiff_t n = last - first;
+    if (mid - first < n / 8 || last - mid - 1 < n / 8) {
+        --bad_allowed;
+        Hx::break_patterns(first, mid);
+        Hx::break_patterns(mid + 1, last);
+    }
+    return mid;
+}
+
+/**
+ * Introsort: quicksort down to small ranges, heap sort once bad_allowed
+ * unbalanced partitions show that the pivots are bad. leftmost is false
+ * when the element before first is the pivot of an enclosing partition,
+ * hence no greater than the range; a pivot equal to it means the range
+ * holds duplicates, and those are split off in one linear pass (as in
+ * pdqsort), so that inputs with few distinct values sort in O(n log k).
+ */
+template <typename RandomAccessIterator, typename Compare, typename Branchless>
+void introsort_loop(RandomAccessIterator first, RandomAccessIterator last, int bad_allowed, bool leftmost,
+        Compare& comp, Branchless branchless)
+{
+    while (last - first > sort_threshold) {
+        if (bad_allowed == 0) {
+            Hx::heap_sort(first, last, comp);
+            return;
+        }
+
+        Hx::select_pivot(first, last, comp);
+        if (!leftmost && !comp(*(first - 1), *first)) {
+            first = Hx::partition_equal(first, last, comp, branchless);
+            continue;
+        }
+
+        RandomAccessIterator mid = Hx::partition_balanced(first, last, bad_allowed, comp, branchless);
+        if (mid - first < last - mid) {
+            Hx::introsort_loop(first, mid, bad_allowed, leftmost, comp, branchless);
+            first = mid + 1;
+            leftmost = false;
+        } else {
+            Hx::introsort_loop(mid + 1, last, bad_allowed, false, comp, branchless);
+            last = mid;
+        }
+    }
+    Hx::small_sort(branchless, first, last, comp);
+}
+
+/**
+ * The floor of log2(n): the number of unbalanced partitions the
+ * introsort loop allows before it falls back to heap sort. Every other
+ * partition leaves at most 7/8 of its range to each side, so the
+ * recursion stays O(log n) deep.
+ */
+inline int sort_depth_limit(ptrdiff_t n)
+{
+    int depth = 0;
+    for ( ; n > 1; n >>= 1)
+        ++depth;
+    return depth;
+}
+
+/**
+ * Handles the inputs that are already sorted either way in one pass:
+ * returns true if [first, last) (of at least two elements) was
+ * ascending, or descending and has now been reversed.
+ */
+template <typename RandomAccessIterator, typename Compare>
+bool sort_monotonic(RandomAccessIterator first, RandomAccessIterator last, Compare& comp)
+{
+    RandomAccessIterator i = first + 1;
+    if (!comp(*i, *first)) {
+        while (i != last && !comp(*i, *(i - 1)))
+            ++i;
+        return i == last;
+    }
+
+    while (i != last && !comp(*(i - 1), *i))
+        ++i;
+    if (i != last)
+        return false;
+    while (first < --last)
+        std::iter_swap(first++, last);
+    return true;
+}
+
+template <typename RandomAccessIterator, typename Compare>
+void sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    if (last - first < 2)
+        return;
+
+    if (Hx::sort_monotonic(first, last, comp))
+        return;
+    Hx::introsort_loop(first, last, Hx::sort_depth_limit(last - first), true, comp,
+        is_branchless_sortable<value_type>());
+}
+
+template <typename RandomAccessIterator>
+void sort(RandomAccessIterator first, RandomAccessIterator last)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    Hx::sort(first, last, std::less<value_type>());
+}
+
+/**
+ * Index of the first of the sorted splitters s[0] ... s[n-1] greater
+ * than x, i.e. the bucket of x.
+ */
+template <typename T, typename Compare>
+size_t bucket_index(const T* s, size_t n, const T& x, Compare& comp)
+{
+    size_t b = 0;
+    while (n > 0) {
+        size_t half = n / 2;
+        if (!comp(x, s[b + half])) {
+            b += half + 1;
+            n -= half + 1;
+        } else {
+            n = half;
+        }
+    }
+    return b;
+}
+
+/**
+ * Parallel samplesort: k - 1 splitters are picked from an oversampled,
+ * sorted sample; every thread counts the elements of its chunk per
+ * bucket, the counts give each (chunk, bucket) pair its place, every
+ * thread scatters its chunk, and then the k buckets are sorted
+ * concurrently with the sequential sort.
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename Compare>
+void sort(ExecutionPolicy& policy, RandomAccessIterator first, RandomAccessIterator last, Compare comp,
+        std::random_access_iterator_tag)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    size_t n = last - first;
+    unsigned k = execution::chunk_count(policy, n);
+    if (k <= 1) {
+        Hx::sort(first, last, comp);
+        return;
+    }
+    if (Hx::sort_monotonic(first, last, comp))
+        return;
+
+    const size_t oversample = 32;
+    std::vector<value_type> sample;
+    size_t s = size_t(k) * oversample;
+    for (size_t i = 0; i < s; ++i)
+        sample.push_back(first[i * n / s]);
+    Hx::sort(sample.begin(), sample.end(), comp);
+    std::vector<value_type> splitters;
+    for (unsigned b = 1; b < k; ++b)
+        splitters.push_back(sample[b * oversample]);
+
+    std::vector<value_type> buf(std::make_move_iterator(first), std::make_move_iterator(last));
+    std::vector<unsigned> bucket(n);
+    std::vector<size_t> count(size_t(k) * k, 0);     // [chunk][bucket]
+    execution::for_each_chunk(policy, n, [&](unsigned c, size_t lo, size_t hi) {
+        size_t* cnt = &count[size_t(c) * k];
+        for (size_t i = lo; i < hi; ++i) {
+            unsigned b = (unsigned) Hx::bucket_index(splitters.data(), k - 1, buf[i], comp);
+            bucket[i] = b;
+            ++cnt[b];
+        }
+    });
+
+    std::vector<size_t> bucket_start(k + 1);
+    size_t pos = 0;
+    for (unsigned b = 0; b < k; ++b) {
+        bucket_start[b] = pos;
+        for (unsigned c = 0; c < k; ++c) {
+            size_t cnt = count[size_t(c) * k + b];
+            count[size_t(c) * k + b] = pos;
+            pos += cnt;
+        }
+    }
+    bucket_start[k] = n;
+
+    execution::for_each_chunk(policy, n, [&](unsigned c, size_t lo, size_t hi) {
+        size_t* out = &count[size_t(c) * k];
+        for (size_t i = lo; i < hi; ++i)
+            first[out[bucket[i]]++] = std::move(buf[i]);
+    });
+
+    execution::fork_join_pool::instance().run(k, [&](unsigned b) {
+        Hx::sort(first + bucket_start[b], first + bucket_start[b + 1], comp);
+    });
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename Compare>
+typename execution::enable_if_execution_policy<ExecutionPolicy, void>::type
+sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    Hx::sort(policy, first, last, comp,
+        typename std::iterator_traits<RandomAccessIterator>::iterator_category());
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator>
+typename execution::enable_if_execution_policy<ExecutionPolicy, void>::type
+sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    Hx::sort(policy, first, last, std::less<value_type>(),
+        typename std::iterator_traits<RandomAccessIterator>::iterator_category());
+}
+
+}   // namespace Hx
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "parallel_backend.hpp"
+#include "sort.hpp"
+
+namespace Hx {
+
+/**
+ * Runs of this many elements are insertion sorted before merging.
+ */
+const ptrdiff_t stable_sort_run = 32;
+
+/**
+ * Moves the merge of the sorted ranges [first1, last1) and
+ * [first2, last2) to out; of equivalent elements, the ones of the first
+ * range come first.
+ */
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator, typename Compare>
+OutputIterator move_merge(InputIterator1 first1, InputIterator1 last1,
+        InputIterator2 first2, InputIterator2 last2, OutputIterator out, Compare& comp)
+{
+    while (first1 != last1 && first2 != last2) {
+        if (comp(*first2, *first1))
+            *out++ = std::move(*first2++);
+        else
+            *out++ = std::move(*first1++);
+    }
+    while (first1 != last1)
+        *out++ = std::move(*first1++);
+    while (first2 != last2)
+        *out++ = std::move(*first2++);
+    return out;
+}
+
+/**
+ * Moves the merge of the adjacent sorted runs of width elements in
+ * [src, src + n) to dst.
+ */
+template <typename InputIterator, typename OutputIterator, typename Compare>
+void merge_runs(InputIterator src, OutputIterator dst, ptrdiff_t n, ptrdiff_t width, Compare& comp)
+{
+    for (ptrdiff_t lo = 0; lo < n; lo += 2 * width) {
+        ptrdiff_t mid = std::min(lo + width, n);
+        ptrdiff_t hi = std::min(lo + 2 * width, n);
+        Hx::move_merge(src + lo, src + mid, src + mid, src + hi, dst + lo, comp);
+    }
+}
+
+/**
+ * Bottom-up merge sort: insertion sorted runs, then merge passes that go
+ * back and forth between the range and a buffer.
+ */
+template <typename RandomAccessIterator, typename Compare>
+void stable_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    ptrdiff_t n = last - first;
+    if (n < 2)
+        return;
+
+    // an ascending input costs one pass
+    RandomAccessIterator i = first + 1;
+    while (i != last && !comp(*i, *(i - 1)))
+        ++i;
+    if (i == last)
+        return;
+
+    for (ptrdiff_t lo = 0; lo < n; lo += stable_sort_run)
+        Hx::insertion_sort(first + lo, first + std::min(lo + stable_sort_run, n), comp);
+    if (n <= stable_sort_run)
+        return;
+
+    std::vector<value_type> buf(std::make_move_iterator(first), std::make_move_iterator(last));
+    bool in_buf = true;
+    for (ptrdiff_t width = stable_sort_run; width < n; width *= 2) {
+        if (in_buf)
+            Hx::merge_runs(buf.begin(), first, n, width, comp);
+        else
+            Hx::merge_runs(first, buf.begin(), n, width, comp);
+        in_buf = !in_buf;
+    }
+    if (in_buf)
+        std::move(buf.begin(), buf.end(), first);
+}
+
+template <typename RandomAccessIterator>
+void stable_sort(RandomAccessIterator first, RandomAccessIterator last)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    Hx::stable_sort(first, last, std::less<value_type>());
+}
+
+/**
+ * Merge path: how many of the first diag elements of the stable merge of
+ * a[0, na) and b[0, nb) come from a.
+ */
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename Compare>
+ptrdiff_t merge_path(RandomAccessIterator1 a, ptrdiff_t na, RandomAccessIterator2 b, ptrdiff_t nb,
+        ptrdiff_t diag, Compare& comp)
+{
+    ptrdiff_t lo = std::max<ptrdiff_t>(0, diag - nb);
+    ptrdiff_t hi = std::min(diag, na);
+    while (lo < hi) {
+        ptrdiff_t i = lo + (hi - lo) / 2;
+        if (comp(b[diag - i - 1], a[i]))
+            hi = i;
+        else
+            lo = i + 1;
+    }
+    return lo;
+}
+
+/**
+ * Same as merge_runs, but each merge is split along its merge path into
+ * as many equal parts as the policy has threads.
+ */
+template <typename ExecutionPolicy, typename InputIterator, typename OutputIterator, typename Compare>
+void merge_runs(ExecutionPolicy& policy, InputIterator src, OutputIterator dst,
+        const std::vector<ptrdiff_t>& runs, Compare& comp)
+{
+    for (size_t r = 0; r + 1 < runs.size(); r += 2) {
+        ptrdiff_t lo = runs[r];
+        ptrdiff_t mid = runs[r + 1];
+        ptrdiff_t hi = (r + 2 < runs.size()) ? runs[r + 2] : mid;
+        execution::for_each_chunk(policy, hi - lo, [&](unsigned, ptrdiff_t d0, ptrdiff_t d1) {
+            ptrdiff_t i0 = Hx::merge_path(src + lo, mid - lo, src + mid, hi - mid, d0, comp);
+            ptrdiff_t i1 = Hx::merge_path(src + lo, mid - lo, src + mid, hi - mid, d1, comp);
+            Hx::move_merge(src + lo + i0, src + lo + i1, src + mid + (d0 - i0), src + mid + (d1 - i1),
+                dst + lo + d0, comp);
+        });
+    }
+}
+
+/**
+ * Parallel merge sort: every thread stable sorts one chunk, then pairs
+ * of adjacent runs are merged, each merge split over all the threads
+ * along its merge path, until one run is left.
+ */
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename Compare>
+void stable_sort(ExecutionPolicy& policy, RandomAccessIterator first, RandomAccessIterator last,
+        Compare comp, std::random_access_iterator_tag)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    ptrdiff_t n = last - first;
+    unsigned k = execution::chunk_count(policy, n);
+    if (k <= 1) {
+        Hx::stable_sort(first, last, comp);
+        return;
+    }
+
+    std::vector<ptrdiff_t> runs(1, 0);
+    execution::for_each_chunk(policy, n, [&](unsigned, ptrdiff_t lo, ptrdiff_t hi) {
+        Hx::stable_sort(first + lo, first + hi, comp);
+    });
+    for (unsigned c = 1; c <= k; ++c)
+        runs.push_back(n / k * c + std::min<ptrdiff_t>(c, n % k));
+
+    std::vector<value_type> buf(std::make_move_iterator(first), std::make_move_iterator(last));
+    bool in_buf = true;
+    while (runs.size() > 2) {
+        if (in_buf)
+            Hx::merge_runs(policy, buf.begin(), first, runs, comp);
+        else
+            Hx::merge_runs(policy, first, buf.begin(), runs, comp);
+        in_buf = !in_buf;
+
+        std::vector<ptrdiff_t> merged;
+        for (size_t r = 0; r < runs.size(); r += 2)
+            merged.push_back(runs[r]);
+        if (merged.back() != n)
+            merged.push_back(n);
+        runs.swap(merged);
+    }
+    if (in_buf) {
+        execution::for_each_chunk(policy, n, [&](unsigned, ptrdiff_t lo, ptrdiff_t hi) {
+            std::move(buf.begin() + lo, buf.begin() + hi, first + lo);
+        });
+    }
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename Compare>
+typename execution::enable_if_execution_policy<ExecutionPolicy, void>::type
+stable_sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+{
+    Hx::stable_sort(policy, first, last, comp,
+        typename std::iterator_traits<RandomAccessIterator>::iterator_category());
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator>
+typename execution::enable_if_execution_policy<ExecutionPolicy, void>::type
+stable_sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+    Hx::stable_sort(policy, first, last, std::less<value_type>(),
+        typename std::iterator_traits<RandomAccessIterator>::iterator_category());
+}
+
+}   // namespace Hx
@@ -0,0 +1,88 @@
+// GB/s of the vectorized adjacent_find against std:: and a plain scalar
+// loop, for every lane type of the kernels; see "bench.hpp" for the
+// options. The argument is the size of the range in bytes, and no two
+// neighbours are equal, so every run reads the whole range. "Hx <isa>"
+// rows cap the kernels at that instruction set.
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "adjacent_find.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+template <typename T>
+std::vector<T> make_data(long bytes)
+{
+    std::vector<T> v(bytes / sizeof(T));
+    for (size_t i = 0; i < v.size(); i++)
+        v[i] = T(i % 97);
+    return v;
+}
+
+/**
+ * Sets the instruction set of the kernels (if level names one) for the
+ * lifetime of the object.
+ */
+struct isa_scope {
+    explicit isa_scope(int level) { if (level >= 0) Hx::simd::set_isa(Hx::simd::isa(level)); }
+    ~isa_scope() { Hx::simd::set_isa(Hx::simd::avx512); }
+};
+
+// std, scalar loop, or Hx at instruction set Level
+enum impl { std_impl = -2, scalar_impl = -1 };
+
+template <typename T, int Impl>
+struct adjacent_find_bench {
+    static void run(state& st)
+    {
+        std::vector<T> v = make_data<T>(st.arg());
+        const T* p = v.data();
+        size_t n = v.size();
+        isa_scope scope(Impl);
+        while (st.keep_running()) {
+            const T* r;
+            if (Impl == std_impl) {
+                r = std::adjacent_find(p, p + n);
+            } else if (Impl == scalar_impl) {
+                size_t i = 0;
+                while (i+1 < n && !(p[i] == p[i+1]))
+                    ++i;
+                r = i+1 < n ? p + i : p + n;
+            } else {
+                r = Hx::adjacent_find(p, p + n);
+            }
+            do_not_optimize(r);
+        }
+        st.set_bytes_per_iteration(n * sizeof(T));
+    }
+};
+
+/** The rows of one lane type: std, scalar, and Hx at every instruction set up to the best one of this cpu. */
+template <typename T>
+void add(Hx::bench::suite& s, const std::string& type, std::initializer_list<long> args)
+{
+    static const Hx::bench::suite::function_type fn[] = {
+        adjacent_find_bench<T, 0>::run, adjacent_find_bench<T, 1>::run,
+        adjacent_find_bench<T, 2>::run, adjacent_find_bench<T, 3>::run };
+    const std::string name = "adjacent_find<" + type + ">";
+    s.add(name, "std", adjacent_find_bench<T, std_impl>::run).args(args);
+    s.add(name, "scalar", adjacent_find_bench<T, scalar_impl>::run).args(args);
+    for (int level = Hx::simd::sse2; level <= Hx::simd::detect_isa(); level++)
+        s.add(name, std::string("Hx ") + Hx::simd::isa_name(Hx::simd::isa(level)), fn[level]).args(args);
+}
+
+int main(int argc, char* argv[])
+{
+    const std::initializer_list<long> sizes = {1 << 14, 64 << 20};
+    Hx::bench::suite s("adjacent_find");
+    add<int8_t>(s, "int8_t", sizes);
+    add<int16_t>(s, "int16_t", sizes);
+    add<int32_t>(s, "int32_t", sizes);
+    add<int64_t>(s, "int64_t", sizes);
+    add<float>(s, "float", sizes);
+    add<double>(s, "double", sizes);
+    return s.run(argc, argv);
+}
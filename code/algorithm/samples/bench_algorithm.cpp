@@ -0,0 +1,135 @@
+// Hx algorithms against their std counterparts; see "bench.hpp" for the options.
+// The data holds no match, so every run scans the whole range.
+#include <vector>
+#include <algorithm>
+#include "adjacent_find.hpp"
+#include "all_of.hpp"
+#include "any_of.hpp"
+#include "none_of.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+template <typename T>
+std::vector<T> make_data(long n)
+{
+    std::vector<T> v(n);
+    for (long i = 0; i < n; i++)
+        v[i] = T(i % 2 + 1);
+    return v;
+}
+
+template <typename T>
+struct is_zero {
+    bool operator()(T x) const { return x == T(0); }
+};
+
+template <typename T>
+struct is_nonzero {
+    bool operator()(T x) const { return x != T(0); }
+};
+
+template <typename T>
+void adjacent_find_std(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        auto it = std::adjacent_find(v.begin(), v.end());
+        do_not_optimize(it);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(T));
+}
+
+template <typename T>
+void adjacent_find_hx(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        auto it = Hx::adjacent_find(v.begin(), v.end());
+        do_not_optimize(it);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(T));
+}
+
+template <typename T>
+void all_of_std(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        bool b = std::all_of(v.begin(), v.end(), is_nonzero<T>());
+        do_not_optimize(b);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(T));
+}
+
+template <typename T>
+void all_of_hx(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        bool b = Hx::all_of(v.begin(), v.end(), is_nonzero<T>());
+        do_not_optimize(b);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(T));
+}
+
+template <typename T>
+void any_of_std(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        bool b = std::any_of(v.begin(), v.end(), is_zero<T>());
+        do_not_optimize(b);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(T));
+}
+
+template <typename T>
+void any_of_hx(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        bool b = Hx::any_of(v.begin(), v.end(), is_zero<T>());
+        do_not_optimize(b);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(T));
+}
+
+template <typename T>
+void none_of_std(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        bool b = std::none_of(v.begin(), v.end(), is_zero<T>());
+        do_not_optimize(b);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(T));
+}
+
+template <typename T>
+void none_of_hx(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        bool b = Hx::none_of(v.begin(), v.end(), is_zero<T>());
+        do_not_optimize(b);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(T));
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("algorithm");
+    s.add("adjacent_find<char>", "std", adjacent_find_std<char>).args({1 << 12, 1 << 24});
+    s.add("adjacent_find<char>", "Hx", adjacent_find_hx<char>).args({1 << 12, 1 << 24});
+    s.add("adjacent_find<int>", "std", adjacent_find_std<int>).args({1 << 12, 1 << 22});
+    s.add("adjacent_find<int>", "Hx", adjacent_find_hx<int>).args({1 << 12, 1 << 22});
+    s.add("all_of<int>", "std", all_of_std<int>).args({1 << 12, 1 << 22});
+    s.add("all_of<int>", "Hx", all_of_hx<int>).args({1 << 12, 1 << 22});
+    s.add("any_of<int>", "std", any_of_std<int>).args({1 << 12, 1 << 22});
+    s.add("any_of<int>", "Hx", any_of_hx<int>).args({1 << 12, 1 << 22});
+    s.add("none_of<double>", "std", none_of_std<double>).args({1 << 12, 1 << 21});
+    s.add("none_of<double>", "Hx", none_of_hx<double>).args({1 << 12, 1 << 21});
+    return s.run(argc, argv);
+}
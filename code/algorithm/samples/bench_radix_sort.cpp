@@ -0,0 +1,122 @@
+// Hx::radix_sort against std::sort (and Hx::sort) on Hx::vector; see
+// "bench.hpp" for the options. The default sizes are 1M and 16M keys;
+// for the full range run with e.g. --args=1048576,16777216,268435456,1073741824
+// (1B 64-bit keys take 16 GB with the buffer). Every iteration sorts a
+// fresh copy of the input, and the copy is not timed.
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include "vector.hpp"
+#include "execution.hpp"
+#include "sort.hpp"
+#include "radix_sort.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+template <typename T>
+T make_key(std::mt19937_64& gen)
+{
+    return T(gen());
+}
+
+template <>
+double make_key<double>(std::mt19937_64& gen)
+{
+    return std::uniform_real_distribution<double>(-1e6, 1e6)(gen);
+}
+
+// short ids, as in "u1234567"
+template <>
+std::string make_key<std::string>(std::mt19937_64& gen)
+{
+    return "u" + std::to_string(gen() % 100000000);
+}
+
+// a record sorted by its 64-bit id
+struct record {
+    uint64_t id;
+    uint32_t payload[2];
+    bool operator<(const record& r) const { return id < r.id; }
+};
+
+template <>
+record make_key<record>(std::mt19937_64& gen)
+{
+    record r = { gen(), { 0, 0 } };
+    return r;
+}
+
+struct record_id {
+    uint64_t operator()(const record& r) const { return r.id; }
+};
+
+struct std_sort {
+    template <typename It> void operator()(It first, It last) const { std::sort(first, last); }
+};
+
+struct hx_sort {
+    template <typename It> void operator()(It first, It last) const { Hx::sort(first, last); }
+};
+
+struct hx_radix_sort {
+    template <typename It> void operator()(It first, It last) const { Hx::radix_sort(first, last); }
+};
+
+struct hx_par_radix_sort {
+    template <typename It> void operator()(It first, It last) const { Hx::radix_sort(Hx::execution::par(4), first, last); }
+};
+
+struct hx_radix_sort_by_id {
+    template <typename It> void operator()(It first, It last) const { Hx::radix_sort(first, last, record_id()); }
+};
+
+struct hx_par_radix_sort_by_id {
+    template <typename It> void operator()(It first, It last) const
+    {
+        Hx::radix_sort(Hx::execution::par(4), first, last, record_id());
+    }
+};
+
+template <typename T, typename Algorithm>
+void run(state& st)
+{
+    std::mt19937_64 gen(st.arg());
+    Hx::vector<T> input;
+    input.reserve(st.arg());
+    for (long i = 0; i < st.arg(); i++)
+        input.push_back(make_key<T>(gen));
+    Hx::vector<T> v(input);
+    Algorithm algorithm;
+    while (st.keep_running()) {
+        st.pause_timing();
+        std::copy(input.begin(), input.end(), v.begin());
+        st.resume_timing();
+        algorithm(v.begin(), v.end());
+        do_not_optimize(v.data());
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+template <typename T, typename Radix = hx_radix_sort, typename ParRadix = hx_par_radix_sort>
+void add(Hx::bench::suite& s, const char* name)
+{
+    s.add(name, "std", run<T, std_sort>).args({1 << 20, 1 << 24});
+    s.add(name, "Hx sort", run<T, hx_sort>).args({1 << 20, 1 << 24});
+    s.add(name, "Hx", run<T, Radix>).args({1 << 20, 1 << 24});
+    s.add(name, "Hx par(4)", run<T, ParRadix>).args({1 << 20, 1 << 24});
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("radix_sort");
+    add<uint32_t>(s, "radix_sort<uint32_t>");
+    add<uint64_t>(s, "radix_sort<uint64_t>");
+    add<int64_t>(s, "radix_sort<int64_t>");
+    add<double>(s, "radix_sort<double>");
+    add<std::string>(s, "radix_sort<string>");
+    add<record, hx_radix_sort_by_id, hx_par_radix_sort_by_id>(s, "radix_sort<record>/by id");
+    return s.run(argc, argv);
+}
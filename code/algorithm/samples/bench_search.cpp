@@ -0,0 +1,294 @@
+// GB/s of the vectorized find, count, find_first_of, mismatch, equal,
+// lexicographical_compare and search against std::, a plain scalar loop
+// and glibc's memchr, memcmp and memmem; see "bench.hpp" for the options.
+// The argument is the size of each range in bytes, and no search finds
+// anything, so every run reads whole ranges. "Hx <isa>" rows cap the
+// kernels at that instruction set.
+#include <string.h>     // memchr, memcmp, memmem
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "find.hpp"
+#include "count.hpp"
+#include "find_first_of.hpp"
+#include "mismatch.hpp"
+#include "equal.hpp"
+#include "lexicographical_compare.hpp"
+#include "search.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+template <typename T>
+std::vector<T> make_data(long bytes)
+{
+    std::mt19937 gen(bytes);
+    std::vector<T> v(bytes / sizeof(T));
+    for (size_t i = 0; i < v.size(); i++)
+        v[i] = T(1 + gen() % 100);
+    return v;
+}
+
+/**
+ * Sets the instruction set of the kernels (if level names one) for the
+ * lifetime of the object.
+ */
+struct isa_scope {
+    explicit isa_scope(int level) { if (level >= 0) Hx::simd::set_isa(Hx::simd::isa(level)); }
+    ~isa_scope() { Hx::simd::set_isa(Hx::simd::avx512); }
+};
+
+// std, scalar loop, libc, or Hx at instruction set Level
+enum impl { std_impl = -3, scalar_impl = -2, libc_impl = -1 };
+
+template <typename T, int Impl>
+struct find_bench {
+    static void run(state& st)
+    {
+        std::vector<T> v = make_data<T>(st.arg());
+        const T* p = v.data();
+        size_t n = v.size();
+        isa_scope scope(Impl);
+        while (st.keep_running()) {
+            const T* r;
+            if (Impl == std_impl) {
+                r = std::find(p, p + n, T(0));
+            } else if (Impl == scalar_impl) {
+                size_t i = 0;
+                while (i < n && p[i] != T(0))
+                    ++i;
+                r = p + i;
+            } else if (Impl == libc_impl) {
+                r = (const T*) memchr(p, 0, n);
+            } else {
+                r = Hx::find(p, p + n, T(0));
+            }
+            do_not_optimize(r);
+        }
+        st.set_bytes_per_iteration(n * sizeof(T));
+    }
+};
+
+template <typename T, int Impl>
+struct count_bench {
+    static void run(state& st)
+    {
+        std::vector<T> v = make_data<T>(st.arg());
+        const T* p = v.data();
+        size_t n = v.size();
+        isa_scope scope(Impl);
+        while (st.keep_running()) {
+            size_t c;
+            if (Impl == std_impl) {
+                c = std::count(p, p + n, T(7));
+            } else if (Impl == scalar_impl) {
+                c = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    if (p[i] == T(7))
+                        ++c;
+                }
+            } else {
+                c = Hx::count(p, p + n, T(7));
+            }
+            do_not_optimize(c);
+        }
+        st.set_bytes_per_iteration(n * sizeof(T));
+    }
+};
+
+template <typename T, int Impl>
+struct find_first_of_bench {
+    static void run(state& st)
+    {
+        std::vector<T> v = make_data<T>(st.arg());
+        const T s[] = { T(0), T(101), T(102), T(103) };
+        const T* p = v.data();
+        size_t n = v.size();
+        isa_scope scope(Impl);
+        while (st.keep_running()) {
+            const T* r;
+            if (Impl == std_impl) {
+                r = std::find_first_of(p, p + n, s, s + 4);
+            } else if (Impl == scalar_impl) {
+                size_t i = 0;
+                while (i < n && p[i] != s[0] && p[i] != s[1] && p[i] != s[2] && p[i] != s[3])
+                    ++i;
+                r = p + i;
+            } else {
+                r = Hx::find_first_of(p, p + n, s, s + 4);
+            }
+            do_not_optimize(r);
+        }
+        st.set_bytes_per_iteration(n * sizeof(T));
+    }
+};
+
+template <typename T, int Impl>
+struct mismatch_bench {
+    static void run(state& st)
+    {
+        std::vector<T> a = make_data<T>(st.arg());
+        std::vector<T> b = a;
+        const T* p = a.data();
+        const T* q = b.data();
+        size_t n = a.size();
+        isa_scope scope(Impl);
+        while (st.keep_running()) {
+            const T* r;
+            if (Impl == std_impl) {
+                r = std::mismatch(p, p + n, q).first;
+            } else if (Impl == scalar_impl) {
+                size_t i = 0;
+                while (i < n && p[i] == q[i])
+                    ++i;
+                r = p + i;
+            } else {
+                r = Hx::mismatch(p, p + n, q).first;
+            }
+            do_not_optimize(r);
+        }
+        st.set_bytes_per_iteration(2 * n * sizeof(T));
+    }
+};
+
+template <typename T, int Impl>
+struct equal_bench {
+    static void run(state& st)
+    {
+        std::vector<T> a = make_data<T>(st.arg());
+        std::vector<T> b = a;
+        const T* p = a.data();
+        const T* q = b.data();
+        size_t n = a.size();
+        isa_scope scope(Impl);
+        while (st.keep_running()) {
+            bool r;
+            if (Impl == std_impl)
+                r = std::equal(p, p + n, q);
+            else if (Impl == libc_impl)
+                r = memcmp(p, q, n * sizeof(T)) == 0;
+            else
+                r = Hx::equal(p, p + n, q);
+            do_not_optimize(r);
+        }
+        st.set_bytes_per_iteration(2 * n * sizeof(T));
+    }
+};
+
+template <typename T, int Impl>
+struct lexicographical_compare_bench {
+    static void run(state& st)
+    {
+        std::vector<T> a = make_data<T>(st.arg());
+        std::vector<T> b = a;
+        const T* p = a.data();
+        const T* q = b.data();
+        size_t n = a.size();
+        isa_scope scope(Impl);
+        while (st.keep_running()) {
+            bool r;
+            if (Impl == std_impl)
+                r = std::lexicographical_compare(p, p + n, q, q + n);
+            else if (Impl == libc_impl)
+                r = memcmp(p, q, n * sizeof(T)) < 0;
+            else
+                r = Hx::lexicographical_compare(p, p + n, q, q + n);
+            do_not_optimize(r);
+        }
+        st.set_bytes_per_iteration(2 * n * sizeof(T));
+    }
+};
+
+template <typename T, int Impl>
+struct search_bench {
+    static void run(state& st)
+    {
+        std::mt19937 gen(st.arg());
+        std::vector<char> text(st.arg());
+        for (size_t i = 0; i < text.size(); i++)
+            text[i] = char('a' + gen() % 26);
+        const char* p = text.data();
+        size_t n = text.size();
+        const std::string needle = "abcdefghijklmnop";
+        const char* s = needle.data();
+        size_t m = needle.size();
+        isa_scope scope(Impl);
+        while (st.keep_running()) {
+            const char* r;
+            if (Impl == std_impl)
+                r = std::search(p, p + n, s, s + m);
+            else if (Impl == libc_impl)
+                r = (const char*) memmem(p, n, s, m);
+            else
+                r = Hx::search(p, p + n, s, s + m);
+            do_not_optimize(r);
+        }
+        st.set_bytes_per_iteration(n);
+    }
+};
+
+/**
+ * Adds the Hx rows of an operation, one per instruction set up to the
+ * best one of this cpu.
+ */
+template <template <typename, int> class Op, typename T>
+void add_hx(Hx::bench::suite& s, const char* name, std::initializer_list<long> args)
+{
+    static const Hx::bench::suite::function_type fn[] = { Op<T, 0>::run, Op<T, 1>::run, Op<T, 2>::run, Op<T, 3>::run };
+    for (int level = Hx::simd::sse2; level <= Hx::simd::detect_isa(); level++)
+        s.add(name, std::string("Hx ") + Hx::simd::isa_name(Hx::simd::isa(level)), fn[level]).args(args);
+}
+
+int main(int argc, char* argv[])
+{
+    const std::initializer_list<long> sizes = {1 << 14, 1 << 24};
+    Hx::bench::suite s("search");
+
+    s.add("find<char>", "std", find_bench<char, std_impl>::run).args(sizes);
+    s.add("find<char>", "scalar", find_bench<char, scalar_impl>::run).args(sizes);
+    s.add("find<char>", "memchr", find_bench<char, libc_impl>::run).args(sizes);
+    add_hx<find_bench, char>(s, "find<char>", sizes);
+    s.add("find<short>", "std", find_bench<short, std_impl>::run).args(sizes);
+    add_hx<find_bench, short>(s, "find<short>", sizes);
+    s.add("find<int>", "std", find_bench<int, std_impl>::run).args(sizes);
+    s.add("find<int>", "scalar", find_bench<int, scalar_impl>::run).args(sizes);
+    add_hx<find_bench, int>(s, "find<int>", sizes);
+    s.add("find<int64_t>", "std", find_bench<int64_t, std_impl>::run).args(sizes);
+    add_hx<find_bench, int64_t>(s, "find<int64_t>", sizes);
+
+    s.add("count<char>", "std", count_bench<char, std_impl>::run).args(sizes);
+    s.add("count<char>", "scalar", count_bench<char, scalar_impl>::run).args(sizes);
+    add_hx<count_bench, char>(s, "count<char>", sizes);
+    s.add("count<int>", "std", count_bench<int, std_impl>::run).args(sizes);
+    add_hx<count_bench, int>(s, "count<int>", sizes);
+
+    s.add("find_first_of<char>", "std", find_first_of_bench<char, std_impl>::run).args(sizes);
+    s.add("find_first_of<char>", "scalar", find_first_of_bench<char, scalar_impl>::run).args(sizes);
+    add_hx<find_first_of_bench, char>(s, "find_first_of<char>", sizes);
+
+    s.add("mismatch<char>", "std", mismatch_bench<char, std_impl>::run).args(sizes);
+    s.add("mismatch<char>", "scalar", mismatch_bench<char, scalar_impl>::run).args(sizes);
+    add_hx<mismatch_bench, char>(s, "mismatch<char>", sizes);
+    s.add("mismatch<int64_t>", "std", mismatch_bench<int64_t, std_impl>::run).args(sizes);
+    add_hx<mismatch_bench, int64_t>(s, "mismatch<int64_t>", sizes);
+
+    s.add("equal<char>", "std", equal_bench<char, std_impl>::run).args(sizes);
+    s.add("equal<char>", "memcmp", equal_bench<char, libc_impl>::run).args(sizes);
+    add_hx<equal_bench, char>(s, "equal<char>", sizes);
+    s.add("equal<int>", "std", equal_bench<int, std_impl>::run).args(sizes);
+    add_hx<equal_bench, int>(s, "equal<int>", sizes);
+
+    s.add("lexicographical_compare<unsigned char>", "std", lexicographical_compare_bench<unsigned char, std_impl>::run).args(sizes);
+    s.add("lexicographical_compare<unsigned char>", "memcmp", lexicographical_compare_bench<unsigned char, libc_impl>::run).args(sizes);
+    add_hx<lexicographical_compare_bench, unsigned char>(s, "lexicographical_compare<unsigned char>", sizes);
+    s.add("lexicographical_compare<int>", "std", lexicographical_compare_bench<int, std_impl>::run).args(sizes);
+    add_hx<lexicographical_compare_bench, int>(s, "lexicographical_compare<int>", sizes);
+
+    s.add("search<char>", "std", search_bench<char, std_impl>::run).args(sizes);
+    s.add("search<char>", "memmem", search_bench<char, libc_impl>::run).args(sizes);
+    add_hx<search_bench, char>(s, "search<char>", sizes);
+    return s.run(argc, argv);
+}
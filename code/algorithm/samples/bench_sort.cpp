@@ -0,0 +1,122 @@
+// Hx::sort, stable_sort and nth_element against their std counterparts on
+// Hx::vector, for random, already sorted, descending, organ-pipe (ascending
+// then descending) and many-duplicate inputs; see "bench.hpp" for the
+// options. Every iteration sorts a fresh copy of one of several inputs,
+// and the copy is not timed: sorting the same small input over and over
+// would let the branch predictor learn it.
+#include <algorithm>
+#include <random>
+#include "vector.hpp"
+#include "execution.hpp"
+#include "sort.hpp"
+#include "stable_sort.hpp"
+#include "nth_element.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+enum input { random_input, sorted_input, descending_input, organ_pipe_input, duplicate_input };
+
+template <typename T>
+Hx::vector<T> make_data(long n, input kind, unsigned seed)
+{
+    Hx::vector<T> v(n);
+    std::mt19937 gen(seed);
+    for (long i = 0; i < n; i++) {
+        switch (kind) {
+        case random_input:     v[i] = T(gen()); break;
+        case sorted_input:     v[i] = T(i); break;
+        case descending_input: v[i] = T(n - i); break;
+        case organ_pipe_input: v[i] = T(i < n / 2 ? i : n - i); break;
+        case duplicate_input:  v[i] = T(gen() % 16); break;
+        }
+    }
+    return v;
+}
+
+struct std_sort {
+    template <typename It> void operator()(It first, It last) const { std::sort(first, last); }
+};
+
+struct hx_sort {
+    template <typename It> void operator()(It first, It last) const { Hx::sort(first, last); }
+};
+
+struct hx_par_sort {
+    template <typename It> void operator()(It first, It last) const { Hx::sort(Hx::execution::par(4), first, last); }
+};
+
+struct std_stable_sort {
+    template <typename It> void operator()(It first, It last) const { std::stable_sort(first, last); }
+};
+
+struct hx_stable_sort {
+    template <typename It> void operator()(It first, It last) const { Hx::stable_sort(first, last); }
+};
+
+struct hx_par_stable_sort {
+    template <typename It> void operator()(It first, It last) const { Hx::stable_sort(Hx::execution::par(4), first, last); }
+};
+
+struct std_nth_element {
+    template <typename It> void operator()(It first, It last) const { std::nth_element(first, first + (last - first) / 2, last); }
+};
+
+struct hx_nth_element {
+    template <typename It> void operator()(It first, It last) const { Hx::nth_element(first, first + (last - first) / 2, last); }
+};
+
+struct hx_par_nth_element {
+    template <typename It> void operator()(It first, It last) const
+    {
+        Hx::nth_element(Hx::execution::par(4), first, first + (last - first) / 2, last);
+    }
+};
+
+template <typename T, input Kind, typename Algorithm>
+void run(state& st)
+{
+    const long inputs = std::max(1L, std::min(64L, (1L << 22) / st.arg()));
+    Hx::vector<Hx::vector<T>> input;
+    for (long i = 0; i < inputs; i++)
+        input.push_back(make_data<T>(st.arg(), Kind, unsigned(i)));
+    Hx::vector<T> v(input[0]);
+    Algorithm algorithm;
+    for (long i = 0; st.keep_running(); i = (i + 1) % inputs) {
+        st.pause_timing();
+        std::copy(input[i].begin(), input[i].end(), v.begin());
+        st.resume_timing();
+        algorithm(v.begin(), v.end());
+        do_not_optimize(v.data());
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+template <typename T, input Kind, typename Std, typename HxSeq, typename HxPar>
+void add(Hx::bench::suite& s, const char* name)
+{
+    s.add(name, "std", run<T, Kind, Std>).args({1 << 10, 1 << 20});
+    s.add(name, "Hx", run<T, Kind, HxSeq>).args({1 << 10, 1 << 20});
+    s.add(name, "Hx par(4)", run<T, Kind, HxPar>).args({1 << 10, 1 << 20});
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("sort");
+    add<int, random_input, std_sort, hx_sort, hx_par_sort>(s, "sort<int>/random");
+    add<int, sorted_input, std_sort, hx_sort, hx_par_sort>(s, "sort<int>/sorted");
+    add<int, descending_input, std_sort, hx_sort, hx_par_sort>(s, "sort<int>/descending");
+    add<int, organ_pipe_input, std_sort, hx_sort, hx_par_sort>(s, "sort<int>/organ_pipe");
+    add<int, duplicate_input, std_sort, hx_sort, hx_par_sort>(s, "sort<int>/dups");
+    add<double, random_input, std_sort, hx_sort, hx_par_sort>(s, "sort<double>/random");
+    add<int, random_input, std_stable_sort, hx_stable_sort, hx_par_stable_sort>(s, "stable_sort<int>/random");
+    add<int, sorted_input, std_stable_sort, hx_stable_sort, hx_par_stable_sort>(s, "stable_sort<int>/sorted");
+    add<int, duplicate_input, std_stable_sort, hx_stable_sort, hx_par_stable_sort>(s, "stable_sort<int>/dups");
+    add<int, random_input, std_nth_element, hx_nth_element, hx_par_nth_element>(s, "nth_element<int>/random");
+    add<int, sorted_input, std_nth_element, hx_nth_element, hx_par_nth_element>(s, "nth_element<int>/sorted");
+    add<int, descending_input, std_nth_element, hx_nth_element, hx_par_nth_element>(s, "nth_element<int>/descending");
+    add<int, organ_pipe_input, std_nth_element, hx_nth_element, hx_par_nth_element>(s, "nth_element<int>/organ_pipe");
+    add<int, duplicate_input, std_nth_element, hx_nth_element, hx_par_nth_element>(s, "nth_element<int>/dups");
+    return s.run(argc, argv);
+}
@@ -0,0 +1,25 @@
+// count algorithm example
+#include <iostream>     // std::cout
+#include <vector>       // std::vector
+#include <algorithm>    // std::count
+
+int main () {
+  // counting elements in array:
+  int myints[] = {10,20,30,30,20,10,10,20};   // 8 elements
+  int mycount = std::count (myints, myints+8, 10);
+  std::cout << "10 appears " << mycount << " times.\n";
+
+  // counting elements in container:
+  std::vector<int> myvector (myints, myints+8);
+  mycount = std::count (myvector.begin(), myvector.end(), 20);
+  std::cout << "20 appears " << mycount  << " times.\n";
+
+  return 0;
+}
+
+/*
+Output:
+
+10 appears 3 times.
+20 appears 3 times.
+*/
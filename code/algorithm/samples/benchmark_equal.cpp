@@ -0,0 +1,36 @@
+// equal algorithm example
+#include <iostream>     // std::cout
+#include <vector>       // std::vector
+#include <algorithm>    // std::equal
+
+bool mypredicate (int i, int j) {
+  return (i==j);
+}
+
+int main () {
+  int myints[] = {20,40,60,80,100};               //   myints: 20 40 60 80 100
+  std::vector<int>myvector (myints,myints+5);     // myvector: 20 40 60 80 100
+
+  // using default comparison:
+  if ( std::equal (myvector.begin(), myvector.end(), myints) )
+    std::cout << "The contents of both sequences are equal.\n";
+  else
+    std::cout << "The contents of both sequences differ.\n";
+
+  myvector[3]=81;                                 // myvector: 20 40 60 81 100
+
+  // using predicate comparison:
+  if ( std::equal (myvector.begin(), myvector.end(), myints, mypredicate) )
+    std::cout << "The contents of both sequences are equal.\n";
+  else
+    std::cout << "The contents of both sequences differ.\n";
+
+  return 0;
+}
+
+/*
+Output:
+
+The contents of both sequences are equal.
+The contents of both sequences differ.
+*/
@@ -0,0 +1,35 @@
+// nth_element example
+#include <iostream>         // std::cout
+#include <vector>           // std::vector
+#include <algorithm>        // std::nth_element
+
+bool myfunction (int i,int j) { return (i<j); }
+
+int main () {
+  int myints[] = {7,3,9,1,8,2,6,5,4};
+  std::vector<int> myvector (myints, myints+9);   // 7 3 9 1 8 2 6 5 4
+
+  // using default comparison (operator <):
+  std::nth_element (myvector.begin(), myvector.begin()+5, myvector.end());
+  std::cout << "the 6th smallest element is " << myvector[5] << '\n';
+
+  // using function as comp
+  std::nth_element (myvector.begin(), myvector.begin()+2, myvector.end(),myfunction);
+  std::cout << "the 3rd smallest element is " << myvector[2] << '\n';
+
+  // the elements before nth are no greater, the ones after no less
+  bool ok = true;
+  for (int i=0; i<2; ++i) ok = ok && myvector[i] <= myvector[2];
+  for (int i=3; i<9; ++i) ok = ok && myvector[2] <= myvector[i];
+  std::cout << "myvector is partitioned around it: " << (ok ? "yes" : "no") << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+the 6th smallest element is 6
+the 3rd smallest element is 3
+myvector is partitioned around it: yes
+*/
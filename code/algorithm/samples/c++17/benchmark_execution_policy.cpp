@@ -0,0 +1,44 @@
+// all_of/any_of/none_of/adjacent_find with execution policies
+#include <iostream>             // std::cout
+#include <vector>               // std::vector
+#include <list>                 // std::list
+#include <execution>            // std::execution::seq/par/par_unseq
+#include <algorithm>            // std::all_of, std::any_of, std::none_of, std::adjacent_find
+
+int main () {
+  std::vector<int> v(1000000);
+  for (size_t i = 0; i < v.size(); i++) v[i] = 2 * i + 1;   // 1 3 5 ...
+  v[700001] = v[700000];                                  // one repeated pair
+
+  if ( std::all_of(std::execution::par, v.begin(), v.end(), [](int i){return i%2;}) )
+    std::cout << "All the elements are odd numbers.\n";
+
+  if ( !std::any_of(std::execution::par_unseq, v.begin(), v.end(), [](int i){return i<0;}) )
+    std::cout << "There are no negative elements in the range.\n";
+
+  if ( std::none_of(std::execution::par, v.begin(), v.end(), [](int i){return i%2==0;}) )
+    std::cout << "There are no even elements in the range.\n";
+
+  auto it = std::adjacent_find(std::execution::par, v.begin(), v.end());
+  if (it != v.end())
+    std::cout << "the first pair of repeated elements is at " << (it - v.begin())
+              << ": " << *it << '\n';
+
+  // not random access: runs sequentially
+  std::list<int> l = {5,20,5,30,30,20,10,10,20};
+  auto lit = std::adjacent_find(std::execution::par, l.begin(), l.end());
+  if (lit != l.end())
+    std::cout << "the first pair of repeated elements in the list are: " << *lit << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+All the elements are odd numbers.
+There are no negative elements in the range.
+There are no even elements in the range.
+the first pair of repeated elements is at 700000: 1400001
+the first pair of repeated elements in the list are: 30
+*/
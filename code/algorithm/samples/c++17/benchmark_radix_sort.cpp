@@ -0,0 +1,62 @@
+// radix_sort example
+#include <iostream>         // std::cout
+#include <vector>           // std::vector
+#include <string>           // std::string
+#include <cstdint>          // uint64_t
+#include <algorithm>        // std::sort, std::stable_sort
+#include <execution>        // std::execution::par
+
+struct person {
+  std::string name;
+  int age;
+};
+
+int main () {
+  int myints[] = {32,-71,12,45,-26,80,53,33};
+  std::sort (myints, myints+8);
+  std::cout << "myints contains:";
+  for (int i=0; i<8; ++i) std::cout << ' ' << myints[i];
+  std::cout << '\n';
+
+  std::vector<double> mydoubles = {3.14, -1.41, 2.72, -4.67, 0.0, 1.32, -0.5};
+  std::sort (mydoubles.begin(), mydoubles.end());
+  std::cout << "mydoubles contains:";
+  for (double d : mydoubles) std::cout << ' ' << d;
+  std::cout << '\n';
+
+  std::vector<std::string> mywords = {"pear", "apple", "peach", "", "plum", "apricot", "app"};
+  std::sort (mywords.begin(), mywords.end());
+  std::cout << "mywords contains:";
+  for (const std::string& w : mywords) std::cout << " \"" << w << '"';
+  std::cout << '\n';
+
+  // by a key, keeping the order of equal keys
+  std::vector<person> people = {{"Ann",31}, {"Bob",25}, {"Cid",31}, {"Dee",19}, {"Eve",25}};
+  std::stable_sort (people.begin(), people.end(), [](const person& a, const person& b) { return a.age < b.age; });
+  std::cout << "people by age:";
+  for (const person& p : people) std::cout << ' ' << p.name << '(' << p.age << ')';
+  std::cout << '\n';
+
+  std::vector<uint64_t> ids(1000000);
+  uint64_t x = 88172645463325252ull;
+  for (size_t i = 0; i < ids.size(); i++) {        // xorshift64
+    x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+    ids[i] = x;
+  }
+  std::sort (std::execution::par, ids.begin(), ids.end());
+  bool sorted = true;
+  for (size_t i = 1; i < ids.size(); i++) sorted = sorted && ids[i-1] <= ids[i];
+  std::cout << "ids sorted: " << (sorted ? "yes" : "no") << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+myints contains: -71 -26 12 32 33 45 53 80
+mydoubles contains: -4.67 -1.41 -0.5 0 1.32 2.72 3.14
+mywords contains: "" "app" "apple" "apricot" "peach" "pear" "plum"
+people by age: Dee(19) Bob(25) Eve(25) Ann(31) Cid(31)
+ids sorted: yes
+*/
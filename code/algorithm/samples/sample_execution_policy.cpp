@@ -0,0 +1,47 @@
+// all_of/any_of/none_of/adjacent_find with execution policies
+#include <iostream>             // std::cout
+#include <vector>               // std::vector
+#include <list>                 // std::list
+#include "execution.hpp"        // Hx::execution::seq/par/par_unseq
+#include "all_of.hpp"           // Hx::all_of
+#include "any_of.hpp"           // Hx::any_of
+#include "none_of.hpp"          // Hx::none_of
+#include "adjacent_find.hpp"    // Hx::adjacent_find
+
+int main () {
+  std::vector<int> v(1000000);
+  for (size_t i = 0; i < v.size(); i++) v[i] = 2 * i + 1;   // 1 3 5 ...
+  v[700001] = v[700000];                                  // one repeated pair
+
+  if ( Hx::all_of(Hx::execution::par, v.begin(), v.end(), [](int i){return i%2;}) )
+    std::cout << "All the elements are odd numbers.\n";
+
+  if ( !Hx::any_of(Hx::execution::par_unseq, v.begin(), v.end(), [](int i){return i<0;}) )
+    std::cout << "There are no negative elements in the range.\n";
+
+  if ( Hx::none_of(Hx::execution::par(2), v.begin(), v.end(), [](int i){return i%2==0;}) )
+    std::cout << "There are no even elements in the range.\n";
+
+  auto it = Hx::adjacent_find(Hx::execution::par, v.begin(), v.end());
+  if (it != v.end())
+    std::cout << "the first pair of repeated elements is at " << (it - v.begin())
+              << ": " << *it << '\n';
+
+  // not random access: runs sequentially
+  std::list<int> l = {5,20,5,30,30,20,10,10,20};
+  auto lit = Hx::adjacent_find(Hx::execution::par, l.begin(), l.end());
+  if (lit != l.end())
+    std::cout << "the first pair of repeated elements in the list are: " << *lit << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+All the elements are odd numbers.
+There are no negative elements in the range.
+There are no even elements in the range.
+the first pair of repeated elements is at 700000: 1400001
+the first pair of repeated elements in the list are: 30
+*/
@@ -0,0 +1,35 @@
+// find example
+#include <iostream>     // std::cout
+#include <vector>       // std::vector
+#include "find.hpp"     // Hx::find
+
+int main () {
+  // using Hx::find with array and pointer:
+  int myints[] = { 10, 20, 30, 40 };
+  int * p;
+
+  p = Hx::find (myints, myints+4, 30);
+  if (p != myints+4)
+    std::cout << "Element found in myints: " << *p << '\n';
+  else
+    std::cout << "Element not found in myints\n";
+
+  // using Hx::find with vector and iterator:
+  std::vector<int> myvector (myints,myints+4);
+  std::vector<int>::iterator it;
+
+  it = Hx::find (myvector.begin(), myvector.end(), 30);
+  if (it != myvector.end())
+    std::cout << "Element found in myvector: " << *it << '\n';
+  else
+    std::cout << "Element not found in myvector\n";
+
+  return 0;
+}
+
+/*
+Output:
+
+Element found in myints: 30
+Element found in myvector: 30
+*/
@@ -0,0 +1,39 @@
+// mismatch algorithm example
+#include <iostream>     // std::cout
+#include <vector>       // std::vector
+#include <utility>      // std::pair
+#include "mismatch.hpp" // Hx::mismatch
+
+bool mypredicate (int i, int j) {
+  return (i==j);
+}
+
+int main () {
+  std::vector<int> myvector;
+  for (int i=1; i<6; i++) myvector.push_back (i*10); // myvector: 10 20 30 40 50
+
+  int myints[] = {10,20,80,320,1024};                //   myints: 10 20 80 320 1024
+
+  std::pair<std::vector<int>::iterator,int*> mypair;
+
+  // using default comparison:
+  mypair = Hx::mismatch (myvector.begin(), myvector.end(), myints);
+  std::cout << "First mismatching elements: " << *mypair.first;
+  std::cout << " and " << *mypair.second << '\n';
+
+  ++mypair.first; ++mypair.second;
+
+  // using predicate comparison:
+  mypair = Hx::mismatch (mypair.first, myvector.end(), mypair.second, mypredicate);
+  std::cout << "Second mismatching elements: " << *mypair.first;
+  std::cout << " and " << *mypair.second << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+First mismatching elements: 30 and 80
+Second mismatching elements: 40 and 320
+*/
@@ -0,0 +1,53 @@
+// sort/stable_sort/nth_element with execution policies
+#include <iostream>             // std::cout
+#include <vector>               // std::vector
+#include <utility>              // std::pair
+#include <functional>           // std::greater
+#include "execution.hpp"        // Hx::execution::seq/par/par_unseq
+#include "sort.hpp"             // Hx::sort
+#include "stable_sort.hpp"      // Hx::stable_sort
+#include "nth_element.hpp"      // Hx::nth_element
+
+int main () {
+  std::vector<int> v(1000000);
+  unsigned x = 1;
+  for (size_t i = 0; i < v.size(); i++) {                 // pseudo random, 0..999
+    x = x * 1103515245 + 12345;
+    v[i] = (x >> 16) % 1000;
+  }
+
+  std::vector<int> s = v;
+  Hx::sort(Hx::execution::par, s.begin(), s.end());
+  bool sorted = true;
+  for (size_t i = 1; i < s.size(); i++) sorted = sorted && !(s[i] < s[i-1]);
+  std::cout << "sorted: " << (sorted ? "yes" : "no")
+            << ", from " << s.front() << " to " << s.back() << '\n';
+
+  Hx::sort(Hx::execution::par(2), s.begin(), s.end(), std::greater<int>());
+  std::cout << "sorted in descending order, from " << s.front() << " to " << s.back() << '\n';
+
+  // pairs of (value, original position): equal values keep their order
+  std::vector<std::pair<int, size_t>> p(v.size());
+  for (size_t i = 0; i < v.size(); i++) p[i] = std::make_pair(v[i], i);
+  Hx::stable_sort(Hx::execution::par_unseq, p.begin(), p.end(),
+    [](const std::pair<int, size_t>& a, const std::pair<int, size_t>& b) { return a.first < b.first; });
+  bool stable = true;
+  for (size_t i = 1; i < p.size(); i++)
+    stable = stable && (p[i-1].first < p[i].first || (p[i-1].first == p[i].first && p[i-1].second < p[i].second));
+  std::cout << "stable: " << (stable ? "yes" : "no") << '\n';
+
+  std::vector<int> m = v;
+  Hx::nth_element(Hx::execution::par, m.begin(), m.begin() + m.size() / 2, m.end());
+  std::cout << "the median is " << m[m.size() / 2] << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+sorted: yes, from 0 to 999
+sorted in descending order, from 999 to 0
+stable: yes
+the median is 496
+*/
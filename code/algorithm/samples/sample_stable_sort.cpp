@@ -0,0 +1,40 @@
+// stable_sort example
+#include <iostream>         // std::cout
+#include <vector>           // std::vector
+#include "stable_sort.hpp"  // Hx::stable_sort
+
+bool compare_as_ints (double i,double j)
+{
+  return (int(i)<int(j));
+}
+
+int main () {
+  double mydoubles[] = {3.14, 1.41, 2.72, 4.67, 1.73, 1.32, 1.62, 2.58};
+
+  std::vector<double> myvector;
+
+  myvector.assign(mydoubles,mydoubles+8);
+
+  std::cout << "using default comparison:";
+  Hx::stable_sort (myvector.begin(), myvector.end());
+  for (std::vector<double>::iterator it=myvector.begin(); it!=myvector.end(); ++it)
+    std::cout << ' ' << *it;
+  std::cout << '\n';
+
+  myvector.assign(mydoubles,mydoubles+8);
+
+  std::cout << "using 'compare_as_ints' :";
+  Hx::stable_sort (myvector.begin(), myvector.end(), compare_as_ints);
+  for (std::vector<double>::iterator it=myvector.begin(); it!=myvector.end(); ++it)
+    std::cout << ' ' << *it;
+  std::cout << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+using default comparison: 1.32 1.41 1.62 1.73 2.58 2.72 3.14 4.67
+using 'compare_as_ints' : 1.41 1.73 1.32 1.62 2.72 2.58 3.14 4.67
+*/
@@ -0,0 +1,90 @@
+// Hx::any against std::any; see "bench.hpp" for the options.
+// Hx::any puts every value on the heap, while std::any keeps small ones
+// (the int rows) in place, so those rows show what that buys.
+#include <any>
+#include <string>
+#include <utility>
+#include "any.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+struct std_any {
+    using any = std::any;
+    template <typename T> static const T* cast(const any& a) { return std::any_cast<T>(&a); }
+};
+
+struct hx_any {
+    using any = Hx::any;
+    template <typename T> static const T* cast(const any& a) { return Hx::any_cast<T>(&a); }
+};
+
+template <typename Any>
+void construct_int(state& st)
+{
+    int x = 42;
+    while (st.keep_running()) {
+        typename Any::any a(x);
+        do_not_optimize(a);
+    }
+}
+
+template <typename Any>
+void construct_string(state& st)
+{
+    const std::string s(64, 'x');
+    while (st.keep_running()) {
+        typename Any::any a(s);
+        do_not_optimize(a);
+    }
+}
+
+template <typename Any>
+void copy(state& st)
+{
+    typename Any::any a(std::string(64, 'x'));
+    while (st.keep_running()) {
+        typename Any::any b(a);
+        do_not_optimize(b);
+    }
+}
+
+template <typename Any>
+void move(state& st)
+{
+    typename Any::any a(std::string(64, 'x'));
+    typename Any::any b;
+    while (st.keep_running()) {
+        b = std::move(a);
+        do_not_optimize(b);
+        a = std::move(b);
+        do_not_optimize(a);
+    }
+}
+
+template <typename Any>
+void cast(state& st)
+{
+    typename Any::any a(42);
+    while (st.keep_running()) {
+        const int* p = Any::template cast<int>(a);
+        do_not_optimize(p);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("any");
+    s.add("construct<int>", "std", construct_int<std_any>);
+    s.add("construct<int>", "Hx", construct_int<hx_any>);
+    s.add("construct<string>", "std", construct_string<std_any>);
+    s.add("construct<string>", "Hx", construct_string<hx_any>);
+    s.add("copy", "std", copy<std_any>);
+    s.add("copy", "Hx", copy<hx_any>);
+    s.add("move", "std", move<std_any>);
+    s.add("move", "Hx", move<hx_any>);
+    s.add("any_cast", "std", cast<std_any>);
+    s.add("any_cast", "Hx", cast<hx_any>);
+    return s.run(argc, argv);
+}
@@ -0,0 +1,462 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define HX_BENCH_RDTSC 1
+#endif
+
+namespace Hx {
+namespace bench {
+
+/**
+ * Makes the compiler assume value is read (and, for the non-const
+ * overload, written) here, so computing it cannot be optimized away.
+ */
+template <typename T>
+inline void do_not_optimize(const T& value)
+{
+    asm volatile ("" : : "r,m"(value) : "memory");
+}
+
+template <typename T>
+inline void do_not_optimize(T& value)
+{
+    asm volatile ("" : "+r,m"(value) : : "memory");
+}
+
+/**
+ * Makes the compiler assume all memory is read and written here, so
+ * pending stores are not sunk out of (or elided from) the timed loop.
+ */
+inline void clobber_memory()
+{
+    asm volatile ("" : : : "memory");
+}
+
+/**
+ * Time stamp counter (reference cycles) on x86, 0 elsewhere.
+ */
+inline uint64_t cycles()
+{
+#ifdef HX_BENCH_RDTSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+inline bool has_cycle_counter()
+{
+#ifdef HX_BENCH_RDTSC
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * What a benchmark function sees: the argument it runs with, and the
+ * timed loop
+ *     while (st.keep_running()) { ... }
+ * Timing starts at the first keep_running() call, so setup before the
+ * loop is not measured.
+ */
+class state {
+public:
+    typedef std::chrono::steady_clock clock_type;
+
+    state(uint64_t iterations, long arg): iterations_(iterations), remaining_(iterations), arg_(arg) {}
+
+    bool keep_running()
+    {
+        if (remaining_ != 0) {
+            if (!started_)
+                start();
+            --remaining_;
+            return true;
+        }
+        stop();
+        return false;
+    }
+
+    long arg() const { return arg_; }
+
+    uint64_t iterations() const { return iterations_; }
+
+    /** Excludes the code up to resume_timing() from the measurement. */
+    void pause_timing()
+    {
+        pause_cycles_ = cycles();
+        pause_time_ = clock_type::now();
+    }
+
+    void resume_timing()
+    {
+        paused_ += clock_type::now() - pause_time_;
+        paused_cycles_ += cycles() - pause_cycles_;
+    }
+
+    /** Bytes (items) one iteration processes, for the throughput columns. */
+    void set_bytes_per_iteration(double bytes) { bytes_ = bytes; }
+    void set_items_per_iteration(double items) { items_ = items; }
+
+    double seconds() const
+    {
+        return std::chrono::duration<double>(end_ - start_ - paused_).count();
+    }
+
+    double cycle_count() const { return double(end_cycles_ - start_cycles_ - paused_cycles_); }
+    double bytes_per_iteration() const { return bytes_; }
+    double items_per_iteration() const { return items_; }
+
+private:
+    void start()
+    {
+        started_ = true;
+        start_ = clock_type::now();
+        start_cycles_ = cycles();
+    }
+
+    void stop()
+    {
+        if (stopped_ || !started_)
+            return;
+        end_cycles_ = cycles();
+        end_ = clock_type::now();
+        stopped_ = true;
+    }
+
+    uint64_t iterations_;
+    uint64_t remaining_;
+    long arg_;
+    bool started_ = false;
+    bool stopped_ = false;
+    clock_type::time_point start_, end_, pause_time_;
+    clock_type::duration paused_ = clock_type::duration::zero();
+    uint64_t start_cycles_ = 0, end_cycles_ = 0, pause_cycles_ = 0, paused_cycles_ = 0;
+    double bytes_ = 0;
+    double items_ = 0;
+};
+
+/**
+ * Per repetition figures of one benchmark run.
+ */
+struct result {
+    std::string name;           // group/arg, e.g. "find/1024"
+    std::string impl;           // "std", "Hx", ...
+    long arg;
+    uint64_t iterations;
+    std::vector<double> ns;     // ns per iteration, one per repetition
+    std::vector<double> cycles; // cycles per iteration
+    double bytes;               // per iteration
+    double items;
+    double speedup;             // median of the "std" run over this median, 0 if none
+
+    static double median(std::vector<double> v)
+    {
+        if (v.empty())
+            return 0;
+        std::sort(v.begin(), v.end());
+        size_t m = v.size() / 2;
+        return (v.size() % 2) ? v[m] : (v[m - 1] + v[m]) / 2;
+    }
+
+    double ns_median() const { return median(ns); }
+    double ns_min() const { return ns.empty() ? 0 : *std::min_element(ns.begin(), ns.end()); }
+    double cycles_median() const { return median(cycles); }
+    double bytes_per_second() const { return bytes / ns_median() * 1e9; }
+    double items_per_second() const { return items / ns_median() * 1e9; }
+};
+
+/**
+ * Run options, taken from the command line:
+ *     --format=table|json|csv  --filter=SUBSTRING
+ *     --repetitions=N  --warmup=N  --min-time=SECONDS
+ *     --args=N,N,...  (replaces the arguments of every benchmark that has some)
+ */
+struct options {
+    std::string format = "table";
+    std::string filter;
+    int repetitions = 5;
+    int warmup = 1;
+    double min_time = 0.05;     // per repetition
+    std::vector<long> args;
+
+    bool parse(int argc, char* argv[])
+    {
+        for (int i = 1; i < argc; i++) {
+            const char* a = argv[i];
+            if (!strncmp(a, "--format=", 9))
+                format = a + 9;
+            else if (!strncmp(a, "--filter=", 9))
+                filter = a + 9;
+            else if (!strncmp(a, "--repetitions=", 14))
+                repetitions = std::max(1, atoi(a + 14));
+            else if (!strncmp(a, "--warmup=", 9))
+                warmup = std::max(0, atoi(a + 9));
+            else if (!strncmp(a, "--min-time=", 11))
+                min_time = atof(a + 11);
+            else if (!strncmp(a, "--args=", 7) && parse_args(a + 7))
+                ;
+            else {
+                fprintf(stderr, "usage: %s [--format=table|json|csv] [--filter=SUBSTRING]\n"
+                    "    [--repetitions=N] [--warmup=N] [--min-time=SECONDS] [--args=N,N,...]\n", argv[0]);
+                return false;
+            }
+        }
+        if (format != "table" && format != "json" && format != "csv") {
+            fprintf(stderr, "%s: unknown format %s\n", argv[0], format.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    bool parse_args(const char* list)
+    {
+        args.clear();
+        for (;;) {
+            char* end;
+            long n = strtol(list, &end, 10);
+            if (end == list)
+                return false;
+            args.push_back(n);
+            if (*end == '\0')
+                return true;
+            if (*end != ',')
+                return false;
+            list = end + 1;
+        }
+    }
+};
+
+/**
+ * A set of benchmarks, each an implementation ("std", "Hx", ...) of a
+ * named operation, run over a list of arguments. Implementations of the
+ * same operation and argument are reported side by side, with their
+ * speedup over the one named "std".
+ *
+ *     Hx::bench::suite s("set");
+ *     s.add("insert", "std", insert<std::set<int>>).args({1000, 1000000});
+ *     s.add("insert", "Hx", insert<Hx::set<int>>).args({1000, 1000000});
+ *     return s.run(argc, argv);
+ */
+class suite {
+public:
+    typedef void (*function_type)(state&);
+
+    class entry {
+    public:
+        entry(const std::string& name, const std::string& impl, function_type fn):
+            name_(name), impl_(impl), fn_(fn), args_(1, 0), has_args_(false) {}
+
+        entry& args(std::initializer_list<long> args)
+        {
+            args_.assign(args.begin(), args.end());
+            has_args_ = true;
+            return *this;
+        }
+
+        /** For arguments only known at run time, e.g. thread counts up to the number of cpus. */
+        entry& args(const std::vector<long>& args)
+        {
+            args_ = args;
+            has_args_ = true;
+            return *this;
+        }
+
+    private:
+        friend class suite;
+
+        std::string name_;
+        std::string impl_;
+        function_type fn_;
+        std::vector<long> args_;
+        bool has_args_;
+    };
+
+    explicit suite(const std::string& name): name_(name) {}
+
+    entry& add(const std::string& name, const std::string& impl, function_type fn)
+    {
+        entries_.push_back(entry(name, impl, fn));
+        return entries_.back();
+    }
+
+    int run(int argc, char* argv[])
+    {
+        if (!opts_.parse(argc, argv))
+            return 1;
+        if (!opts_.args.empty()) {
+            for (size_t i = 0; i < entries_.size(); i++) {
+                if (entries_[i].has_args_)
+                    entries_[i].args_ = opts_.args;
+            }
+        }
+
+        // group the implementations of each name and argument together
+        std::vector<result> results;
+        for (size_t i = 0; i < entries_.size(); i++) {
+            const entry& e = entries_[i];
+            for (size_t a = 0; a < e.args_.size(); a++) {
+                std::string name = e.has_args_ ? e.name_ + "/" + std::to_string(e.args_[a]) : e.name_;
+                if (!opts_.filter.empty() && (name + " " + e.impl_).find(opts_.filter) == std::string::npos)
+                    continue;
+                if (find(results, name, e.impl_) != nullptr)
+                    continue;
+                for (size_t j = i; j < entries_.size(); j++) {
+                    const entry& f = entries_[j];
+                    if (f.name_ == e.name_ && std::find(f.args_.begin(), f.args_.end(), e.args_[a]) != f.args_.end()
+                            && find(results, name, f.impl_) == nullptr)
+                        results.push_back(measure(f, name, e.args_[a]));
+                }
+            }
+        }
+
+        for (size_t i = 0; i < results.size(); i++) {
+            const result* base = find(results, results[i].name, "std");
+            results[i].speedup = base ? base->ns_median() / results[i].ns_median() : 0;
+        }
+
+        if (opts_.format == "json")
+            print_json(results);
+        else if (opts_.format == "csv")
+            print_csv(results);
+        else
+            print_table(results);
+        return 0;
+    }
+
+private:
+    static const result* find(const std::vector<result>& results, const std::string& name, const std::string& impl)
+    {
+        for (size_t i = 0; i < results.size(); i++) {
+            if (results[i].name == name && results[i].impl == impl)
+                return &results[i];
+        }
+        return nullptr;
+    }
+
+    static state run_once(const entry& e, long arg, uint64_t iterations)
+    {
+        state st(iterations, arg);
+        e.fn_(st);
+        return st;
+    }
+
+    // picks the iteration count so that one repetition lasts min_time,
+    // then runs the warmup and the measured repetitions
+    result measure(const entry& e, const std::string& name, long arg)
+    {
+        uint64_t n = 1;
+        for (;;) {
+            state st = run_once(e, arg, n);
+            double s = st.seconds();
+            if (s >= opts_.min_time || n >= 1000000000)
+                break;
+            double mult = (s > 0) ? 1.4 * opts_.min_time / s : 10;
+            n = std::max(n + 1, uint64_t(n * std::min(mult, 10.0)));
+        }
+
+        for (int i = 0; i < opts_.warmup; i++)
+            run_once(e, arg, n);
+
+        result r;
+        r.name = name;
+        r.impl = e.impl_;
+        r.arg = arg;
+        r.iterations = n;
+        r.bytes = r.items = r.speedup = 0;
+        for (int i = 0; i < opts_.repetitions; i++) {
+            state st = run_once(e, arg, n);
+            r.ns.push_back(st.seconds() * 1e9 / n);
+            r.cycles.push_back(st.cycle_count() / n);
+            r.bytes = st.bytes_per_iteration();
+            r.items = st.items_per_iteration();
+        }
+        if (opts_.format == "table")
+            fprintf(stderr, ".");
+        return r;
+    }
+
+    void print_table(const std::vector<result>& results) const
+    {
+        fprintf(stderr, "\n");
+        printf("%s: %d repetitions of >= %.3f s, median per iteration%s\n", name_.c_str(),
+            opts_.repetitions, opts_.min_time, has_cycle_counter() ? ", cycles from rdtsc" : "");
+#ifndef NDEBUG
+        printf("***WARNING*** built without -DNDEBUG, timings are not representative\n");
+#endif
+        printf("%-32s %-12s %14s %14s %14s %10s %12s %8s\n",
+            "benchmark", "impl", "ns", "min ns", "cycles", "GB/s", "items/s", "vs std");
+        for (size_t i = 0; i < results.size(); i++) {
+            const result& r = results[i];
+            char gbps[32] = "", items[32] = "", speedup[32] = "";
+            if (r.bytes > 0)
+                snprintf(gbps, sizeof(gbps), "%.2f", r.bytes_per_second() / 1e9);
+            if (r.items > 0)
+                snprintf(items, sizeof(items), "%.3g", r.items_per_second());
+            if (r.speedup > 0)
+                snprintf(speedup, sizeof(speedup), "%.2fx", r.speedup);
+            printf("%-32s %-12s %14.1f %14.1f %14.1f %10s %12s %8s\n", r.name.c_str(), r.impl.c_str(),
+                r.ns_median(), r.ns_min(), r.cycles_median(), gbps, items, speedup);
+        }
+    }
+
+    static std::string quote(const std::string& s)
+    {
+        std::string q = "\"";
+        for (size_t i = 0; i < s.size(); i++) {
+            if (s[i] == '"' || s[i] == '\\')
+                q += '\\';
+            q += s[i];
+        }
+        return q + "\"";
+    }
+
+    void print_json(const std::vector<result>& results) const
+    {
+        printf("{\n  \"suite\": %s,\n  \"repetitions\": %d,\n  \"min_time\": %g,\n  \"benchmarks\": [\n",
+            quote(name_).c_str(), opts_.repetitions, opts_.min_time);
+        for (size_t i = 0; i < results.size(); i++) {
+            const result& r = results[i];
+            printf("    {\"name\": %s, \"impl\": %s, \"arg\": %ld, \"iterations\": %llu, "
+                "\"ns\": %.3f, \"ns_min\": %.3f, \"cycles\": %.2f, "
+                "\"bytes_per_second\": %.6g, \"items_per_second\": %.6g, \"speedup_vs_std\": %.4f}%s\n",
+                quote(r.name).c_str(), quote(r.impl).c_str(), r.arg, (unsigned long long) r.iterations,
+                r.ns_median(), r.ns_min(), r.cycles_median(),
+                r.bytes > 0 ? r.bytes_per_second() : 0.0, r.items > 0 ? r.items_per_second() : 0.0,
+                r.speedup, (i + 1 < results.size()) ? "," : "");
+        }
+        printf("  ]\n}\n");
+    }
+
+    void print_csv(const std::vector<result>& results) const
+    {
+        printf("suite,name,impl,arg,iterations,ns,ns_min,cycles,bytes_per_second,items_per_second,speedup_vs_std\n");
+        for (size_t i = 0; i < results.size(); i++) {
+            const result& r = results[i];
+            printf("%s,%s,%s,%ld,%llu,%.3f,%.3f,%.2f,%.6g,%.6g,%.4f\n",
+                name_.c_str(), r.name.c_str(), r.impl.c_str(), r.arg, (unsigned long long) r.iterations,
+                r.ns_median(), r.ns_min(), r.cycles_median(),
+                r.bytes > 0 ? r.bytes_per_second() : 0.0, r.items > 0 ? r.items_per_second() : 0.0,
+                r.speedup);
+        }
+    }
+
+    std::string name_;
+    std::vector<entry> entries_;
+    options opts_;
+};
+
+}   // namespace bench
+}   // namespace Hx
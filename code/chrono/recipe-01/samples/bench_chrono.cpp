@@ -0,0 +1,64 @@
+// Hx::chrono against std::chrono; see "bench.hpp" for the options.
+#include <chrono>
+#include "chrono.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+template <typename Clock>
+void now(state& st)
+{
+    while (st.keep_running()) {
+        typename Clock::time_point t = Clock::now();
+        do_not_optimize(t);
+    }
+}
+
+template <typename Clock>
+void elapsed(state& st)
+{
+    while (st.keep_running()) {
+        typename Clock::time_point start = Clock::now();
+        typename Clock::duration d = Clock::now() - start;
+        do_not_optimize(d);
+    }
+}
+
+template <typename Milliseconds, typename Nanoseconds>
+void duration_cast(state& st)
+{
+    long long ns = 123456789;
+    while (st.keep_running()) {
+        do_not_optimize(ns);
+        Milliseconds ms = Hx::chrono::duration_cast<Milliseconds>(Nanoseconds(ns));
+        do_not_optimize(ms);
+    }
+}
+
+template <typename Milliseconds, typename Nanoseconds>
+void duration_cast_std(state& st)
+{
+    long long ns = 123456789;
+    while (st.keep_running()) {
+        do_not_optimize(ns);
+        Milliseconds ms = std::chrono::duration_cast<Milliseconds>(Nanoseconds(ns));
+        do_not_optimize(ms);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("chrono");
+    s.add("system_clock::now", "std", now<std::chrono::system_clock>);
+    s.add("system_clock::now", "Hx", now<Hx::chrono::system_clock>);
+    s.add("steady_clock::now", "std", now<std::chrono::steady_clock>);
+    s.add("steady_clock::now", "Hx", now<Hx::chrono::steady_clock>);
+    s.add("high_resolution_clock::now", "std", now<std::chrono::high_resolution_clock>);
+    s.add("high_resolution_clock::now", "Hx", now<Hx::chrono::high_resolution_clock>);
+    s.add("steady_clock elapsed", "std", elapsed<std::chrono::steady_clock>);
+    s.add("steady_clock elapsed", "Hx", elapsed<Hx::chrono::steady_clock>);
+    s.add("duration_cast", "std", duration_cast_std<std::chrono::milliseconds, std::chrono::nanoseconds>);
+    s.add("duration_cast", "Hx", duration_cast<Hx::chrono::milliseconds, Hx::chrono::nanoseconds>);
+    return s.run(argc, argv);
+}
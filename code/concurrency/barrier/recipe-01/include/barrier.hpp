@@ -0,0 +1,285 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_BARRIER_INC
+#define MINI_STL_BARRIER_INC
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+#include "futex.hpp"
+#include "spin.hpp"
+
+namespace Hx {
+
+namespace detail {
+
+struct empty_completion {
+    void operator()() noexcept {}
+};
+
+/** A small number per thread, handed out in the order threads first ask. */
+inline unsigned this_thread_slot()
+{
+    static std::atomic<unsigned> next(0);
+    thread_local unsigned slot = next.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+}    // namespace detail
+
+/**
+ * Reusable barrier for a fixed set of threads, which repeatedly all
+ * arrive and wait for one another; each time, once the last of them has
+ * arrived, the completion function runs on that thread before any of
+ * them is released.
+ *
+ * A combining tree spreads the arrivals: every leaf takes up to four of
+ * them, every inner node one from each of up to four children, so that
+ * no counter is shared by more than four threads. A thread starts at a
+ * leaf picked by its slot and moves on to the next when that one is
+ * full; whoever fills a node carries one arrival up to its parent, and
+ * whoever fills the root completes the phase. Node counters carry the
+ * parity of the phase they count (sense reversal), so the nodes need no
+ * resetting between phases. Waiters compare the phase number, which is
+ * the futex word: they spin (only with more than one cpu), yield a few
+ * times, then sleep on it, and the completing thread only enters the
+ * kernel if some of them sleep.
+ */
+template <typename CompletionFunction = detail::empty_completion>
+class barrier {
+public:
+    /** What arrive returns and wait takes: the phase the arrival was in. */
+    class arrival_token {
+        friend class barrier;
+        int phase_;
+
+        explicit arrival_token(int phase): phase_(phase) {}
+
+    public:
+        arrival_token(arrival_token&&) = default;
+        arrival_token& operator=(arrival_token&&) = default;
+    };
+
+    static constexpr ptrdiff_t max() noexcept { return INT_MAX; }
+
+    explicit barrier(ptrdiff_t expected, CompletionFunction f = CompletionFunction()):
+        storage_(new char[storage_size(int(expected))]),
+        nodes_(place_nodes(storage_.get(), int(expected))), expected_(int(expected)),
+        drops_(0), phase_(0), waiters_(0), completion_(std::move(f))
+    {
+        build(expected_, 0);
+    }
+
+    barrier(const barrier&) = delete;
+    barrier& operator=(const barrier&) = delete;
+
+    /** Counts update arrivals in the current phase. */
+    arrival_token arrive(ptrdiff_t update = 1)
+    {
+        int phase = phase_.load(std::memory_order_acquire);
+        int tag = (phase & 1) << count_bits;
+        int n = int(update);
+        // once the phase is complete, a drop may reshape the tree under us
+        const int leaves = leaves_;
+        for (int i = int(detail::this_thread_slot() % unsigned(leaves)); ; i = (i+1 == leaves) ? 0 : i+1) {
+            bool filled;
+            n -= take(nodes_[i], tag, n, filled);
+            if (filled)
+                climb(i, tag);
+            if (n == 0)
+                break;
+        }
+        return arrival_token(phase);
+    }
+
+    /** Blocks until the phase of token is over. */
+    void wait(arrival_token&& token) const
+    {
+        const int phase = token.phase_;
+        const int pauses = detail::pause_budget(spin_count);
+        for (int i = 0; i < pauses+yield_count; i++) {
+            if (phase_.load(std::memory_order_acquire) != phase)
+                return;
+            if (i < pauses)
+                cpu_relax();
+            else
+                std::this_thread::yield();
+        }
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        while (phase_.load(std::memory_order_seq_cst) == phase)
+            sleep(phase);
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void arrive_and_wait() { wait(arrive()); }
+
+    /** Arrives, and leaves the set: later phases expect one arrival less. */
+    void arrive_and_drop()
+    {
+        drops_.fetch_add(1, std::memory_order_relaxed);
+        arrive();
+    }
+
+private:
+    static const int fan_in = 4;
+    static const int count_bits = 30;
+    static const int count_mask = (1 << count_bits)-1;
+    static const int spin_count = 64;
+    static const int yield_count = 4;
+
+    struct alignas(64) node {
+        std::atomic<int> count;     // the phase parity << count_bits | arrivals
+        int expected;
+        int parent;                 // -1 for the root
+    };
+
+    static int level_size(int n) { return n <= fan_in ? 1 : (n+fan_in-1)/fan_in; }
+
+    static int node_count(int expected)
+    {
+        int total = 0;
+        for (int n = level_size(expected); ; n = level_size(n)) {
+            total += n;
+            if (n == 1)
+                return total;
+        }
+    }
+
+    /**
+     * Before C++17, new node[n] only aligns to alignof(std::max_align_t),
+     * not to the cache line node asks for: the nodes live in a char array
+     * with room to align them by hand.
+     */
+    static std::size_t storage_size(int expected) { return node_count(expected)*sizeof(node)+alignof(node)-1; }
+
+    static node* place_nodes(char* storage, int expected)
+    {
+        void* p = storage;
+        std::size_t space = storage_size(expected);
+        int n = node_count(expected);
+        node* nodes = static_cast<node*>(std::align(alignof(node), n*sizeof(node), p, space));
+        for (int i = 0; i < n; i++)
+            new (&nodes[i]) node;
+        return nodes;
+    }
+
+    /**
+     * Lays the tree out for expected arrivals, leaves first and the root
+     * last, with every counter at zero for the phase of parity tag.
+     */
+    void build(int expected, int tag)
+    {
+        leaves_ = level_size(expected);
+        int base = 0;
+        int n = leaves_;
+        int below = expected;           // what this level counts
+        for (;;) {
+            int next_base = base+n;
+            for (int j = 0; j < n; j++) {
+                node& x = nodes_[base+j];
+                int rest = below-j*fan_in;
+                x.expected = rest < fan_in ? rest : fan_in;
+                x.parent = n == 1 ? -1 : next_base+j/fan_in;
+                x.count.store(tag, std::memory_order_relaxed);
+            }
+            if (n == 1)
+                return;
+            below = n;
+            base = next_base;
+            n = level_size(n);
+        }
+    }
+
+    static int arrivals(int value, int tag) { return (value & ~count_mask) == tag ? value & count_mask : 0; }
+
+    /**
+     * Counts up to n arrivals at x in the phase of parity tag, as many as
+     * it has room for, and returns how many that was; filled says whether
+     * they were the last x expected. A counter tagged with the other
+     * parity is left over from the phase before, and counts as zero.
+     */
+    static int take(node& x, int tag, int n, bool& filled)
+    {
+        int value = x.count.load(std::memory_order_relaxed);
+        for (;;) {
+            int c = arrivals(value, tag);
+            int room = x.expected-c;
+            if (room <= 0) {
+                filled = false;
+                return 0;
+            }
+            int k = n < room ? n : room;
+            if (x.count.compare_exchange_weak(value, tag | (c+k), std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                filled = k == room;
+                return k;
+            }
+        }
+    }
+
+    /** Node i just filled up: carries the arrival up while that fills nodes too. */
+    void climb(int i, int tag)
+    {
+        for (;;) {
+            int p = nodes_[i].parent;
+            if (p < 0) {
+                complete(tag);
+                return;
+            }
+            bool filled;
+            take(nodes_[p], tag, 1, filled);
+            if (!filled)
+                return;
+            i = p;
+        }
+    }
+
+    /** The last arrival of the phase: reshapes the tree for the dropped threads, runs the completion, releases everyone. */
+    void complete(int tag)
+    {
+        int dropped = drops_.exchange(0, std::memory_order_relaxed);
+        if (dropped != 0) {
+            expected_ -= dropped;
+            build(expected_, tag ^ (1 << count_bits));
+        }
+        completion_();
+        phase_.fetch_add(1, std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_seq_cst) != 0)
+            wake();
+    }
+
+    void sleep(int phase) const
+    {
+#if defined(__linux__)
+        futex_wait(const_cast<std::atomic<int>*>(&phase_), phase);
+#else
+        (void) phase;
+        std::this_thread::yield();
+#endif
+    }
+
+    void wake()
+    {
+#if defined(__linux__)
+        futex_wake(&phase_, INT_MAX);
+#endif
+    }
+
+    std::unique_ptr<char[]> storage_;
+    node* nodes_;                   // in storage_; trivially destructible
+    int leaves_;
+    int expected_;
+    std::atomic<int> drops_;
+    alignas(64) std::atomic<int> phase_;    // the futex word
+    mutable std::atomic<int> waiters_;
+    CompletionFunction completion_;
+};
+
+}    // namespace Hx
+
+#endif
@@ -0,0 +1,100 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_LATCH_INC
+#define MINI_STL_LATCH_INC
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <thread>
+#include "futex.hpp"
+#include "spin.hpp"
+
+namespace Hx {
+
+/**
+ * Single-use downward counter: threads count it down, and wait() blocks
+ * until it reaches zero.
+ * The counter is the futex word. Waiters announce themselves in waiters_
+ * before they sleep, so the count_down that reaches zero only enters the
+ * kernel if somebody sleeps, and the ones before it never do.
+ */
+class latch {
+    std::atomic<int> count_;        // the futex word
+    mutable std::atomic<int> waiters_;
+
+public:
+    static constexpr ptrdiff_t max() noexcept { return INT_MAX; }
+
+    explicit latch(ptrdiff_t expected): count_(int(expected)), waiters_(0) {}
+
+    latch(const latch&) = delete;
+    latch& operator=(const latch&) = delete;
+
+    /** Decrements the counter by n, waking the waiters if that makes it zero. */
+    void count_down(ptrdiff_t n = 1)
+    {
+        if (count_.fetch_sub(int(n), std::memory_order_seq_cst) == n &&
+                waiters_.load(std::memory_order_seq_cst) != 0)
+            wake();
+    }
+
+    /** True if the counter is zero; never blocks. */
+    bool try_wait() const noexcept { return count_.load(std::memory_order_acquire) == 0; }
+
+    /** Blocks until the counter is zero. */
+    void wait() const
+    {
+        const int pauses = detail::pause_budget(spin_count);
+        for (int i = 0; i < pauses+yield_count; i++) {
+            if (try_wait())
+                return;
+            if (i < pauses)
+                cpu_relax();
+            else
+                std::this_thread::yield();
+        }
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        for (;;) {
+            int c = count_.load(std::memory_order_seq_cst);
+            if (c == 0)
+                break;
+            sleep(c);
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /** count_down(n), then wait(). */
+    void arrive_and_wait(ptrdiff_t n = 1)
+    {
+        count_down(n);
+        wait();
+    }
+
+private:
+    static const int spin_count = 64;
+    static const int yield_count = 4;
+
+    void sleep(int c) const
+    {
+#if defined(__linux__)
+        futex_wait(const_cast<std::atomic<int>*>(&count_), c);
+#else
+        (void) c;
+        std::this_thread::yield();
+#endif
+    }
+
+    void wake()
+    {
+#if defined(__linux__)
+        futex_wake(&count_, INT_MAX);
+#endif
+    }
+};
+
+}    // namespace Hx
+
+#endif
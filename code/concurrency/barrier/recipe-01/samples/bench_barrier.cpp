@@ -0,0 +1,85 @@
+// Barrier crossing latency; see "bench.hpp" for the options. The
+// argument is the number of threads; every iteration they cross the
+// barrier 100 times together, and the time per crossing is the time per
+// iteration / 100.
+//   std   std::barrier
+//   cv    the phase loop our batch jobs use: a generation counter under
+//         an Hx::mutex, with an Hx::condition_variable notify_all from the
+//         last thread to arrive (condition_variable/recipe-02)
+//   Hx    Hx::barrier
+#include <barrier>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "mutex.hpp"
+#include "condition_variable.hpp"
+#include "barrier.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+
+const int crossings = 100;
+
+class cv_barrier {
+    Hx::mutex mtx_;
+    Hx::condition_variable cv_;
+    const int expected_;
+    int count_;
+    long generation_;
+
+public:
+    explicit cv_barrier(int expected): expected_(expected), count_(0), generation_(0) {}
+
+    void arrive_and_wait()
+    {
+        std::unique_lock<Hx::mutex> lock(mtx_);
+        long g = generation_;
+        if (++count_ == expected_) {
+            count_ = 0;
+            generation_++;
+            cv_.notify_all();
+        } else {
+            cv_.wait(lock, [&] { return generation_ != g; });
+        }
+    }
+};
+
+template <typename Barrier>
+void crossing(state& st)
+{
+    const int n = int(st.arg());
+    while (st.keep_running()) {
+        st.pause_timing();
+        Barrier b(n);
+        std::vector<std::thread> threads;
+        for (int t = 1; t < n; t++) {
+            threads.push_back(std::thread([&] {
+                for (int i = 0; i <= crossings; i++)
+                    b.arrive_and_wait();
+            }));
+        }
+        b.arrive_and_wait();        // everybody has started
+        st.resume_timing();
+
+        for (int i = 0; i < crossings; i++)
+            b.arrive_and_wait();
+
+        st.pause_timing();
+        for (size_t t = 0; t < threads.size(); t++)
+            threads[t].join();
+        st.resume_timing();
+    }
+    st.set_items_per_iteration(crossings);
+}
+
+int main(int argc, char* argv[])
+{
+    // glibc skips lock prefixes until a second thread has existed
+    std::thread([] {}).join();
+
+    Hx::bench::suite s("barrier");
+    s.add("crossing", "std", crossing<std::barrier<>>).args({2, 4, 8, 16, 32, 64, 128});
+    s.add("crossing", "cv", crossing<cv_barrier>).args({2, 4, 8, 16, 32, 64, 128});
+    s.add("crossing", "Hx", crossing<Hx::barrier<>>).args({2, 4, 8, 16, 32, 64, 128});
+    return s.run(argc, argv);
+}
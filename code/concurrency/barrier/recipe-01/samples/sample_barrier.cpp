@@ -0,0 +1,63 @@
+// barrier example: a data-parallel loop in phases
+#include <iostream>       // std::cout
+#include <thread>         // std::thread
+#include <utility>        // std::swap
+#include <vector>         // std::vector
+#include "barrier.hpp"    // Hx::barrier
+
+int main ()
+{
+  // smooth a signal by averaging each point with its neighbours, one
+  // step per phase; every thread updates its own slice of next, and the
+  // completion function swaps the buffers once all slices are done
+  const int n = 16, nthreads = 4, steps = 3;
+  std::vector<double> cur(n, 0.0), next(n, 0.0);
+  cur[n/2] = 81.0;
+
+  int step = 0;
+  auto on_completion = [&]() noexcept {
+    std::swap(cur, next);
+    ++step;
+    std::cout << "step " << step << ": " << cur[n/2-1] << ' ' << cur[n/2] << ' ' << cur[n/2+1] << '\n';
+  };
+  Hx::barrier<decltype(on_completion)> sync(nthreads, on_completion);
+
+  auto worker = [&](int id) {
+    for (int s = 0; s < steps; s++) {
+      for (int i = id * n / nthreads; i < (id+1) * n / nthreads; i++) {
+        double left = i > 0 ? cur[i-1] : 0, right = i < n-1 ? cur[i+1] : 0;
+        next[i] = (left + cur[i] + right) / 3;
+      }
+      sync.arrive_and_wait();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int id = 0; id < nthreads; id++)
+    threads.emplace_back(worker, id);
+  for (auto& th : threads)
+    th.join();
+
+  // a thread that is done for good drops out, and later phases wait for
+  // the others only
+  Hx::barrier<> b(3);
+  std::thread quitter([&] { b.arrive_and_drop(); });
+  for (int round = 0; round < 2; round++) {
+    std::thread helper([&] { b.arrive_and_wait(); });
+    b.arrive_and_wait();
+    helper.join();
+  }
+  quitter.join();
+  std::cout << "two phases without the dropped thread\n";
+
+  return 0;
+}
+
+/*
+Output:
+
+step 1: 27 27 27
+step 2: 18 27 18
+step 3: 18 21 18
+two phases without the dropped thread
+*/
@@ -0,0 +1,60 @@
+// latch example
+#include <iostream>       // std::cout
+#include <string>         // std::string
+#include <thread>         // std::thread
+#include <vector>         // std::vector
+#include "latch.hpp"      // Hx::latch
+
+struct job {
+  const std::string name;
+  std::string product{"not worked"};
+  std::thread action{};
+};
+
+int main ()
+{
+  job jobs[] = {{"annika"}, {"buru"}, {"chuck"}};
+
+  Hx::latch work_done{3};
+  Hx::latch start_clean_up{1};
+
+  auto work = [&](job& my_job) {
+    my_job.product = my_job.name + " worked";
+    work_done.count_down();
+    start_clean_up.wait();
+    my_job.product = my_job.name + " cleaned";
+  };
+
+  std::cout << "Work is starting... ";
+  for (auto& job : jobs)
+    job.action = std::thread{work, std::ref(job)};
+
+  work_done.wait();
+  std::cout << "done:\n";
+  for (auto const& job : jobs)
+    std::cout << "  " << job.product << '\n';
+
+  std::cout << "Workers are cleaning up... ";
+  start_clean_up.count_down();
+  for (auto& job : jobs)
+    job.action.join();
+
+  std::cout << "done:\n";
+  for (auto const& job : jobs)
+    std::cout << "  " << job.product << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+Work is starting... done:
+  annika worked
+  buru worked
+  chuck worked
+Workers are cleaning up... done:
+  annika cleaned
+  buru cleaned
+  chuck cleaned
+*/
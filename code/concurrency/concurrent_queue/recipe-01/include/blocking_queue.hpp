@@ -0,0 +1,192 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_BLOCKING_QUEUE_INC
+#define MINI_STL_BLOCKING_QUEUE_INC
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include "futex.hpp"
+
+namespace Hx {
+
+/**
+ * Event count: lets threads sleep until a condition that lock-free code
+ * changes might have become true, at no cost to the code that changes it
+ * while nobody sleeps.
+ *
+ *     int key = ec.prepare_wait();
+ *     if (condition) ec.cancel_wait(); else ec.wait(key);
+ *
+ * and, after making the condition true, ec.notify_one() or notify_all(),
+ * which only enter the kernel if some thread is between prepare_wait and
+ * the end of its wait.
+ */
+class event_count {
+    std::atomic<int> epoch_;        // bumped by every notify that finds waiters; the futex word
+    std::atomic<int> waiters_;
+
+public:
+    event_count(): epoch_(0), waiters_(0) {}
+
+    event_count(const event_count&) = delete;
+    event_count& operator=(const event_count&) = delete;
+
+    /** Announces a wait; check the condition again after this. */
+    int prepare_wait()
+    {
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        return epoch_.load(std::memory_order_seq_cst);
+    }
+
+    /** Withdraws a prepare_wait, the condition having become true. */
+    void cancel_wait()
+    {
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /** Sleeps until a notify after the prepare_wait that returned key. */
+    void wait(int key)
+    {
+#if defined(__linux__)
+        while (epoch_.load(std::memory_order_acquire) == key)
+            futex_wait(&epoch_, key);
+#else
+        while (epoch_.load(std::memory_order_acquire) == key)
+            std::this_thread::yield();
+#endif
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void notify_one() { notify(1); }
+    void notify_all() { notify(0x7fffffff); }
+
+private:
+    void notify(int n)
+    {
+        // orders the caller's change to the condition before the load of
+        // waiters_: either a waiter sees the change in its check after
+        // prepare_wait, or we see the waiter
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) == 0)
+            return;
+        epoch_.fetch_add(1, std::memory_order_release);
+#if defined(__linux__)
+        futex_wake(&epoch_, n);
+#else
+        (void) n;
+#endif
+    }
+};
+
+/**
+ * Blocking push and pop over a non-blocking bounded queue (spsc_ring or
+ * mpmc_queue), keeping its thread rules: a blocking_queue<spsc_ring<T>>
+ * still has one producer and one consumer.
+ * A full push or empty pop retries a few times, then sleeps on an
+ * event_count until the other side makes progress; while neither side
+ * sleeps, push and pop cost what the underlying queue's do plus one
+ * fence and one load.
+ */
+template <typename Queue>
+class blocking_queue {
+public:
+    typedef typename Queue::value_type value_type;
+    typedef size_t size_type;
+
+    explicit blocking_queue(size_t capacity): queue_(capacity) {}
+
+    blocking_queue(const blocking_queue&) = delete;
+    blocking_queue& operator=(const blocking_queue&) = delete;
+
+    size_t capacity() const { return queue_.capacity(); }
+
+    /** Appends x, waiting while the queue is full. */
+    void push(const value_type& x)
+    {
+        value_type copy(x);
+        push(std::move(copy));
+    }
+
+    void push(value_type&& x)
+    {
+        if (!spin([&] { return queue_.try_push(std::move(x)); })) {
+            for (;;) {
+                int key = not_full_.prepare_wait();
+                if (queue_.try_push(std::move(x))) {
+                    not_full_.cancel_wait();
+                    break;
+                }
+                not_full_.wait(key);
+                if (queue_.try_push(std::move(x)))
+                    break;
+            }
+        }
+        not_empty_.notify_one();
+    }
+
+    /** Moves the oldest element to x, waiting while the queue is empty. */
+    void pop(value_type& x)
+    {
+        if (!spin([&] { return queue_.try_pop(x); })) {
+            for (;;) {
+                int key = not_empty_.prepare_wait();
+                if (queue_.try_pop(x)) {
+                    not_empty_.cancel_wait();
+                    break;
+                }
+                not_empty_.wait(key);
+                if (queue_.try_pop(x))
+                    break;
+            }
+        }
+        not_full_.notify_one();
+    }
+
+    /** Non-blocking versions, which still wake a waiting other side. */
+    bool try_push(value_type x)
+    {
+        if (!queue_.try_push(std::move(x)))
+            return false;
+        not_empty_.notify_one();
+        return true;
+    }
+
+    bool try_pop(value_type& x)
+    {
+        if (!queue_.try_pop(x))
+            return false;
+        not_full_.notify_one();
+        return true;
+    }
+
+    /** The underlying queue. */
+    Queue& queue() { return queue_; }
+
+private:
+    // a short spin, then a few yields, before a thread commits to sleeping
+    template <typename Try>
+    static bool spin(Try attempt)
+    {
+        for (int i = 0; i < 32; i++) {
+            if (attempt())
+                return true;
+            if (i < 16)
+                cpu_relax();
+            else
+                std::this_thread::yield();
+        }
+        return false;
+    }
+
+    Queue queue_;
+    event_count not_empty_;
+    event_count not_full_;
+};
+
+}    // namespace Hx
+
+#endif
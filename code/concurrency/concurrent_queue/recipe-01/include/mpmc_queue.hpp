@@ -0,0 +1,149 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_MPMC_QUEUE_INC
+#define MINI_STL_MPMC_QUEUE_INC
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Hx {
+
+/**
+ * Bounded multi-producer multi-consumer queue
+ * (Vyukov's bounded MPMC queue, 1024cores.net). Each slot carries a
+ * sequence number saying whose turn it is: slot i of lap k is free for
+ * the producer of position k*capacity+i when its sequence equals that
+ * position, and full for the consumer of that position when it equals
+ * position+1. A producer claims a position with one CAS on the enqueue
+ * index, a consumer with one CAS on the dequeue index; the two indices
+ * are on separate cache lines, and no thread ever waits for another to
+ * finish, except for the slot it claimed.
+ * The capacity is rounded up to a power of two.
+ */
+template <typename T>
+class mpmc_queue {
+public:
+    typedef T value_type;
+    typedef size_t size_type;
+
+    /** Constructs an empty queue that holds at least capacity elements. */
+    explicit mpmc_queue(size_t capacity):
+        mask_(round_up(capacity)-1), cells_(new cell[mask_+1]),
+        enqueue_pos_(0), dequeue_pos_(0)
+    {
+        for (size_t i = 0; i <= mask_; i++)
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    ~mpmc_queue()
+    {
+        size_t e = enqueue_pos_.load(std::memory_order_relaxed);
+        for (size_t pos = dequeue_pos_.load(std::memory_order_relaxed); pos != e; pos++)
+            cells_[pos & mask_].get()->~T();
+        delete [] cells_;
+    }
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    size_t capacity() const { return mask_+1; }
+
+    /** Appends x, or returns false if the queue is full. */
+    bool try_push(const T& x) { return emplace(x); }
+    bool try_push(T&& x) { return emplace(std::move(x)); }
+
+    /** Constructs an element in place, or returns false if the queue is full. */
+    template <typename... Args>
+    bool try_emplace(Args&&... args) { return emplace(std::forward<Args>(args)...); }
+
+    /** Moves the oldest element to x, or returns false if the queue is empty. */
+    bool try_pop(T& x)
+    {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        cell* c;
+        for (;;) {
+            c = &cells_[pos & mask_];
+            size_t seq = c->seq.load(std::memory_order_acquire);
+            intptr_t dif = intptr_t(seq)-intptr_t(pos+1);
+            if (dif == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed))
+                    break;
+            } else if (dif < 0) {
+                return false;       // the producer of pos has not been here yet
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        T* p = c->get();
+        x = std::move(*p);
+        p->~T();
+        // free for the producer of the same slot one lap later
+        c->seq.store(pos+mask_+1, std::memory_order_release);
+        return true;
+    }
+
+    /** The number of elements, only a hint while other threads use the queue. */
+    size_t size_approx() const
+    {
+        size_t e = enqueue_pos_.load(std::memory_order_relaxed);
+        size_t d = dequeue_pos_.load(std::memory_order_relaxed);
+        return e > d ? e-d : 0;
+    }
+
+    bool empty_approx() const { return size_approx() == 0; }
+
+private:
+    struct cell {
+        std::atomic<size_t> seq;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+        T* get() { return reinterpret_cast<T*>(&storage); }
+    };
+
+    static size_t round_up(size_t n)
+    {
+        size_t p = 2;
+        while (p < n)
+            p *= 2;
+        return p;
+    }
+
+    template <typename... Args>
+    bool emplace(Args&&... args)
+    {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        cell* c;
+        for (;;) {
+            c = &cells_[pos & mask_];
+            size_t seq = c->seq.load(std::memory_order_acquire);
+            intptr_t dif = intptr_t(seq)-intptr_t(pos);
+            if (dif == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed))
+                    break;
+            } else if (dif < 0) {
+                return false;       // the consumer of the last lap has not been here yet
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        ::new (static_cast<void*>(&c->storage)) T(std::forward<Args>(args)...);
+        c->seq.store(pos+1, std::memory_order_release);
+        return true;
+    }
+
+    const size_t mask_;
+    cell* const cells_;
+
+    alignas(64) std::atomic<size_t> enqueue_pos_;
+    alignas(64) std::atomic<size_t> dequeue_pos_;
+};
+
+}    // namespace Hx
+
+#endif
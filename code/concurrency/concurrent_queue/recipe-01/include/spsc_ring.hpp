@@ -0,0 +1,164 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_SPSC_RING_INC
+#define MINI_STL_SPSC_RING_INC
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace Hx {
+
+/**
+ * Bounded single-producer single-consumer ring buffer
+ * One thread pushes and one thread pops, without locks: each side owns
+ * one index and only reads the other's. The two indices live on separate
+ * cache lines, next to the side's cached copy of the other index, which
+ * it refreshes only when the ring looks full (producer) or empty
+ * (consumer); while the ring is neither, a push or pop touches no cache
+ * line the other side writes, except the slot itself.
+ * push_batch and pop_batch move up to n elements for one index update.
+ * The capacity is rounded up to a power of two.
+ */
+template <typename T>
+class spsc_ring {
+public:
+    typedef T value_type;
+    typedef size_t size_type;
+
+    /** Constructs an empty ring that holds at least capacity elements. */
+    explicit spsc_ring(size_t capacity):
+        mask_(round_up(capacity)-1),
+        slots_(static_cast<T*>(::operator new((mask_+1)*sizeof(T)))),
+        head_(0), cached_tail_(0), tail_(0), cached_head_(0)
+    {
+    }
+
+    ~spsc_ring()
+    {
+        size_t t = tail_.load(std::memory_order_relaxed);
+        for (size_t h = head_.load(std::memory_order_relaxed); h != t; h++)
+            slots_[h & mask_].~T();
+        ::operator delete(slots_);
+    }
+
+    spsc_ring(const spsc_ring&) = delete;
+    spsc_ring& operator=(const spsc_ring&) = delete;
+
+    size_t capacity() const { return mask_+1; }
+
+    /** The number of elements, exact only when called by the producer or the consumer while the other is idle. */
+    size_t size_approx() const
+    {
+        return tail_.load(std::memory_order_acquire)-head_.load(std::memory_order_acquire);
+    }
+
+    bool empty_approx() const { return size_approx() == 0; }
+
+    /** Producer only: appends x, or returns false if the ring is full. */
+    bool try_push(const T& x) { return emplace(x); }
+    bool try_push(T&& x) { return emplace(std::move(x)); }
+
+    /** Producer only: constructs an element in place, or returns false if the ring is full. */
+    template <typename... Args>
+    bool try_emplace(Args&&... args) { return emplace(std::forward<Args>(args)...); }
+
+    /**
+     * Producer only: appends the first of the n elements from first that
+     * fit, and returns how many that was.
+     */
+    template <typename InputIterator>
+    size_t push_batch(InputIterator first, size_t n)
+    {
+        size_t t = tail_.load(std::memory_order_relaxed);
+        size_t room = capacity()-(t-cached_head_);
+        if (room < n) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            room = capacity()-(t-cached_head_);
+        }
+        if (n > room)
+            n = room;
+        for (size_t i = 0; i < n; ++i, ++first)
+            ::new (static_cast<void*>(&slots_[(t+i) & mask_])) T(*first);
+        tail_.store(t+n, std::memory_order_release);
+        return n;
+    }
+
+    /** Consumer only: moves the oldest element to x, or returns false if the ring is empty. */
+    bool try_pop(T& x)
+    {
+        size_t h = head_.load(std::memory_order_relaxed);
+        if (h == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (h == cached_tail_)
+                return false;
+        }
+        T& slot = slots_[h & mask_];
+        x = std::move(slot);
+        slot.~T();
+        head_.store(h+1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer only: moves up to n of the oldest elements to out, and
+     * returns how many that was.
+     */
+    template <typename OutputIterator>
+    size_t pop_batch(OutputIterator out, size_t n)
+    {
+        size_t h = head_.load(std::memory_order_relaxed);
+        if (cached_tail_-h < n)
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+        if (n > cached_tail_-h)
+            n = cached_tail_-h;
+        for (size_t i = 0; i < n; ++i, ++out) {
+            T& slot = slots_[(h+i) & mask_];
+            *out = std::move(slot);
+            slot.~T();
+        }
+        head_.store(h+n, std::memory_order_release);
+        return n;
+    }
+
+private:
+    static size_t round_up(size_t n)
+    {
+        size_t p = 2;
+        while (p < n)
+            p *= 2;
+        return p;
+    }
+
+    template <typename... Args>
+    bool emplace(Args&&... args)
+    {
+        size_t t = tail_.load(std::memory_order_relaxed);
+        if (t-cached_head_ == capacity()) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (t-cached_head_ == capacity())
+                return false;
+        }
+        ::new (static_cast<void*>(&slots_[t & mask_])) T(std::forward<Args>(args)...);
+        tail_.store(t+1, std::memory_order_release);
+        return true;
+    }
+
+    const size_t mask_;
+    T* const slots_;
+
+    // the consumer's line
+    alignas(64) std::atomic<size_t> head_;      // next to pop
+    size_t cached_tail_;                        // the consumer's copy of tail_
+
+    // the producer's line
+    alignas(64) std::atomic<size_t> tail_;      // next to push
+    size_t cached_head_;                        // the producer's copy of head_
+};
+
+}    // namespace Hx
+
+#endif
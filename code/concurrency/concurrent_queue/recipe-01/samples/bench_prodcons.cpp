@@ -0,0 +1,133 @@
+// prodcons4 (semaphore/cxx-20) on the lock-free queues; see "bench.hpp"
+// for the options. The argument is the number of producers, and of
+// consumers; every iteration they move 2^16 ints through a buffer of 16
+// slots (10 in prodcons4 proper).
+//   std        prodcons4: an array guarded by a binary semaphore, plus
+//              nempty and nstored counting semaphores (std::)
+//   semaphore  the same on Hx::counting_semaphore (semaphore/recipe-01)
+//   mpmc       Hx::blocking_queue<Hx::mpmc_queue<int>>
+//   spsc       Hx::blocking_queue<Hx::spsc_ring<int>>, one pair only
+#include <atomic>
+#include <semaphore>
+#include <thread>
+#include <vector>
+#include "semaphore.hpp"
+#include "spsc_ring.hpp"
+#include "mpmc_queue.hpp"
+#include "blocking_queue.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+const int nbuff = 16;
+const long items_per_iteration = 1 << 16;
+
+struct std_semaphores {
+    typedef std::counting_semaphore<> counting;
+    typedef std::binary_semaphore binary;
+};
+
+struct hx_semaphores {
+    typedef Hx::counting_semaphore<> counting;
+    typedef Hx::binary_semaphore binary;
+};
+
+template <typename Semaphores>
+void prodcons_semaphore(state& st)
+{
+    const long n = st.arg();
+    while (st.keep_running()) {
+        st.pause_timing();
+        typename Semaphores::binary mutex(1);
+        typename Semaphores::counting nempty(nbuff), nstored(0);
+        int buff[nbuff];
+        long nput = 0, nget = 0;
+        std::vector<long> sums(n, 0);
+        std::vector<std::thread> threads;
+        st.resume_timing();
+
+        for (long t = 0; t < n; t++) {
+            threads.push_back(std::thread([&] {
+                for (;;) {
+                    nempty.acquire();
+                    mutex.acquire();
+                    if (nput >= items_per_iteration) {
+                        nstored.release();      // let consumers terminate
+                        nempty.release();
+                        mutex.release();
+                        return;
+                    }
+                    buff[nput % nbuff] = int(nput);
+                    nput++;
+                    mutex.release();
+                    nstored.release();
+                }
+            }));
+            threads.push_back(std::thread([&, t] {
+                for (;;) {
+                    nstored.acquire();
+                    mutex.acquire();
+                    if (nget >= items_per_iteration) {
+                        nstored.release();
+                        mutex.release();
+                        return;
+                    }
+                    sums[t] += buff[nget % nbuff];
+                    nget++;
+                    mutex.release();
+                    nempty.release();
+                }
+            }));
+        }
+        for (size_t i = 0; i < threads.size(); i++)
+            threads[i].join();
+        do_not_optimize(sums.data());
+    }
+    st.set_items_per_iteration(items_per_iteration);
+}
+
+template <typename Queue>
+void prodcons_queue(state& st)
+{
+    const long n = st.arg();
+    while (st.keep_running()) {
+        st.pause_timing();
+        Hx::blocking_queue<Queue> queue(nbuff);
+        std::atomic<long> nput(0), nget(0);
+        std::vector<long> sums(n, 0);
+        std::vector<std::thread> threads;
+        st.resume_timing();
+
+        for (long t = 0; t < n; t++) {
+            // each producer and consumer claims an item number first, so
+            // that every claimed pop has a push to match
+            threads.push_back(std::thread([&] {
+                long i;
+                while ((i = nput.fetch_add(1, std::memory_order_relaxed)) < items_per_iteration)
+                    queue.push(int(i));
+            }));
+            threads.push_back(std::thread([&, t] {
+                int x;
+                while (nget.fetch_add(1, std::memory_order_relaxed) < items_per_iteration) {
+                    queue.pop(x);
+                    sums[t] += x;
+                }
+            }));
+        }
+        for (size_t i = 0; i < threads.size(); i++)
+            threads[i].join();
+        do_not_optimize(sums.data());
+    }
+    st.set_items_per_iteration(items_per_iteration);
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("prodcons");
+    s.add("prodcons", "std", prodcons_semaphore<std_semaphores>).args({1, 2, 4, 8});
+    s.add("prodcons", "semaphore", prodcons_semaphore<hx_semaphores>).args({1, 2, 4, 8});
+    s.add("prodcons", "mpmc", prodcons_queue<Hx::mpmc_queue<int>>).args({1, 2, 4, 8});
+    s.add("prodcons", "spsc", prodcons_queue<Hx::spsc_ring<int>>).args({1});
+    return s.run(argc, argv);
+}
@@ -0,0 +1,43 @@
+// mpmc_queue and blocking_queue example
+#include <iostream>             // std::cout
+#include <string>               // std::string
+#include <thread>               // std::thread
+#include <vector>               // std::vector
+#include "mpmc_queue.hpp"       // Hx::mpmc_queue
+#include "blocking_queue.hpp"   // Hx::blocking_queue
+
+int main ()
+{
+  // non-blocking: try_push fails when full, try_pop when empty
+  Hx::mpmc_queue<std::string> q(2);
+  std::cout << std::boolalpha;
+  std::cout << q.try_push("one") << ' ' << q.try_push("two") << ' ' << q.try_push("three") << '\n';
+  std::string s;
+  while (q.try_pop(s)) std::cout << s << '\n';
+
+  // blocking: 4 producers and 4 consumers through a 16-slot queue
+  Hx::blocking_queue<Hx::mpmc_queue<int>> bq(16);
+  std::vector<std::thread> threads;
+  std::vector<long> sums(4, 0);
+  for (int t = 0; t < 4; t++) {
+    threads.push_back(std::thread([&bq,t] {
+      for (int i = 0; i < 10000; i++) bq.push(t * 10000 + i);
+    }));
+    threads.push_back(std::thread([&bq,&sums,t] {
+      for (int i = 0, x; i < 10000; i++) { bq.pop(x); sums[t] += x; }
+    }));
+  }
+  for (auto& th : threads) th.join();
+  std::cout << "sum: " << sums[0] + sums[1] + sums[2] + sums[3] << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+true true false
+one
+two
+sum: 799980000
+*/
@@ -0,0 +1,41 @@
+// spsc_ring example
+#include <iostream>         // std::cout
+#include <thread>           // std::thread
+#include "spsc_ring.hpp"    // Hx::spsc_ring
+
+int main ()
+{
+  Hx::spsc_ring<int> ring(6);   // rounded up to 8
+  std::cout << "capacity: " << ring.capacity() << '\n';
+
+  // one producer thread, one consumer thread
+  long sum = 0;
+  std::thread consumer([&ring,&sum] {
+    for (int n = 0, x; n < 1000; )
+      if (ring.try_pop(x)) { sum += x; n++; }
+  });
+  for (int i = 0; i < 1000; )
+    if (ring.try_push(i)) i++;
+  consumer.join();
+  std::cout << "sum: " << sum << '\n';
+
+  // batches move several elements for one index update
+  int in[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  std::cout << "pushed: " << ring.push_batch(in, 10) << '\n';
+  int out[10];
+  size_t n = ring.pop_batch(out, 10);
+  std::cout << "popped:";
+  for (size_t i = 0; i < n; i++) std::cout << ' ' << out[i];
+  std::cout << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+capacity: 8
+sum: 499500
+pushed: 8
+popped: 1 2 3 4 5 6 7 8
+*/
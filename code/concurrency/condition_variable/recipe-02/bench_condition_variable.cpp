@@ -0,0 +1,132 @@
+// The futex Hx::condition_variable (with Hx::mutex) against
+// std::condition_variable (with std::mutex, i.e. pthread_cond_t); see
+// "bench.hpp" for the options.
+//   notify_one   a round trip between two threads, each waking the other
+//   notify_all/N from notify_all until all N waiters hold the mutex in turn
+//   wait_for/US  an unnotified wait_for(US microseconds); the time per
+//                iteration minus US is how late the timeout fires
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "mutex.hpp"
+#include "condition_variable.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+
+struct std_cv {
+    typedef std::mutex mutex;
+    typedef std::condition_variable condition_variable;
+};
+
+struct hx_cv {
+    typedef Hx::mutex mutex;
+    typedef Hx::condition_variable condition_variable;
+};
+
+template <typename Cv>
+void notify_one(state& st)
+{
+    typename Cv::mutex mtx;
+    typename Cv::condition_variable ping, pong;
+    long turn = 0;          // even: the caller's turn, odd: the echo thread's
+    bool stop = false;
+
+    std::thread echo([&] {
+        std::unique_lock<typename Cv::mutex> lock(mtx);
+        for (;;) {
+            ping.wait(lock, [&] { return stop || turn % 2 == 1; });
+            if (stop)
+                return;
+            turn++;
+            pong.notify_one();
+        }
+    });
+
+    while (st.keep_running()) {
+        std::unique_lock<typename Cv::mutex> lock(mtx);
+        long t = ++turn;
+        ping.notify_one();
+        pong.wait(lock, [&] { return turn != t; });
+    }
+    {
+        std::lock_guard<typename Cv::mutex> lock(mtx);
+        stop = true;
+    }
+    ping.notify_one();
+    echo.join();
+    st.set_items_per_iteration(1);
+}
+
+template <typename Cv>
+void notify_all(state& st)
+{
+    const long waiters = st.arg();
+    typename Cv::mutex mtx;
+    typename Cv::condition_variable go, done;
+    unsigned long round = 0;
+    long asleep = 0;        // waiters waiting for the next round
+    long finished = 0;      // waiters through this round
+    bool stop = false;
+
+    std::vector<std::thread> threads;
+    for (long i = 0; i < waiters; i++) {
+        threads.push_back(std::thread([&] {
+            std::unique_lock<typename Cv::mutex> lock(mtx);
+            for (;;) {
+                unsigned long seen = round;
+                asleep++;
+                done.notify_one();
+                go.wait(lock, [&] { return stop || round != seen; });
+                if (stop)
+                    return;
+                if (++finished == waiters)
+                    done.notify_one();
+            }
+        }));
+    }
+
+    std::unique_lock<typename Cv::mutex> lock(mtx);
+    while (st.keep_running()) {
+        st.pause_timing();
+        done.wait(lock, [&] { return asleep == waiters; });
+        asleep = 0;
+        finished = 0;
+        round++;
+        st.resume_timing();
+        go.notify_all();
+        done.wait(lock, [&] { return finished == waiters; });
+    }
+    done.wait(lock, [&] { return asleep == waiters; });
+    stop = true;
+    go.notify_all();
+    lock.unlock();
+    for (size_t i = 0; i < threads.size(); i++)
+        threads[i].join();
+    st.set_items_per_iteration(waiters);
+}
+
+template <typename Cv>
+void wait_for(state& st)
+{
+    const std::chrono::microseconds timeout(st.arg());
+    typename Cv::mutex mtx;
+    typename Cv::condition_variable cv;
+    std::unique_lock<typename Cv::mutex> lock(mtx);
+    while (st.keep_running())
+        cv.wait_for(lock, timeout);
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("condition_variable");
+    s.add("notify_one", "std", notify_one<std_cv>);
+    s.add("notify_one", "Hx", notify_one<hx_cv>);
+    s.add("notify_all", "std", notify_all<std_cv>).args({1, 4, 16, 64});
+    s.add("notify_all", "Hx", notify_all<hx_cv>).args({1, 4, 16, 64});
+    s.add("wait_for", "std", wait_for<std_cv>).args({10, 100, 1000});
+    s.add("wait_for", "Hx", wait_for<hx_cv>).args({10, 100, 1000});
+    return s.run(argc, argv);
+}
@@ -0,0 +1,38 @@
+// condition_variable example
+#include <iostream>           // std::cout
+#include <thread>             // std::thread
+#include <mutex>              // std::unique_lock
+#include "mutex.hpp"          // Hx::mutex
+#include "condition_variable.hpp" // Hx::condition_variable
+
+Hx::mutex mtx;
+Hx::condition_variable cv;
+bool ready = false;
+
+void print_id (int id) {
+    std::unique_lock<Hx::mutex> lck(mtx);
+    while (!ready) cv.wait(lck);
+    // ...
+    std::cout << "thread " << id << '\n';
+}
+
+void go() {
+    std::unique_lock<Hx::mutex> lck(mtx);
+    ready = true;
+    cv.notify_all();
+}
+
+int main ()
+{
+    std::thread threads[10];
+    // spawn 10 threads:
+    for (int i=0; i<10; ++i)
+        threads[i] = std::thread(print_id,i);
+
+    std::cout << "10 threads ready to race...\n";
+    go();                       // go!
+
+    for (auto& th : threads) th.join();
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include "condition_variable.hpp"
+#include <cassert>
+#include <cerrno>
+#include <climits>
+#include <ctime>
+#include "futex.hpp"
+
+namespace Hx {
+
+condition_variable::condition_variable():
+    seq_(0), waiters_(0), mutex_(nullptr)
+{
+}
+
+condition_variable::~condition_variable()
+{
+    assert(waiters_.load(std::memory_order_relaxed) == 0);
+}
+
+void condition_variable::notify_one() noexcept
+{
+    // pairs with wait_on: either the waiter sees the new seq_ and does not
+    // sleep, or we see it counted in waiters_ and wake it
+    seq_.fetch_add(1, std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_seq_cst) > 0)
+        futex_wake(&seq_, 1);
+}
+
+void condition_variable::notify_all() noexcept
+{
+    seq_.fetch_add(1, std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_seq_cst) == 0)
+        return;
+
+    // wake one waiter and queue the others on the mutex, so that each
+    // unlock hands it to the next; see wait_on for how they relock
+    mutex* m = mutex_.load(std::memory_order_relaxed);
+    int seq = seq_.load(std::memory_order_relaxed);
+    while (futex_cmp_requeue(&seq_, 1, INT_MAX, m->native_handle(), seq) == -1 && errno == EAGAIN)
+        seq = seq_.load(std::memory_order_relaxed);
+}
+
+void condition_variable::wait(std::unique_lock<mutex>& lck)
+{
+    assert(lck.owns_lock());
+    wait_on(*lck.mutex(), nullptr);
+}
+
+cv_status condition_variable::wait_until_steady(std::unique_lock<mutex>& lck, std::chrono::steady_clock::time_point deadline)
+{
+    using namespace std::chrono;
+    assert(lck.owns_lock());
+    steady_clock::duration left = deadline-steady_clock::now();
+    if (left <= steady_clock::duration::zero())
+        return cv_status::timeout;
+
+    // FUTEX_WAIT measures a relative timeout on CLOCK_MONOTONIC
+    seconds sec = duration_cast<seconds>(left);
+    nanoseconds nsec = duration_cast<nanoseconds>(left-sec);
+    struct timespec ts;
+    ts.tv_sec = sec.count();
+    ts.tv_nsec = nsec.count();
+    if (wait_on(*lck.mutex(), &ts) || steady_clock::now() < deadline)
+        return cv_status::no_timeout;
+    return cv_status::timeout;
+}
+
+bool condition_variable::wait_on(mutex& m, const struct timespec* timeout)
+{
+    mutex_.store(&m, std::memory_order_relaxed);
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    int seq = seq_.load(std::memory_order_seq_cst);
+    m.unlock();
+
+    int rc = futex_wait(&seq_, seq, timeout);
+    bool timed_out = rc == -1 && errno == ETIMEDOUT;
+
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+
+    // relock without Hx::mutex's spin: the notifier usually still holds
+    // the mutex and is not about to let go. A waiter that was woken may
+    // have been requeued onto the mutex word (by a notify_all it entered
+    // the wait too late to know of); it takes the mutex as contended (2)
+    // even if it is free, so that its unlock wakes whoever is still
+    // queued behind it. One that never slept or timed out was not
+    std::atomic<int>* word = m.native_handle();
+    int c = 0;
+    if (rc == 0 ||
+            !word->compare_exchange_strong(c, 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+        while (word->exchange(2, std::memory_order_acquire) != 0)
+            futex_wait(word, 2);
+    }
+    return !timed_out;
+}
+
+condition_variable_any::condition_variable_any():
+    seq_(0), waiters_(0)
+{
+}
+
+condition_variable_any::~condition_variable_any()
+{
+    assert(waiters_.load(std::memory_order_relaxed) == 0);
+}
+
+void condition_variable_any::notify_one() noexcept
+{
+    // pairs with enter: either the waiter sees the new seq_ and does not
+    // sleep, or we see it counted in waiters_ and wake it
+    seq_.fetch_add(1, std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_seq_cst) > 0)
+        futex_wake(&seq_, 1);
+}
+
+void condition_variable_any::notify_all() noexcept
+{
+    seq_.fetch_add(1, std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_seq_cst) > 0)
+        futex_wake(&seq_, INT_MAX);
+}
+
+int condition_variable_any::enter()
+{
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    return seq_.load(std::memory_order_seq_cst);
+}
+
+void condition_variable_any::leave()
+{
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool condition_variable_any::sleep(int seq, const struct timespec* timeout)
+{
+    return !(futex_wait(&seq_, seq, timeout) == -1 && errno == ETIMEDOUT);
+}
+
+bool condition_variable_any::sleep_until(int seq, std::chrono::steady_clock::time_point deadline)
+{
+    using namespace std::chrono;
+    steady_clock::duration left = deadline-steady_clock::now();
+    if (left <= steady_clock::duration::zero())
+        return false;
+    seconds sec = duration_cast<seconds>(left);
+    nanoseconds nsec = duration_cast<nanoseconds>(left-sec);
+    struct timespec ts;
+    ts.tv_sec = sec.count();
+    ts.tv_nsec = nsec.count();
+    return sleep(seq, &ts);
+}
+
+}   // namespace Hx
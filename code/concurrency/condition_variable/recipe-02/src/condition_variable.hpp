@@ -0,0 +1,315 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_CONDITION_VARIABLE_INC
+#define MINI_STL_CONDITION_VARIABLE_INC
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include "mutex.hpp"
+
+#if !defined(HX_MUTEX_USE_FUTEX)
+#error "this condition_variable needs the futex Hx::mutex (Linux, without HX_MUTEX_USE_PTHREAD)"
+#endif
+
+namespace Hx {
+
+/**
+ * The scoped enumeration cv_status describes whether a timed wait
+ * returned because of timeout or not.
+ */
+enum class cv_status {
+    timeout,
+    no_timeout,
+};
+
+namespace detail {
+
+// rounds up, so that a wait never ends before its time
+template <typename Rep, typename Period>
+std::chrono::steady_clock::duration ceil_cast(const std::chrono::duration<Rep, Period>& d)
+{
+    using namespace std::chrono;
+    steady_clock::duration r = duration_cast<steady_clock::duration>(d);
+    return r < d ? r+steady_clock::duration(1) : r;
+}
+
+}    // namespace detail
+
+/**
+ * The condition_variable class is a synchronization primitive
+ * that can be used to block a thread, or multiple threads
+ * at the same time, until: a notification is received
+ * from another thread, a timeout expires,
+ * or a spurious wakeup occurs.
+ * Any thread that intends to wait on condition_variable
+ * has to acquire a unique_lock first.
+ * The wait operations atomically release the mutex
+ * and suspend the execution of the thread.
+ * When the condition variable is notified,
+ * the thread is awakened, and the mutex is reacquired.
+ *
+ * This one works with the futex Hx::mutex rather than std::mutex. Waiters
+ * sleep on a sequence counter that every notify bumps, so a notify that
+ * comes between a waiter's unlock and its sleep is never lost. notify_one
+ * wakes one sleeper, and only if there are waiters at all. notify_all
+ * wakes one and requeues the rest onto the mutex's futex word
+ * (FUTEX_CMP_REQUEUE), where each unlock passes the mutex on to the next,
+ * instead of waking them all to fight over it. Timeouts run on
+ * steady_clock (CLOCK_MONOTONIC), so setting the wall clock does not
+ * stretch or cut them short.
+ */
+class condition_variable {
+    std::atomic<int> seq_;          // bumped by every notify; waiters sleep on it
+    std::atomic<int> waiters_;      // threads inside a wait
+    std::atomic<mutex*> mutex_;     // the waiters' mutex, for notify_all to requeue onto
+
+public:
+    typedef std::atomic<int>* native_handle_type;
+
+    /** Constructs an object of type condition_variable. */
+    condition_variable();
+
+    condition_variable(const condition_variable&) = delete;
+    condition_variable& operator=(const condition_variable&) = delete;
+
+    /** Destroys the object of type condition_variable. */
+    ~condition_variable();
+
+    /**
+     * Notify one
+     * Unblocks one of the threads currently waiting for this condition.
+     * If no threads are waiting, the function does nothing.
+     * If more than one, it is unspecified which of the threads is selected.
+     */
+    void notify_one() noexcept;
+
+    /**
+     * Notify all
+     * Unblocks all threads currently waiting for this condition.
+     * If no threads are waiting, the function does nothing.
+     */
+    void notify_all() noexcept;
+
+    /**
+     * Wait until notified
+     * The execution of the current thread
+     * (which shall have locked lck's mutex) is blocked until notified.
+     */
+    void wait(std::unique_lock<mutex>& lck);
+
+    /**
+     * If pred is specified, the function only blocks if pred returns false,
+     * and notifications can only unblock the thread when it becomes true
+     * (which is specially useful to check against spurious wake-up calls).
+     */
+    template <typename Predicate>
+    void wait(std::unique_lock<mutex>& lck, Predicate pred)
+    {
+        while (!pred()) {
+            wait(lck);
+        }
+    }
+
+    /**
+     * Wait for timeout or until notified
+     * The execution of the current thread (which shall have locked lck's mutex)
+     * is blocked during rel_time, or until notified
+     * (if the latter happens first).
+     */
+    template <typename Rep, typename Period>
+    cv_status wait_for(std::unique_lock<mutex>& lck, const std::chrono::duration<Rep, Period>& rel_time)
+    {
+        using namespace std::chrono;
+        return wait_until(lck, steady_clock::now()+detail::ceil_cast(rel_time));
+    }
+
+    /**
+     * If pred is specified, the function only blocks if pred returns false,
+     * and notifications can only unblock the thread when it becomes true
+     * (which is especially useful to check against spurious wake-up calls).
+     */
+    template <typename Rep, typename Period, typename Predicate>
+    bool wait_for(std::unique_lock<mutex>& lck,
+        const std::chrono::duration<Rep, Period>& rel_time, Predicate pred)
+    {
+        using namespace std::chrono;
+        return wait_until(lck, steady_clock::now()+detail::ceil_cast(rel_time), pred);
+    }
+
+    /**
+     * Wait until notified or time point
+     * The execution of the current thread (which shall have locked lck's mutex)
+     * is blocked either until notified or until abs_time,
+     * whichever happens first.
+     * The sleep itself is timed on steady_clock; for other clocks the
+     * time left is converted when the wait starts, and Clock is checked
+     * again when it ends.
+     */
+    template <typename Clock, typename Duration>
+    cv_status wait_until(std::unique_lock<mutex>& lck,
+        const std::chrono::time_point<Clock, Duration>& abs_time)
+    {
+        using namespace std::chrono;
+        steady_clock::time_point deadline = steady_clock::now()+detail::ceil_cast(abs_time-Clock::now());
+        wait_until_steady(lck, deadline);
+        return Clock::now() < abs_time ? cv_status::no_timeout : cv_status::timeout;
+    }
+
+    template <typename Duration>
+    cv_status wait_until(std::unique_lock<mutex>& lck,
+        const std::chrono::time_point<std::chrono::steady_clock, Duration>& abs_time)
+    {
+        using namespace std::chrono;
+        return wait_until_steady(lck, time_point_cast<steady_clock::duration>(abs_time));
+    }
+
+    /**
+     * If pred is specified, the function only blocks if pred returns false,
+     * and notifications can only unblock the thread when it becomes true
+     * (which is especially useful to check against spurious wake-up calls).
+     */
+    template <typename Clock, typename Duration, typename Predicate>
+    bool wait_until(std::unique_lock<mutex>& lck,
+        const std::chrono::time_point<Clock, Duration>& abs_time, Predicate pred)
+    {
+        while (!pred()) {
+            if (wait_until(lck, abs_time) == cv_status::timeout) {
+                return pred();
+            }
+        }
+        return true;
+    }
+
+    /** Accesses the native handle of *this: the sequence counter's futex word. */
+    native_handle_type native_handle() { return &seq_; }
+
+private:
+    cv_status wait_until_steady(std::unique_lock<mutex>& lck, std::chrono::steady_clock::time_point deadline);
+    bool wait_on(mutex& m, const struct timespec* timeout);
+};
+
+/**
+ * The condition_variable_any class is a generalization of
+ * condition_variable. Whereas condition_variable works only on
+ * std::unique_lock<Hx::mutex>, condition_variable_any can operate
+ * on any lock that meets the BasicLockable requirements.
+ *
+ * Waiters sleep on a sequence counter as with condition_variable, and
+ * notify_one does not enter the kernel without waiters; notify_all wakes
+ * them all, since there is no futex word of the lock to requeue them onto.
+ */
+class condition_variable_any {
+    std::atomic<int> seq_;          // bumped by every notify; waiters sleep on it
+    std::atomic<int> waiters_;      // threads inside a wait
+
+public:
+    /** Constructs an object of type condition_variable_any. */
+    condition_variable_any();
+
+    condition_variable_any(const condition_variable_any&) = delete;
+    condition_variable_any& operator=(const condition_variable_any&) = delete;
+
+    /** Destroys the object of type condition_variable_any. */
+    ~condition_variable_any();
+
+    /** Unblocks one of the threads currently waiting for this condition. */
+    void notify_one() noexcept;
+
+    /** Unblocks all threads currently waiting for this condition. */
+    void notify_all() noexcept;
+
+    /**
+     * Wait until notified
+     * Atomically unlocks lck, blocks until notified, then locks lck again.
+     */
+    template <typename Lock>
+    void wait(Lock& lck)
+    {
+        int seq = enter();
+        lck.unlock();
+        sleep(seq, nullptr);
+        leave();
+        lck.lock();
+    }
+
+    template <typename Lock, typename Predicate>
+    void wait(Lock& lck, Predicate pred)
+    {
+        while (!pred()) {
+            wait(lck);
+        }
+    }
+
+    template <typename Lock, typename Rep, typename Period>
+    cv_status wait_for(Lock& lck, const std::chrono::duration<Rep, Period>& rel_time)
+    {
+        using namespace std::chrono;
+        return wait_until(lck, steady_clock::now()+detail::ceil_cast(rel_time));
+    }
+
+    template <typename Lock, typename Rep, typename Period, typename Predicate>
+    bool wait_for(Lock& lck, const std::chrono::duration<Rep, Period>& rel_time, Predicate pred)
+    {
+        using namespace std::chrono;
+        return wait_until(lck, steady_clock::now()+detail::ceil_cast(rel_time), pred);
+    }
+
+    /**
+     * Wait until notified or time point
+     * As with condition_variable, the sleep is timed on steady_clock.
+     */
+    template <typename Lock, typename Clock, typename Duration>
+    cv_status wait_until(Lock& lck, const std::chrono::time_point<Clock, Duration>& abs_time)
+    {
+        using namespace std::chrono;
+        steady_clock::time_point deadline = steady_clock::now()+detail::ceil_cast(abs_time-Clock::now());
+        wait_until_steady(lck, deadline);
+        return Clock::now() < abs_time ? cv_status::no_timeout : cv_status::timeout;
+    }
+
+    template <typename Lock, typename Duration>
+    cv_status wait_until(Lock& lck, const std::chrono::time_point<std::chrono::steady_clock, Duration>& abs_time)
+    {
+        using namespace std::chrono;
+        return wait_until_steady(lck, time_point_cast<steady_clock::duration>(abs_time));
+    }
+
+    template <typename Lock, typename Clock, typename Duration, typename Predicate>
+    bool wait_until(Lock& lck, const std::chrono::time_point<Clock, Duration>& abs_time, Predicate pred)
+    {
+        while (!pred()) {
+            if (wait_until(lck, abs_time) == cv_status::timeout) {
+                return pred();
+            }
+        }
+        return true;
+    }
+
+private:
+    template <typename Lock>
+    cv_status wait_until_steady(Lock& lck, std::chrono::steady_clock::time_point deadline)
+    {
+        using namespace std::chrono;
+        if (deadline <= steady_clock::now())
+            return cv_status::timeout;
+        int seq = enter();
+        lck.unlock();
+        bool notified = sleep_until(seq, deadline);
+        leave();
+        lck.lock();
+        return notified || steady_clock::now() < deadline ? cv_status::no_timeout : cv_status::timeout;
+    }
+
+    // counts the caller as a waiter and returns the sequence number to sleep on
+    int enter();
+    void leave();
+    bool sleep(int seq, const struct timespec* timeout);
+    bool sleep_until(int seq, std::chrono::steady_clock::time_point deadline);
+};
+
+}    // namespace Hx
+
+#endif
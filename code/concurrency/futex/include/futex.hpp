@@ -0,0 +1,72 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_FUTEX_INC
+#define MINI_STL_FUTEX_INC
+
+#include <atomic>
+#include <ctime>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Hx {
+
+/**
+ * Tells the cpu we are in a spin-wait loop (pause on x86), which saves
+ * power and lets the other hyper-thread run.
+ */
+inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+#if defined(__linux__)
+
+static_assert(sizeof(std::atomic<int>) == sizeof(int), "futex word must be a plain int");
+
+/**
+ * Sleeps while *addr == expected, until futex_wake, a signal, or the
+ * relative timeout (if any) elapses. Returns 0, or -1 with errno set
+ * (EAGAIN if *addr != expected, EINTR, ETIMEDOUT); callers recheck their
+ * condition either way.
+ */
+inline int futex_wait(std::atomic<int>* addr, int expected, const struct timespec* timeout = nullptr)
+{
+    return int(syscall(SYS_futex, reinterpret_cast<int*>(addr), FUTEX_WAIT_PRIVATE, expected, timeout, nullptr, 0));
+}
+
+/**
+ * Wakes up to n threads sleeping in futex_wait on addr.
+ */
+inline int futex_wake(std::atomic<int>* addr, int n)
+{
+    return int(syscall(SYS_futex, reinterpret_cast<int*>(addr), FUTEX_WAKE_PRIVATE, n, nullptr, nullptr, 0));
+}
+
+/**
+ * If *addr == expected, wakes up to n_wake threads sleeping on addr and
+ * moves up to n_requeue of the others to sleep on addr2 instead, without
+ * waking them. Returns the number of threads woken or moved, or -1 with
+ * errno set (EAGAIN if *addr != expected).
+ */
+inline int futex_cmp_requeue(std::atomic<int>* addr, int n_wake, int n_requeue, std::atomic<int>* addr2, int expected)
+{
+    // the kernel takes n_requeue in the timeout argument
+    return int(syscall(SYS_futex, reinterpret_cast<int*>(addr), FUTEX_CMP_REQUEUE_PRIVATE, n_wake,
+        reinterpret_cast<void*>(static_cast<long>(n_requeue)), reinterpret_cast<int*>(addr2), expected));
+}
+
+#endif
+
+}    // namespace Hx
+
+#endif
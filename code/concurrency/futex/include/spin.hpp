@@ -0,0 +1,28 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_SPIN_INC
+#define MINI_STL_SPIN_INC
+
+#include <thread>
+
+namespace Hx {
+
+namespace detail {
+
+/**
+ * How many times a spin-wait should pause before it yields: n, or none on
+ * a single cpu, where the thread we wait for cannot run while we spin.
+ */
+inline int pause_budget(int n)
+{
+    static const bool smp = std::thread::hardware_concurrency() > 1;
+    return smp ? n : 0;
+}
+
+}    // namespace detail
+
+}    // namespace Hx
+
+#endif
@@ -0,0 +1,588 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_FUTURE_INC
+#define MINI_STL_FUTURE_INC
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include "shared_state.hpp"
+#include "thread.hpp"
+
+namespace Hx {
+
+template <typename T> class future;
+template <typename T> class shared_future;
+
+/**
+ * Launch policy of async; async|deferred lets the implementation pick,
+ * which here means a new thread, or deferred if no thread can be started.
+ */
+enum class launch {
+    async = 1,
+    deferred = 2,
+};
+
+inline launch operator|(launch a, launch b) { return launch(int(a) | int(b)); }
+inline launch operator&(launch a, launch b) { return launch(int(a) & int(b)); }
+
+namespace detail {
+
+struct future_access;
+
+/** What future<T>::get and shared_future<T>::get return. */
+template <typename T>
+struct future_result {
+    typedef T type;
+    typedef const T& shared_type;
+    static T get(shared_state<T>& s) { return std::move(s.get()); }
+};
+
+template <typename T>
+struct future_result<T&> {
+    typedef T& type;
+    typedef T& shared_type;
+    static T& get(shared_state<T&>& s) { return s.get(); }
+};
+
+template <>
+struct future_result<void> {
+    typedef void type;
+    typedef void shared_type;
+    static void get(shared_state<void>& s) { s.get(); }
+};
+
+/**
+ * What future and shared_future have in common: a counted reference to
+ * the shared state. The future of an async on its own thread waits for
+ * it before letting go.
+ */
+template <typename T>
+class future_base {
+public:
+    future_base() noexcept: state_(nullptr) {}
+
+    bool valid() const noexcept { return state_ != nullptr; }
+
+    void wait() const { checked()->wait(); }
+
+    template <typename Rep, typename Period>
+    future_status wait_for(const std::chrono::duration<Rep, Period>& rel_time) const
+    {
+        return checked()->wait_until(std::chrono::steady_clock::now()+
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(rel_time));
+    }
+
+    template <typename Clock, typename Duration>
+    future_status wait_until(const std::chrono::time_point<Clock, Duration>& abs_time) const
+    {
+        return wait_for(abs_time-Clock::now());
+    }
+
+    /** True once the result is in; never blocks. */
+    bool is_ready() const { return checked()->is_ready(); }
+
+protected:
+    friend struct future_access;
+
+    explicit future_base(shared_state<T>* state) noexcept: state_(state) {}
+
+    future_base(future_base&& other) noexcept: state_(other.state_) { other.state_ = nullptr; }
+
+    future_base& operator=(future_base&& other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            state_ = other.state_;
+            other.state_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~future_base() { reset(); }
+
+    void reset() noexcept
+    {
+        if (state_ == nullptr)
+            return;
+        if (state_->is_async())
+            state_->wait();
+        state_->release();
+        state_ = nullptr;
+    }
+
+    shared_state<T>* checked() const
+    {
+        if (state_ == nullptr)
+            throw std::future_error(std::future_errc::no_state);
+        return state_;
+    }
+
+    shared_state<T>* state_;
+};
+
+/** The type f(future) returns, for then(). */
+template <typename Future, typename F>
+struct then_result {
+    typedef decltype(std::declval<typename std::decay<F>::type&>()(std::declval<Future>())) type;
+};
+
+/** The back door through which the free functions get at the states of futures. */
+struct future_access {
+    template <typename Future>
+    static Future make(typename Future::state_type* state) { return Future(state); }
+
+    template <typename Future>
+    static typename Future::state_type* state(const Future& f) { return f.state_; }
+
+    /** Hands state (one reference) to f, called once it is ready, and returns the future of f's result. */
+    template <typename Future, typename F>
+    static future<typename then_result<Future, F>::type> then(typename Future::state_type* state, F&& f);
+};
+
+/** Runs f(Future(state)) once state is ready and stores the result in next. */
+template <typename Future, typename R, typename F, typename T>
+class then_node: public callback_node {
+    shared_state<T>* state_;        // one reference, handed to the future passed to f
+    shared_state<R>* next_;         // one reference
+    F f_;
+
+public:
+    template <typename G>
+    then_node(shared_state<T>* state, shared_state<R>* next, G&& f):
+        state_(state), next_(next), f_(std::forward<G>(f)) {}
+
+    virtual void run() noexcept
+    {
+        invoke_and_store<R>::run(*next_, f_, future_access::make<Future>(state_));
+        next_->release();
+        delete this;
+    }
+};
+
+template <typename Future, typename F>
+future<typename then_result<Future, F>::type> future_access::then(typename Future::state_type* state, F&& f)
+{
+    typedef typename then_result<Future, F>::type R;
+    typedef then_node<Future, R, typename std::decay<F>::type, typename Future::value_type> node_type;
+    // both references go to the node once it exists; until then, an
+    // exception drops them
+    std::unique_ptr<typename Future::state_type, state_releaser> held(state);
+    std::unique_ptr<shared_state<R>, state_releaser> next(new shared_state<R>);
+    node_type* node = new node_type(held.get(), next.get(), std::forward<F>(f));
+    held.release();
+    next->add_ref();
+    shared_state<R>* result = next.release();
+    state->add_callback(node);
+    return future<R>(result);
+}
+
+}    // namespace detail
+
+/**
+ * The consumer end of a shared state: get() waits for the result and
+ * returns it, moving the value out, or rethrows the stored exception;
+ * afterwards the future is no longer valid.
+ * A future whose result is in costs one acquire load to get; one still
+ * waiting spins briefly, then sleeps on the state's futex word.
+ */
+template <typename T>
+class future: public detail::future_base<T> {
+    typedef detail::future_base<T> base;
+
+public:
+    typedef T value_type;
+    typedef detail::shared_state<T> state_type;
+
+    future() noexcept {}
+    future(future&& other) noexcept: base(std::move(other)) {}
+    future& operator=(future&& other) noexcept { base::operator=(std::move(other)); return *this; }
+
+    future(const future&) = delete;
+    future& operator=(const future&) = delete;
+
+    typename detail::future_result<T>::type get()
+    {
+        future hold(std::move(*this));         // releases the state on the way out
+        return detail::future_result<T>::get(*hold.checked());
+    }
+
+    /** Turns this future into a shared_future, which it leaves invalid. */
+    shared_future<T> share() noexcept;
+
+    /**
+     * Returns a future of f(future<T>), which runs f once this future's
+     * result is in: on the thread that stores it, or right here if it
+     * already is. Leaves this future invalid.
+     */
+    template <typename F>
+    future<typename detail::then_result<future, F>::type> then(F&& f)
+    {
+        this->checked();
+        state_type* state = this->state_;
+        this->state_ = nullptr;
+        return detail::future_access::then<future>(state, std::forward<F>(f));
+    }
+
+private:
+    friend struct detail::future_access;
+
+    explicit future(state_type* state) noexcept: base(state) {}
+};
+
+/**
+ * A copyable future: every copy can wait for and read the result, which
+ * get() returns by const reference and leaves in place.
+ */
+template <typename T>
+class shared_future: public detail::future_base<T> {
+    typedef detail::future_base<T> base;
+
+public:
+    typedef T value_type;
+    typedef detail::shared_state<T> state_type;
+
+    shared_future() noexcept {}
+    shared_future(future<T>&& other) noexcept: base(std::move(other)) {}
+    shared_future(shared_future&& other) noexcept: base(std::move(other)) {}
+
+    shared_future(const shared_future& other) noexcept: base(other.state_)
+    {
+        if (this->state_ != nullptr)
+            this->state_->add_ref();
+    }
+
+    shared_future& operator=(shared_future&& other) noexcept { base::operator=(std::move(other)); return *this; }
+
+    shared_future& operator=(const shared_future& other) noexcept
+    {
+        shared_future copy(other);
+        return *this = std::move(copy);
+    }
+
+    typename detail::future_result<T>::shared_type get() const
+    {
+        return this->checked()->get();
+    }
+
+    /** Like future::then, but f gets a copy and this future stays valid. */
+    template <typename F>
+    future<typename detail::then_result<shared_future, F>::type> then(F&& f) const
+    {
+        this->checked()->add_ref();
+        return detail::future_access::then<shared_future>(this->state_, std::forward<F>(f));
+    }
+
+private:
+    friend struct detail::future_access;
+
+    explicit shared_future(state_type* state) noexcept: base(state) {}
+};
+
+template <typename T>
+inline shared_future<T> future<T>::share() noexcept
+{
+    return shared_future<T>(std::move(*this));
+}
+
+namespace detail {
+
+/** What promise<T>, promise<T&> and promise<void> have in common. */
+template <typename T>
+class promise_base {
+public:
+    promise_base(): state_(new shared_state<T>) {}
+
+    promise_base(promise_base&& other) noexcept: state_(other.state_) { other.state_ = nullptr; }
+
+    promise_base& operator=(promise_base&& other) noexcept
+    {
+        promise_base tmp(std::move(other));
+        swap(tmp);
+        return *this;
+    }
+
+    promise_base(const promise_base&) = delete;
+    promise_base& operator=(const promise_base&) = delete;
+
+    /** Without a stored result, the future gets broken_promise. */
+    ~promise_base()
+    {
+        if (state_ != nullptr)
+            state_->abandon();
+    }
+
+    void swap(promise_base& other) noexcept { std::swap(state_, other.state_); }
+
+    /** Returns the future; only once. */
+    future<T> get_future()
+    {
+        checked()->retrieve();
+        state_->add_ref();
+        return future_access::make<future<T>>(state_);
+    }
+
+    void set_exception(std::exception_ptr e) { checked()->set_exception(e); }
+
+protected:
+    shared_state<T>* checked() const
+    {
+        if (state_ == nullptr)
+            throw std::future_error(std::future_errc::no_state);
+        return state_;
+    }
+
+    shared_state<T>* state_;
+};
+
+}    // namespace detail
+
+/**
+ * The producer end of a shared state: stores a value or an exception
+ * once, waking whoever waits on the future and running its
+ * continuations.
+ */
+template <typename T>
+class promise: public detail::promise_base<T> {
+public:
+    promise() {}
+    promise(promise&& other) noexcept: detail::promise_base<T>(std::move(other)) {}
+    promise& operator=(promise&& other) noexcept { detail::promise_base<T>::operator=(std::move(other)); return *this; }
+
+    void set_value(const T& value) { this->checked()->set_value(value); }
+    void set_value(T&& value) { this->checked()->set_value(std::move(value)); }
+};
+
+template <typename T>
+class promise<T&>: public detail::promise_base<T&> {
+public:
+    promise() {}
+    promise(promise&& other) noexcept: detail::promise_base<T&>(std::move(other)) {}
+    promise& operator=(promise&& other) noexcept { detail::promise_base<T&>::operator=(std::move(other)); return *this; }
+
+    void set_value(T& value) { this->checked()->set_value(value); }
+};
+
+template <>
+class promise<void>: public detail::promise_base<void> {
+public:
+    promise() {}
+    promise(promise&& other) noexcept: detail::promise_base<void>(std::move(other)) {}
+    promise& operator=(promise&& other) noexcept { detail::promise_base<void>::operator=(std::move(other)); return *this; }
+
+    void set_value() { this->checked()->set_value(); }
+};
+
+template <typename T>
+inline void swap(promise<T>& a, promise<T>& b) noexcept
+{
+    a.swap(b);
+}
+
+template <typename Signature> class packaged_task;
+
+/**
+ * A function bundled with a promise: calling the task calls the function
+ * and stores what it returns, or what it throws, for the future.
+ */
+template <typename R, typename... Args>
+class packaged_task<R(Args...)> {
+public:
+    packaged_task() noexcept: state_(nullptr) {}
+
+    template <typename F, typename = typename std::enable_if<
+        !std::is_same<typename std::decay<F>::type, packaged_task>::value>::type>
+    explicit packaged_task(F&& f): fn_(std::forward<F>(f)), state_(new detail::shared_state<R>) {}
+
+    packaged_task(packaged_task&& other) noexcept: fn_(std::move(other.fn_)), state_(other.state_)
+    {
+        other.state_ = nullptr;
+    }
+
+    packaged_task& operator=(packaged_task&& other) noexcept
+    {
+        packaged_task tmp(std::move(other));
+        swap(tmp);
+        return *this;
+    }
+
+    packaged_task(const packaged_task&) = delete;
+    packaged_task& operator=(const packaged_task&) = delete;
+
+    ~packaged_task()
+    {
+        if (state_ != nullptr)
+            state_->abandon();
+    }
+
+    bool valid() const noexcept { return state_ != nullptr; }
+
+    void swap(packaged_task& other) noexcept
+    {
+        fn_.swap(other.fn_);
+        std::swap(state_, other.state_);
+    }
+
+    /** Returns the future; only once. */
+    future<R> get_future()
+    {
+        checked()->retrieve();
+        state_->add_ref();
+        return detail::future_access::make<future<R>>(state_);
+    }
+
+    /** Calls the function with args; only once per shared state. */
+    void operator()(Args... args)
+    {
+        checked()->claim();
+        detail::invoke_and_store<R>::run(*state_, fn_, std::forward<Args>(args)...);
+    }
+
+    /** Abandons the shared state for a new one, so that the task can run again. */
+    void reset()
+    {
+        detail::shared_state<R>* fresh = new detail::shared_state<R>;
+        checked()->abandon();
+        state_ = fresh;
+    }
+
+private:
+    detail::shared_state<R>* checked() const
+    {
+        if (state_ == nullptr)
+            throw std::future_error(std::future_errc::no_state);
+        return state_;
+    }
+
+    std::function<R(Args...)> fn_;
+    detail::shared_state<R>* state_;
+};
+
+template <typename R, typename... Args>
+inline void swap(packaged_task<R(Args...)>& a, packaged_task<R(Args...)>& b) noexcept
+{
+    a.swap(b);
+}
+
+namespace detail {
+
+/** The bound call of an async, and the type it returns. */
+template <typename F, typename... Args>
+struct async_result {
+    typedef decltype(std::bind(std::declval<F>(), std::declval<Args>()...)) bound_type;
+    typedef decltype(std::declval<bound_type&>()()) type;
+};
+
+/**
+ * The shared state of an async: the bound call, run either on a detached
+ * Hx::thread, which holds a reference until it is done, or by the first
+ * thread to wait on the future.
+ */
+template <typename R, typename Bound>
+class async_state: public shared_state<R> {
+    Bound fn_;
+
+public:
+    explicit async_state(Bound&& fn): fn_(std::move(fn)) {}
+
+    void run()
+    {
+        this->claim();
+        invoke_and_store<R>::run(*this, fn_);
+    }
+
+    /** Starts the call on a new thread; throws std::system_error if there is none to be had. */
+    void launch_async()
+    {
+        this->set_async();
+        this->add_ref();
+        try {
+            Hx::thread t([this] {
+                run();
+                this->release();
+            });
+            t.detach();
+        } catch (...) {
+            this->release();
+            throw;
+        }
+    }
+
+    void defer() { this->set_deferred(); }
+
+protected:
+    virtual void run_deferred() { run(); }
+};
+
+}    // namespace detail
+
+/**
+ * Calls f(args...) on a new thread (launch::async) or on the first wait
+ * for the future (launch::deferred), and returns the future of its
+ * result. f and args are bound as with Hx::thread.
+ * The future of a launch::async call waits for it before going away.
+ */
+template <typename F, typename... Args>
+future<typename detail::async_result<F, Args...>::type> async(launch policy, F&& f, Args&&... args)
+{
+    typedef typename detail::async_result<F, Args...>::bound_type Bound;
+    typedef typename detail::async_result<F, Args...>::type R;
+    detail::async_state<R, Bound>* state =
+        new detail::async_state<R, Bound>(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+    if ((policy & launch::async) == launch::async) {
+        try {
+            state->launch_async();
+            return detail::future_access::make<future<R>>(state);
+        } catch (const std::system_error&) {
+            if ((policy & launch::deferred) != launch::deferred) {
+                state->release();
+                throw;
+            }
+        }
+    }
+    state->defer();
+    return detail::future_access::make<future<R>>(state);
+}
+
+template <typename F, typename... Args, typename = typename std::enable_if<
+    !std::is_same<typename std::decay<F>::type, launch>::value>::type>
+future<typename detail::async_result<F, Args...>::type> async(F&& f, Args&&... args)
+{
+    return Hx::async(launch::async | launch::deferred, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+/** A future whose value is already in. */
+template <typename T>
+future<typename std::decay<T>::type> make_ready_future(T&& value)
+{
+    promise<typename std::decay<T>::type> p;
+    p.set_value(std::forward<T>(value));
+    return p.get_future();
+}
+
+inline future<void> make_ready_future()
+{
+    promise<void> p;
+    p.set_value();
+    return p.get_future();
+}
+
+/** A future that holds e. */
+template <typename T>
+future<T> make_exceptional_future(std::exception_ptr e)
+{
+    promise<T> p;
+    p.set_exception(e);
+    return p.get_future();
+}
+
+}    // namespace Hx
+
+#endif
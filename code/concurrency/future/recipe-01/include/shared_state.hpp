@@ -0,0 +1,391 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_SHARED_STATE_INC
+#define MINI_STL_SHARED_STATE_INC
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <ctime>
+#include <exception>
+#include <future>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "futex.hpp"
+
+namespace Hx {
+
+enum class future_status {
+    ready,
+    timeout,
+    deferred,
+};
+
+namespace detail {
+
+/**
+ * Something to run once a shared state is ready, on the thread that makes
+ * it ready (or, if it already is, on the thread that adds it). run()
+ * deletes the node.
+ */
+struct callback_node {
+    callback_node* next;
+
+    callback_node(): next(nullptr) {}
+    virtual ~callback_node() {}
+    virtual void run() noexcept = 0;
+};
+
+/**
+ * The shared state of a promise and its futures, without the value.
+ * A futex word says whether the result is in: empty, empty with sleeping
+ * waiters, or ready. The producer stores the result, swaps the word to
+ * ready, and only calls FUTEX_WAKE if it saw waiters; a consumer that
+ * finds it ready reads the result without any lock. Continuations are a
+ * lock-free stack of callback_nodes, closed with a sentinel when the
+ * state becomes ready. A reference count keeps the state alive for the
+ * promise, the futures, and pending continuations.
+ */
+class state_base {
+public:
+    state_base(): word_(empty), refs_(1), callbacks_(nullptr), satisfied_(false),
+        retrieved_(false), deferred_(none), async_(false) {}
+
+    virtual ~state_base() {}
+
+    state_base(const state_base&) = delete;
+    state_base& operator=(const state_base&) = delete;
+
+    void add_ref() { refs_.fetch_add(1, std::memory_order_relaxed); }
+
+    void release()
+    {
+        if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete this;
+    }
+
+    bool is_ready() const { return word_.load(std::memory_order_acquire) == ready; }
+
+    /** True for the state of a deferred async that has not run yet. */
+    bool is_deferred() const { return deferred_.load(std::memory_order_acquire) == pending; }
+
+    /** True for the state of an async on its own thread: the last future waits for it. */
+    bool is_async() const { return async_; }
+
+    /** Blocks until the result is in, first running the function of a deferred async. */
+    void wait()
+    {
+        run_if_deferred();
+        if (is_ready())
+            return;
+        for (int i = 0; i < spin_count; i++) {
+            cpu_relax();
+            if (is_ready())
+                return;
+        }
+        for (;;) {
+            int w = word_.load(std::memory_order_acquire);
+            if (w == ready)
+                return;
+            if (w == empty && !word_.compare_exchange_weak(w, waiting, std::memory_order_acquire))
+                continue;
+            sleep(nullptr);
+        }
+    }
+
+    /** Blocks until the result is in or deadline passes. */
+    future_status wait_until(std::chrono::steady_clock::time_point deadline)
+    {
+        using namespace std::chrono;
+        if (is_deferred())
+            return future_status::deferred;
+        for (;;) {
+            int w = word_.load(std::memory_order_acquire);
+            if (w == ready)
+                return future_status::ready;
+            steady_clock::duration left = deadline-steady_clock::now();
+            if (left <= steady_clock::duration::zero())
+                return future_status::timeout;
+            if (w == empty && !word_.compare_exchange_weak(w, waiting, std::memory_order_acquire))
+                continue;
+            seconds sec = duration_cast<seconds>(left);
+            nanoseconds nsec = duration_cast<nanoseconds>(left-sec);
+            struct timespec ts;
+            ts.tv_sec = sec.count();
+            ts.tv_nsec = nsec.count();
+            sleep(&ts);
+        }
+    }
+
+    /**
+     * Runs node once the state is ready: now, on this thread, if it
+     * already is. A deferred async runs first, on this thread.
+     */
+    void add_callback(callback_node* node)
+    {
+        run_if_deferred();
+        callback_node* head = callbacks_.load(std::memory_order_acquire);
+        for (;;) {
+            if (head == closed()) {
+                node->run();
+                return;
+            }
+            node->next = head;
+            if (callbacks_.compare_exchange_weak(head, node, std::memory_order_acq_rel, std::memory_order_acquire))
+                return;
+        }
+    }
+
+    /** The promise side: claims the one right to store a result. */
+    void claim()
+    {
+        if (satisfied_.exchange(true, std::memory_order_relaxed))
+            throw std::future_error(std::future_errc::promise_already_satisfied);
+    }
+
+    /** Gives back a claim whose result could not be stored, e.g. because T's constructor threw. */
+    void unclaim() { satisfied_.store(false, std::memory_order_relaxed); }
+
+    bool satisfied() const { return satisfied_.load(std::memory_order_relaxed); }
+
+    /** The promise side: claims the one right to hand out a future. */
+    void retrieve()
+    {
+        if (retrieved_.exchange(true, std::memory_order_relaxed))
+            throw std::future_error(std::future_errc::future_already_retrieved);
+    }
+
+    /** After claim(): stores an exception as the result. */
+    void store_exception(std::exception_ptr e)
+    {
+        error_ = e;
+        make_ready();
+    }
+
+    void set_exception(std::exception_ptr e)
+    {
+        claim();
+        store_exception(e);
+    }
+
+    /**
+     * The promise side lets go of the state; if it never stored a result,
+     * broken_promise becomes the result.
+     */
+    void abandon()
+    {
+        if (!satisfied_.exchange(true, std::memory_order_relaxed))
+            store_exception(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+        release();
+    }
+
+    /** Rethrows the stored exception, if any; the state must be ready. */
+    void rethrow_if_error() const
+    {
+        if (error_)
+            std::rethrow_exception(error_);
+    }
+
+protected:
+    static const int empty = 0;
+    static const int waiting = 1;
+    static const int ready = 2;
+
+    static const int none = 0;
+    static const int pending = 1;
+    static const int taken = 2;
+
+    static const int spin_count = 32;
+
+    /** Publishes the stored result: wakes the sleepers, runs the continuations. */
+    void make_ready() noexcept
+    {
+        if (word_.exchange(ready, std::memory_order_acq_rel) == waiting)
+            wake_all();
+        callback_node* list = callbacks_.exchange(closed(), std::memory_order_acq_rel);
+        // the stack has the newest first; run them in the order they came
+        callback_node* fifo = nullptr;
+        while (list != nullptr) {
+            callback_node* next = list->next;
+            list->next = fifo;
+            fifo = list;
+            list = next;
+        }
+        while (fifo != nullptr) {
+            callback_node* next = fifo->next;
+            fifo->run();
+            fifo = next;
+        }
+    }
+
+    void set_deferred() { deferred_.store(pending, std::memory_order_relaxed); }
+    void set_async() { async_ = true; }
+
+    /** A deferred async's function, run by the first thread to wait. */
+    virtual void run_deferred() {}
+
+private:
+    static callback_node* closed()
+    {
+        static char sentinel;
+        return reinterpret_cast<callback_node*>(&sentinel);
+    }
+
+    void run_if_deferred()
+    {
+        int d = pending;
+        if (deferred_.load(std::memory_order_acquire) == pending &&
+                deferred_.compare_exchange_strong(d, taken, std::memory_order_acq_rel))
+            run_deferred();
+    }
+
+    void sleep(const struct timespec* timeout)
+    {
+#if defined(__linux__)
+        futex_wait(&word_, waiting, timeout);
+#else
+        (void) timeout;
+        std::this_thread::yield();
+#endif
+    }
+
+    void wake_all()
+    {
+#if defined(__linux__)
+        futex_wake(&word_, INT_MAX);
+#endif
+    }
+
+    std::atomic<int> word_;                     // empty, waiting or ready; the futex word
+    std::atomic<int> refs_;
+    std::atomic<callback_node*> callbacks_;     // pending continuations, or closed()
+    std::atomic<bool> satisfied_;               // a result has been claimed
+    std::atomic<bool> retrieved_;               // the future has been handed out
+    std::atomic<int> deferred_;                 // none, pending or taken
+    bool async_;
+    std::exception_ptr error_;
+};
+
+/** Where a shared state keeps its value: in place, as a pointer for T&, or nowhere for void. */
+template <typename T>
+class value_box {
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_;
+    bool full_;
+
+public:
+    value_box(): full_(false) {}
+    ~value_box() { if (full_) get().~T(); }
+
+    template <typename... Args>
+    void construct(Args&&... args)
+    {
+        ::new (static_cast<void*>(&storage_)) T(std::forward<Args>(args)...);
+        full_ = true;
+    }
+
+    T& get() { return *reinterpret_cast<T*>(&storage_); }
+};
+
+template <typename T>
+class value_box<T&> {
+    T* p_;
+
+public:
+    value_box(): p_(nullptr) {}
+    void construct(T& r) { p_ = &r; }
+    T& get() { return *p_; }
+};
+
+template <>
+class value_box<void> {
+public:
+    void construct() {}
+    void get() {}
+};
+
+/** Lets a unique_ptr hold a reference to a shared state. */
+struct state_releaser {
+    void operator()(state_base* state) const { state->release(); }
+};
+
+/** The shared state with a T result. */
+template <typename T>
+class shared_state: public state_base {
+    value_box<T> box_;
+
+public:
+    /** After claim(): stores the value. */
+    template <typename... Args>
+    void emplace_value(Args&&... args)
+    {
+        box_.construct(std::forward<Args>(args)...);
+        make_ready();
+    }
+
+    /**
+     * Claims the state and stores the value; if constructing the value
+     * throws, the state stays unsatisfied, so that the promise can try
+     * again or, abandoned, break.
+     */
+    template <typename... Args>
+    void set_value(Args&&... args)
+    {
+        claim();
+        try {
+            emplace_value(std::forward<Args>(args)...);
+        } catch (...) {
+            unclaim();
+            throw;
+        }
+    }
+
+    /** Waits for the result; returns the value or rethrows the exception. */
+    typename std::add_lvalue_reference<T>::type get()
+    {
+        wait();
+        rethrow_if_error();
+        return box_.get();
+    }
+};
+
+/**
+ * Calls f(args...) and stores what it returns, or what it throws, in a
+ * state already claimed.
+ */
+template <typename R>
+struct invoke_and_store {
+    template <typename F, typename... Args>
+    static void run(shared_state<R>& state, F& f, Args&&... args)
+    {
+        try {
+            state.emplace_value(f(std::forward<Args>(args)...));
+        } catch (...) {
+            state.store_exception(std::current_exception());
+        }
+    }
+};
+
+template <>
+struct invoke_and_store<void> {
+    template <typename F, typename... Args>
+    static void run(shared_state<void>& state, F& f, Args&&... args)
+    {
+        try {
+            f(std::forward<Args>(args)...);
+        } catch (...) {
+            state.store_exception(std::current_exception());
+            return;
+        }
+        state.emplace_value();
+    }
+};
+
+}    // namespace detail
+
+}    // namespace Hx
+
+#endif
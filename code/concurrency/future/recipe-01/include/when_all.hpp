@@ -0,0 +1,225 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_WHEN_ALL_INC
+#define MINI_STL_WHEN_ALL_INC
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "future.hpp"
+#include "integer_sequence.hpp"
+
+namespace Hx {
+
+/** What the future of when_any holds: the futures, and which of them was ready first. */
+template <typename Sequence>
+struct when_any_result {
+    size_t index;
+    Sequence futures;
+};
+
+namespace detail {
+
+/**
+ * The shared state of a when_all or when_any: owns the futures until it
+ * hands them over as its value, and counts down the events it still
+ * waits for. Every future gets a callback that holds a reference to the
+ * aggregate; the aggregate also waits for its own set-up to finish, so
+ * that no callback can hand the futures over while they are still being
+ * attached to.
+ */
+template <typename Sequence, typename Result>
+class aggregate_state: public shared_state<Result> {
+public:
+    explicit aggregate_state(Sequence&& futures, size_t pending):
+        futures_(std::move(futures)), pending_(pending) {}
+
+    /** Counts one event down; the last one publishes the result. */
+    void arrive()
+    {
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            this->emplace_value(make_result());
+    }
+
+    const Sequence& futures() const { return futures_; }
+
+protected:
+    virtual Result make_result() = 0;
+
+    Sequence futures_;
+
+private:
+    std::atomic<size_t> pending_;
+};
+
+/** Calls on_ready(index) on an aggregate once a future is ready. */
+template <typename Aggregate>
+class aggregate_node: public callback_node {
+    Aggregate* aggregate_;          // one reference
+    size_t index_;
+
+public:
+    aggregate_node(Aggregate* aggregate, size_t index): aggregate_(aggregate), index_(index)
+    {
+        aggregate_->add_ref();
+    }
+
+    virtual void run() noexcept
+    {
+        aggregate_->on_ready(index_);
+        aggregate_->release();
+        delete this;
+    }
+};
+
+/** Waits for every future, then for its own set-up. */
+template <typename Sequence>
+class when_all_state: public aggregate_state<Sequence, Sequence> {
+public:
+    when_all_state(Sequence&& futures, size_t n):
+        aggregate_state<Sequence, Sequence>(std::move(futures), n+1) {}
+
+    void on_ready(size_t) { this->arrive(); }
+
+private:
+    virtual Sequence make_result() { return std::move(this->futures_); }
+};
+
+/**
+ * Waits for the first future to be ready, and for its own set-up; with
+ * no futures at all, only for the set-up.
+ */
+template <typename Sequence>
+class when_any_state: public aggregate_state<Sequence, when_any_result<Sequence>> {
+public:
+    when_any_state(Sequence&& futures, size_t n):
+        aggregate_state<Sequence, when_any_result<Sequence>>(std::move(futures), n == 0 ? 1 : 2),
+        first_(false), index_(size_t(-1)) {}
+
+    void on_ready(size_t index)
+    {
+        if (!first_.exchange(true, std::memory_order_relaxed)) {
+            index_ = index;
+            this->arrive();
+        }
+    }
+
+private:
+    virtual when_any_result<Sequence> make_result()
+    {
+        when_any_result<Sequence> r;
+        r.index = index_;
+        r.futures = std::move(this->futures_);
+        return r;
+    }
+
+    std::atomic<bool> first_;
+    size_t index_;
+};
+
+template <typename Aggregate, typename Future>
+inline void attach(Aggregate* aggregate, const Future& f, size_t index)
+{
+    future_access::state(f)->add_callback(new aggregate_node<Aggregate>(aggregate, index));
+}
+
+/** Attaches to every future of a vector, then arrives for the set-up. */
+template <typename Aggregate, typename Sequence>
+void attach_all(Aggregate* aggregate, const Sequence& futures)
+{
+    for (size_t i = 0; i < futures.size(); i++)
+        attach(aggregate, futures[i], i);
+    aggregate->arrive();
+}
+
+/** The same for a tuple. */
+template <typename Aggregate, typename Sequence, size_t... I>
+void attach_all(Aggregate* aggregate, const Sequence& futures, index_sequence<I...>)
+{
+    int expand[] = {0, (attach(aggregate, std::get<I>(futures), I), 0)...};
+    (void) expand;
+    aggregate->arrive();
+}
+
+template <typename InputIterator>
+std::vector<typename std::iterator_traits<InputIterator>::value_type>
+take_futures(InputIterator first, InputIterator last)
+{
+    std::vector<typename std::iterator_traits<InputIterator>::value_type> futures;
+    for (; first != last; ++first) {
+        if (!first->valid())
+            throw std::future_error(std::future_errc::no_state);
+        futures.push_back(std::move(*first));
+    }
+    return futures;
+}
+
+}    // namespace detail
+
+/**
+ * Returns a future of the futures in [first, last), moved in, which is
+ * ready once all of them are.
+ */
+template <typename InputIterator>
+future<std::vector<typename std::iterator_traits<InputIterator>::value_type>>
+when_all(InputIterator first, InputIterator last)
+{
+    typedef std::vector<typename std::iterator_traits<InputIterator>::value_type> Sequence;
+    Sequence futures = detail::take_futures(first, last);
+    size_t n = futures.size();
+    detail::when_all_state<Sequence>* state = new detail::when_all_state<Sequence>(std::move(futures), n);
+    future<Sequence> result = detail::future_access::make<future<Sequence>>(state);
+    detail::attach_all(state, state->futures());
+    return result;
+}
+
+/** Returns a future of a tuple of the futures, ready once all of them are. */
+template <typename... Futures>
+future<std::tuple<typename std::decay<Futures>::type...>> when_all(Futures&&... fs)
+{
+    typedef std::tuple<typename std::decay<Futures>::type...> Sequence;
+    detail::when_all_state<Sequence>* state =
+        new detail::when_all_state<Sequence>(Sequence(std::forward<Futures>(fs)...), sizeof...(Futures));
+    future<Sequence> result = detail::future_access::make<future<Sequence>>(state);
+    detail::attach_all(state, state->futures(), make_index_sequence<sizeof...(Futures)>());
+    return result;
+}
+
+/**
+ * Returns a future of the futures in [first, last), moved in, and the
+ * index of the first one to be ready; size_t(-1) if there are none.
+ */
+template <typename InputIterator>
+future<when_any_result<std::vector<typename std::iterator_traits<InputIterator>::value_type>>>
+when_any(InputIterator first, InputIterator last)
+{
+    typedef std::vector<typename std::iterator_traits<InputIterator>::value_type> Sequence;
+    Sequence futures = detail::take_futures(first, last);
+    size_t n = futures.size();
+    detail::when_any_state<Sequence>* state = new detail::when_any_state<Sequence>(std::move(futures), n);
+    future<when_any_result<Sequence>> result = detail::future_access::make<future<when_any_result<Sequence>>>(state);
+    detail::attach_all(state, state->futures());
+    return result;
+}
+
+/** The same for a tuple of futures. */
+template <typename... Futures>
+future<when_any_result<std::tuple<typename std::decay<Futures>::type...>>> when_any(Futures&&... fs)
+{
+    typedef std::tuple<typename std::decay<Futures>::type...> Sequence;
+    detail::when_any_state<Sequence>* state =
+        new detail::when_any_state<Sequence>(Sequence(std::forward<Futures>(fs)...), sizeof...(Futures));
+    future<when_any_result<Sequence>> result = detail::future_access::make<future<when_any_result<Sequence>>>(state);
+    detail::attach_all(state, state->futures(), make_index_sequence<sizeof...(Futures)>());
+    return result;
+}
+
+}    // namespace Hx
+
+#endif
@@ -0,0 +1,135 @@
+// Hx::future against std::future; see "bench.hpp" for the options.
+//   round_trip   ping-pong between the main thread and a worker: each
+//                side sets a promise and gets the other's future; arg
+//                pairs per iteration
+//   ready        promise, get_future, set_value and get on one thread
+//   outstanding  arg futures created and left waiting, then fulfilled,
+//                then got: the footprint of a million shared states
+//   then         a chain of arg continuations, run on set_value (Hx only)
+//   async        async(launch::async) and get, a thread each
+#include <future>
+#include <thread>
+#include <vector>
+#include "future.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+struct std_future {
+    template <typename T> using promise = std::promise<T>;
+    template <typename T> using future = std::future<T>;
+
+    template <typename F>
+    static std::future<int> async(F f) { return std::async(std::launch::async, f); }
+};
+
+struct hx_future {
+    template <typename T> using promise = Hx::promise<T>;
+    template <typename T> using future = Hx::future<T>;
+
+    template <typename F>
+    static Hx::future<int> async(F f) { return Hx::async(Hx::launch::async, f); }
+};
+
+template <typename Impl>
+void round_trip(state& st)
+{
+    const long n = st.arg();
+    while (st.keep_running()) {
+        st.pause_timing();
+        std::vector<typename Impl::template promise<int>> ping(n), pong(n);
+        std::vector<typename Impl::template future<int>> ping_f, pong_f;
+        for (long i = 0; i < n; i++) {
+            ping_f.push_back(ping[i].get_future());
+            pong_f.push_back(pong[i].get_future());
+        }
+        std::thread worker([&] {
+            for (long i = 0; i < n; i++)
+                pong[i].set_value(ping_f[i].get()+1);
+        });
+        st.resume_timing();
+
+        long sum = 0;
+        for (long i = 0; i < n; i++) {
+            ping[i].set_value(int(i));
+            sum += pong_f[i].get();
+        }
+        do_not_optimize(sum);
+
+        st.pause_timing();
+        worker.join();
+        st.resume_timing();
+    }
+    st.set_items_per_iteration(n);
+}
+
+template <typename Impl>
+void ready(state& st)
+{
+    while (st.keep_running()) {
+        typename Impl::template promise<int> p;
+        typename Impl::template future<int> f = p.get_future();
+        p.set_value(1);
+        do_not_optimize(f.get());
+    }
+}
+
+template <typename Impl>
+void outstanding(state& st)
+{
+    const long n = st.arg();
+    while (st.keep_running()) {
+        std::vector<typename Impl::template promise<int>> promises(n);
+        std::vector<typename Impl::template future<int>> futures;
+        futures.reserve(n);
+        for (long i = 0; i < n; i++)
+            futures.push_back(promises[i].get_future());
+        for (long i = 0; i < n; i++)
+            promises[i].set_value(int(i));
+        long sum = 0;
+        for (long i = 0; i < n; i++)
+            sum += futures[i].get();
+        do_not_optimize(sum);
+    }
+    st.set_items_per_iteration(n);
+}
+
+void then_chain(state& st)
+{
+    const long n = st.arg();
+    while (st.keep_running()) {
+        Hx::promise<int> p;
+        Hx::future<int> f = p.get_future();
+        for (long i = 0; i < n; i++)
+            f = f.then([](Hx::future<int> x) { return x.get()+1; });
+        p.set_value(0);
+        do_not_optimize(f.get());
+    }
+    st.set_items_per_iteration(n);
+}
+
+template <typename Impl>
+void async(state& st)
+{
+    while (st.keep_running())
+        do_not_optimize(Impl::async([] { return 1; }).get());
+}
+
+int main(int argc, char* argv[])
+{
+    // glibc skips lock prefixes until a second thread has existed
+    std::thread([] {}).join();
+
+    Hx::bench::suite s("future");
+    s.add("round_trip", "std", round_trip<std_future>).args({1000});
+    s.add("round_trip", "Hx", round_trip<hx_future>).args({1000});
+    s.add("ready", "std", ready<std_future>);
+    s.add("ready", "Hx", ready<hx_future>);
+    s.add("outstanding", "std", outstanding<std_future>).args({1 << 20});
+    s.add("outstanding", "Hx", outstanding<hx_future>).args({1 << 20});
+    s.add("then", "Hx", then_chain).args({1, 16});
+    s.add("async", "std", async<std_future>);
+    s.add("async", "Hx", async<hx_future>);
+    return s.run(argc, argv);
+}
@@ -0,0 +1,37 @@
+// async example
+#include <iostream>       // std::cout
+#include "future.hpp"     // Hx::async, Hx::future, Hx::launch
+
+// a non-optimized way of checking for prime numbers:
+bool is_prime (int x) {
+  for (int i=2; i<x; ++i) if (x%i==0) return false;
+  return true;
+}
+
+int main ()
+{
+  // call function asynchronously:
+  Hx::future<bool> fut = Hx::async (Hx::launch::async, is_prime, 444444443);
+
+  std::cout << "checking, please wait\n";
+  bool x = fut.get();     // waits for is_prime to return
+
+  std::cout << "444444443 " << (x?"is":"is not") << " prime.\n";
+
+  // a deferred call runs on the first wait, in the waiting thread
+  int calls = 0;
+  Hx::future<int> lazy = Hx::async (Hx::launch::deferred, [&calls] { return ++calls; });
+  std::cout << "calls before get: " << calls << '\n';
+  std::cout << "get: " << lazy.get() << ", calls after get: " << calls << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+checking, please wait
+444444443 is prime.
+calls before get: 0
+get: 1, calls after get: 1
+*/
@@ -0,0 +1,59 @@
+// packaged_task example
+#include <iostream>     // std::cout
+#include <utility>      // std::move
+#include "thread.hpp"   // Hx::thread
+#include "future.hpp"   // Hx::packaged_task, Hx::future
+
+// count down taking a second for each value:
+int countdown (int from, int to) {
+  for (int i=from; i!=to; --i) {
+    std::cout << i << '\n';
+  }
+  std::cout << "Lift off!\n";
+  return from-to;
+}
+
+int main ()
+{
+  Hx::packaged_task<int(int,int)> tsk (countdown);   // set up packaged_task
+  Hx::future<int> ret = tsk.get_future();            // get future
+
+  Hx::thread th (std::move(tsk),10,0);   // spawn thread to count down from 10 to 0
+
+  // ...
+
+  int value = ret.get();                  // wait for the task to finish and get result
+
+  std::cout << "The countdown lasted for " << value << " seconds.\n";
+
+  th.join();
+
+  // reset() gives the task a new shared state, so that it can run again
+  Hx::packaged_task<int(int)> square ([](int x) { return x*x; });
+  Hx::future<int> f1 = square.get_future();
+  square(3);
+  square.reset();
+  Hx::future<int> f2 = square.get_future();
+  square(4);
+  std::cout << f1.get() << ' ' << f2.get() << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+10
+9
+8
+7
+6
+5
+4
+3
+2
+1
+Lift off!
+The countdown lasted for 10 seconds.
+9 16
+*/
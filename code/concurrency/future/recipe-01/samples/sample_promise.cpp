@@ -0,0 +1,56 @@
+// promise example
+#include <iostream>       // std::cout
+#include <functional>     // std::ref
+#include <stdexcept>      // std::runtime_error
+#include "thread.hpp"     // Hx::thread
+#include "future.hpp"     // Hx::promise, Hx::future
+
+void print_int (Hx::future<int>& fut) {
+  int x = fut.get();
+  std::cout << "value: " << x << '\n';
+}
+
+int main ()
+{
+  Hx::promise<int> prom;                      // create promise
+
+  Hx::future<int> fut = prom.get_future();    // engagement with future
+
+  Hx::thread th1 (print_int, std::ref(fut));  // send future to new thread
+
+  prom.set_value (10);                        // fulfill promise
+                                              // (synchronizes with getting the future)
+  th1.join();
+
+  // an exception travels to the future the same way
+  Hx::promise<int> prom2;
+  Hx::future<int> fut2 = prom2.get_future();
+  prom2.set_exception(std::make_exception_ptr(std::runtime_error("no value")));
+  try {
+    fut2.get();
+  } catch (std::exception& e) {
+    std::cout << "caught: " << e.what() << '\n';
+  }
+
+  // a promise destroyed without a result breaks it
+  Hx::future<int> fut3;
+  {
+    Hx::promise<int> prom3;
+    fut3 = prom3.get_future();
+  }
+  try {
+    fut3.get();
+  } catch (std::future_error& e) {
+    std::cout << "broken promise: " << (e.code() == std::future_errc::broken_promise) << '\n';
+  }
+
+  return 0;
+}
+
+/*
+Output:
+
+value: 10
+caught: no value
+broken promise: 1
+*/
@@ -0,0 +1,33 @@
+// shared_future example
+#include <iostream>       // std::cout
+#include <vector>         // std::vector
+#include "thread.hpp"     // Hx::thread
+#include "future.hpp"     // Hx::promise, Hx::shared_future
+
+int main ()
+{
+  Hx::promise<int> prom;
+  Hx::shared_future<int> fut = prom.get_future().share();
+
+  // every thread waits on its own copy of the same shared state
+  std::vector<int> results(4);
+  std::vector<Hx::thread> threads;
+  for (int i = 0; i < 4; i++)
+    threads.push_back(Hx::thread([fut, i, &results] { results[i] = fut.get() * (i+1); }));
+
+  prom.set_value(10);
+  for (auto& th : threads) th.join();
+
+  for (int r : results) std::cout << r << ' ';
+  std::cout << '\n';
+  std::cout << "still valid: " << fut.valid() << ", value: " << fut.get() << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+10 20 30 40 
+still valid: 1, value: 10
+*/
@@ -0,0 +1,48 @@
+// future::then example
+#include <iostream>       // std::cout
+#include <string>         // std::string, std::to_string
+#include <stdexcept>      // std::runtime_error
+#include "future.hpp"     // Hx::promise, Hx::future
+
+int main ()
+{
+  Hx::promise<int> prom;
+
+  // each continuation gets the ready future of the previous step and
+  // runs on the thread that makes it ready
+  Hx::future<std::string> fut = prom.get_future()
+    .then([](Hx::future<int> f) { return f.get() * 2; })
+    .then([](Hx::future<int> f) { return "answer: " + std::to_string(f.get()); });
+
+  std::cout << "ready before set_value: " << fut.is_ready() << '\n';
+  prom.set_value(21);
+  std::cout << "ready after set_value: " << fut.is_ready() << '\n';
+  std::cout << fut.get() << '\n';
+
+  // an exception passes down the chain until a continuation handles it
+  Hx::promise<int> prom2;
+  Hx::future<int> fut2 = prom2.get_future()
+    .then([](Hx::future<int> f) { return f.get() + 1; })
+    .then([](Hx::future<int> f) {
+      try {
+        return f.get();
+      } catch (std::exception& e) {
+        std::cout << "recovered from: " << e.what() << '\n';
+        return -1;
+      }
+    });
+  prom2.set_exception(std::make_exception_ptr(std::runtime_error("bad input")));
+  std::cout << fut2.get() << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+ready before set_value: 0
+ready after set_value: 1
+answer: 42
+recovered from: bad input
+-1
+*/
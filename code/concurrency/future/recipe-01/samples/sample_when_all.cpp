@@ -0,0 +1,52 @@
+// when_all and when_any example
+#include <iostream>       // std::cout
+#include <tuple>          // std::get
+#include <vector>         // std::vector
+#include "thread.hpp"     // Hx::thread
+#include "future.hpp"     // Hx::promise, Hx::future
+#include "when_all.hpp"   // Hx::when_all, Hx::when_any
+
+int main ()
+{
+  // when_all over a range: a future of the vector of futures
+  std::vector<Hx::promise<int>> proms(3);
+  std::vector<Hx::future<int>> futs;
+  for (auto& p : proms) futs.push_back(p.get_future());
+
+  Hx::future<std::vector<Hx::future<int>>> all = Hx::when_all(futs.begin(), futs.end());
+  Hx::thread th([&proms] {
+    for (int i = 0; i < 3; i++) proms[i].set_value((i+1)*100);
+  });
+  std::vector<Hx::future<int>> done = all.get();
+  th.join();
+  int sum = 0;
+  for (auto& f : done) sum += f.get();
+  std::cout << "sum: " << sum << '\n';
+
+  // when_all over a list of futures of different types: a tuple
+  Hx::promise<int> pi;
+  Hx::promise<std::string> ps;
+  auto both = Hx::when_all(pi.get_future(), ps.get_future());
+  ps.set_value("two");
+  pi.set_value(1);
+  auto t = both.get();
+  std::cout << std::get<0>(t).get() << ' ' << std::get<1>(t).get() << '\n';
+
+  // when_any: the futures, and which was ready first
+  Hx::promise<int> p1, p2;
+  auto any = Hx::when_any(p1.get_future(), p2.get_future());
+  p2.set_value(2);
+  auto r = any.get();
+  std::cout << "first ready: " << r.index << ", value: " << std::get<1>(r.futures).get() << '\n';
+  p1.set_value(1);
+
+  return 0;
+}
+
+/*
+Output:
+
+sum: 600
+1 two
+first ready: 1, value: 2
+*/
@@ -0,0 +1,442 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_LOCK_PROFILER_INC
+#define MINI_STL_LOCK_PROFILER_INC
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Hx {
+
+#if defined(HX_LOCK_PROFILING)
+constexpr bool lock_profiling_enabled = true;
+#else
+constexpr bool lock_profiling_enabled = false;
+#endif
+
+/** The counters of one lock at one moment, as lock_registry::snapshot returns them. */
+struct lock_snapshot {
+    std::string name;
+    const void* address;
+    unsigned long long acquisitions;            // exclusive
+    unsigned long long contended;               // exclusive acquisitions that had to wait
+    unsigned long long failed;                  // try_lock, try_lock_for and try_lock_until that gave up
+    unsigned long long total_wait_ns;
+    unsigned long long max_wait_ns;
+    unsigned long long total_hold_ns;
+    unsigned long long max_hold_ns;
+    unsigned long long shared_acquisitions;
+    unsigned long long shared_contended;
+    unsigned long long shared_total_wait_ns;
+    unsigned long long shared_max_wait_ns;
+};
+
+/**
+ * The contention statistics of one lock: relaxed atomic counters, which
+ * the threads that use the lock update and anybody may read.
+ */
+class lock_stats {
+public:
+    lock_stats(const char* name, const void* address):
+        name_(name != nullptr ? name : ""), address_(address), prev_(nullptr), next_(nullptr)
+    {
+        reset();
+    }
+
+    lock_stats(const lock_stats&) = delete;
+    lock_stats& operator=(const lock_stats&) = delete;
+
+    const std::string& name() const { return name_; }
+    const void* address() const { return address_; }
+
+    unsigned long long acquisitions() const { return acquisitions_.load(std::memory_order_relaxed); }
+    unsigned long long contended() const { return contended_.load(std::memory_order_relaxed); }
+    unsigned long long failed() const { return failed_.load(std::memory_order_relaxed); }
+    unsigned long long total_wait_ns() const { return total_wait_ns_.load(std::memory_order_relaxed); }
+    unsigned long long max_wait_ns() const { return max_wait_ns_.load(std::memory_order_relaxed); }
+    unsigned long long total_hold_ns() const { return total_hold_ns_.load(std::memory_order_relaxed); }
+    unsigned long long max_hold_ns() const { return max_hold_ns_.load(std::memory_order_relaxed); }
+    unsigned long long shared_acquisitions() const { return shared_acquisitions_.load(std::memory_order_relaxed); }
+    unsigned long long shared_contended() const { return shared_contended_.load(std::memory_order_relaxed); }
+
+    void record_acquire() { acquisitions_.fetch_add(1, std::memory_order_relaxed); }
+
+    void record_contended_acquire(unsigned long long wait_ns)
+    {
+        acquisitions_.fetch_add(1, std::memory_order_relaxed);
+        contended_.fetch_add(1, std::memory_order_relaxed);
+        total_wait_ns_.fetch_add(wait_ns, std::memory_order_relaxed);
+        raise(max_wait_ns_, wait_ns);
+    }
+
+    void record_failure(unsigned long long wait_ns)
+    {
+        failed_.fetch_add(1, std::memory_order_relaxed);
+        total_wait_ns_.fetch_add(wait_ns, std::memory_order_relaxed);
+        raise(max_wait_ns_, wait_ns);
+    }
+
+    void record_hold(unsigned long long hold_ns)
+    {
+        total_hold_ns_.fetch_add(hold_ns, std::memory_order_relaxed);
+        raise(max_hold_ns_, hold_ns);
+    }
+
+    void record_shared_acquire() { shared_acquisitions_.fetch_add(1, std::memory_order_relaxed); }
+
+    void record_shared_contended_acquire(unsigned long long wait_ns)
+    {
+        shared_acquisitions_.fetch_add(1, std::memory_order_relaxed);
+        shared_contended_.fetch_add(1, std::memory_order_relaxed);
+        shared_total_wait_ns_.fetch_add(wait_ns, std::memory_order_relaxed);
+        raise(shared_max_wait_ns_, wait_ns);
+    }
+
+    lock_snapshot snapshot() const
+    {
+        lock_snapshot s;
+        s.name = name_;
+        s.address = address_;
+        s.acquisitions = acquisitions();
+        s.contended = contended();
+        s.failed = failed();
+        s.total_wait_ns = total_wait_ns();
+        s.max_wait_ns = max_wait_ns();
+        s.total_hold_ns = total_hold_ns();
+        s.max_hold_ns = max_hold_ns();
+        s.shared_acquisitions = shared_acquisitions();
+        s.shared_contended = shared_contended();
+        s.shared_total_wait_ns = shared_total_wait_ns_.load(std::memory_order_relaxed);
+        s.shared_max_wait_ns = shared_max_wait_ns_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void reset()
+    {
+        std::atomic<unsigned long long>* all[] = {&acquisitions_, &contended_, &failed_,
+            &total_wait_ns_, &max_wait_ns_, &total_hold_ns_, &max_hold_ns_,
+            &shared_acquisitions_, &shared_contended_, &shared_total_wait_ns_, &shared_max_wait_ns_};
+        for (size_t i = 0; i < sizeof(all)/sizeof(all[0]); i++)
+            all[i]->store(0, std::memory_order_relaxed);
+    }
+
+private:
+    friend class lock_registry;
+
+    static void raise(std::atomic<unsigned long long>& max, unsigned long long x)
+    {
+        unsigned long long m = max.load(std::memory_order_relaxed);
+        while (x > m && !max.compare_exchange_weak(m, x, std::memory_order_relaxed))
+            ;
+    }
+
+    const std::string name_;
+    const void* const address_;
+    std::atomic<unsigned long long> acquisitions_;
+    std::atomic<unsigned long long> contended_;
+    std::atomic<unsigned long long> failed_;
+    std::atomic<unsigned long long> total_wait_ns_;
+    std::atomic<unsigned long long> max_wait_ns_;
+    std::atomic<unsigned long long> total_hold_ns_;
+    std::atomic<unsigned long long> max_hold_ns_;
+    std::atomic<unsigned long long> shared_acquisitions_;
+    std::atomic<unsigned long long> shared_contended_;
+    std::atomic<unsigned long long> shared_total_wait_ns_;
+    std::atomic<unsigned long long> shared_max_wait_ns_;
+    lock_stats* prev_;              // the registry's list, under its mutex
+    lock_stats* next_;
+};
+
+/**
+ * Every profiled lock alive in the process, in a list under a plain
+ * std::mutex (taken when a lock is created or destroyed, and to dump);
+ * the counters of a lock go away with it.
+ */
+class lock_registry {
+public:
+    static lock_registry& instance()
+    {
+        static lock_registry registry;
+        return registry;
+    }
+
+    void add(lock_stats* s)
+    {
+        std::lock_guard<std::mutex> guard(mtx_);
+        s->prev_ = nullptr;
+        s->next_ = head_;
+        if (head_ != nullptr)
+            head_->prev_ = s;
+        head_ = s;
+    }
+
+    void remove(lock_stats* s)
+    {
+        std::lock_guard<std::mutex> guard(mtx_);
+        if (s->prev_ != nullptr)
+            s->prev_->next_ = s->next_;
+        else
+            head_ = s->next_;
+        if (s->next_ != nullptr)
+            s->next_->prev_ = s->prev_;
+    }
+
+    /** The counters of every lock, the most waited for first. */
+    std::vector<lock_snapshot> snapshot() const
+    {
+        std::vector<lock_snapshot> v;
+        {
+            std::lock_guard<std::mutex> guard(mtx_);
+            for (const lock_stats* s = head_; s != nullptr; s = s->next_)
+                v.push_back(s->snapshot());
+        }
+        std::stable_sort(v.begin(), v.end(), [](const lock_snapshot& a, const lock_snapshot& b) {
+            return a.total_wait_ns+a.shared_total_wait_ns > b.total_wait_ns+b.shared_total_wait_ns;
+        });
+        return v;
+    }
+
+    /** Zeroes every lock's counters. */
+    void reset()
+    {
+        std::lock_guard<std::mutex> guard(mtx_);
+        for (lock_stats* s = head_; s != nullptr; s = s->next_)
+            s->reset();
+    }
+
+    /** One line per lock, times in microseconds. */
+    void dump_text(std::ostream& os) const
+    {
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-24s %10s %10s %8s %12s %10s %12s %10s %10s %10s\n",
+            "lock", "acquired", "contended", "failed", "wait_us", "max_wait", "hold_us", "max_hold",
+            "shared", "shared_ctd");
+        os << line;
+        std::vector<lock_snapshot> v = snapshot();
+        for (size_t i = 0; i < v.size(); i++) {
+            const lock_snapshot& s = v[i];
+            std::snprintf(line, sizeof(line), "%-24s %10llu %10llu %8llu %12.1f %10.1f %12.1f %10.1f %10llu %10llu\n",
+                label(s).c_str(), s.acquisitions, s.contended, s.failed,
+                (s.total_wait_ns+s.shared_total_wait_ns)/1e3, std::max(s.max_wait_ns, s.shared_max_wait_ns)/1e3,
+                s.total_hold_ns/1e3, s.max_hold_ns/1e3, s.shared_acquisitions, s.shared_contended);
+            os << line;
+        }
+    }
+
+    /** {"locks": [{...}, ...]}, times in nanoseconds. */
+    void dump_json(std::ostream& os) const
+    {
+        std::vector<lock_snapshot> v = snapshot();
+        os << "{\"locks\": [";
+        for (size_t i = 0; i < v.size(); i++) {
+            const lock_snapshot& s = v[i];
+            char address[32];
+            std::snprintf(address, sizeof(address), "%p", s.address);
+            os << (i == 0 ? "\n" : ",\n")
+               << "  {\"name\": \"" << escape(s.name) << "\", \"address\": \"" << address << "\""
+               << ", \"acquisitions\": " << s.acquisitions
+               << ", \"contended\": " << s.contended
+               << ", \"failed\": " << s.failed
+               << ", \"total_wait_ns\": " << s.total_wait_ns
+               << ", \"max_wait_ns\": " << s.max_wait_ns
+               << ", \"total_hold_ns\": " << s.total_hold_ns
+               << ", \"max_hold_ns\": " << s.max_hold_ns
+               << ", \"shared_acquisitions\": " << s.shared_acquisitions
+               << ", \"shared_contended\": " << s.shared_contended
+               << ", \"shared_total_wait_ns\": " << s.shared_total_wait_ns
+               << ", \"shared_max_wait_ns\": " << s.shared_max_wait_ns << "}";
+        }
+        os << (v.empty() ? "]}\n" : "\n]}\n");
+    }
+
+private:
+    lock_registry(): head_(nullptr) {}
+
+    static std::string label(const lock_snapshot& s)
+    {
+        if (!s.name.empty())
+            return s.name;
+        char address[32];
+        std::snprintf(address, sizeof(address), "%p", s.address);
+        return address;
+    }
+
+    static std::string escape(const std::string& s)
+    {
+        std::string r;
+        for (size_t i = 0; i < s.size(); i++) {
+            unsigned char c = (unsigned char) s[i];
+            if (c == '"' || c == '\\') {
+                r += '\\';
+                r += char(c);
+            } else if (c < 0x20) {
+                char u[8];
+                std::snprintf(u, sizeof(u), "\\u%04x", c);
+                r += u;
+            } else {
+                r += char(c);
+            }
+        }
+        return r;
+    }
+
+    mutable std::mutex mtx_;
+    lock_stats* head_;
+};
+
+template <typename Mutex, bool Enabled>
+class basic_profiled;
+
+/**
+ * A Mutex (Hx::mutex, timed_mutex, recursive_mutex,
+ * recursive_timed_mutex, shared_mutex, or anything with the same
+ * members) that records its own contention in the lock_registry, under
+ * the name it was given.
+ * Every acquisition first tries the lock; only when that fails does it
+ * read steady_clock around the blocking call, and count the acquisition
+ * as contended. The time from acquisition (of the outermost level, for a
+ * recursive mutex) to unlock is the hold time; shared acquisitions are
+ * counted and timed when they wait, but their hold times are not kept.
+ * Only the members the program calls are instantiated, so the Mutex
+ * needs only those.
+ */
+template <typename Mutex>
+class basic_profiled<Mutex, true>: public Mutex {
+    typedef std::chrono::steady_clock clock;
+
+public:
+    explicit basic_profiled(const char* name = nullptr): stats_(name, this), depth_(0)
+    {
+        lock_registry::instance().add(&stats_);
+    }
+
+    ~basic_profiled() { lock_registry::instance().remove(&stats_); }
+
+    void lock()
+    {
+        if (Mutex::try_lock()) {
+            stats_.record_acquire();
+            held(clock::now());
+            return;
+        }
+        clock::time_point start = clock::now();
+        Mutex::lock();
+        clock::time_point now = clock::now();
+        stats_.record_contended_acquire(ns(now-start));
+        held(now);
+    }
+
+    bool try_lock()
+    {
+        if (!Mutex::try_lock()) {
+            stats_.record_failure(0);
+            return false;
+        }
+        stats_.record_acquire();
+        held(clock::now());
+        return true;
+    }
+
+    template <typename Rep, typename Period>
+    bool try_lock_for(const std::chrono::duration<Rep, Period>& rel_time)
+    {
+        return timed([&] { return Mutex::try_lock_for(rel_time); });
+    }
+
+    template <typename Clock, typename Duration>
+    bool try_lock_until(const std::chrono::time_point<Clock, Duration>& abs_time)
+    {
+        return timed([&] { return Mutex::try_lock_until(abs_time); });
+    }
+
+    void unlock()
+    {
+        // read the hold start before another thread can take the lock
+        if (--depth_ == 0)
+            stats_.record_hold(ns(clock::now()-hold_start_));
+        Mutex::unlock();
+    }
+
+    void lock_shared()
+    {
+        if (Mutex::try_lock_shared()) {
+            stats_.record_shared_acquire();
+            return;
+        }
+        clock::time_point start = clock::now();
+        Mutex::lock_shared();
+        stats_.record_shared_contended_acquire(ns(clock::now()-start));
+    }
+
+    bool try_lock_shared()
+    {
+        if (!Mutex::try_lock_shared()) {
+            stats_.record_failure(0);
+            return false;
+        }
+        stats_.record_shared_acquire();
+        return true;
+    }
+
+    const lock_stats& stats() const { return stats_; }
+
+private:
+    static unsigned long long ns(clock::duration d)
+    {
+        return (unsigned long long) std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    }
+
+    // the caller now owns the lock
+    void held(clock::time_point now)
+    {
+        if (depth_++ == 0)
+            hold_start_ = now;
+    }
+
+    template <typename Attempt>
+    bool timed(Attempt attempt)
+    {
+        if (Mutex::try_lock()) {
+            stats_.record_acquire();
+            held(clock::now());
+            return true;
+        }
+        clock::time_point start = clock::now();
+        bool locked = attempt();
+        clock::time_point now = clock::now();
+        if (!locked) {
+            stats_.record_failure(ns(now-start));
+            return false;
+        }
+        stats_.record_contended_acquire(ns(now-start));
+        held(now);
+        return true;
+    }
+
+    lock_stats stats_;
+    unsigned depth_;                    // recursion depth of the owner; only the owner touches it
+    clock::time_point hold_start_;      // likewise
+};
+
+/** Profiling off: the Mutex itself, plus a constructor that ignores the name. */
+template <typename Mutex>
+class basic_profiled<Mutex, false>: public Mutex {
+public:
+    explicit basic_profiled(const char* = nullptr) {}
+};
+
+/** A Mutex that is profiled when the program is built with HX_LOCK_PROFILING defined. */
+template <typename Mutex>
+using profiled = basic_profiled<Mutex, lock_profiling_enabled>;
+
+}    // namespace Hx
+
+#endif
@@ -0,0 +1,177 @@
+// What the lock profiler costs: the Hx mutex types by themselves, wrapped
+// with profiling off, and wrapped with it on; std::mutex for reference.
+// See "bench.hpp" for the options. The argument of the contended rows is
+// the number of threads sharing one mutex; every iteration they take it
+// 2^16 times in total.
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include "mutex.hpp"
+#include "recursive_mutex.hpp"
+#include "shared_mutex.hpp"
+#include "lock_profiler.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+const long ops_per_iteration = 1 << 16;
+
+// profiling off is the mutex itself
+static_assert(sizeof(Hx::basic_profiled<Hx::mutex, false>) == sizeof(Hx::mutex), "profiling off adds no state");
+static_assert(sizeof(Hx::basic_profiled<Hx::shared_mutex, false>) == sizeof(Hx::shared_mutex), "profiling off adds no state");
+
+template <typename Mutex> using off = Hx::basic_profiled<Mutex, false>;
+template <typename Mutex> using on = Hx::basic_profiled<Mutex, true>;
+
+/**
+ * threads - 1 helper threads that run a job together with the calling
+ * thread whenever run() is called.
+ */
+class crew {
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::vector<std::thread> threads_;
+    std::function<void()> job_;
+    unsigned long generation_ = 0;
+    long running_ = 0;
+    bool stop_ = false;
+
+public:
+    explicit crew(long threads)
+    {
+        for (long i = 1; i < threads; i++) {
+            threads_.push_back(std::thread([this] {
+                unsigned long seen = 0;
+                for (;;) {
+                    std::unique_lock<std::mutex> lock(mtx_);
+                    cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                    if (stop_)
+                        return;
+                    seen = generation_;
+                    lock.unlock();
+                    job_();
+                    lock.lock();
+                    if (--running_ == 0)
+                        cv_.notify_all();
+                }
+            }));
+        }
+    }
+
+    ~crew()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (size_t i = 0; i < threads_.size(); i++)
+            threads_[i].join();
+    }
+
+    void run(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            job_ = job;
+            running_ = long(threads_.size());
+            ++generation_;
+        }
+        cv_.notify_all();
+        job();
+        std::unique_lock<std::mutex> lock(mtx_);
+        cv_.wait(lock, [&] { return running_ == 0; });
+    }
+};
+
+template <typename Mutex>
+void uncontended(state& st)
+{
+    Mutex mtx;
+    long counter = 0;
+    while (st.keep_running()) {
+        mtx.lock();
+        counter++;
+        mtx.unlock();
+    }
+    do_not_optimize(&counter);
+}
+
+template <typename Mutex>
+void contended(state& st)
+{
+    const long threads = st.arg();
+    const long ops = ops_per_iteration / threads;
+    Mutex mtx;
+    long counter = 0;
+    crew c(threads);
+    while (st.keep_running()) {
+        c.run([&] {
+            for (long i = 0; i < ops; i++) {
+                mtx.lock();
+                counter++;
+                mtx.unlock();
+            }
+        });
+    }
+    do_not_optimize(&counter);
+    st.set_items_per_iteration(ops * threads);
+}
+
+template <typename Mutex>
+void recursive(state& st)
+{
+    Mutex mtx;
+    long counter = 0;
+    while (st.keep_running()) {
+        mtx.lock();
+        mtx.lock();
+        counter++;
+        mtx.unlock();
+        mtx.unlock();
+    }
+    do_not_optimize(&counter);
+}
+
+template <typename Mutex>
+void shared(state& st)
+{
+    Mutex mtx;
+    long counter = 0;
+    while (st.keep_running()) {
+        mtx.lock_shared();
+        counter++;
+        mtx.unlock_shared();
+    }
+    do_not_optimize(&counter);
+}
+
+int main(int argc, char* argv[])
+{
+    // glibc skips the atomic instructions of pthread_mutex_lock until the
+    // process starts its first thread; start one so that every row runs
+    // as in a threaded program
+    std::thread([] {}).join();
+
+    Hx::bench::suite s("lock_profiler");
+    s.add("mutex/uncontended", "std", uncontended<std::mutex>);
+    s.add("mutex/uncontended", "Hx", uncontended<Hx::mutex>);
+    s.add("mutex/uncontended", "off", uncontended<off<Hx::mutex>>);
+    s.add("mutex/uncontended", "on", uncontended<on<Hx::mutex>>);
+    s.add("mutex/contended", "std", contended<std::mutex>).args({2, 4, 16});
+    s.add("mutex/contended", "Hx", contended<Hx::mutex>).args({2, 4, 16});
+    s.add("mutex/contended", "off", contended<off<Hx::mutex>>).args({2, 4, 16});
+    s.add("mutex/contended", "on", contended<on<Hx::mutex>>).args({2, 4, 16});
+    s.add("recursive_mutex/depth2", "std", recursive<std::recursive_mutex>);
+    s.add("recursive_mutex/depth2", "Hx", recursive<Hx::recursive_mutex>);
+    s.add("recursive_mutex/depth2", "off", recursive<off<Hx::recursive_mutex>>);
+    s.add("recursive_mutex/depth2", "on", recursive<on<Hx::recursive_mutex>>);
+    s.add("shared_mutex/lock_shared", "Hx", shared<Hx::shared_mutex>);
+    s.add("shared_mutex/lock_shared", "off", shared<off<Hx::shared_mutex>>);
+    s.add("shared_mutex/lock_shared", "on", shared<on<Hx::shared_mutex>>);
+    return s.run(argc, argv);
+}
@@ -0,0 +1,73 @@
+// lock_profiler example (built with -DHX_LOCK_PROFILING)
+#include <atomic>             // std::atomic
+#include <chrono>             // std::chrono::milliseconds
+#include <iostream>           // std::cout
+#include <thread>             // std::thread, std::this_thread::sleep_for
+#include <vector>             // std::vector
+#include "mutex.hpp"          // Hx::mutex
+#include "recursive_mutex.hpp"// Hx::recursive_mutex
+#include "shared_mutex.hpp"   // Hx::shared_mutex
+#include "lock_profiler.hpp"  // Hx::profiled, Hx::lock_registry
+
+Hx::profiled<Hx::mutex> queue_mtx("queue");
+Hx::profiled<Hx::recursive_mutex> tree_mtx("tree");
+Hx::profiled<Hx::shared_mutex> table_mtx("table");
+
+int main ()
+{
+  // three times nobody else wants it
+  for (int i = 0; i < 3; i++) {
+    queue_mtx.lock();
+    queue_mtx.unlock();
+  }
+
+  // then another thread holds it for a while
+  std::atomic<bool> held(false);
+  std::thread th([&] {
+    queue_mtx.lock();
+    held = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue_mtx.unlock();
+  });
+  while (!held)
+    std::this_thread::yield();
+  if (!queue_mtx.try_lock())
+    std::cout << "queue is busy\n";
+  queue_mtx.lock();
+  queue_mtx.unlock();
+  th.join();
+
+  // a recursive mutex is held once, however deep
+  tree_mtx.lock();
+  tree_mtx.lock();
+  tree_mtx.unlock();
+  tree_mtx.unlock();
+
+  table_mtx.lock_shared();
+  table_mtx.lock_shared();
+  table_mtx.unlock_shared();
+  table_mtx.unlock_shared();
+  table_mtx.lock();
+  table_mtx.unlock();
+
+  // the most waited for first
+  std::vector<Hx::lock_snapshot> locks = Hx::lock_registry::instance().snapshot();
+  for (auto& s : locks) {
+    std::cout << s.name << ": " << s.acquisitions << " acquired, " << s.contended << " contended, "
+              << s.failed << " failed, " << s.shared_acquisitions << " shared";
+    if (s.max_wait_ns >= 10000000)
+      std::cout << ", waited 10ms or more";
+    std::cout << '\n';
+  }
+
+  return 0;
+}
+
+/*
+Output:
+
+queue is busy
+queue: 5 acquired, 1 contended, 1 failed, 0 shared, waited 10ms or more
+table: 1 acquired, 0 contended, 0 failed, 2 shared
+tree: 2 acquired, 0 contended, 0 failed, 0 shared
+*/
@@ -0,0 +1,61 @@
+// Hx::mutex against std::mutex; see "bench.hpp" for the options.
+// The argument is the number of threads contending for the mutex
+// (the timed one included).
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "mutex.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+template <typename Mutex>
+void lock_unlock(state& st)
+{
+    Mutex mtx;
+    long counter = 0;
+    std::atomic<bool> done(false);
+    std::vector<std::thread> others;
+    for (long i = 1; i < st.arg(); i++) {
+        others.push_back(std::thread([&]() {
+            while (!done.load(std::memory_order_relaxed)) {
+                mtx.lock();
+                counter++;
+                mtx.unlock();
+            }
+        }));
+    }
+
+    while (st.keep_running()) {
+        mtx.lock();
+        counter++;
+        mtx.unlock();
+    }
+
+    done = true;
+    for (size_t i = 0; i < others.size(); i++)
+        others[i].join();
+    do_not_optimize(counter);
+}
+
+template <typename Mutex>
+void try_lock(state& st)
+{
+    Mutex mtx;
+    while (st.keep_running()) {
+        if (mtx.try_lock())
+            mtx.unlock();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("mutex");
+    s.add("lock_unlock", "std", lock_unlock<std::mutex>).args({1, 2, 4});
+    s.add("lock_unlock", "Hx", lock_unlock<Hx::mutex>).args({1, 2, 4});
+    s.add("try_lock", "std", try_lock<std::mutex>);
+    s.add("try_lock", "Hx", try_lock<Hx::mutex>);
+    return s.run(argc, argv);
+}
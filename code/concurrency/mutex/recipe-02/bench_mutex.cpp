@@ -0,0 +1,155 @@
+// The futex Hx::mutex against a plain pthread_mutex_t; see "bench.hpp"
+// for the options. The argument is the number of threads sharing one
+// mutex; every iteration they take it 2^16 times in total. The tiny
+// critical section bumps a counter, the medium one updates 16 cache
+// lines.
+#include <pthread.h>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "mutex.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+const long ops_per_iteration = 1 << 16;
+
+// the pthread_mutex_t calls, without the error checks
+class pthread_mutex {
+    pthread_mutex_t mtx_;
+
+public:
+    pthread_mutex() { pthread_mutex_init(&mtx_, NULL); }
+    ~pthread_mutex() { pthread_mutex_destroy(&mtx_); }
+
+    void lock() { pthread_mutex_lock(&mtx_); }
+    bool try_lock() { return pthread_mutex_trylock(&mtx_) == 0; }
+    void unlock() { pthread_mutex_unlock(&mtx_); }
+};
+
+struct alignas(64) cache_line {
+    long value;
+};
+
+struct tiny_section {
+    long counter = 0;
+    void operator()() { counter++; }
+};
+
+struct medium_section {
+    cache_line lines[16];
+    medium_section() { for (int i = 0; i < 16; i++) lines[i].value = 0; }
+    void operator()() { for (int i = 0; i < 16; i++) lines[i].value += i; }
+};
+
+/**
+ * threads - 1 helper threads that run a job together with the calling
+ * thread whenever run() is called.
+ */
+class crew {
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::vector<std::thread> threads_;
+    std::function<void()> job_;
+    unsigned long generation_ = 0;
+    long running_ = 0;
+    bool stop_ = false;
+
+public:
+    explicit crew(long threads)
+    {
+        for (long i = 1; i < threads; i++) {
+            threads_.push_back(std::thread([this] {
+                unsigned long seen = 0;
+                for (;;) {
+                    std::unique_lock<std::mutex> lock(mtx_);
+                    cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                    if (stop_)
+                        return;
+                    seen = generation_;
+                    lock.unlock();
+                    job_();
+                    lock.lock();
+                    if (--running_ == 0)
+                        cv_.notify_all();
+                }
+            }));
+        }
+    }
+
+    ~crew()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (size_t i = 0; i < threads_.size(); i++)
+            threads_[i].join();
+    }
+
+    void run(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            job_ = job;
+            running_ = long(threads_.size());
+            ++generation_;
+        }
+        cv_.notify_all();
+        job();
+        std::unique_lock<std::mutex> lock(mtx_);
+        cv_.wait(lock, [&] { return running_ == 0; });
+    }
+};
+
+template <typename Mutex, typename Section>
+void contended(state& st)
+{
+    const long threads = st.arg();
+    const long ops = ops_per_iteration / threads;
+    Mutex mtx;
+    Section section;
+    crew c(threads);
+    while (st.keep_running()) {
+        c.run([&] {
+            for (long i = 0; i < ops; i++) {
+                mtx.lock();
+                section();
+                mtx.unlock();
+            }
+        });
+    }
+    do_not_optimize(&section);
+    st.set_items_per_iteration(ops * threads);
+}
+
+template <typename Mutex>
+void try_lock(state& st)
+{
+    Mutex mtx;
+    while (st.keep_running()) {
+        if (mtx.try_lock())
+            mtx.unlock();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // glibc skips the atomic instructions of pthread_mutex_lock until the
+    // process starts its first thread; start one so that every row runs
+    // as in a threaded program
+    std::thread([] {}).join();
+
+    Hx::bench::suite s("mutex");
+    s.add("lock_unlock/tiny", "pthread", contended<pthread_mutex, tiny_section>).args({1, 2, 4, 8, 16, 32, 64});
+    s.add("lock_unlock/tiny", "Hx", contended<Hx::mutex, tiny_section>).args({1, 2, 4, 8, 16, 32, 64});
+    s.add("lock_unlock/medium", "pthread", contended<pthread_mutex, medium_section>).args({1, 2, 4, 8, 16, 32, 64});
+    s.add("lock_unlock/medium", "Hx", contended<Hx::mutex, medium_section>).args({1, 2, 4, 8, 16, 32, 64});
+    s.add("try_lock", "pthread", try_lock<pthread_mutex>);
+    s.add("try_lock", "Hx", try_lock<Hx::mutex>);
+    return s.run(argc, argv);
+}
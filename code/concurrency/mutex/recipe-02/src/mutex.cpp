@@ -0,0 +1,132 @@
+#include "mutex.hpp"
+#include <algorithm>
+#include <cassert>
+#include <system_error>
+
+namespace Hx {
+
+#if defined(HX_MUTEX_USE_FUTEX)
+
+namespace {
+
+// bounds of the adaptive spin, in pause instructions
+const int min_spin = detail::futex_min_spin;
+const int max_spin = 1024;
+
+}   // namespace
+
+mutex::mutex(): state_(0), spin_(min_spin)
+{
+}
+
+mutex::~mutex()
+{
+    assert(state_.load(std::memory_order_relaxed) == 0);
+}
+
+namespace detail {
+
+bool futex_lock_slow(std::atomic<int>& state, std::atomic<int>& spin_avg,
+    const std::chrono::steady_clock::time_point* deadline)
+{
+    using namespace std::chrono;
+
+    // spin while the owner is likely to release soon: up to twice the
+    // spins that recently paid off (updated without a lock; it is only
+    // a hint)
+    int spin = spin_avg.load(std::memory_order_relaxed);
+    int limit = std::min(max_spin, 2 * spin + min_spin);
+    for (int i = 0; i < limit; i++) {
+        int c = state.load(std::memory_order_relaxed);
+        if (c == 0 && state.compare_exchange_weak(c, 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            spin_avg.store(spin + (i - spin) / 8, std::memory_order_relaxed);
+            return true;
+        }
+        if (c == 2)
+            break;              // others are sleeping already, queue up behind them
+        cpu_relax();
+    }
+    spin_avg.store(spin + (limit - spin) / 8, std::memory_order_relaxed);
+
+    // mark the lock contended, and sleep until we get it; taking it with
+    // 2 rather than 1 means our unlock will wake the next sleeper. Giving
+    // up leaves the 2 behind, which costs the owner one spare wake
+    int c = state.exchange(2, std::memory_order_acquire);
+    while (c != 0) {
+        if (deadline == nullptr) {
+            futex_wait(&state, 2);
+        } else {
+            steady_clock::duration left = *deadline-steady_clock::now();
+            if (left <= steady_clock::duration::zero())
+                return false;
+
+            // FUTEX_WAIT measures a relative timeout on CLOCK_MONOTONIC
+            seconds sec = duration_cast<seconds>(left);
+            nanoseconds nsec = duration_cast<nanoseconds>(left-sec);
+            struct timespec ts;
+            ts.tv_sec = sec.count();
+            ts.tv_nsec = nsec.count();
+            futex_wait(&state, 2, &ts);
+        }
+        c = state.exchange(2, std::memory_order_acquire);
+    }
+    return true;
+}
+
+}   // namespace detail
+
+#else
+
+mutex::mutex()
+{
+    int err = pthread_mutex_init(&mtx_, NULL);
+    if (err != 0) {
+        throw std::system_error(err, std::system_category(), __func__);
+    }
+}
+
+mutex::~mutex() 
+{
+    int err = pthread_mutex_destroy(&mtx_);
+    (void) err;
+    assert(err == 0);
+}
+
+void mutex::lock()
+{
+    while (true) {
+        int err = pthread_mutex_lock(&mtx_);
+        if (err == 0) {
+            break;
+        } else if (err == EINTR) {
+            continue;
+        } else {
+            throw std::system_error(err, std::system_category(), __func__);
+        }
+    }
+}
+
+bool mutex::try_lock()
+{
+    int err = pthread_mutex_trylock(&mtx_);
+    if (err == 0) {
+        return true;
+    } else if (err == EBUSY) {
+        return false;
+    } else {
+        throw std::system_error(err, std::system_category(), __func__);
+    }
+    return false;
+}
+
+void mutex::unlock()
+{
+    int err = pthread_mutex_unlock(&mtx_);
+    if (err != 0) {
+        throw std::system_error(err, std::system_category(), __func__);
+    }
+}
+
+#endif
+
+}   // namespace Hx
@@ -0,0 +1,135 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_MUTEX_INC
+#define MINI_STL_MUTEX_INC
+
+#if defined(__linux__) && !defined(HX_MUTEX_USE_PTHREAD)
+#define HX_MUTEX_USE_FUTEX 1
+#include <atomic>
+#include <chrono>
+#include "futex.hpp"
+#else
+#include <pthread.h>
+#endif
+
+namespace Hx {
+
+#if defined(HX_MUTEX_USE_FUTEX)
+
+namespace detail {
+
+// the spin a futex word starts from, in pause instructions
+const int futex_min_spin = 16;
+
+/**
+ * The contended path of locking a futex word (0, 1 or 2, as in mutex
+ * below), spin_avg being its running average of the spins that paid
+ * off: spins, then sleeps until it takes the word. With a deadline it
+ * gives up once that has passed and returns false.
+ */
+bool futex_lock_slow(std::atomic<int>& state, std::atomic<int>& spin_avg,
+    const std::chrono::steady_clock::time_point* deadline = nullptr);
+
+}   // namespace detail
+
+#endif
+
+/**
+ * The mutex class is a synchronization primitive 
+ * that can be used to protect shared data 
+ * from being simultaneously accessed by multiple threads. 
+ *
+ * On Linux the mutex is one futex word: 0 unlocked, 1 locked, 2 locked
+ * with (possibly) sleeping waiters (Drepper, "Futexes Are Tricky"). The
+ * uncontended lock and unlock are one atomic instruction each and never
+ * enter the kernel. A contended lock first spins for a while, adapting
+ * the spin to how long the lock has recently been held, and only then
+ * sleeps in FUTEX_WAIT_PRIVATE. Elsewhere, or with HX_MUTEX_USE_PTHREAD
+ * defined, it wraps a pthread_mutex_t as before.
+ */
+class mutex {
+#if defined(HX_MUTEX_USE_FUTEX)
+    std::atomic<int> state_;     // 0, 1 or 2, as above
+    std::atomic<int> spin_;      // running average of the spins that paid off
+#else
+    pthread_mutex_t mtx_;        // native mutex handle
+#endif
+
+public:
+#if defined(HX_MUTEX_USE_FUTEX)
+    typedef std::atomic<int>* native_handle_type;
+#else
+    typedef pthread_mutex_t* native_handle_type;
+#endif
+
+    /**
+     * Constructs the mutex. 
+     * The mutex is in unlocked state after the call. 
+     */
+    mutex();
+
+    /** Destroys the mutex. */
+    ~mutex();
+
+    mutex(const mutex&) = delete;
+    mutex& operator=(const mutex&) = delete;
+
+#if defined(HX_MUTEX_USE_FUTEX)
+    /**
+     * Locks the mutex. 
+     * If another thread has already locked the mutex, a call to lock will 
+     * block execution until the lock is acquired. If lock is called by a 
+     * thread that already owns the mutex, the program may deadlock. 
+     */
+    void lock()
+    {
+        int c = 0;
+        if (!state_.compare_exchange_strong(c, 1, std::memory_order_acquire, std::memory_order_relaxed))
+            detail::futex_lock_slow(state_, spin_);
+    }
+
+    /**
+     * Tries to lock the mutex. Returns immediately. 
+     * On successful lock acquisition returns true, otherwise returns false.
+     * The behavior is undefined if the mutex is not unlocked 
+     * before being destroyed, i.e. some thread still owns it. 
+     */
+    bool try_lock()
+    {
+        int c = 0;
+        return state_.compare_exchange_strong(c, 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    /**
+     * Unlocks the mutex.
+     * The mutex must be unlocked by all threads that have successfully locked 
+     * it before being destroyed. Otherwise, the behavior is undefined. 
+     */
+    void unlock()
+    {
+        if (state_.exchange(0, std::memory_order_release) == 2)
+            futex_wake(&state_, 1);
+    }
+
+    /** 
+     * Returns the underlying implementation-defined native handle object:
+     * the futex word.
+     */
+    native_handle_type native_handle() { return &state_; }
+#else
+    void lock();
+    bool try_lock();
+    void unlock();
+
+    /** 
+     * Returns the underlying implementation-defined native handle object. 
+     */
+    native_handle_type native_handle() { return &mtx_; }
+#endif
+};
+
+}    // namespace Hx
+
+#endif
@@ -0,0 +1,168 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_COHORT_LOCK_INC
+#define MINI_STL_COHORT_LOCK_INC
+
+#include <cctype>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <string>
+#if defined(__linux__)
+#include <sched.h>
+#endif
+#include "mcs_lock.hpp"
+#include "ticket_lock.hpp"
+
+namespace Hx {
+
+/** The number of NUMA nodes the kernel may bring up, 1 if it does not say. */
+inline unsigned numa_node_count()
+{
+    // e.g. "0" or "0-3"
+    std::ifstream in("/sys/devices/system/node/possible");
+    std::string list;
+    if (!(in >> list))
+        return 1;
+    unsigned last = 0;
+    unsigned n = 0;
+    bool digits = false;
+    for (size_t i = 0; i <= list.size(); i++) {
+        if (i < list.size() && std::isdigit((unsigned char) list[i])) {
+            n = n*10 + unsigned(list[i]-'0');
+            digits = true;
+        } else if (digits) {
+            last = n > last ? n : last;
+            n = 0;
+            digits = false;
+        }
+    }
+    return last+1;
+}
+
+/** The NUMA node of the cpu the calling thread runs on (it may move at any time). */
+inline unsigned this_numa_node()
+{
+#if defined(__linux__)
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (getcpu(&cpu, &node) == 0)
+        return node;
+#endif
+    return 0;
+}
+
+/**
+ * NUMA-aware lock, after the lock cohorting of Dice, Marathe and Shavit:
+ * an mcs_lock per NUMA node in front of one global ticket_lock. A thread
+ * takes the local lock of the node it runs on, then the global lock;
+ * but when the holder unlocks while others of its node wait, it hands
+ * them the local lock together with the global one, which it keeps, so
+ * that the lock and the data it guards stay in one node's caches for a
+ * while. After pass_limit such handoffs in a row the holder releases the
+ * global lock anyway, so that the other nodes cannot starve.
+ *
+ * The global lock is the ticket_lock because whoever ends a cohort's
+ * turn releases it, not whoever took it; the local lock is the mcs_lock
+ * because the holder can tell if someone waits behind it, and waiters
+ * never give up, so a handed-on global lock always finds a taker. With
+ * a single node the one cohort is everybody, and the global lock and the
+ * question of where the thread runs are left out.
+ */
+class cohort_lock {
+public:
+    static const int pass_limit = 64;
+
+    explicit cohort_lock(unsigned nodes = numa_node_count()):
+        nodes_(nodes == 0 ? 1 : nodes), storage_(new char[storage_size(nodes_)]),
+        cohorts_(place_cohorts(storage_.get(), nodes_)), owner_(nullptr) {}
+
+    cohort_lock(const cohort_lock&) = delete;
+    cohort_lock& operator=(const cohort_lock&) = delete;
+
+    void lock()
+    {
+        cohort& c = local();
+        c.local.lock();
+        if (nodes_ > 1 && !c.global_owned)
+            global_.lock();
+        owner_ = &c;
+    }
+
+    bool try_lock()
+    {
+        cohort& c = local();
+        // a free local lock never comes with the global one
+        if (!c.local.try_lock())
+            return false;
+        if (nodes_ > 1 && !global_.try_lock()) {
+            c.local.unlock();
+            return false;
+        }
+        owner_ = &c;
+        return true;
+    }
+
+    void unlock()
+    {
+        cohort& c = *owner_;
+        if (nodes_ == 1) {
+            c.local.unlock();
+            return;
+        }
+        if (c.passes < pass_limit && c.local.has_waiters()) {
+            c.passes++;
+            c.global_owned = true;
+            c.local.unlock();
+            return;
+        }
+        c.passes = 0;
+        c.global_owned = false;
+        global_.unlock();
+        c.local.unlock();
+    }
+
+    unsigned nodes() const { return nodes_; }
+
+private:
+    struct alignas(64) cohort {
+        mcs_lock local;
+        bool global_owned;      // the local lock comes with the global one; under the local lock
+        int passes;             // handoffs within the cohort in a row; likewise
+
+        cohort(): global_owned(false), passes(0) {}
+    };
+
+    /**
+     * Before C++17, new cohort[n] only aligns to alignof(std::max_align_t),
+     * not to the cache line cohort asks for: the cohorts live in a char
+     * array with room to align them by hand.
+     */
+    static std::size_t storage_size(unsigned n) { return n*sizeof(cohort)+alignof(cohort)-1; }
+
+    static cohort* place_cohorts(char* storage, unsigned n)
+    {
+        void* p = storage;
+        std::size_t space = storage_size(n);
+        cohort* cohorts = static_cast<cohort*>(std::align(alignof(cohort), n*sizeof(cohort), p, space));
+        for (unsigned i = 0; i < n; i++)
+            new (&cohorts[i]) cohort;
+        return cohorts;
+    }
+
+    // the cohort of the node the caller runs on
+    cohort& local() { return cohorts_[nodes_ == 1 ? 0 : this_numa_node() % nodes_]; }
+
+    const unsigned nodes_;
+    std::unique_ptr<char[]> storage_;
+    cohort* cohorts_;           // in storage_; trivially destructible
+    ticket_lock global_;
+    cohort* owner_;             // the holder's cohort; only the holder touches it
+};
+
+}    // namespace Hx
+
+#endif
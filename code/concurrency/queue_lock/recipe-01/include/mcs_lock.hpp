@@ -0,0 +1,204 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_MCS_LOCK_INC
+#define MINI_STL_MCS_LOCK_INC
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include "futex.hpp"
+#include "spin.hpp"
+
+namespace Hx {
+
+namespace detail {
+
+/** A thread's place in the queue of an mcs_lock. */
+struct alignas(64) mcs_node {
+    std::atomic<mcs_node*> next;        // who queued up behind
+    std::atomic<int> state;             // waiting, sleeping or granted; the futex word
+    mcs_node* free_next;                // in the thread's pool
+    char* storage;                      // what the pool allocated it in
+
+    explicit mcs_node(char* s): next(nullptr), state(0), free_next(nullptr), storage(s) {}
+};
+
+/**
+ * The queue nodes of one thread: it takes one for every mcs_lock it
+ * acquires and gives it back when it unlocks, so that it can hold any
+ * number of locks at once.
+ */
+class mcs_node_pool {
+public:
+    mcs_node_pool(): free_(nullptr) {}
+
+    ~mcs_node_pool()
+    {
+        while (free_ != nullptr) {
+            mcs_node* n = free_;
+            free_ = n->free_next;
+            delete[] n->storage;
+        }
+    }
+
+    static mcs_node_pool& local()
+    {
+        thread_local mcs_node_pool pool;
+        return pool;
+    }
+
+    mcs_node* get()
+    {
+        mcs_node* n = free_;
+        if (n == nullptr)
+            return make();
+        free_ = n->free_next;
+        return n;
+    }
+
+    void put(mcs_node* n)
+    {
+        n->free_next = free_;
+        free_ = n;
+    }
+
+private:
+    /**
+     * Before C++17, new mcs_node only aligns to alignof(std::max_align_t),
+     * not to the cache line mcs_node asks for: every node lives in a char
+     * array with room to align it by hand.
+     */
+    static mcs_node* make()
+    {
+        std::size_t space = sizeof(mcs_node)+alignof(mcs_node)-1;
+        char* storage = new char[space];
+        void* p = storage;
+        return new (std::align(alignof(mcs_node), sizeof(mcs_node), p, space)) mcs_node(storage);
+    }
+
+    mcs_node* free_;
+};
+
+}    // namespace detail
+
+/**
+ * Queue lock of Mellor-Crummey and Scott: every waiter queues a node of
+ * its own and waits on that node only, and the holder hands the lock to
+ * the next node directly. Waiters do not touch the lock or each other's
+ * cache lines while they wait, handoffs are FIFO, and a handoff costs
+ * one cache line transfer however many threads wait.
+ *
+ * The nodes come from a per-thread pool, so lock() takes no argument and
+ * the lock is Lockable. Waiters spin (only with more than one cpu),
+ * yield a few times, then sleep on the futex word in their node; the
+ * holder only enters the kernel when the next waiter sleeps.
+ */
+class mcs_lock {
+public:
+    mcs_lock(): tail_(nullptr), owner_(nullptr) {}
+
+    mcs_lock(const mcs_lock&) = delete;
+    mcs_lock& operator=(const mcs_lock&) = delete;
+
+    void lock()
+    {
+        detail::mcs_node* me = detail::mcs_node_pool::local().get();
+        me->next.store(nullptr, std::memory_order_relaxed);
+        me->state.store(waiting, std::memory_order_relaxed);
+        detail::mcs_node* pred = tail_.exchange(me, std::memory_order_acq_rel);
+        if (pred != nullptr) {
+            pred->next.store(me, std::memory_order_release);
+            wait(me);
+        }
+        owner_ = me;
+    }
+
+    bool try_lock()
+    {
+        if (tail_.load(std::memory_order_relaxed) != nullptr)
+            return false;
+        detail::mcs_node_pool& pool = detail::mcs_node_pool::local();
+        detail::mcs_node* me = pool.get();
+        me->next.store(nullptr, std::memory_order_relaxed);
+        detail::mcs_node* expected = nullptr;
+        // release: a successor will link itself into me
+        if (!tail_.compare_exchange_strong(expected, me, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            pool.put(me);
+            return false;
+        }
+        owner_ = me;
+        return true;
+    }
+
+    void unlock()
+    {
+        detail::mcs_node* me = owner_;
+        detail::mcs_node* succ = me->next.load(std::memory_order_acquire);
+        if (succ == nullptr) {
+            detail::mcs_node* expected = me;
+            if (tail_.compare_exchange_strong(expected, nullptr, std::memory_order_release, std::memory_order_relaxed)) {
+                detail::mcs_node_pool::local().put(me);
+                return;
+            }
+            // somebody has queued up, but not linked itself in yet
+            succ = wait_for_successor(me);
+        }
+        // the successor may finish with its node (and its thread exit)
+        // before the wake; a stray wake is harmless to any futex user
+        if (succ->state.exchange(granted, std::memory_order_release) == sleeping)
+            futex_wake(&succ->state, 1);
+        detail::mcs_node_pool::local().put(me);
+    }
+
+    /** Whether another thread waits behind the holder; only the holder may ask. */
+    bool has_waiters() const { return tail_.load(std::memory_order_relaxed) != owner_; }
+
+private:
+    static const int waiting = 0;
+    static const int sleeping = 1;
+    static const int granted = 2;
+    static const int spin_count = 128;
+    static const int yield_count = 4;
+
+    static void wait(detail::mcs_node* me)
+    {
+        const int pauses = detail::pause_budget(spin_count);
+        for (int i = 0; i < pauses+yield_count; i++) {
+            if (me->state.load(std::memory_order_acquire) == granted)
+                return;
+            if (i < pauses)
+                cpu_relax();
+            else
+                std::this_thread::yield();
+        }
+        int s = waiting;
+        me->state.compare_exchange_strong(s, sleeping, std::memory_order_acquire);
+        while (me->state.load(std::memory_order_acquire) == sleeping)
+            futex_wait(&me->state, sleeping);
+    }
+
+    static detail::mcs_node* wait_for_successor(detail::mcs_node* me)
+    {
+        const int pauses = detail::pause_budget(spin_count);
+        for (int i = 0; ; i++) {
+            detail::mcs_node* succ = me->next.load(std::memory_order_acquire);
+            if (succ != nullptr)
+                return succ;
+            if (i < pauses)
+                cpu_relax();
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    alignas(64) std::atomic<detail::mcs_node*> tail_;   // the last in line, or none
+    detail::mcs_node* owner_;                           // the holder's node; only the holder touches it
+};
+
+}    // namespace Hx
+
+#endif
@@ -0,0 +1,111 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_TICKET_LOCK_INC
+#define MINI_STL_TICKET_LOCK_INC
+
+#include <atomic>
+#include <climits>
+#include <thread>
+#include "futex.hpp"
+#include "spin.hpp"
+
+namespace Hx {
+
+/**
+ * FIFO spin lock: lock() takes the next ticket and waits until the lock
+ * serves it, so threads get the lock in the order they asked, and nobody
+ * can starve. unlock() only moves the serving number on, so any thread may
+ * release a lock another one took (cohort_lock relies on that).
+ *
+ * Waiters spin with a pause proportional to their distance from the head
+ * of the line (only with more than one cpu), yield a few times, then
+ * sleep. Sleepers spread over a few futex slots by ticket, and unlock
+ * wakes only the slot of the ticket it serves, and only if somebody
+ * sleeps there, so a handoff wakes one thread rather than the whole line.
+ */
+class ticket_lock {
+public:
+    ticket_lock(): next_(0), serving_(0) {}
+
+    ticket_lock(const ticket_lock&) = delete;
+    ticket_lock& operator=(const ticket_lock&) = delete;
+
+    void lock()
+    {
+        const int ticket = next_.fetch_add(1, std::memory_order_relaxed);
+        if (serving_.load(std::memory_order_acquire) != ticket)
+            wait(ticket);
+    }
+
+    /** Takes a ticket only if it would be served at once. */
+    bool try_lock()
+    {
+        int serving = serving_.load(std::memory_order_acquire);
+        int ticket = serving;
+        return next_.compare_exchange_strong(ticket, successor(serving), std::memory_order_relaxed);
+    }
+
+    void unlock()
+    {
+        const int ticket = successor(serving_.load(std::memory_order_relaxed));
+        // pairs with wait: either the sleeper sees the new number, or we see it counted
+        serving_.store(ticket, std::memory_order_seq_cst);
+        slot& s = slots_[ticket & slot_mask];
+        if (s.sleepers.load(std::memory_order_seq_cst) != 0) {
+            s.seq.fetch_add(1, std::memory_order_seq_cst);
+            futex_wake(&s.seq, INT_MAX);
+        }
+    }
+
+private:
+    static const int slot_count = 8;
+    static const int slot_mask = slot_count-1;
+    static const int spin_count = 64;
+    static const int max_backoff = 16;
+    static const int yield_count = 4;
+
+    struct slot {
+        std::atomic<int> seq;           // bumped to wake; the futex word
+        std::atomic<int> sleepers;
+        slot(): seq(0), sleepers(0) {}
+    };
+
+    // the numbers wrap around
+    static int successor(int ticket) { return int(unsigned(ticket)+1u); }
+    static int distance(int ticket, int serving) { return int(unsigned(ticket)-unsigned(serving)); }
+
+    void wait(int ticket)
+    {
+        const int pauses = detail::pause_budget(spin_count);
+        for (int i = 0; i < pauses+yield_count; i++) {
+            int d = distance(ticket, serving_.load(std::memory_order_acquire));
+            if (d == 0)
+                return;
+            if (i < pauses) {
+                for (int k = d < max_backoff ? d : max_backoff; k > 0; k--)
+                    cpu_relax();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        slot& s = slots_[ticket & slot_mask];
+        s.sleepers.fetch_add(1, std::memory_order_seq_cst);
+        for (;;) {
+            int seq = s.seq.load(std::memory_order_seq_cst);
+            if (serving_.load(std::memory_order_seq_cst) == ticket)
+                break;
+            futex_wait(&s.seq, seq);
+        }
+        s.sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    alignas(64) std::atomic<int> next_;     // the next ticket to hand out
+    alignas(64) std::atomic<int> serving_;  // the ticket that holds the lock
+    alignas(64) slot slots_[slot_count];
+};
+
+}    // namespace Hx
+
+#endif
@@ -0,0 +1,154 @@
+// The queue locks against the futex Hx::mutex and std::mutex; see
+// "bench.hpp" for the options. The argument is the number of threads
+// sharing one lock.
+// throughput: every iteration they take it 2^14 times in total, each as
+// often as it manages to.
+// fairness: every iteration each thread takes it 2^14 / threads times,
+// and those done keep taking it until the last is done too; an unfair
+// lock lets a few threads hog it while the last one starves.
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "mutex.hpp"
+#include "ticket_lock.hpp"
+#include "mcs_lock.hpp"
+#include "cohort_lock.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+const long ops_per_iteration = 1 << 14;
+
+/**
+ * threads - 1 helper threads that run a job together with the calling
+ * thread whenever run() is called.
+ */
+class crew {
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::vector<std::thread> threads_;
+    std::function<void()> job_;
+    unsigned long generation_ = 0;
+    long running_ = 0;
+    bool stop_ = false;
+
+public:
+    explicit crew(long threads)
+    {
+        for (long i = 1; i < threads; i++) {
+            threads_.push_back(std::thread([this] {
+                unsigned long seen = 0;
+                for (;;) {
+                    std::unique_lock<std::mutex> lock(mtx_);
+                    cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                    if (stop_)
+                        return;
+                    seen = generation_;
+                    lock.unlock();
+                    job_();
+                    lock.lock();
+                    if (--running_ == 0)
+                        cv_.notify_all();
+                }
+            }));
+        }
+    }
+
+    ~crew()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (size_t i = 0; i < threads_.size(); i++)
+            threads_[i].join();
+    }
+
+    void run(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            job_ = job;
+            running_ = long(threads_.size());
+            ++generation_;
+        }
+        cv_.notify_all();
+        job();
+        std::unique_lock<std::mutex> lock(mtx_);
+        cv_.wait(lock, [&] { return running_ == 0; });
+    }
+};
+
+template <typename Lock>
+void throughput(state& st)
+{
+    const long threads = st.arg();
+    Lock lck;
+    long counter = 0;
+    crew c(threads);
+    while (st.keep_running()) {
+        long target = counter + ops_per_iteration;
+        c.run([&] {
+            for (;;) {
+                std::lock_guard<Lock> guard(lck);
+                if (counter == target)
+                    return;
+                counter++;
+            }
+        });
+    }
+    do_not_optimize(&counter);
+    st.set_items_per_iteration(ops_per_iteration);
+}
+
+template <typename Lock>
+void fairness(state& st)
+{
+    const long threads = st.arg();
+    const long share = ops_per_iteration / threads;
+    Lock lck;
+    long counter = 0;
+    crew c(threads);
+    while (st.keep_running()) {
+        std::atomic<long> done(0);
+        c.run([&] {
+            for (long mine = 1; ; mine++) {
+                lck.lock();
+                counter++;
+                lck.unlock();
+                if (mine == share)
+                    done.fetch_add(1, std::memory_order_relaxed);
+                else if (mine > share && done.load(std::memory_order_relaxed) == threads)
+                    return;
+            }
+        });
+    }
+    do_not_optimize(&counter);
+    st.set_items_per_iteration(share * threads);
+}
+
+int main(int argc, char* argv[])
+{
+    // glibc skips the atomic instructions of pthread_mutex_lock until the
+    // process starts its first thread; start one so that every row runs
+    // as in a threaded program
+    std::thread([] {}).join();
+
+    Hx::bench::suite s("queue_lock");
+    s.add("throughput", "std", throughput<std::mutex>).args({1, 2, 4, 8, 16, 32, 64, 128});
+    s.add("throughput", "Hx::mutex", throughput<Hx::mutex>).args({1, 2, 4, 8, 16, 32, 64, 128});
+    s.add("throughput", "ticket", throughput<Hx::ticket_lock>).args({1, 2, 4, 8, 16, 32, 64, 128});
+    s.add("throughput", "mcs", throughput<Hx::mcs_lock>).args({1, 2, 4, 8, 16, 32, 64, 128});
+    s.add("throughput", "cohort", throughput<Hx::cohort_lock>).args({1, 2, 4, 8, 16, 32, 64, 128});
+    s.add("fairness", "std", fairness<std::mutex>).args({1, 2, 4, 8, 16, 32, 64, 128});
+    s.add("fairness", "Hx::mutex", fairness<Hx::mutex>).args({1, 2, 4, 8, 16, 32, 64, 128});
+    s.add("fairness", "ticket", fairness<Hx::ticket_lock>).args({1, 2, 4, 8, 16, 32, 64, 128});
+    s.add("fairness", "mcs", fairness<Hx::mcs_lock>).args({1, 2, 4, 8, 16, 32, 64, 128});
+    s.add("fairness", "cohort", fairness<Hx::cohort_lock>).args({1, 2, 4, 8, 16, 32, 64, 128});
+    return s.run(argc, argv);
+}
@@ -0,0 +1,54 @@
+// condition_variable_any::wait with an mcs_lock
+#include <iostream>           // std::cout
+#include <thread>             // std::thread, std::this_thread::yield
+#include <mutex>              // std::unique_lock
+#include "mcs_lock.hpp"       // Hx::mcs_lock
+#include "condition_variable.hpp" // Hx::condition_variable_any
+
+Hx::mcs_lock lck;
+Hx::condition_variable_any cv;
+
+int cargo = 0;
+bool shipment_available() {return cargo!=0;}
+
+void consume (int n) {
+  for (int i=0; i<n; ++i) {
+    std::unique_lock<Hx::mcs_lock> ul(lck);
+    cv.wait(ul,shipment_available);
+    // consume:
+    std::cout << cargo << '\n';
+    cargo=0;
+  }
+}
+
+int main ()
+{
+  std::thread consumer_thread (consume,10);
+
+  // produce 10 items when needed:
+  for (int i=0; i<10; ++i) {
+    while (shipment_available()) std::this_thread::yield();
+    std::unique_lock<Hx::mcs_lock> ul(lck);
+    cargo = i+1;
+    cv.notify_one();
+  }
+
+  consumer_thread.join();
+
+  return 0;
+}
+
+/*
+Output:
+
+1
+2
+3
+4
+5
+6
+7
+8
+9
+10
+*/
@@ -0,0 +1,41 @@
+// lock_guard with the queue locks
+#include <iostream>       // std::cout
+#include <thread>         // std::thread
+#include <mutex>          // std::lock_guard
+#include <vector>         // std::vector
+#include "ticket_lock.hpp"  // Hx::ticket_lock
+#include "mcs_lock.hpp"     // Hx::mcs_lock
+#include "cohort_lock.hpp"  // Hx::cohort_lock
+
+template <typename Lock>
+long count (int threads, int n) {
+  Lock lck;
+  long counter = 0;
+  std::vector<std::thread> v;
+  for (int i=0; i<threads; ++i)
+    v.push_back(std::thread([&] {
+      for (int j=0; j<n; ++j) {
+        std::lock_guard<Lock> guard(lck);
+        ++counter;
+      }
+    }));
+  for (auto& th : v) th.join();
+  return counter;
+}
+
+int main ()
+{
+  std::cout << "ticket_lock: " << count<Hx::ticket_lock>(8,10000) << '\n';
+  std::cout << "mcs_lock: " << count<Hx::mcs_lock>(8,10000) << '\n';
+  std::cout << "cohort_lock: " << count<Hx::cohort_lock>(8,10000) << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+ticket_lock: 80000
+mcs_lock: 80000
+cohort_lock: 80000
+*/
@@ -0,0 +1,91 @@
+// Hx::recursive_timed_mutex against std::recursive_timed_mutex; see
+// "bench.hpp" for the options. The argument of lock_unlock is the number of
+// threads contending for the mutex, that of relock how deep one thread
+// locks it; try_lock_for never has to wait.
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "recursive_timed_mutex.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+template <typename Mutex>
+void lock_unlock(state& st)
+{
+    Mutex mtx;
+    long counter = 0;
+    std::atomic<bool> done(false);
+    std::vector<std::thread> others;
+    for (long i = 1; i < st.arg(); i++) {
+        others.push_back(std::thread([&]() {
+            while (!done.load(std::memory_order_relaxed)) {
+                mtx.lock();
+                counter++;
+                mtx.unlock();
+            }
+        }));
+    }
+
+    while (st.keep_running()) {
+        mtx.lock();
+        counter++;
+        mtx.unlock();
+    }
+
+    done = true;
+    for (size_t i = 0; i < others.size(); i++)
+        others[i].join();
+    do_not_optimize(counter);
+}
+
+template <typename Mutex>
+void try_lock(state& st)
+{
+    Mutex mtx;
+    while (st.keep_running()) {
+        if (mtx.try_lock())
+            mtx.unlock();
+    }
+}
+
+template <typename Mutex>
+void try_lock_for(state& st)
+{
+    Mutex mtx;
+    while (st.keep_running()) {
+        if (mtx.try_lock_for(std::chrono::milliseconds(1)))
+            mtx.unlock();
+    }
+}
+
+template <typename Mutex>
+void relock(state& st)
+{
+    const long depth = st.arg();
+    Mutex mtx;
+    while (st.keep_running()) {
+        for (long i = 0; i < depth; i++)
+            mtx.lock();
+        for (long i = 0; i < depth; i++)
+            mtx.unlock();
+    }
+    st.set_items_per_iteration(depth);
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("recursive_timed_mutex");
+    s.add("lock_unlock", "std", lock_unlock<std::recursive_timed_mutex>).args({1, 2, 4});
+    s.add("lock_unlock", "Hx", lock_unlock<Hx::recursive_timed_mutex>).args({1, 2, 4});
+    s.add("try_lock", "std", try_lock<std::recursive_timed_mutex>);
+    s.add("try_lock", "Hx", try_lock<Hx::recursive_timed_mutex>);
+    s.add("try_lock_for", "std", try_lock_for<std::recursive_timed_mutex>);
+    s.add("try_lock_for", "Hx", try_lock_for<Hx::recursive_timed_mutex>);
+    s.add("relock", "std", relock<std::recursive_timed_mutex>).args({1, 4});
+    s.add("relock", "Hx", relock<Hx::recursive_timed_mutex>).args({1, 4});
+    return s.run(argc, argv);
+}
@@ -0,0 +1,119 @@
+// Hx::counting_semaphore against std::counting_semaphore and boost's
+// interprocess_semaphore; see "bench.hpp" for the options.
+//   prodcons/N   prodcons4 with N producers and N consumers: a 10-slot
+//                buffer guarded by a binary semaphore, with nempty and
+//                nstored counting semaphores; 2^16 items per iteration
+//   uncontended  an acquire/release pair on one thread
+#include <semaphore>
+#include <thread>
+#include <vector>
+#include <boost/interprocess/sync/interprocess_semaphore.hpp>
+#include "semaphore.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+const int nbuff = 10;
+const long items_per_iteration = 1 << 16;
+
+struct std_semaphores {
+    typedef std::counting_semaphore<> counting;
+    typedef std::binary_semaphore binary;
+};
+
+struct hx_semaphores {
+    typedef Hx::counting_semaphore<> counting;
+    typedef Hx::binary_semaphore binary;
+};
+
+// boost's wait/post under the std names
+class boost_semaphore {
+    boost::interprocess::interprocess_semaphore sem_;
+
+public:
+    explicit boost_semaphore(ptrdiff_t desired): sem_(unsigned(desired)) {}
+    void acquire() { sem_.wait(); }
+    void release() { sem_.post(); }
+};
+
+struct boost_semaphores {
+    typedef boost_semaphore counting;
+    typedef boost_semaphore binary;
+};
+
+template <typename Semaphores>
+void prodcons(state& st)
+{
+    const long n = st.arg();
+    while (st.keep_running()) {
+        st.pause_timing();
+        typename Semaphores::binary mutex(1);
+        typename Semaphores::counting nempty(nbuff), nstored(0);
+        int buff[nbuff];
+        long nput = 0, nget = 0;
+        long sum = 0;
+        std::vector<std::thread> threads;
+        st.resume_timing();
+
+        for (long i = 0; i < n; i++) {
+            threads.push_back(std::thread([&] {
+                for (;;) {
+                    nempty.acquire();
+                    mutex.acquire();
+                    if (nput >= items_per_iteration) {
+                        nstored.release();      // let a consumer see the end too
+                        nempty.release();
+                        mutex.release();
+                        return;
+                    }
+                    buff[nput % nbuff] = int(nput);
+                    nput++;
+                    mutex.release();
+                    nstored.release();
+                }
+            }));
+            threads.push_back(std::thread([&] {
+                for (;;) {
+                    nstored.acquire();
+                    mutex.acquire();
+                    if (nget >= items_per_iteration) {
+                        nstored.release();
+                        mutex.release();
+                        return;
+                    }
+                    sum += buff[nget % nbuff];
+                    nget++;
+                    mutex.release();
+                    nempty.release();
+                }
+            }));
+        }
+        for (size_t i = 0; i < threads.size(); i++)
+            threads[i].join();
+        do_not_optimize(&sum);
+    }
+    st.set_items_per_iteration(items_per_iteration);
+}
+
+template <typename Semaphores>
+void uncontended(state& st)
+{
+    typename Semaphores::counting sem(1);
+    while (st.keep_running()) {
+        sem.acquire();
+        sem.release();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("semaphore");
+    s.add("prodcons", "std", prodcons<std_semaphores>).args({1, 2, 4, 8});
+    s.add("prodcons", "boost", prodcons<boost_semaphores>).args({1, 2, 4, 8});
+    s.add("prodcons", "Hx", prodcons<hx_semaphores>).args({1, 2, 4, 8});
+    s.add("uncontended", "std", uncontended<std_semaphores>);
+    s.add("uncontended", "boost", uncontended<boost_semaphores>);
+    s.add("uncontended", "Hx", uncontended<hx_semaphores>);
+    return s.run(argc, argv);
+}
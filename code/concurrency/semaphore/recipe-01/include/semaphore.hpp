@@ -0,0 +1,200 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_SEMAPHORE_INC
+#define MINI_STL_SEMAPHORE_INC
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <ctime>
+#include <thread>
+#include "futex.hpp"
+
+namespace Hx {
+
+/**
+ * A counting_semaphore is a lightweight synchronization primitive that
+ * can control access to a shared resource. It holds an internal counter
+ * that acquire decrements, blocking while it is zero, and release
+ * increments, waking blocked threads.
+ *
+ * The counter is a futex word. acquire and release are a single atomic
+ * instruction as long as no thread has to wait: release only enters the
+ * kernel (FUTEX_WAKE_PRIVATE) when a waiter has announced itself. A
+ * thread that finds the counter at zero spins and yields a little before
+ * it sleeps in FUTEX_WAIT_PRIVATE (elsewhere than Linux, it yields). Timed waits run
+ * on steady_clock.
+ *
+ * LeastMaxValue may be at most INT_MAX, the range of a futex word; that
+ * is also the default.
+ */
+template <ptrdiff_t LeastMaxValue = INT_MAX>
+class counting_semaphore {
+    static_assert(LeastMaxValue >= 0 && LeastMaxValue <= INT_MAX, "the counter is a 32-bit futex word");
+
+    static const int spin_count = 16;     // pause, then as many yields
+
+    std::atomic<int> count_;
+    std::atomic<int> waiters_;      // threads about to sleep or sleeping on count_
+
+public:
+    /** The largest value the counter can reach. */
+    static constexpr ptrdiff_t max() noexcept { return LeastMaxValue; }
+
+    /** Initializes the counter with desired (0 <= desired <= max()). */
+    constexpr explicit counting_semaphore(ptrdiff_t desired): count_(int(desired)), waiters_(0) {}
+
+    ~counting_semaphore()
+    {
+        assert(waiters_.load(std::memory_order_relaxed) == 0);
+    }
+
+    counting_semaphore(const counting_semaphore&) = delete;
+    counting_semaphore& operator=(const counting_semaphore&) = delete;
+
+    /**
+     * Increments the counter by update, and wakes as many waiting
+     * threads. The counter must not exceed max().
+     */
+    void release(ptrdiff_t update = 1)
+    {
+        assert(update >= 0 && update <= max()-count_.load(std::memory_order_relaxed));
+        // pairs with wait(): either the waiter sees the new count and
+        // does not sleep, or we see it announced and wake it
+        count_.fetch_add(int(update), std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_seq_cst) > 0)
+            futex_wake_n(int(update));
+    }
+
+    /**
+     * Decrements the counter, blocking until it is greater than zero.
+     */
+    void acquire()
+    {
+        if (!try_acquire())
+            wait(nullptr);
+    }
+
+    /**
+     * Decrements the counter if it is greater than zero, without
+     * blocking. Returns true if it did.
+     */
+    bool try_acquire() noexcept
+    {
+        int c = count_.load(std::memory_order_relaxed);
+        while (c > 0) {
+            if (count_.compare_exchange_weak(c, c-1, std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * Decrements the counter, blocking for at most rel_time until it is
+     * greater than zero. Returns false on timeout.
+     */
+    template <typename Rep, typename Period>
+    bool try_acquire_for(const std::chrono::duration<Rep, Period>& rel_time)
+    {
+        using namespace std::chrono;
+        if (try_acquire())
+            return true;
+        steady_clock::time_point deadline = steady_clock::now()+duration_cast<steady_clock::duration>(rel_time);
+        return wait(&deadline);
+    }
+
+    /**
+     * Decrements the counter, blocking until it is greater than zero or
+     * abs_time has passed. Returns false on timeout.
+     */
+    template <typename Clock, typename Duration>
+    bool try_acquire_until(const std::chrono::time_point<Clock, Duration>& abs_time)
+    {
+        using namespace std::chrono;
+        if (try_acquire())
+            return true;
+        steady_clock::time_point deadline = steady_clock::now()+duration_cast<steady_clock::duration>(abs_time-Clock::now());
+        while (!wait(&deadline)) {
+            // steady_clock and Clock may drift apart; trust Clock
+            if (Clock::now() >= abs_time)
+                return false;
+            deadline = steady_clock::now()+duration_cast<steady_clock::duration>(abs_time-Clock::now());
+        }
+        return true;
+    }
+
+private:
+    // the slow path of acquire: spin, then sleep until we get a unit or
+    // the deadline (if any) passes
+    bool wait(const std::chrono::steady_clock::time_point* deadline)
+    {
+        using namespace std::chrono;
+        // a unit is often released within a few hundred cycles; failing
+        // that, yielding lets the releaser run if it shares our cpu
+        for (int i = 0; i < 2*spin_count; i++) {
+            if (i < spin_count)
+                cpu_relax();
+            else
+                std::this_thread::yield();
+            if (try_acquire())
+                return true;
+        }
+
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        bool acquired = false;
+        for (;;) {
+            int c = count_.load(std::memory_order_seq_cst);
+            while (c > 0 && !acquired) {
+                if (count_.compare_exchange_weak(c, c-1, std::memory_order_acquire, std::memory_order_relaxed))
+                    acquired = true;
+            }
+            if (acquired)
+                break;
+            if (deadline == nullptr) {
+                futex_wait_zero(nullptr);
+                continue;
+            }
+            steady_clock::duration left = *deadline-steady_clock::now();
+            if (left <= steady_clock::duration::zero())
+                break;
+            seconds sec = duration_cast<seconds>(left);
+            nanoseconds nsec = duration_cast<nanoseconds>(left-sec);
+            struct timespec ts;
+            ts.tv_sec = sec.count();
+            ts.tv_nsec = nsec.count();
+            futex_wait_zero(&ts);
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return acquired;
+    }
+
+    void futex_wait_zero(const struct timespec* timeout)
+    {
+#if defined(__linux__)
+        futex_wait(&count_, 0, timeout);
+#else
+        (void) timeout;
+        std::this_thread::yield();
+#endif
+    }
+
+    void futex_wake_n(int n)
+    {
+#if defined(__linux__)
+        futex_wake(&count_, n);
+#else
+        (void) n;
+#endif
+    }
+};
+
+/** A semaphore with only two states, such as a mutex that any thread may release. */
+typedef counting_semaphore<1> binary_semaphore;
+
+}    // namespace Hx
+
+#endif
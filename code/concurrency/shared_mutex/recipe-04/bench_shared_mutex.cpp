@@ -0,0 +1,202 @@
+// The distributed-reader Hx::shared_mutex against std::shared_mutex
+// (pthread_rwlock_t) and the one-mutex, two-condition-variable design of
+// recipes 01-03; see "bench.hpp" for the options. The argument is the
+// number of threads sharing one lock; every iteration they take it 2^16
+// times in total, a given share of them exclusively. A reader sums 8
+// cache lines of the protected table, a writer updates them.
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include "shared_mutex.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+const long ops_per_iteration = 1 << 16;
+
+// recipe-03: writer-preferring, every lock and unlock goes through mutex
+class cv_shared_mutex {
+    std::mutex mutex;
+    std::condition_variable read;
+    std::condition_variable write;
+    int r_active = 0;
+    int w_active = 0;
+    int r_wait = 0;
+    int w_wait = 0;
+
+public:
+    void lock()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (w_active || r_active > 0) {
+            w_wait++;
+            while (w_active || r_active > 0)
+                write.wait(lock);
+            w_wait--;
+        }
+        w_active = 1;
+    }
+
+    void unlock()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        w_active = 0;
+        if (w_wait > 0)
+            write.notify_one();
+        else if (r_wait > 0)
+            read.notify_all();
+    }
+
+    void lock_shared()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (w_active || w_wait > 0) {
+            r_wait++;
+            while (w_active || w_wait > 0)
+                read.wait(lock);
+            r_wait--;
+        }
+        r_active++;
+    }
+
+    void unlock_shared()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        r_active--;
+        if (r_active == 0 && w_wait > 0)
+            write.notify_one();
+    }
+};
+
+struct alignas(64) cache_line {
+    long value;
+};
+
+struct table {
+    cache_line lines[8];
+    table() { for (int i = 0; i < 8; i++) lines[i].value = 0; }
+    long read() const { long s = 0; for (int i = 0; i < 8; i++) s += lines[i].value; return s; }
+    void write() { for (int i = 0; i < 8; i++) lines[i].value += i; }
+};
+
+/**
+ * threads - 1 helper threads that run a job together with the calling
+ * thread whenever run() is called.
+ */
+class crew {
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::vector<std::thread> threads_;
+    std::function<void(long)> job_;
+    unsigned long generation_ = 0;
+    long running_ = 0;
+    bool stop_ = false;
+
+public:
+    explicit crew(long threads)
+    {
+        for (long i = 1; i < threads; i++) {
+            threads_.push_back(std::thread([this, i] {
+                unsigned long seen = 0;
+                for (;;) {
+                    std::unique_lock<std::mutex> lock(mtx_);
+                    cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                    if (stop_)
+                        return;
+                    seen = generation_;
+                    lock.unlock();
+                    job_(i);
+                    lock.lock();
+                    if (--running_ == 0)
+                        cv_.notify_all();
+                }
+            }));
+        }
+    }
+
+    ~crew()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (size_t i = 0; i < threads_.size(); i++)
+            threads_[i].join();
+    }
+
+    // runs job(i) on thread i, the caller being thread 0
+    void run(std::function<void(long)> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            job_ = job;
+            running_ = long(threads_.size());
+            ++generation_;
+        }
+        cv_.notify_all();
+        job(0);
+        std::unique_lock<std::mutex> lock(mtx_);
+        cv_.wait(lock, [&] { return running_ == 0; });
+    }
+};
+
+// WritesPerMille of every 1000 operations take the lock exclusively
+template <typename SharedMutex, int WritesPerMille>
+void mixed(state& st)
+{
+    const long threads = st.arg();
+    const long ops = ops_per_iteration / threads;
+    SharedMutex mtx;
+    table data;
+    std::vector<cache_line> sums(threads);
+    crew c(threads);
+    while (st.keep_running()) {
+        c.run([&](long self) {
+            unsigned rnd = unsigned(self) * 2654435761u + 1;
+            long sum = 0;
+            for (long i = 0; i < ops; i++) {
+                rnd ^= rnd << 13;
+                rnd ^= rnd >> 17;
+                rnd ^= rnd << 5;
+                if (rnd % 1000 < unsigned(WritesPerMille)) {
+                    mtx.lock();
+                    data.write();
+                    mtx.unlock();
+                } else {
+                    mtx.lock_shared();
+                    sum += data.read();
+                    mtx.unlock_shared();
+                }
+            }
+            sums[self].value = sum;
+        });
+    }
+    do_not_optimize(sums.data());
+    st.set_items_per_iteration(ops * threads);
+}
+
+#define ADD_MIXED(name, per_mille)                                                                  \
+    s.add(name, "std", mixed<std::shared_mutex, per_mille>).args({1, 2, 4, 8, 16, 32, 64});         \
+    s.add(name, "cv", mixed<cv_shared_mutex, per_mille>).args({1, 2, 4, 8, 16, 32, 64});            \
+    s.add(name, "Hx", mixed<Hx::shared_mutex, per_mille>).args({1, 2, 4, 8, 16, 32, 64})
+
+int main(int argc, char* argv[])
+{
+    // glibc skips the atomic instructions of its locks until the process
+    // starts its first thread; start one so that every row runs as in a
+    // threaded program
+    std::thread([] {}).join();
+
+    Hx::bench::suite s("shared_mutex");
+    ADD_MIXED("read_only", 0);
+    ADD_MIXED("writes_0.1%", 1);
+    ADD_MIXED("writes_1%", 10);
+    ADD_MIXED("writes_10%", 100);
+    ADD_MIXED("writes_50%", 500);
+    return s.run(argc, argv);
+}
@@ -0,0 +1,152 @@
+#include "shared_mutex.hpp"
+#include <cassert>
+#include <climits>
+#include <thread>
+#include "futex.hpp"
+
+namespace Hx {
+
+namespace {
+
+// 休眠前自旋的次数（pause 指令数）
+const int max_spin = 128;
+
+// *addr == expected 时休眠，直到被唤醒；调用方醒来后自行重新检查条件
+void wait_on(std::atomic<int>& word, int expected)
+{
+#if defined(__linux__)
+    futex_wait(&word, expected);
+#else
+    (void) word;
+    (void) expected;
+    std::this_thread::yield();
+#endif
+}
+
+void wake_all(std::atomic<int>& word)
+{
+#if defined(__linux__)
+    futex_wake(&word, INT_MAX);
+#else
+    (void) word;
+#endif
+}
+
+}   // namespace
+
+shared_mutex::shared_mutex():
+    writer_(0), drain_(0)
+{
+    for (int i = 0; i < slot_count; i++)
+        slots_[i].readers.store(0, std::memory_order_relaxed);
+}
+
+shared_mutex::~shared_mutex()
+{
+    assert(writer_.load(std::memory_order_relaxed) == 0);
+    for (int i = 0; i < slot_count; i++)
+        assert(slots_[i].readers.load(std::memory_order_relaxed) == 0);
+}
+
+void shared_mutex::lock()
+{
+    int c = 0;
+    if (!writer_.compare_exchange_strong(c, 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        lock_writer_slow();
+    wait_for_readers();
+}
+
+bool shared_mutex::try_lock()
+{
+    int c = 0;
+    if (!writer_.compare_exchange_strong(c, 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return false;
+    for (int i = 0; i < slot_count; i++) {
+        if (slots_[i].readers.load(std::memory_order_seq_cst) != 0) {
+            unlock();
+            return false;
+        }
+    }
+    return true;
+}
+
+void shared_mutex::unlock()
+{
+    if (writer_.exchange(0, std::memory_order_release) == 2)
+        wake_all(writer_);
+}
+
+bool shared_mutex::try_lock_shared()
+{
+    reader_slot& s = slots_[slot_index()];
+    s.readers.fetch_add(1, std::memory_order_seq_cst);
+    if (writer_.load(std::memory_order_seq_cst) == 0)
+        return true;
+    leave(s);
+    return false;
+}
+
+void shared_mutex::lock_shared_slow(reader_slot& s)
+{
+    // 有写者：先退出槽，让写者等到的读者计数能归零，等写者解锁后再重试
+    do {
+        leave(s);
+        wait_for_no_writer();
+        s.readers.fetch_add(1, std::memory_order_seq_cst);
+    } while (writer_.load(std::memory_order_seq_cst) != 0);
+}
+
+void shared_mutex::lock_writer_slow()
+{
+    for (int i = 0; i < max_spin; i++) {
+        int c = writer_.load(std::memory_order_relaxed);
+        if (c == 0 && writer_.compare_exchange_weak(c, 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return;
+        if (c == 2)
+            break;
+        cpu_relax();
+    }
+    // 以 2 占有，解锁时会唤醒其他等待者
+    while (writer_.exchange(2, std::memory_order_seq_cst) != 0)
+        wait_on(writer_, 2);
+}
+
+void shared_mutex::wait_for_readers()
+{
+    for (int i = 0; i < slot_count; i++) {
+        std::atomic<long>& readers = slots_[i].readers;
+        for (int spin = 0; spin < max_spin && readers.load(std::memory_order_seq_cst) != 0; spin++)
+            cpu_relax();
+        for (;;) {
+            // 先读 drain_ 再查计数：计数之后才归零的话，drain_ 已变，wait_on 立即返回
+            int seq = drain_.load(std::memory_order_seq_cst);
+            if (readers.load(std::memory_order_seq_cst) == 0)
+                break;
+            wait_on(drain_, seq);
+        }
+    }
+}
+
+void shared_mutex::wait_for_no_writer()
+{
+    for (int spin = 0; spin < max_spin; spin++) {
+        if (writer_.load(std::memory_order_relaxed) == 0)
+            return;
+        cpu_relax();
+    }
+    int c = writer_.load(std::memory_order_relaxed);
+    while (c != 0) {
+        if (c == 1 && !writer_.compare_exchange_weak(c, 2, std::memory_order_relaxed))
+            continue;
+        wait_on(writer_, 2);
+        c = writer_.load(std::memory_order_relaxed);
+    }
+}
+
+void shared_mutex::wake_writer()
+{
+    drain_.fetch_add(1, std::memory_order_seq_cst);
+    wake_all(drain_);
+}
+
+}   // Hx
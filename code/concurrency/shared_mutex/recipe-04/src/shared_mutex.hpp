@@ -0,0 +1,152 @@
+/**
+ * @file shared_mutex.hpp
+ * @brief 读写锁
+ * @author hexu_1985@sina.com
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ * @see Lev, Luchangco and Olszewski, "Scalable Reader-Writer Locks", SPAA 2009
+ * @see Drepper, "Futexes Are Tricky"
+ */
+#ifndef MINI_STL_SHARED_MUTEX_INC
+#define MINI_STL_SHARED_MUTEX_INC
+
+#include <atomic>
+
+namespace Hx {
+
+/**
+ * @brief shared_mutex 类是一个同步原语，可用于保护共享数据不被多个线程同时访问。
+ *      与便于独占访问的其他互斥类型不同，shared_mutex 拥有二个访问级别：
+ *      共享 - 多个线程能共享同一互斥的所有权。
+ *      独占性 - 仅一个线程能占有互斥。
+ *
+ * @note 读者计数分散在 slot_count 个各占一条 cache line 的槽里，每个线程固定使用
+ *      其中一个槽。无写者时 lock_shared/unlock_shared 只修改本线程的槽，
+ *      不同线程的读锁不再争用同一条 cache line。写者先占有 futex 字 writer_，
+ *      此后新来的读者退让，写者再逐个等待各槽的读者计数归零（写者优先）。
+ *      等待一律先有限自旋，再在 futex 上休眠（非 Linux 平台上让出 CPU）。
+ *      代价是对象较大（约 slot_count 条 cache line），且写者加锁要扫描所有槽。
+ */
+class shared_mutex {
+public:
+    static const int slot_count = 64;
+
+private:
+    struct alignas(64) reader_slot {
+        std::atomic<long> readers;  // readers holding or trying for the lock through this slot
+    };
+
+    reader_slot             slots_[slot_count];
+    alignas(64) std::atomic<int> writer_;   // 0 无写者，1 有写者，2 有写者且可能有线程在等待
+    std::atomic<int>        drain_;         // 读者离开时递增，写者在其上等待读者计数归零
+
+public:
+    /**
+     * @brief 构造互斥。调用后互斥在未锁定状态。
+     */
+    shared_mutex();
+
+    /**
+     * @brief 复制构造函数被删除。
+     */
+	shared_mutex(const shared_mutex&) = delete;
+
+    /**
+     * @brief 赋值运算符被删除，不可复制。
+     */
+	shared_mutex& operator=(const shared_mutex&) = delete;
+
+    /**
+     * @brief 销毁互斥。
+     *
+     * @warning 若互斥为任何线程占有，或若任何线程在保有任何互斥的所有权时终止，则行为未定义。
+     */
+    ~shared_mutex();
+
+    /**
+     * @brief 锁定互斥。若另一线程已锁定互斥，则到 lock 的调用将阻塞执行，直至获得锁。
+     *
+     * @warning 若已以任何模式（共享或排他性）占有 mutex 的线程调用 lock ，则行为未定义。
+     */
+	void lock();
+
+    /**
+     * @brief 尝试锁定互斥。立即返回。
+     *
+     * @return 成功获得锁时返回 true ，否则返回 false 。
+     *
+     * @note 允许此函数虚假地失败而返回 false ，即使互斥当前未为任何其他线程所锁定。
+     *
+     * @warning 若已以任何模式（共享或排他性）占有 mutex 的线程调用 try_lock ，则行为未定义。
+     */
+	bool try_lock();
+
+    /**
+     * @brief 解锁互斥。
+     *
+     * @warning 互斥必须为当前执行线程所锁定，否则行为未定义。
+     */
+	void unlock();
+
+    /**
+     * @brief 获得互斥的共享所有权。若另一线程以排他性所有权保有互斥，则到 lock_shared 的调用将阻塞执行，直到能取得共享所有权。
+     *
+     * @warning 若已以任何模式（排他性或共享）占有 mutex 的线程调用 lock_shared ，则行为未定义。
+     */
+	void lock_shared()
+    {
+        reader_slot& s = slots_[slot_index()];
+        s.readers.fetch_add(1, std::memory_order_seq_cst);
+        if (writer_.load(std::memory_order_seq_cst) != 0)
+            lock_shared_slow(s);
+    }
+
+    /**
+     * @brief 尝试以共享模式锁定互斥。立即返回。
+     *
+     * @return 成功获得锁时返回 true ，否则返回 false 。
+     *
+     * @note 允许此函数虚假地失败并返回 false ，即使互斥当前不为任何其他线程所排他性锁定。
+     *
+     * @warning 若调用方线程已以任何模式占有互斥，则行为未定义。
+     */
+	bool try_lock_shared();
+
+    /**
+     * @brief 将互斥从调用方线程的共享所有权释放。
+     *
+     * @warning 当前执行线程必须以共享模式锁定互斥，否则行为未定义。
+     */
+	void unlock_shared()
+    {
+        leave(slots_[slot_index()]);
+    }
+
+private:
+    // 本线程使用的槽，线程第一次调用时依次分配
+    static int slot_index()
+    {
+        static std::atomic<unsigned> next(0);
+        static thread_local int index = int(next.fetch_add(1, std::memory_order_relaxed) % slot_count);
+        return index;
+    }
+
+    // 读者离开槽 s；若有写者在等待此槽归零，唤醒它
+    void leave(reader_slot& s)
+    {
+        if (s.readers.fetch_sub(1, std::memory_order_seq_cst) == 1 &&
+                writer_.load(std::memory_order_seq_cst) != 0)
+            wake_writer();
+    }
+
+    void lock_shared_slow(reader_slot& s);
+    void lock_writer_slow();
+    void wait_for_readers();
+    void wait_for_no_writer();
+    void wake_writer();
+};
+
+}	// namespace Hx
+
+#endif
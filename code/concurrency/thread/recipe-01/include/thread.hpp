@@ -9,8 +9,12 @@
 #define MINI_STL_THREAD_INC
 
 #include "thread_id.hpp"
+#include <cstddef>
 #include <memory>
 #include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 namespace Hx {
 
@@ -25,6 +29,8 @@ public:
     typedef thread_id id;
     typedef id::native_handle_type native_handle_type;
 
+    class attributes;
+
     /**
      * @brief 构造不表示线程的新 thread 对象。
      */
@@ -49,13 +55,32 @@ public:
      * @param fn 在新线程中执行的函数
      * @param ...args 参数列表
      */
-    template <typename Fn, typename... Args>
+    template <typename Fn, typename... Args, typename = typename std::enable_if<
+        !std::is_same<typename std::decay<Fn>::type, attributes>::value>::type>
     explicit thread(Fn&& fn, Args&&... args)
     {
         create_thread(make_routine(std::bind(
             std::forward<Fn>(fn), std::forward<Args>(args)...)));
     }
 
+    /**
+     * @brief 按 attr 指定的属性(栈大小, CPU亲和性, 调度策略, 线程名, NUMA节点)创建新线程并运行 fn 。
+     *
+     * @tparam Fn 函数类型
+     * @tparam ...Args 参数类型列表
+     * @param attr 线程属性
+     * @param fn 在新线程中执行的函数
+     * @param ...args 参数列表
+     *
+     * @note 属性无法满足时(如无权限设置实时调度策略)抛出 std::system_error ，不会创建线程。
+     */
+    template <typename Fn, typename... Args>
+    thread(const attributes& attr, Fn&& fn, Args&&... args)
+    {
+        create_thread(make_routine(std::bind(
+            std::forward<Fn>(fn), std::forward<Args>(args)...)), &attr);
+    }
+
     /**
      * @brief 移动构造函数。构造表示曾为 other 所表示的执行线程的 thread 对象。此调用后 other 不再表示执行线程。
      *
@@ -200,8 +225,65 @@ private:
      * @brief 创建线程，在新线程里运行例程
      *
      * @param rtn 例程对象指针
+     * @param attr 线程属性，为空时使用默认属性
+     */
+    void create_thread(routine_base* rtn, const attributes* attr = nullptr);
+};
+
+/**
+ * @brief 线程的创建属性，各设置函数返回 *this ，可以链式调用：
+ *
+ *     Hx::thread t(Hx::thread::attributes().stack_size(64*1024).cpu(2).name("io"), fn);
+ *
+ * 未设置的属性沿用pthread的默认值。
+ */
+class thread::attributes {
+public:
+    attributes(): stack_size_(0), guard_size_(0), has_guard_size_(false),
+        sched_policy_(-1), sched_priority_(0), numa_node_(-1) {}
+
+    /**
+     * @brief 设置栈大小，小于PTHREAD_STACK_MIN时取PTHREAD_STACK_MIN
+     */
+    attributes& stack_size(size_t bytes) { stack_size_ = bytes; return *this; }
+
+    /**
+     * @brief 设置栈溢出保护区大小，0表示不要保护区
+     */
+    attributes& guard_size(size_t bytes) { guard_size_ = bytes; has_guard_size_ = true; return *this; }
+
+    /**
+     * @brief 把 cpu 加入线程可以运行的CPU集合(亲和性)，可以多次调用
+     */
+    attributes& cpu(int cpu) { cpus_.push_back(cpu); return *this; }
+
+    /**
+     * @brief 设置调度策略(SCHED_OTHER, SCHED_FIFO, SCHED_RR等)和优先级，不再继承创建者的调度属性
+     */
+    attributes& scheduling(int policy, int priority) { sched_policy_ = policy; sched_priority_ = priority; return *this; }
+
+    /**
+     * @brief 设置线程名(pthread_setname_np)，超过15个字符的部分被截掉
      */
-    void create_thread(routine_base* rtn);
+    attributes& name(const std::string& name) { name_ = name; return *this; }
+
+    /**
+     * @brief 设置首选NUMA节点：线程优先从该节点分配内存，没有用cpu()指定CPU集合时只在该节点的CPU上运行。
+     *        系统不支持NUMA或没有该节点时忽略。
+     */
+    attributes& numa_node(int node) { numa_node_ = node; return *this; }
+
+private:
+    friend class thread;
+
+    size_t stack_size_;         // 0: 默认
+    size_t guard_size_;
+    bool has_guard_size_;
+    std::vector<int> cpus_;     // 空: 不限制
+    int sched_policy_;          // -1: 继承创建者
+    int sched_priority_;
+    std::string name_;          // 空: 不命名
+    int numa_node_;             // -1: 不指定
 };
 
 inline 
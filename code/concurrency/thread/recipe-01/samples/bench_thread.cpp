@@ -0,0 +1,88 @@
+// Pinned workers against ones the scheduler may move; see "bench.hpp"
+// for the options. The argument is the number of workers per cpu. Every
+// worker allocates and first-touches its own 256 KiB buffer, then sums
+// it 64 times; a worker that stays on one cpu keeps finding the buffer in
+// that cpu's caches (and, with numa, in its node's memory), one that
+// moves has to fetch it again.
+//   std      std::thread
+//   Hx       Hx::thread with default attributes
+//   pinned   Hx::thread with attributes().cpu(i % cpus)
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "thread.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+const size_t buffer_bytes = 256 * 1024;
+const int passes = 64;
+
+struct work {
+    std::atomic<int> ready;
+    std::atomic<bool> go;
+
+    work(): ready(0), go(false) {}
+
+    void operator()()
+    {
+        std::vector<long> buffer(buffer_bytes / sizeof(long), 1);
+        ready.fetch_add(1);
+        while (!go.load(std::memory_order_acquire))
+            std::this_thread::yield();
+        long sum = 0;
+        for (int p = 0; p < passes; p++)
+            for (size_t i = 0; i < buffer.size(); i++)
+                sum += buffer[i];
+        do_not_optimize(sum);
+    }
+};
+
+struct std_spawn {
+    typedef std::thread thread;
+    static std::thread spawn(work& w, unsigned) { return std::thread(std::ref(w)); }
+};
+
+struct hx_spawn {
+    typedef Hx::thread thread;
+    static Hx::thread spawn(work& w, unsigned) { return Hx::thread(std::ref(w)); }
+};
+
+struct pinned_spawn {
+    typedef Hx::thread thread;
+    static Hx::thread spawn(work& w, unsigned i)
+    {
+        return Hx::thread(Hx::thread::attributes().cpu(int(i % std::thread::hardware_concurrency())), std::ref(w));
+    }
+};
+
+template <typename Spawn>
+void locality(state& st)
+{
+    const unsigned n = unsigned(st.arg()) * std::thread::hardware_concurrency();
+    while (st.keep_running()) {
+        st.pause_timing();
+        work w;
+        std::vector<typename Spawn::thread> threads;
+        for (unsigned i = 0; i < n; i++)
+            threads.push_back(Spawn::spawn(w, i));
+        while (w.ready.load() != int(n))
+            std::this_thread::yield();
+        st.resume_timing();
+
+        w.go.store(true, std::memory_order_release);
+        for (size_t i = 0; i < threads.size(); i++)
+            threads[i].join();
+    }
+    st.set_bytes_per_iteration(double(n) * buffer_bytes * passes);
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("thread");
+    s.add("locality", "std", locality<std_spawn>).args({1, 2, 4});
+    s.add("locality", "Hx", locality<hx_spawn>).args({1, 2, 4});
+    s.add("locality", "pinned", locality<pinned_spawn>).args({1, 2, 4});
+    return s.run(argc, argv);
+}
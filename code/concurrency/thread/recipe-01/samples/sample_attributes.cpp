@@ -0,0 +1,39 @@
+#include <iostream>
+#include <pthread.h>
+#include <sched.h>
+#include "thread.hpp"
+
+void report()
+{
+    char name[16];
+    pthread_getname_np(pthread_self(), name, sizeof(name));
+
+    pthread_attr_t attr;
+    size_t stack_size;
+    cpu_set_t set;
+    pthread_getattr_np(pthread_self(), &attr);
+    pthread_attr_getstacksize(&attr, &stack_size);
+    pthread_attr_destroy(&attr);
+    pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+
+    std::cout << "name: " << name << '\n'
+              << "stack size: " << stack_size / 1024 << " KiB\n"
+              << "cpus: " << CPU_COUNT(&set) << ", on cpu 0: " << CPU_ISSET(0, &set) << '\n';
+}
+
+int main()
+{
+    Hx::thread t(Hx::thread::attributes().stack_size(256 * 1024).cpu(0).name("pinned-worker"), report);
+    t.join();
+
+    // attributes the system cannot honour fail the creation
+    try {
+        Hx::thread bad(Hx::thread::attributes().cpu(-1), report);
+        bad.join();
+    } catch (const std::system_error& e) {
+        std::cout << "not created: " << (e.code() == std::errc::invalid_argument) << '\n';
+    }
+
+    return 0;
+}
+
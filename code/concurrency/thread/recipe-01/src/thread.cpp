@@ -1,7 +1,16 @@
 #include "thread.hpp"
 #include <system_error>
+#include <fstream>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
 #include <unistd.h>
 #include <pthread.h>
+#include <sched.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#endif
 
 namespace {
 
@@ -21,6 +30,69 @@ void *pthread_function(void *arg)
     return NULL;
 }
 
+// what a thread created with attributes sets up for itself before it
+// runs its routine
+struct start_info {
+    Hx::thread::routine_base* routine;
+    std::string name;
+    int numa_node;
+};
+
+// the cpus of a numa node, from a sysfs list such as "0-3,8-11"; empty
+// if there is no such node
+std::vector<int> numa_node_cpus(int node)
+{
+    std::vector<int> cpus;
+    char path[64];
+    std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+    std::ifstream in(path);
+    std::string list;
+    if (!std::getline(in, list))
+        return cpus;
+    const char* p = list.c_str();
+    while (*p != '\0') {
+        char* end;
+        long first = std::strtol(p, &end, 10);
+        if (end == p)
+            break;
+        long last = first;
+        if (*end == '-')
+            last = std::strtol(end+1, &end, 10);
+        for (long cpu = first; cpu <= last; cpu++)
+            cpus.push_back(int(cpu));
+        p = (*end == ',') ? end+1 : end;
+    }
+    return cpus;
+}
+
+// asks the kernel to allocate this thread's memory on node when it can;
+// a hint, so failure (no numa support) is ignored
+void prefer_numa_node(int node)
+{
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+    const int bits = int(sizeof(unsigned long)*CHAR_BIT);
+    unsigned long mask[16] = {0};
+    if (node < 0 || node >= bits*16)
+        return;
+    mask[node/bits] = 1UL << (node%bits);
+    syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask, (unsigned long) bits*16);
+#else
+    (void) node;
+#endif
+}
+
+void *pthread_start_function(void *arg)
+{
+    start_info* info = reinterpret_cast<start_info*>(arg);
+    Hx::thread::routine_base* routine = info->routine;
+    if (!info->name.empty())
+        pthread_setname_np(pthread_self(), info->name.substr(0, 15).c_str());
+    if (info->numa_node >= 0)
+        prefer_numa_node(info->numa_node);
+    delete info;
+    return pthread_function(routine);
+}
+
 }   // namespace
 
 namespace Hx {
@@ -59,14 +131,77 @@ void thread::detach()
 	id_ = id();
 }
 
-void thread::create_thread(routine_base* rtn)
+void thread::create_thread(routine_base* rtn, const attributes* attr)
 {
 	pthread_t tid;
-	int error = pthread_create(&tid, NULL, &pthread_function, rtn);
+	if (attr == nullptr) {
+		int error = pthread_create(&tid, NULL, &pthread_function, rtn);
+		if (error != 0) {
+			delete rtn;
+			throw std::system_error(error, std::system_category(), __func__);
+		}
+		id_ = tid;
+		return;
+	}
+
+	std::unique_ptr<routine_base> routine(rtn);
+	std::unique_ptr<start_info> info(new start_info{rtn, attr->name_, attr->numa_node_});
+
+	pthread_attr_t pattr;
+	int error = pthread_attr_init(&pattr);
+	if (error != 0) {
+		throw std::system_error(error, std::system_category(), __func__);
+	}
+
+	if (attr->stack_size_ != 0) {
+		size_t size = attr->stack_size_ < size_t(PTHREAD_STACK_MIN) ? size_t(PTHREAD_STACK_MIN) : attr->stack_size_;
+		error = pthread_attr_setstacksize(&pattr, size);
+	}
+	if (error == 0 && attr->has_guard_size_) {
+		error = pthread_attr_setguardsize(&pattr, attr->guard_size_);
+	}
+
+	// an explicit cpu set wins over the cpus of the numa node
+	std::vector<int> cpus = attr->cpus_;
+	if (cpus.empty() && attr->numa_node_ >= 0) {
+		cpus = numa_node_cpus(attr->numa_node_);
+	}
+	if (error == 0 && !cpus.empty()) {
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		for (size_t i = 0; i < cpus.size(); i++) {
+			if (cpus[i] < 0 || cpus[i] >= CPU_SETSIZE) {
+				error = EINVAL;
+				break;
+			}
+			CPU_SET(cpus[i], &set);
+		}
+		if (error == 0) {
+			error = pthread_attr_setaffinity_np(&pattr, sizeof(set), &set);
+		}
+	}
+
+	if (error == 0 && attr->sched_policy_ != -1) {
+		sched_param param;
+		param.sched_priority = attr->sched_priority_;
+		error = pthread_attr_setinheritsched(&pattr, PTHREAD_EXPLICIT_SCHED);
+		if (error == 0) {
+			error = pthread_attr_setschedpolicy(&pattr, attr->sched_policy_);
+		}
+		if (error == 0) {
+			error = pthread_attr_setschedparam(&pattr, &param);
+		}
+	}
+
+	if (error == 0) {
+		error = pthread_create(&tid, &pattr, &pthread_start_function, info.get());
+	}
+	pthread_attr_destroy(&pattr);
 	if (error != 0) {
-		delete rtn;
 		throw std::system_error(error, std::system_category(), __func__);
 	}
+	info.release();
+	routine.release();
 	id_ = tid;
 }
 
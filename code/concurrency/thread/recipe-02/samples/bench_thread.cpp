@@ -0,0 +1,36 @@
+// Hx::thread against std::thread; see "bench.hpp" for the options.
+// The argument is the number of threads started and joined per iteration,
+// each of which only bumps a counter, so the rows time thread creation
+// and join.
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "thread.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+template <typename Thread>
+void create_join(state& st)
+{
+    const long n = st.arg();
+    std::atomic<long> counter(0);
+    while (st.keep_running()) {
+        std::vector<Thread> threads;
+        for (long i = 0; i < n; i++)
+            threads.push_back(Thread([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); }));
+        for (size_t i = 0; i < threads.size(); i++)
+            threads[i].join();
+    }
+    do_not_optimize(counter);
+    st.set_items_per_iteration(n);
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("thread");
+    s.add("create_join", "std", create_join<std::thread>).args({1, 8});
+    s.add("create_join", "Hx", create_join<Hx::thread>).args({1, 8});
+    return s.run(argc, argv);
+}
@@ -0,0 +1,130 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_CHASE_LEV_DEQUE_INC
+#define MINI_STL_CHASE_LEV_DEQUE_INC
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace Hx {
+
+/**
+ * Chase-Lev work-stealing deque of pointers
+ * (Chase and Lev, "Dynamic circular work-stealing deque", SPAA 2005, with
+ * the C11 memory orders of Le et al., PPoPP 2013).
+ * One thread, the owner, pushes and pops at the bottom; any other thread
+ * may steal from the top. The buffer grows when full; the arrays it grew
+ * out of are kept until the deque is destroyed, since a thief may still
+ * be reading them.
+ */
+template <typename T>
+class chase_lev_deque {
+    struct array {
+        int64_t size;
+        std::atomic<T*>* slots;
+
+        explicit array(int64_t n): size(n), slots(new std::atomic<T*>[n]) {}
+        ~array() { delete [] slots; }
+
+        T* get(int64_t i) const { return slots[i & (size - 1)].load(std::memory_order_relaxed); }
+        void put(int64_t i, T* x) { slots[i & (size - 1)].store(x, std::memory_order_relaxed); }
+    };
+
+    std::atomic<int64_t> top_;
+    std::atomic<int64_t> bottom_;
+    std::atomic<array*> array_;
+    std::vector<array*> retired_;   // owner only
+
+public:
+    /**
+     * Constructs an empty deque with room for capacity pointers
+     * (a power of two).
+     */
+    explicit chase_lev_deque(int64_t capacity = 256): top_(0), bottom_(0), array_(new array(capacity)) {}
+
+    ~chase_lev_deque()
+    {
+        delete array_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < retired_.size(); i++)
+            delete retired_[i];
+    }
+
+    chase_lev_deque(const chase_lev_deque&) = delete;
+    chase_lev_deque& operator=(const chase_lev_deque&) = delete;
+
+    /** Pushes x at the bottom; owner only. */
+    void push(T* x)
+    {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_acquire);
+        array* a = array_.load(std::memory_order_relaxed);
+        if (b - t > a->size - 1)
+            a = grow(a, t, b);
+        a->put(b, x);
+        bottom_.store(b + 1, std::memory_order_release);
+    }
+
+    /** Pops from the bottom, or returns nullptr if empty; owner only. */
+    T* pop()
+    {
+        int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        array* a = array_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        T* x = a->get(b);
+        if (t == b) {
+            // the last element: race the thieves for it
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                x = nullptr;
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return x;
+    }
+
+    /**
+     * Steals from the top. Returns nullptr if the deque is empty, or if
+     * another thread took the element first.
+     */
+    T* steal()
+    {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b)
+            return nullptr;
+        array* a = array_.load(std::memory_order_acquire);
+        T* x = a->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        return x;
+    }
+
+    /** True if the deque looked empty; a hint only, as for any thread but the owner. */
+    bool empty() const
+    {
+        return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed);
+    }
+
+private:
+    array* grow(array* a, int64_t t, int64_t b)
+    {
+        array* bigger = new array(a->size * 2);
+        for (int64_t i = t; i < b; i++)
+            bigger->put(i, a->get(i));
+        retired_.push_back(a);
+        array_.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+};
+
+}    // namespace Hx
+
+#endif
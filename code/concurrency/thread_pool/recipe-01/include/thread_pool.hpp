@@ -0,0 +1,390 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_THREAD_POOL_INC
+#define MINI_STL_THREAD_POOL_INC
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "thread.hpp"
+#include "chase_lev_deque.hpp"
+
+namespace Hx {
+
+class thread_pool;
+class task_group;
+
+/**
+ * A queued call. Tasks of up to task_block_size bytes come from a
+ * per-thread free list instead of operator new.
+ */
+class pool_task {
+public:
+    static const size_t task_block_size = 64;
+    static const size_t task_cache_limit = 4096;
+
+    virtual ~pool_task() {}
+
+    /** Runs the call, then destroys the task. */
+    virtual void execute() noexcept = 0;
+
+    static void* operator new(size_t n)
+    {
+        if (n > task_block_size)
+            return ::operator new(n);
+        task_cache& cache = local_cache();
+        if (cache.head == nullptr)
+            return ::operator new(task_block_size);
+        free_block* b = cache.head;
+        cache.head = b->next;
+        --cache.count;
+        return b;
+    }
+
+    static void operator delete(void* p, size_t n)
+    {
+        if (n > task_block_size) {
+            ::operator delete(p);
+            return;
+        }
+        task_cache& cache = local_cache();
+        if (cache.count >= task_cache_limit) {
+            ::operator delete(p);
+            return;
+        }
+        free_block* b = static_cast<free_block*>(p);
+        b->next = cache.head;
+        cache.head = b;
+        ++cache.count;
+    }
+
+private:
+    struct free_block {
+        free_block* next;
+    };
+
+    struct task_cache {
+        free_block* head = nullptr;
+        size_t count = 0;
+
+        ~task_cache()
+        {
+            while (head != nullptr) {
+                free_block* b = head;
+                head = b->next;
+                ::operator delete(b);
+            }
+        }
+    };
+
+    static task_cache& local_cache()
+    {
+        static thread_local task_cache cache;
+        return cache;
+    }
+};
+
+/**
+ * Work-stealing thread pool
+ * Each worker (an Hx::thread) owns a Chase-Lev deque: the tasks a worker
+ * submits go to the bottom of its own deque and it runs them newest first,
+ * while idle workers steal the oldest ones from the top of a random
+ * victim's. Tasks submitted from outside the pool go through one shared
+ * queue. Workers with nothing to run or steal sleep on a condition
+ * variable.
+ * The destructor runs every task submitted before it, then joins the
+ * workers.
+ */
+class thread_pool {
+    friend class task_group;
+
+    struct worker_slot {
+        thread_pool* pool;
+        unsigned index;
+    };
+
+    std::vector<std::unique_ptr<chase_lev_deque<pool_task>>> deques_;
+    std::vector<thread> workers_;
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<pool_task*> injected_;           // guarded by mtx_
+    std::atomic<size_t> injected_size_;
+    std::atomic<unsigned> sleeping_;
+    unsigned long epoch_ = 0;                   // guarded by mtx_
+    bool stop_ = false;                         // guarded by mtx_
+
+public:
+    /**
+     * Starts threads workers, by default one per hardware thread.
+     */
+    explicit thread_pool(unsigned threads = thread::hardware_concurrency()):
+        injected_size_(0), sleeping_(0)
+    {
+        if (threads == 0)
+            threads = 1;
+        for (unsigned i = 0; i < threads; i++)
+            deques_.emplace_back(new chase_lev_deque<pool_task>());
+        for (unsigned i = 0; i < threads; i++)
+            workers_.emplace_back(&thread_pool::work, this, i);
+    }
+
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stop_ = true;
+            ++epoch_;
+        }
+        cv_.notify_all();
+        for (size_t i = 0; i < workers_.size(); i++)
+            workers_[i].join();
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    /** Number of workers. */
+    unsigned size() const { return unsigned(workers_.size()); }
+
+    /**
+     * Queues fn() to run on one of the workers. As with Hx::thread, an
+     * exception escaping fn calls std::terminate; use a task_group to get
+     * it back.
+     */
+    template <typename Fn>
+    void submit(Fn&& fn)
+    {
+        push(new call_task<typename std::decay<Fn>::type>(std::forward<Fn>(fn)));
+    }
+
+    /**
+     * Runs one queued task on the calling thread, if there is one.
+     * Returns false if none was found.
+     */
+    bool run_pending_task()
+    {
+        pool_task* t = find_task();
+        if (t == nullptr)
+            return false;
+        t->execute();
+        return true;
+    }
+
+private:
+    template <typename Fn>
+    class call_task: public pool_task {
+        Fn fn_;
+
+    public:
+        template <typename F>
+        explicit call_task(F&& fn): fn_(std::forward<F>(fn)) {}
+
+        void execute() noexcept
+        {
+            fn_();
+            delete this;
+        }
+    };
+
+    static worker_slot& current()
+    {
+        static thread_local worker_slot slot = { nullptr, 0 };
+        return slot;
+    }
+
+    void push(pool_task* t)
+    {
+        worker_slot& self = current();
+        if (self.pool == this) {
+            deques_[self.index]->push(t);
+        } else {
+            std::lock_guard<std::mutex> lock(mtx_);
+            injected_.push_back(t);
+            injected_size_.fetch_add(1, std::memory_order_relaxed);
+        }
+        // pairs with the fence in work(): either a worker about to sleep
+        // sees the task, or we see it sleeping and wake it
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping_.load(std::memory_order_relaxed) > 0) {
+            {
+                std::lock_guard<std::mutex> lock(mtx_);
+                ++epoch_;
+            }
+            cv_.notify_one();
+        }
+    }
+
+    pool_task* find_task()
+    {
+        worker_slot& self = current();
+        if (self.pool == this) {
+            if (pool_task* t = deques_[self.index]->pop())
+                return t;
+        }
+        if (injected_size_.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (!injected_.empty()) {
+                pool_task* t = injected_.front();
+                injected_.pop_front();
+                injected_size_.fetch_sub(1, std::memory_order_relaxed);
+                return t;
+            }
+        }
+        unsigned n = unsigned(deques_.size());
+        unsigned start = random_index() % n;
+        for (unsigned i = 0; i < n; i++) {
+            unsigned victim = (start + i) % n;
+            if (self.pool == this && victim == self.index)
+                continue;
+            if (pool_task* t = deques_[victim]->steal())
+                return t;
+        }
+        return nullptr;
+    }
+
+    static unsigned random_index()
+    {
+        static thread_local unsigned state = unsigned(reinterpret_cast<uintptr_t>(&state)) | 1;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    bool looks_idle() const
+    {
+        if (injected_size_.load(std::memory_order_relaxed) > 0)
+            return false;
+        for (size_t i = 0; i < deques_.size(); i++) {
+            if (!deques_[i]->empty())
+                return false;
+        }
+        return true;
+    }
+
+    void work(unsigned index)
+    {
+        worker_slot& self = current();
+        self.pool = this;
+        self.index = index;
+        for (;;) {
+            pool_task* t = nullptr;
+            for (int spin = 0; spin < 64 && t == nullptr; spin++) {
+                t = find_task();
+                if (t == nullptr)
+                    std::this_thread::yield();
+            }
+            if (t != nullptr) {
+                t->execute();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mtx_);
+            sleeping_.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (looks_idle()) {
+                if (stop_) {
+                    sleeping_.fetch_sub(1, std::memory_order_relaxed);
+                    return;
+                }
+                unsigned long seen = epoch_;
+                cv_.wait(lock, [&] { return stop_ || epoch_ != seen; });
+            }
+            sleeping_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * A set of tasks to wait for
+ * run() queues a task on the pool; wait() returns once all of them have
+ * finished, running queued tasks (of this group or others) on the calling
+ * thread in the meantime, so that waiting inside a task does not tie up
+ * a worker. The first exception thrown by a task is rethrown by wait().
+ * The destructor waits too.
+ */
+class task_group {
+    thread_pool& pool_;
+    std::atomic<long> pending_;
+    std::atomic<bool> failed_;
+    std::exception_ptr error_;
+
+public:
+    explicit task_group(thread_pool& pool): pool_(pool), pending_(0), failed_(false) {}
+
+    ~task_group()
+    {
+        help_until_done();
+    }
+
+    task_group(const task_group&) = delete;
+    task_group& operator=(const task_group&) = delete;
+
+    template <typename Fn>
+    void run(Fn&& fn)
+    {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        pool_.push(new group_task<typename std::decay<Fn>::type>(this, std::forward<Fn>(fn)));
+    }
+
+    void wait()
+    {
+        help_until_done();
+        if (failed_.load(std::memory_order_relaxed)) {
+            std::exception_ptr e = error_;
+            error_ = nullptr;
+            failed_.store(false, std::memory_order_relaxed);
+            std::rethrow_exception(e);
+        }
+    }
+
+private:
+    template <typename Fn>
+    class group_task: public pool_task {
+        task_group* group_;
+        Fn fn_;
+
+    public:
+        template <typename F>
+        group_task(task_group* group, F&& fn): group_(group), fn_(std::forward<F>(fn)) {}
+
+        void execute() noexcept
+        {
+            task_group* group = group_;
+            try {
+                fn_();
+            } catch (...) {
+                bool expected = false;
+                if (group->failed_.compare_exchange_strong(expected, true))
+                    group->error_ = std::current_exception();
+            }
+            delete this;
+            group->pending_.fetch_sub(1, std::memory_order_release);
+        }
+    };
+
+    void help_until_done()
+    {
+        while (pending_.load(std::memory_order_acquire) > 0) {
+            if (!pool_.run_pending_task())
+                std::this_thread::yield();
+        }
+    }
+};
+
+}    // namespace Hx
+
+#endif
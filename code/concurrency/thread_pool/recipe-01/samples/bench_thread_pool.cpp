@@ -0,0 +1,152 @@
+// Hx::thread_pool against one Hx::thread per task; see "bench.hpp" for
+// the options. fib and quicksort fork one task per call above a cutoff
+// (below it they run sequentially) and join it before returning;
+// small_tasks runs arg tasks that only bump a counter. "sequential" is
+// the same recursion without any task.
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <vector>
+#include "thread.hpp"
+#include "thread_pool.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+const int fib_cutoff = 12;
+const long quicksort_cutoff = 4096;
+
+Hx::thread_pool& pool()
+{
+    static Hx::thread_pool p;
+    return p;
+}
+
+long fib_seq(int n)
+{
+    return (n < 2) ? n : fib_seq(n - 1) + fib_seq(n - 2);
+}
+
+// fork/join with the pool, one plain Hx::thread per fork, or no fork
+struct pool_fork {
+    template <typename Fn, typename Gn>
+    static void invoke(Fn fn, Gn gn)
+    {
+        Hx::task_group g(pool());
+        g.run(fn);
+        gn();
+        g.wait();
+    }
+};
+
+struct thread_fork {
+    template <typename Fn, typename Gn>
+    static void invoke(Fn fn, Gn gn)
+    {
+        Hx::thread t(fn);
+        gn();
+        t.join();
+    }
+};
+
+struct no_fork {
+    template <typename Fn, typename Gn>
+    static void invoke(Fn fn, Gn gn)
+    {
+        fn();
+        gn();
+    }
+};
+
+template <typename Fork>
+long fib(int n)
+{
+    if (n < fib_cutoff)
+        return fib_seq(n);
+    long a, b;
+    Fork::invoke([&a, n] { a = fib<Fork>(n - 1); }, [&b, n] { b = fib<Fork>(n - 2); });
+    return a + b;
+}
+
+template <typename Fork>
+void quicksort(int* a, long n)
+{
+    if (n < quicksort_cutoff) {
+        std::sort(a, a + n);
+        return;
+    }
+    int pivot = std::max(std::min(a[0], a[n / 2]), std::min(std::max(a[0], a[n / 2]), a[n - 1]));
+    int* mid1 = std::partition(a, a + n, [pivot](int x) { return x < pivot; });
+    int* mid2 = std::partition(mid1, a + n, [pivot](int x) { return !(pivot < x); });
+    Fork::invoke([a, mid1] { quicksort<Fork>(a, mid1 - a); },
+        [a, n, mid2] { quicksort<Fork>(mid2, a + n - mid2); });
+}
+
+template <typename Fork>
+void run_fib(state& st)
+{
+    pool();
+    while (st.keep_running())
+        do_not_optimize(fib<Fork>(int(st.arg())));
+}
+
+template <typename Fork>
+void run_quicksort(state& st)
+{
+    std::mt19937 gen(st.arg());
+    std::vector<int> input(st.arg());
+    for (size_t i = 0; i < input.size(); i++)
+        input[i] = int(gen());
+    std::vector<int> v(input);
+    pool();
+    while (st.keep_running()) {
+        st.pause_timing();
+        std::copy(input.begin(), input.end(), v.begin());
+        st.resume_timing();
+        quicksort<Fork>(v.data(), long(v.size()));
+        do_not_optimize(v.data());
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+void small_tasks_pool(state& st)
+{
+    std::atomic<long> counter(0);
+    while (st.keep_running()) {
+        Hx::task_group g(pool());
+        for (long i = 0; i < st.arg(); i++)
+            g.run([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        g.wait();
+    }
+    do_not_optimize(counter.load());
+    st.set_items_per_iteration(st.arg());
+}
+
+void small_tasks_thread(state& st)
+{
+    std::atomic<long> counter(0);
+    std::vector<Hx::thread> threads(st.arg());
+    while (st.keep_running()) {
+        for (long i = 0; i < st.arg(); i++)
+            threads[i] = Hx::thread([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        for (long i = 0; i < st.arg(); i++)
+            threads[i].join();
+    }
+    do_not_optimize(counter.load());
+    st.set_items_per_iteration(st.arg());
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("thread_pool");
+    s.add("fib", "sequential", run_fib<no_fork>).args({20, 25});
+    s.add("fib", "Hx::thread", run_fib<thread_fork>).args({20, 25});
+    s.add("fib", "thread_pool", run_fib<pool_fork>).args({20, 25});
+    s.add("quicksort", "sequential", run_quicksort<no_fork>).args({1 << 20});
+    s.add("quicksort", "Hx::thread", run_quicksort<thread_fork>).args({1 << 20});
+    s.add("quicksort", "thread_pool", run_quicksort<pool_fork>).args({1 << 20});
+    s.add("small_tasks", "Hx::thread", small_tasks_thread).args({1000, 10000});
+    s.add("small_tasks", "thread_pool", small_tasks_pool).args({1000, 10000});
+    return s.run(argc, argv);
+}
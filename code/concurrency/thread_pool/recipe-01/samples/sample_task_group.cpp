@@ -0,0 +1,42 @@
+// task_group example
+#include <iostream>         // std::cout
+#include <stdexcept>        // std::runtime_error
+#include "thread_pool.hpp"  // Hx::thread_pool, Hx::task_group
+
+Hx::thread_pool pool;
+
+// fork/join: each call forks fib(n-1) as a task and computes fib(n-2)
+// itself; wait() runs queued tasks instead of blocking the worker
+long fib (int n)
+{
+  if (n < 2) return n;
+  long a, b;
+  Hx::task_group g(pool);
+  g.run([&a,n] { a = fib(n-1); });
+  b = fib(n-2);
+  g.wait();
+  return a + b;
+}
+
+int main ()
+{
+  std::cout << "fib(20) = " << fib(20) << '\n';
+
+  // the first exception of a task is rethrown by wait()
+  Hx::task_group g(pool);
+  g.run([] { throw std::runtime_error("task failed"); });
+  try {
+    g.wait();
+  } catch (std::exception& e) {
+    std::cout << "caught: " << e.what() << '\n';
+  }
+
+  return 0;
+}
+
+/*
+Output:
+
+fib(20) = 6765
+caught: task failed
+*/
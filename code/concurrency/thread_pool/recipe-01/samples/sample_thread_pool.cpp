@@ -0,0 +1,27 @@
+// thread_pool example
+#include <iostream>         // std::cout
+#include <atomic>           // std::atomic
+#include "thread_pool.hpp"  // Hx::thread_pool, Hx::task_group
+
+int main ()
+{
+  std::atomic<int> sum(0);
+  {
+    Hx::thread_pool pool(4);
+    std::cout << "workers: " << pool.size() << '\n';
+
+    // fire and forget: the destructor runs every task submitted
+    for (int i=1; i<=100; ++i)
+      pool.submit([&sum,i] { sum += i; });
+  }
+  std::cout << "sum of 1..100: " << sum << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+workers: 4
+sum of 1..100: 5050
+*/
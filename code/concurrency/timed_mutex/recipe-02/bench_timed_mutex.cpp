@@ -0,0 +1,96 @@
+// The futex Hx::timed_mutex against std::timed_mutex (a pthread_mutex_t
+// with pthread_mutex_timedlock); see "bench.hpp" for the options.
+//   lock_unlock/N   N threads taking the mutex in turn
+//   try_lock_for/N  the same with try_lock_for(1s), which never times out
+//   timeout/US      try_lock_for(US microseconds) on a mutex another thread
+//                   holds; the time per iteration minus US is how late
+//                   the timeout fires
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "timed_mutex.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+template <typename Mutex, bool Timed>
+void contended(state& st)
+{
+    Mutex mtx;
+    long counter = 0;
+    std::atomic<bool> done(false);
+    auto take = [&mtx]() {
+        if (Timed)
+            return mtx.try_lock_for(std::chrono::seconds(1));
+        mtx.lock();
+        return true;
+    };
+    std::vector<std::thread> others;
+    for (long i = 1; i < st.arg(); i++) {
+        others.push_back(std::thread([&]() {
+            while (!done.load(std::memory_order_relaxed)) {
+                if (take()) {
+                    counter++;
+                    mtx.unlock();
+                }
+            }
+        }));
+    }
+
+    while (st.keep_running()) {
+        if (take()) {
+            counter++;
+            mtx.unlock();
+        }
+    }
+
+    done = true;
+    for (size_t i = 0; i < others.size(); i++)
+        others[i].join();
+    do_not_optimize(counter);
+}
+
+template <typename Mutex>
+void timeout(state& st)
+{
+    const std::chrono::microseconds rel_time(st.arg());
+    Mutex mtx;
+    std::atomic<bool> held(false), done(false);
+    std::thread owner([&]() {
+        mtx.lock();
+        held = true;
+        while (!done.load())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        mtx.unlock();
+    });
+    while (!held.load())
+        std::this_thread::yield();
+
+    while (st.keep_running()) {
+        bool r = mtx.try_lock_for(rel_time);
+        do_not_optimize(r);
+    }
+
+    done = true;
+    owner.join();
+}
+
+int main(int argc, char* argv[])
+{
+    // glibc skips the atomic instructions of pthread_mutex_lock until the
+    // process starts its first thread; start one so that every row runs
+    // as in a threaded program
+    std::thread([] {}).join();
+
+    Hx::bench::suite s("timed_mutex");
+    s.add("lock_unlock", "std", contended<std::timed_mutex, false>).args({1, 2, 4, 8});
+    s.add("lock_unlock", "Hx", contended<Hx::timed_mutex, false>).args({1, 2, 4, 8});
+    s.add("try_lock_for", "std", contended<std::timed_mutex, true>).args({1, 2, 4, 8});
+    s.add("try_lock_for", "Hx", contended<Hx::timed_mutex, true>).args({1, 2, 4, 8});
+    s.add("timeout", "std", timeout<std::timed_mutex>).args({10, 100, 1000});
+    s.add("timeout", "Hx", timeout<Hx::timed_mutex>).args({10, 100, 1000});
+    return s.run(argc, argv);
+}
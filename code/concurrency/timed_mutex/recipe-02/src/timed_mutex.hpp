@@ -0,0 +1,179 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_TIMED_MUTEX_INC
+#define MINI_STL_TIMED_MUTEX_INC
+
+#include <chrono>
+#include "mutex.hpp"
+
+namespace Hx {
+
+/**
+ * Timed mutex class
+ * A timed mutex is a time lockable object that is designed to signal when 
+ * critical sections of code need exclusive access, just like a regular mutex, 
+ * but additionally supporting timed try-lock requests.
+ *
+ * On Linux it is the futex word of mutex, locked the same way (with the
+ * same adaptive spin). A timed lock sleeps in FUTEX_WAIT with a timeout
+ * on CLOCK_MONOTONIC, so setting the wall clock does not make it wait
+ * longer or give up early. Elsewhere, or with HX_MUTEX_USE_PTHREAD
+ * defined, it wraps a pthread_mutex_t and pthread_mutex_timedlock.
+ */
+class timed_mutex {
+#if defined(HX_MUTEX_USE_FUTEX)
+    std::atomic<int> state_;     // 0, 1 or 2, as in mutex
+    std::atomic<int> spin_;      // running average of the spins that paid off
+#else
+    pthread_mutex_t mtx_;        // native mutex handle
+#endif
+
+public:
+#if defined(HX_MUTEX_USE_FUTEX)
+    typedef std::atomic<int>* native_handle_type;
+#else
+    typedef pthread_mutex_t* native_handle_type;
+#endif
+
+    /**
+     * Constructs the mutex. 
+     * The mutex is in unlocked state after the call. 
+     */
+    timed_mutex();
+
+    /** Destroys the mutex. */
+    ~timed_mutex();
+
+    timed_mutex(const timed_mutex&) = delete;
+    timed_mutex& operator=(const timed_mutex&) = delete;
+
+#if defined(HX_MUTEX_USE_FUTEX)
+    /**
+     * Locks the mutex. 
+     * If another thread has already locked the mutex, a call to lock will 
+     * block execution until the lock is acquired. If lock is called by a 
+     * thread that already owns the mutex, the program may deadlock. 
+     */
+    void lock()
+    {
+        int c = 0;
+        if (!state_.compare_exchange_strong(c, 1, std::memory_order_acquire, std::memory_order_relaxed))
+            detail::futex_lock_slow(state_, spin_);
+    }
+
+    /**
+     * Tries to lock the mutex. Returns immediately. 
+     * On successful lock acquisition returns true, otherwise returns false.
+     * The behavior is undefined if the mutex is not unlocked 
+     * before being destroyed, i.e. some thread still owns it. 
+     */
+    bool try_lock()
+    {
+        int c = 0;
+        return state_.compare_exchange_strong(c, 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    /**
+     * Unlocks the mutex.
+     * The mutex must be unlocked by all threads that have successfully locked 
+     * it before being destroyed. Otherwise, the behavior is undefined. 
+     */
+    void unlock()
+    {
+        if (state_.exchange(0, std::memory_order_release) == 2)
+            futex_wake(&state_, 1);
+    }
+
+    /**
+     * Tries to lock the mutex. Blocks until specified rel_time 
+     * has elapsed or the lock is acquired, whichever comes first. 
+     * On successful lock acquisition returns true, otherwise returns false.
+     */
+    template <typename Rep, typename Period>
+    bool try_lock_for(const std::chrono::duration<Rep, Period> &rel_time)
+    {
+        using namespace std::chrono;
+        return try_lock() || timed_lock(steady_clock::now()+ceil_cast(rel_time));
+    }
+
+    /**
+     * Tries to lock the mutex. Blocks until specified abs_time 
+     * has been reached or the lock is acquired, whichever comes first. 
+     * On successful lock acquisition returns true, otherwise returns false. 
+     * The sleep itself is timed on steady_clock; for other clocks the
+     * time left is measured once, on entry.
+     */
+    template <typename Clock, typename Duration>
+    bool try_lock_until(const std::chrono::time_point<Clock, Duration> &abs_time)
+    {
+        using namespace std::chrono;
+        return try_lock() || timed_lock(steady_clock::now()+ceil_cast(abs_time-Clock::now()));
+    }
+
+    template <typename Duration>
+    bool try_lock_until(const std::chrono::time_point<std::chrono::steady_clock, Duration> &abs_time)
+    {
+        using namespace std::chrono;
+        return try_lock() || timed_lock(time_point_cast<steady_clock::duration>(abs_time));
+    }
+
+    /** 
+     * Returns the underlying implementation-defined native handle object:
+     * the futex word.
+     */
+    native_handle_type native_handle() { return &state_; }
+
+private:
+    bool timed_lock(std::chrono::steady_clock::time_point deadline)
+    {
+        return detail::futex_lock_slow(state_, spin_, &deadline);
+    }
+
+    // rel_time in steady_clock ticks, rounded up so we never give up early
+    template <typename Rep, typename Period>
+    static std::chrono::steady_clock::duration ceil_cast(const std::chrono::duration<Rep, Period>& rel_time)
+    {
+        using namespace std::chrono;
+        steady_clock::duration r = duration_cast<steady_clock::duration>(rel_time);
+        return r < rel_time ? r+steady_clock::duration(1) : r;
+    }
+#else
+    void lock(); 
+    bool try_lock(); 
+    void unlock(); 
+
+    template <typename Rep, typename Period>
+    bool try_lock_for(const std::chrono::duration<Rep, Period> &rel_time)
+    {
+        using namespace std::chrono;
+        auto abs_time = system_clock::now()+rel_time;
+        // convert abs_time to timespec type
+        seconds sec = duration_cast<seconds>(abs_time.time_since_epoch());
+        nanoseconds nsec = duration_cast<nanoseconds>((abs_time-sec).time_since_epoch());
+        struct timespec ts;
+        ts.tv_sec = sec.count();
+        ts.tv_nsec = nsec.count();
+        return timed_lock(&mtx_, &ts);
+    }
+
+    template <typename Clock, typename Duration>
+    bool try_lock_until(const std::chrono::time_point<Clock, Duration> &abs_time)
+    {
+        return try_lock_for(abs_time-Clock::now());
+    }
+
+    /** 
+     * Returns the underlying implementation-defined native handle object. 
+     */
+    native_handle_type native_handle() { return &mtx_; }
+
+private:
+    static bool timed_lock(pthread_mutex_t* mutex, const struct timespec* abstime);
+#endif
+};
+
+}    // namespace Hx
+
+#endif
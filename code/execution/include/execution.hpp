@@ -0,0 +1,95 @@
+#pragma once
+
+#include <type_traits>
+#include "thread.hpp"
+
+namespace Hx {
+namespace execution {
+
+/**
+ * Sequenced execution policy
+ * The algorithm runs on the calling thread, in order, like the overload
+ * without a policy.
+ */
+class sequenced_policy {
+public:
+    unsigned concurrency() const { return 1; }
+};
+
+/**
+ * Parallel execution policy
+ * The algorithm may be split into chunks that run on the fork_join_pool.
+ * par(n) limits it to n threads (the calling thread included); the default
+ * is thread::hardware_concurrency().
+ */
+class parallel_policy {
+    unsigned threads_ = 0;
+
+public:
+    constexpr parallel_policy() {}
+    constexpr explicit parallel_policy(unsigned threads): threads_(threads) {}
+
+    parallel_policy operator()(unsigned threads) const { return parallel_policy(threads); }
+
+    unsigned concurrency() const
+    {
+        unsigned n = threads_ ? threads_ : thread::hardware_concurrency();
+        return n ? n : 1;
+    }
+};
+
+/**
+ * Parallel and unsequenced execution policy
+ * As parallel_policy, and in addition the element accesses of one chunk may
+ * be interleaved, so that the inner loops carry no early exit and can be
+ * vectorized.
+ */
+class parallel_unsequenced_policy {
+    unsigned threads_ = 0;
+
+public:
+    constexpr parallel_unsequenced_policy() {}
+    constexpr explicit parallel_unsequenced_policy(unsigned threads): threads_(threads) {}
+
+    parallel_unsequenced_policy operator()(unsigned threads) const
+    {
+        return parallel_unsequenced_policy(threads);
+    }
+
+    unsigned concurrency() const
+    {
+        unsigned n = threads_ ? threads_ : thread::hardware_concurrency();
+        return n ? n : 1;
+    }
+};
+
+constexpr sequenced_policy seq{};
+constexpr parallel_policy par{};
+constexpr parallel_unsequenced_policy par_unseq{};
+
+/**
+ * Checks whether T is an execution policy type.
+ */
+template <typename T>
+struct is_execution_policy: std::false_type {};
+
+template <>
+struct is_execution_policy<sequenced_policy>: std::true_type {};
+
+template <>
+struct is_execution_policy<parallel_policy>: std::true_type {};
+
+template <>
+struct is_execution_policy<parallel_unsequenced_policy>: std::true_type {};
+
+/**
+ * Removes the policy-taking overloads of an algorithm from overload
+ * resolution unless ExecutionPolicy (after decay) is an execution policy.
+ */
+template <typename ExecutionPolicy, typename T>
+struct enable_if_execution_policy: std::enable_if<
+    is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, T> {};
+
+}   // namespace execution
+}   // namespace Hx
+
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include "thread.hpp"
+
+namespace Hx {
+namespace execution {
+
+/**
+ * Fork-join pool behind the parallel execution policies.
+ * The workers are Hx::thread objects, started on first use and kept until
+ * program exit. run(n, fn) calls fn(0) ... fn(n-1) on n threads, the calling
+ * thread included, and returns once all the calls have returned.
+ * One job runs at a time; a run() issued from inside a job executes inline.
+ */
+class fork_join_pool {
+    typedef std::function<void(unsigned)> job_type;
+
+    std::mutex run_mtx_;        // serializes jobs
+    std::mutex mtx_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    std::vector<thread> workers_;
+    const job_type* job_ = nullptr;
+    unsigned job_size_ = 0;
+    std::atomic<unsigned> next_{0};
+    unsigned long generation_ = 0;
+    unsigned active_ = 0;       // workers that have not finished the current job
+    bool stop_ = false;
+
+public:
+    static fork_join_pool& instance()
+    {
+        static fork_join_pool pool;
+        return pool;
+    }
+
+    fork_join_pool() = default;
+    fork_join_pool(const fork_join_pool&) = delete;
+    fork_join_pool& operator=(const fork_join_pool&) = delete;
+
+    ~fork_join_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stop_ = true;
+        }
+        work_cv_.notify_all();
+        for (auto& t: workers_) {
+            t.join();
+        }
+    }
+
+    /**
+     * Calls fn(i) for every i in [0, n), on up to n threads.
+     * As with the standard parallel algorithms, an exception escaping fn
+     * calls std::terminate.
+     */
+    template <typename Fn>
+    void run(unsigned n, Fn fn)
+    {
+        if (n <= 1 || in_worker()) {
+            for (unsigned i = 0; i < n; ++i) {
+                fn(i);
+            }
+            return;
+        }
+
+        job_type job = [&fn](unsigned i) { fn(i); };
+        std::lock_guard<std::mutex> serial(run_mtx_);
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            while (workers_.size() < n - 1) {
+                workers_.emplace_back(&fork_join_pool::work, this);
+            }
+            job_ = &job;
+            job_size_ = n;
+            next_.store(0, std::memory_order_relaxed);
+            active_ = workers_.size();
+            ++generation_;
+        }
+        work_cv_.notify_all();
+
+        in_worker() = true;
+        drain();
+        in_worker() = false;
+
+        std::unique_lock<std::mutex> lock(mtx_);
+        done_cv_.wait(lock, [this] { return active_ == 0; });
+        job_ = nullptr;
+    }
+
+private:
+    static bool& in_worker()
+    {
+        static thread_local bool flag = false;
+        return flag;
+    }
+
+    void drain() noexcept
+    {
+        unsigned i;
+        while ((i = next_.fetch_add(1, std::memory_order_relaxed)) < job_size_) {
+            (*job_)(i);
+        }
+    }
+
+    void work()
+    {
+        in_worker() = true;
+        unsigned long seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mtx_);
+                work_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_)
+                    return;
+                seen = generation_;
+            }
+            drain();
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (--active_ == 0)
+                done_cv_.notify_one();
+        }
+    }
+};
+
+}   // namespace execution
+}   // namespace Hx
+
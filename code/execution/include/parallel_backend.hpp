@@ -0,0 +1,240 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include "execution.hpp"
+#include "fork_join_pool.hpp"
+
+namespace Hx {
+namespace execution {
+
+/**
+ * Ranges shorter than this many elements per thread are not worth
+ * waking the pool for.
+ */
+const long parallel_grain = 4096;
+
+/**
+ * Number of chunks a range of n elements is split into under policy.
+ */
+template <typename ExecutionPolicy, typename Size>
+unsigned chunk_count(const ExecutionPolicy& policy, Size n)
+{
+    Size k = n / parallel_grain;
+    return k < Size(policy.concurrency()) ? (k > 0 ? unsigned(k) : 1u) : policy.concurrency();
+}
+
+/**
+ * Calls fn(c, lo, hi) for each of k contiguous chunks [lo, hi) of [0, n),
+ * one chunk per thread, and returns k.
+ */
+template <typename ExecutionPolicy, typename Size, typename Fn>
+unsigned for_each_chunk(const ExecutionPolicy& policy, Size n, Fn fn)
+{
+    unsigned k = chunk_count(policy, n);
+    fork_join_pool::instance().run(k, [&](unsigned c) {
+        fn(c, n / k * c + std::min<Size>(c, n % k), n / k * (c + 1) + std::min<Size>(c + 1, n % k));
+    });
+    return k;
+}
+
+/**
+ * First i in [lo, hi) for which test(i) is true, or hi.
+ */
+template <typename Size, typename Test>
+Size scan_first(Size lo, Size hi, Test& test)
+{
+    while (lo < hi && !test(lo))
+        ++lo;
+    return lo;
+}
+
+/**
+ * Same as scan_first, but tests a whole stride before looking at the
+ * results, so the inner loop has no early exit and can be vectorized.
+ */
+template <typename Size, typename Test>
+Size scan_first_unseq(Size lo, Size hi, Test& test)
+{
+    const Size stride = 64;
+    for ( ; hi - lo >= stride; lo += stride) {
+        bool hit = false;
+        for (Size j = 0; j < stride; ++j)
+            hit |= bool(test(lo + j));
+        if (hit)
+            break;
+    }
+    return scan_first(lo, hi, test);
+}
+
+/**
+ * First i in [0, n) for which test(i) is true, or n.
+ * The range is cut into blocks that the threads claim in increasing order.
+ * Once a match is found, blocks starting after it are no longer claimed,
+ * which cancels the search on the other threads at the next block boundary.
+ */
+template <typename Size, typename Test, typename Scan>
+Size parallel_find_first(unsigned threads, Size n, Test& test, Scan scan)
+{
+    if (threads <= 1)
+        return scan(Size(0), n, test);
+
+    const Size block = std::max<Size>(n / (Size(threads) * 16), parallel_grain);
+    const Size blocks = (n + block - 1) / block;
+    std::atomic<Size> found(n);
+    std::atomic<Size> next(0);
+
+    fork_join_pool::instance().run(threads, [&](unsigned) {
+        for (;;) {
+            Size b = next.fetch_add(1, std::memory_order_relaxed);
+            if (b >= blocks)
+                return;
+            Size lo = b * block;
+            if (lo >= found.load(std::memory_order_relaxed))
+                return;     // an earlier block already matched
+            Size hi = std::min(n, lo + block);
+            Size i = scan(lo, hi, test);
+            if (i == hi)
+                continue;
+            Size cur = found.load(std::memory_order_relaxed);
+            while (i < cur && !found.compare_exchange_weak(cur, i, std::memory_order_relaxed))
+                ;
+        }
+    });
+    return found.load(std::memory_order_relaxed);
+}
+
+template <typename Size, typename Test>
+Size find_first(const sequenced_policy&, Size n, Test test)
+{
+    return scan_first(Size(0), n, test);
+}
+
+template <typename Size, typename Test>
+Size find_first(const parallel_policy& policy, Size n, Test test)
+{
+    return parallel_find_first(chunk_count(policy, n), n, test, scan_first<Size, Test>);
+}
+
+template <typename Size, typename Test>
+Size find_first(const parallel_unsequenced_policy& policy, Size n, Test test)
+{
+    return parallel_find_first(chunk_count(policy, n), n, test, scan_first_unseq<Size, Test>);
+}
+
+/**
+ * Folds get(lo) ... get(hi-1) into init with op, in no particular order.
+ * Eight independent accumulators break the loop-carried dependency of a
+ * left fold, so the compiler can keep them in one vector register (and the
+ * adds pipeline even when it does not). op must be associative and
+ * commutative.
+ */
+template <typename Size, typename T, typename BinaryOperation, typename Get>
+T unrolled_fold(Size lo, Size hi, T init, BinaryOperation& op, Get& get)
+{
+    if (hi - lo < 16) {
+        for ( ; lo < hi; ++lo)
+            init = op(init, get(lo));
+        return init;
+    }
+
+    T a0 = get(lo), a1 = get(lo + 1), a2 = get(lo + 2), a3 = get(lo + 3);
+    T a4 = get(lo + 4), a5 = get(lo + 5), a6 = get(lo + 6), a7 = get(lo + 7);
+    for (lo += 8; hi - lo >= 8; lo += 8) {
+        a0 = op(a0, get(lo));
+        a1 = op(a1, get(lo + 1));
+        a2 = op(a2, get(lo + 2));
+        a3 = op(a3, get(lo + 3));
+        a4 = op(a4, get(lo + 4));
+        a5 = op(a5, get(lo + 5));
+        a6 = op(a6, get(lo + 6));
+        a7 = op(a7, get(lo + 7));
+    }
+    for ( ; lo < hi; ++lo)
+        a0 = op(a0, get(lo));
+
+    return op(init, op(op(op(a0, a1), op(a2, a3)), op(op(a4, a5), op(a6, a7))));
+}
+
+/**
+ * Generalized sum of get(0) ... get(n-1) and init: one unrolled_fold per
+ * chunk, then the partial sums are folded in chunk order.
+ */
+template <typename ExecutionPolicy, typename Size, typename T, typename BinaryOperation, typename Get>
+T reduce(const ExecutionPolicy& policy, Size n, T init, BinaryOperation op, Get get)
+{
+    unsigned k = chunk_count(policy, n);
+    if (k <= 1)
+        return unrolled_fold(Size(0), n, init, op, get);
+
+    std::vector<T> partial(k, init);
+    for_each_chunk(policy, n, [&](unsigned c, Size lo, Size hi) {
+        partial[c] = unrolled_fold(lo + 1, hi, T(get(lo)), op, get);
+    });
+    for (unsigned c = 0; c < k; ++c)
+        init = op(init, partial[c]);
+    return init;
+}
+
+/**
+ * Sequential scan of [lo, hi) starting from acc: put(i, v) receives
+ * op(acc, get(lo), ..., get(i)) if inclusive, op(acc, get(lo), ..., get(i-1))
+ * otherwise. get(i) is read before put(i, v) is written, so the output may
+ * alias the input.
+ */
+template <typename Size, typename T, typename BinaryOperation, typename Get, typename Put>
+void scan_chunk(Size lo, Size hi, T acc, BinaryOperation& op, Get& get, Put& put, bool inclusive)
+{
+    if (inclusive) {
+        for ( ; lo < hi; ++lo) {
+            acc = op(acc, get(lo));
+            put(lo, acc);
+        }
+    } else {
+        for ( ; lo < hi; ++lo) {
+            T x = get(lo);
+            put(lo, acc);
+            acc = op(acc, x);
+        }
+    }
+}
+
+/**
+ * Prefix scan of get(0) ... get(n-1) seeded with init, written through put.
+ * Parallel two-pass scan: each chunk is first reduced, the chunk sums are
+ * scanned sequentially into per-chunk seeds, then every chunk is scanned
+ * from its seed. op must be associative; unlike reduce it need not be
+ * commutative, so the chunks are folded in order.
+ */
+template <typename ExecutionPolicy, typename Size, typename T,
+    typename BinaryOperation, typename Get, typename Put>
+void scan(const ExecutionPolicy& policy, Size n, T init, BinaryOperation op,
+    Get get, Put put, bool inclusive)
+{
+    unsigned k = chunk_count(policy, n);
+    if (k <= 1) {
+        scan_chunk(Size(0), n, init, op, get, put, inclusive);
+        return;
+    }
+
+    std::vector<T> seed(k, init);
+    for_each_chunk(policy, n, [&](unsigned c, Size lo, Size hi) {
+        T sum = get(lo);
+        for (Size i = lo + 1; i < hi; ++i)
+            sum = op(sum, get(i));
+        seed[c] = sum;
+    });
+    for (unsigned c = 0; c < k; ++c) {
+        T sum = op(init, seed[c]);
+        seed[c] = init;
+        init = sum;
+    }
+    for_each_chunk(policy, n, [&](unsigned c, Size lo, Size hi) {
+        scan_chunk(lo, hi, seed[c], op, get, put, inclusive);
+    });
+}
+
+}   // namespace execution
+}   // namespace Hx
+
@@ -0,0 +1,1133 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HX_SIMD_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#define HX_SIMD_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace Hx {
+namespace simd {
+
+/**
+ * Instruction sets the kernels are compiled for, weakest first.
+ * avx2 and avx512 also require POPCNT; avx512 means AVX-512 F and BW.
+ */
+enum isa { scalar, sse2, avx2, avx512 };
+
+inline const char* isa_name(isa level)
+{
+    static const char* names[] = { "scalar", "sse2", "avx2", "avx512" };
+    return names[level];
+}
+
+/**
+ * Best instruction set both the cpu and the os (saved register state)
+ * support, from cpuid and xgetbv.
+ */
+inline isa detect_isa()
+{
+#ifdef HX_SIMD_X86
+    unsigned a, b, c, d;
+    if (!__get_cpuid(1, &a, &b, &c, &d) || !(d & bit_SSE2))
+        return scalar;
+    if (!(c & bit_OSXSAVE) || !(c & bit_AVX) || !(c & bit_POPCNT) ||
+            !__get_cpuid_count(7, 0, &a, &b, &c, &d))
+        return sse2;
+
+    unsigned lo, hi;
+    __asm__ volatile ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    if ((lo & 0x06) != 0x06 || !(b & bit_AVX2))     // xmm and ymm state
+        return sse2;
+    if ((lo & 0xe6) == 0xe6 && (b & bit_AVX512F) && (b & bit_AVX512BW))     // plus opmask and zmm
+        return avx512;
+    return avx2;
+#else
+    return scalar;
+#endif
+}
+
+inline isa& active_isa_ref()
+{
+    static isa level = detect_isa();
+    return level;
+}
+
+/**
+ * Instruction set the kernels currently dispatch to.
+ */
+inline isa active_isa()
+{
+    return active_isa_ref();
+}
+
+/**
+ * Caps the instruction set the kernels dispatch to (at most what
+ * detect_isa() found), e.g. to compare kernels in a benchmark.
+ * Not thread safe: call it before the kernels are used concurrently.
+ */
+inline void set_isa(isa level)
+{
+    isa best = detect_isa();
+    active_isa_ref() = (level < best) ? level : best;
+}
+
+/**
+ * True if Iterator walks a contiguous array of an arithmetic type the
+ * kernels handle: plain pointers (also Hx::vector and std::array
+ * iterators), std::vector and std::string iterators.
+ */
+template <typename Iterator,
+          typename T = typename std::remove_cv<typename std::iterator_traits<Iterator>::value_type>::type,
+          bool = std::is_arithmetic<T>::value && !std::is_same<T, long double>::value>
+struct is_vectorizable: std::false_type {};
+
+template <typename Iterator, typename T>
+struct is_vectorizable<Iterator, T, true>: std::integral_constant<bool,
+    (std::is_pointer<Iterator>::value &&
+     !std::is_volatile<typename std::remove_pointer<Iterator>::type>::value) ||
+    (!std::is_same<T, bool>::value &&
+     (std::is_same<Iterator, typename std::vector<T>::iterator>::value ||
+      std::is_same<Iterator, typename std::vector<T>::const_iterator>::value)) ||
+    std::is_same<Iterator, std::string::iterator>::value ||
+    std::is_same<Iterator, std::string::const_iterator>::value> {};
+
+/**
+ * True if the find_pred kernels pay off for Predicate over Iterator: the
+ * predicate must be a class type (lambda, function object), since a call
+ * through a function pointer is not inlined into the kernels and costs an
+ * indirect call per element, block after block, without early exit.
+ */
+template <typename Iterator, typename Predicate>
+struct is_vectorizable_predicate: std::integral_constant<bool,
+    is_vectorizable<Iterator>::value && std::is_class<Predicate>::value> {};
+
+/**
+ * True if the find and count kernels apply to searching Iterator for a T:
+ * element == value must come down to comparing the element with the
+ * value converted to the element type. It does when the element type is
+ * the common type of the two, or when both are integers; an integer range
+ * searched for a floating point value compares in floating point, which
+ * rounds large elements, and is left to the scalar loop.
+ */
+template <typename Iterator, typename T,
+          bool = is_vectorizable<Iterator>::value && std::is_arithmetic<T>::value>
+struct is_vectorizable_value: std::false_type {};
+
+template <typename Iterator, typename T>
+struct is_vectorizable_value<Iterator, T, true>: std::integral_constant<bool,
+    std::is_same<typename std::common_type<typename std::iterator_traits<Iterator>::value_type, T>::type,
+                 typename std::remove_cv<typename std::iterator_traits<Iterator>::value_type>::type>::value ||
+    (std::is_integral<typename std::iterator_traits<Iterator>::value_type>::value && std::is_integral<T>::value)> {};
+
+/**
+ * True if the kernels that compare two ranges apply to Iterator1 and
+ * Iterator2: both vectorizable, over the same element type.
+ */
+template <typename Iterator1, typename Iterator2>
+struct is_vectorizable_pair: std::integral_constant<bool,
+    is_vectorizable<Iterator1>::value && is_vectorizable<Iterator2>::value &&
+    std::is_same<typename std::remove_cv<typename std::iterator_traits<Iterator1>::value_type>::type,
+                 typename std::remove_cv<typename std::iterator_traits<Iterator2>::value_type>::type>::value> {};
+
+/**
+ * Address of the element a (dereferenceable) contiguous iterator refers to.
+ */
+template <typename Iterator>
+typename std::iterator_traits<Iterator>::pointer address_of(Iterator it)
+{
+    return &*it;
+}
+
+/**
+ * Lane layout of T: 1, 2, 4, 8 byte integers, or float (-4) and double (-8).
+ */
+template <typename T>
+struct lane_kind: std::integral_constant<int,
+    std::is_floating_point<T>::value ? -int(sizeof(T)) : int(sizeof(T))> {};
+
+typedef std::integral_constant<int, 1> lane_i8;
+typedef std::integral_constant<int, 2> lane_i16;
+typedef std::integral_constant<int, 4> lane_i32;
+typedef std::integral_constant<int, 8> lane_i64;
+typedef std::integral_constant<int, -4> lane_f32;
+typedef std::integral_constant<int, -8> lane_f64;
+
+/**
+ * First j >= i with p[j] == p[j+1], or n.
+ */
+template <typename T>
+size_t adjacent_find_scalar(const T* p, size_t n, size_t i)
+{
+    for ( ; i + 1 < n; ++i) {
+        if (p[i] == p[i + 1])
+            return i;
+    }
+    return n;
+}
+
+/**
+ * First j >= i with bool(pred(p[j])) == Value, or n.
+ */
+template <bool Value, typename T, typename Predicate>
+inline __attribute__((always_inline))
+size_t find_pred_scalar(T* p, size_t n, size_t i, Predicate& pred)
+{
+    while (i < n && bool(pred(p[i])) != Value)
+        ++i;
+    return i;
+}
+
+/**
+ * Same as find_pred_scalar, but tests a whole block before looking at the
+ * results. The block loop has no early exit, so the compiler vectorizes it
+ * with whatever instruction set the calling kernel is compiled for.
+ */
+template <size_t Block, bool Value, typename T, typename Predicate>
+inline __attribute__((always_inline))
+size_t find_pred_blocks(T* p, size_t n, Predicate& pred)
+{
+    size_t i = 0;
+    for ( ; n - i >= Block; i += Block) {
+        unsigned hit = 0;
+        for (size_t j = 0; j < Block; ++j)
+            hit |= unsigned(bool(pred(p[i + j])) == Value);
+        if (hit)
+            break;
+    }
+    return find_pred_scalar<Value>(p, n, i, pred);
+}
+
+#ifdef HX_SIMD_X86
+
+// Byte masks of the lanes where a == b, one overload per lane_kind.
+
+HX_SIMD_TARGET("sse2") inline unsigned eq_mask(__m128i a, __m128i b, lane_i8)
+{ return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)); }
+
+HX_SIMD_TARGET("sse2") inline unsigned eq_mask(__m128i a, __m128i b, lane_i16)
+{ return _mm_movemask_epi8(_mm_cmpeq_epi16(a, b)); }
+
+HX_SIMD_TARGET("sse2") inline unsigned eq_mask(__m128i a, __m128i b, lane_i32)
+{ return _mm_movemask_epi8(_mm_cmpeq_epi32(a, b)); }
+
+HX_SIMD_TARGET("sse2") inline unsigned eq_mask(__m128i a, __m128i b, lane_i64)
+{
+    // no 64 bit compare before sse4.1: both 32 bit halves must match
+    __m128i c = _mm_cmpeq_epi32(a, b);
+    return _mm_movemask_epi8(_mm_and_si128(c, _mm_shuffle_epi32(c, 0xb1)));
+}
+
+HX_SIMD_TARGET("sse2") inline unsigned eq_mask(__m128i a, __m128i b, lane_f32)
+{ return _mm_movemask_epi8(_mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)))); }
+
+HX_SIMD_TARGET("sse2") inline unsigned eq_mask(__m128i a, __m128i b, lane_f64)
+{ return _mm_movemask_epi8(_mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)))); }
+
+HX_SIMD_TARGET("avx2") inline unsigned eq_mask(__m256i a, __m256i b, lane_i8)
+{ return _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)); }
+
+HX_SIMD_TARGET("avx2") inline unsigned eq_mask(__m256i a, __m256i b, lane_i16)
+{ return _mm256_movemask_epi8(_mm256_cmpeq_epi16(a, b)); }
+
+HX_SIMD_TARGET("avx2") inline unsigned eq_mask(__m256i a, __m256i b, lane_i32)
+{ return _mm256_movemask_epi8(_mm256_cmpeq_epi32(a, b)); }
+
+HX_SIMD_TARGET("avx2") inline unsigned eq_mask(__m256i a, __m256i b, lane_i64)
+{ return _mm256_movemask_epi8(_mm256_cmpeq_epi64(a, b)); }
+
+HX_SIMD_TARGET("avx2") inline unsigned eq_mask(__m256i a, __m256i b, lane_f32)
+{
+    return _mm256_movemask_epi8(_mm256_castps_si256(
+        _mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ)));
+}
+
+HX_SIMD_TARGET("avx2") inline unsigned eq_mask(__m256i a, __m256i b, lane_f64)
+{
+    return _mm256_movemask_epi8(_mm256_castpd_si256(
+        _mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ)));
+}
+
+// AVX-512 compares straight into a lane mask.
+
+HX_SIMD_TARGET("avx512f,avx512bw") inline unsigned long long eq_mask(__m512i a, __m512i b, lane_i8)
+{ return _mm512_cmpeq_epi8_mask(a, b); }
+
+HX_SIMD_TARGET("avx512f,avx512bw") inline unsigned eq_mask(__m512i a, __m512i b, lane_i16)
+{ return _mm512_cmpeq_epi16_mask(a, b); }
+
+HX_SIMD_TARGET("avx512f,avx512bw") inline unsigned eq_mask(__m512i a, __m512i b, lane_i32)
+{ return _mm512_cmpeq_epi32_mask(a, b); }
+
+HX_SIMD_TARGET("avx512f,avx512bw") inline unsigned eq_mask(__m512i a, __m512i b, lane_i64)
+{ return _mm512_cmpeq_epi64_mask(a, b); }
+
+HX_SIMD_TARGET("avx512f,avx512bw") inline unsigned eq_mask(__m512i a, __m512i b, lane_f32)
+{ return _mm512_cmp_ps_mask(_mm512_castsi512_ps(a), _mm512_castsi512_ps(b), _CMP_EQ_OQ); }
+
+HX_SIMD_TARGET("avx512f,avx512bw") inline unsigned eq_mask(__m512i a, __m512i b, lane_f64)
+{ return _mm512_cmp_pd_mask(_mm512_castsi512_pd(a), _mm512_castsi512_pd(b), _CMP_EQ_OQ); }
+
+/**
+ * adjacent_find kernels: compare each vector with the same vector loaded
+ * one element further on (the lanes shifted by one), then take the first
+ * set bit of the movemask. Two vectors per iteration keep both load ports
+ * busy.
+ */
+template <typename T>
+HX_SIMD_TARGET("sse2")
+size_t adjacent_find_sse2(const T* p, size_t n)
+{
+    const size_t w = 16 / sizeof(T);
+    size_t i = 0;
+    for ( ; i + 2 * w < n; i += 2 * w) {
+        unsigned m0 = eq_mask(_mm_loadu_si128((const __m128i*) (p + i)),
+            _mm_loadu_si128((const __m128i*) (p + i + 1)), lane_kind<T>());
+        unsigned m1 = eq_mask(_mm_loadu_si128((const __m128i*) (p + i + w)),
+            _mm_loadu_si128((const __m128i*) (p + i + w + 1)), lane_kind<T>());
+        if (m0 | m1)
+            return i + __builtin_ctz(m0 | (m1 << 16)) / sizeof(T);
+    }
+    return adjacent_find_scalar(p, n, i);
+}
+
+template <typename T>
+HX_SIMD_TARGET("avx2")
+size_t adjacent_find_avx2(const T* p, size_t n)
+{
+    const size_t w = 32 / sizeof(T);
+    size_t i = 0;
+    for ( ; i + 2 * w < n; i += 2 * w) {
+        unsigned m0 = eq_mask(_mm256_loadu_si256((const __m256i*) (p + i)),
+            _mm256_loadu_si256((const __m256i*) (p + i + 1)), lane_kind<T>());
+        unsigned m1 = eq_mask(_mm256_loadu_si256((const __m256i*) (p + i + w)),
+            _mm256_loadu_si256((const __m256i*) (p + i + w + 1)), lane_kind<T>());
+        if (m0 | m1)
+            return i + __builtin_ctzll(m0 | ((unsigned long long) m1 << 32)) / sizeof(T);
+    }
+    return adjacent_find_scalar(p, n, i);
+}
+
+template <typename T>
+HX_SIMD_TARGET("avx512f,avx512bw")
+size_t adjacent_find_avx512(const T* p, size_t n)
+{
+    typedef decltype(eq_mask(__m512i(), __m512i(), lane_kind<T>())) mask_type;
+    const size_t w = 64 / sizeof(T);
+    size_t i = 0;
+    for ( ; i + 2 * w < n; i += 2 * w) {
+        mask_type m0 = eq_mask(_mm512_loadu_si512(p + i),
+            _mm512_loadu_si512(p + i + 1), lane_kind<T>());
+        mask_type m1 = eq_mask(_mm512_loadu_si512(p + i + w),
+            _mm512_loadu_si512(p + i + w + 1), lane_kind<T>());
+        if (m0)
+            return i + __builtin_ctzll(m0);
+        if (m1)
+            return i + w + __builtin_ctzll(m1);
+    }
+    return adjacent_find_scalar(p, n, i);
+}
+
+/**
+ * find_pred kernels: find_pred_blocks compiled for each instruction set.
+ * A block is four vectors of T.
+ */
+template <bool Value, typename T, typename Predicate>
+HX_SIMD_TARGET("sse2")
+size_t find_pred_sse2(T* p, size_t n, Predicate& pred)
+{
+    return find_pred_blocks<4 * 16 / sizeof(T), Value>(p, n, pred);
+}
+
+template <bool Value, typename T, typename Predicate>
+HX_SIMD_TARGET("avx2")
+size_t find_pred_avx2(T* p, size_t n, Predicate& pred)
+{
+    return find_pred_blocks<4 * 32 / sizeof(T), Value>(p, n, pred);
+}
+
+template <bool Value, typename T, typename Predicate>
+HX_SIMD_TARGET("avx512f,avx512bw")
+size_t find_pred_avx512(T* p, size_t n, Predicate& pred)
+{
+    return find_pred_blocks<4 * 64 / sizeof(T), Value>(p, n, pred);
+}
+
+#endif  // HX_SIMD_X86
+
+/**
+ * First i with p[i] == p[i+1], or n.
+ */
+template <typename T>
+size_t adjacent_find(const T* p, size_t n)
+{
+#ifdef HX_SIMD_X86
+    switch (active_isa()) {
+    case avx512: return adjacent_find_avx512(p, n);
+    case avx2: return adjacent_find_avx2(p, n);
+    case sse2: return adjacent_find_sse2(p, n);
+    default: break;
+    }
+#endif
+    return adjacent_find_scalar(p, n, 0);
+}
+
+/**
+ * First i with bool(pred(p[i])) == Value, or n. T may be const.
+ * pred may be called on elements after the one found (but within [p, p+n)),
+ * so it should not have side effects.
+ */
+template <bool Value, typename T, typename Predicate>
+size_t find_pred(T* p, size_t n, Predicate& pred)
+{
+#ifdef HX_SIMD_X86
+    switch (active_isa()) {
+    case avx512: return find_pred_avx512<Value>(p, n, pred);
+    case avx2: return find_pred_avx2<Value>(p, n, pred);
+    case sse2: return find_pred_sse2<Value>(p, n, pred);
+    default: break;
+    }
+#endif
+    return find_pred_scalar<Value>(p, n, 0, pred);
+}
+
+/**
+ * Unsigned integer of the same size as T, holding its bits, so that any
+ * lane type can be broadcast with the integer set1 intrinsics.
+ */
+template <size_t Size> struct lane_bits;
+template <> struct lane_bits<1> { typedef uint8_t type; };
+template <> struct lane_bits<2> { typedef uint16_t type; };
+template <> struct lane_bits<4> { typedef uint32_t type; };
+template <> struct lane_bits<8> { typedef uint64_t type; };
+
+template <typename T>
+typename lane_bits<sizeof(T)>::type bits_of(T x)
+{
+    typename lane_bits<sizeof(T)>::type u;
+    memcpy(&u, &x, sizeof(u));
+    return u;
+}
+
+/**
+ * First j >= i with p[j] == value, or n.
+ */
+template <typename T>
+size_t find_scalar(const T* p, size_t n, size_t i, T value)
+{
+    while (i < n && !(p[i] == value))
+        ++i;
+    return i;
+}
+
+/**
+ * Number of j >= i with p[j] == value.
+ */
+template <typename T>
+size_t count_scalar(const T* p, size_t n, size_t i, T value)
+{
+    size_t c = 0;
+    for ( ; i < n; ++i)
+        c += (p[i] == value);
+    return c;
+}
+
+/**
+ * First j >= i with a[j] != b[j], or n.
+ */
+template <typename T>
+size_t mismatch_scalar(const T* a, const T* b, size_t n, size_t i)
+{
+    while (i < n && a[i] == b[i])
+        ++i;
+    return i;
+}
+
+/**
+ * First j >= i with p[j] equal to one of s[0] ... s[m-1], or n.
+ */
+template <typename T>
+size_t find_first_of_scalar(const T* p, size_t n, size_t i, const T* s, size_t m)
+{
+    for ( ; i < n; ++i) {
+        for (size_t k = 0; k < m; ++k) {
+            if (p[i] == s[k])
+                return i;
+        }
+    }
+    return n;
+}
+
+/**
+ * First j >= i where s[0] ... s[m-1] occurs in p, or n.
+ */
+template <typename T>
+size_t search_scalar(const T* p, size_t n, size_t i, const T* s, size_t m)
+{
+    for ( ; i + m <= n; ++i) {
+        if (mismatch_scalar(p + i, s, m, 0) == m)
+            return i;
+    }
+    return n;
+}
+
+/**
+ * The SIMD kernels of find_first_of handle up to this many needles, each
+ * held broadcast in a register; more go to the scalar loop.
+ */
+const size_t find_first_of_max_needles = 16;
+
+#ifdef HX_SIMD_X86
+
+// Vectors with every lane set to the bits of x.
+
+HX_SIMD_TARGET("sse2") inline __m128i broadcast128(uint8_t x) { return _mm_set1_epi8(char(x)); }
+HX_SIMD_TARGET("sse2") inline __m128i broadcast128(uint16_t x) { return _mm_set1_epi16(short(x)); }
+HX_SIMD_TARGET("sse2") inline __m128i broadcast128(uint32_t x) { return _mm_set1_epi32(int(x)); }
+HX_SIMD_TARGET("sse2") inline __m128i broadcast128(uint64_t x) { return _mm_set1_epi64x((long long) x); }
+
+HX_SIMD_TARGET("avx2") inline __m256i broadcast256(uint8_t x) { return _mm256_set1_epi8(char(x)); }
+HX_SIMD_TARGET("avx2") inline __m256i broadcast256(uint16_t x) { return _mm256_set1_epi16(short(x)); }
+HX_SIMD_TARGET("avx2") inline __m256i broadcast256(uint32_t x) { return _mm256_set1_epi32(int(x)); }
+HX_SIMD_TARGET("avx2") inline __m256i broadcast256(uint64_t x) { return _mm256_set1_epi64x((long long) x); }
+
+HX_SIMD_TARGET("avx512f,avx512bw") inline __m512i broadcast512(uint8_t x) { return _mm512_set1_epi8(char(x)); }
+HX_SIMD_TARGET("avx512f,avx512bw") inline __m512i broadcast512(uint16_t x) { return _mm512_set1_epi16(short(x)); }
+HX_SIMD_TARGET("avx512f,avx512bw") inline __m512i broadcast512(uint32_t x) { return _mm512_set1_epi32(int(x)); }
+HX_SIMD_TARGET("avx512f,avx512bw") inline __m512i broadcast512(uint64_t x) { return _mm512_set1_epi64((long long) x); }
+
+/**
+ * find kernels: compare two vectors per iteration with the broadcast
+ * value, and take the first set bit of their masks (as memchr does).
+ */
+template <typename T>
+HX_SIMD_TARGET("sse2")
+size_t find_sse2(const T* p, size_t n, T value)
+{
+    const size_t w = 16 / sizeof(T);
+    const __m128i v = broadcast128(bits_of(value));
+    size_t i = 0;
+    for ( ; i + 2 * w <= n; i += 2 * w) {
+        unsigned m0 = eq_mask(_mm_loadu_si128((const __m128i*) (p + i)), v, lane_kind<T>());
+        unsigned m1 = eq_mask(_mm_loadu_si128((const __m128i*) (p + i + w)), v, lane_kind<T>());
+        if (m0 | m1)
+            return i + __builtin_ctz(m0 | (m1 << 16)) / sizeof(T);
+    }
+    return find_scalar(p, n, i, value);
+}
+
+template <typename T>
+HX_SIMD_TARGET("avx2")
+size_t find_avx2(const T* p, size_t n, T value)
+{
+    const size_t w = 32 / sizeof(T);
+    const __m256i v = broadcast256(bits_of(value));
+    size_t i = 0;
+    for ( ; i + 2 * w <= n; i += 2 * w) {
+        unsigned m0 = eq_mask(_mm256_loadu_si256((const __m256i*) (p + i)), v, lane_kind<T>());
+        unsigned m1 = eq_mask(_mm256_loadu_si256((const __m256i*) (p + i + w)), v, lane_kind<T>());
+        if (m0 | m1)
+            return i + __builtin_ctzll(m0 | ((unsigned long long) m1 << 32)) / sizeof(T);
+    }
+    return find_scalar(p, n, i, value);
+}
+
+template <typename T>
+HX_SIMD_TARGET("avx512f,avx512bw")
+size_t find_avx512(const T* p, size_t n, T value)
+{
+    typedef decltype(eq_mask(__m512i(), __m512i(), lane_kind<T>())) mask_type;
+    const size_t w = 64 / sizeof(T);
+    const __m512i v = broadcast512(bits_of(value));
+    size_t i = 0;
+    for ( ; i + 2 * w <= n; i += 2 * w) {
+        mask_type m0 = eq_mask(_mm512_loadu_si512(p + i), v, lane_kind<T>());
+        mask_type m1 = eq_mask(_mm512_loadu_si512(p + i + w), v, lane_kind<T>());
+        if (m0)
+            return i + __builtin_ctzll(m0);
+        if (m1)
+            return i + w + __builtin_ctzll(m1);
+    }
+    return find_scalar(p, n, i, value);
+}
+
+/**
+ * count kernels: add up the population counts of the compare masks.
+ * The sse2 and avx2 masks have a bit per byte, sizeof(T) per lane.
+ */
+template <typename T>
+HX_SIMD_TARGET("sse2")
+size_t count_sse2(const T* p, size_t n, T value)
+{
+    const size_t w = 16 / sizeof(T);
+    const __m128i v = broadcast128(bits_of(value));
+    size_t bits = 0;
+    size_t i = 0;
+    for ( ; i + 2 * w <= n; i += 2 * w) {
+        unsigned m0 = eq_mask(_mm_loadu_si128((const __m128i*) (p + i)), v, lane_kind<T>());
+        unsigned m1 = eq_mask(_mm_loadu_si128((const __m128i*) (p + i + w)), v, lane_kind<T>());
+        bits += __builtin_popcount(m0 | (m1 << 16));
+    }
+    return bits / sizeof(T) + count_scalar(p, n, i, value);
+}
+
+template <typename T>
+HX_SIMD_TARGET("avx2,popcnt")
+size_t count_avx2(const T* p, size_t n, T value)
+{
+    const size_t w = 32 / sizeof(T);
+    const __m256i v = broadcast256(bits_of(value));
+    size_t bits = 0;
+    size_t i = 0;
+    for ( ; i + 2 * w <= n; i += 2 * w) {
+        unsigned m0 = eq_mask(_mm256_loadu_si256((const __m256i*) (p + i)), v, lane_kind<T>());
+        unsigned m1 = eq_mask(_mm256_loadu_si256((const __m256i*) (p + i + w)), v, lane_kind<T>());
+        bits += __builtin_popcountll(m0 | ((unsigned long long) m1 << 32));
+    }
+    return bits / sizeof(T) + count_scalar(p, n, i, value);
+}
+
+template <typename T>
+HX_SIMD_TARGET("avx512f,avx512bw,popcnt")
+size_t count_avx512(const T* p, size_t n, T value)
+{
+    const size_t w = 64 / sizeof(T);
+    const __m512i v = broadcast512(bits_of(value));
+    size_t c = 0;
+    size_t i = 0;
+    for ( ; i + 2 * w <= n; i += 2 * w) {
+        c += __builtin_popcountll(eq_mask(_mm512_loadu_si512(p + i), v, lane_kind<T>()));
+        c += __builtin_popcountll(eq_mask(_mm512_loadu_si512(p + i + w), v, lane_kind<T>()));
+    }
+    return c + count_scalar(p, n, i, value);
+}
+
+/**
+ * mismatch kernels: the first clear bit of the compare mask of a vector
+ * of each range.
+ */
+template <typename T>
+HX_SIMD_TARGET("sse2")
+size_t mismatch_sse2(const T* a, const T* b, size_t n)
+{
+    const size_t w = 16 / sizeof(T);
+    size_t i = 0;
+    for ( ; i + 2 * w <= n; i += 2 * w) {
+        unsigned m0 = eq_mask(_mm_loadu_si128((const __m128i*) (a + i)),
+            _mm_loadu_si128((const __m128i*) (b + i)), lane_kind<T>());
+        unsigned m1 = eq_mask(_mm_loadu_si128((const __m128i*) (a + i + w)),
+            _mm_loadu_si128((const __m128i*) (b + i + w)), lane_kind<T>());
+        unsigned m = ~(m0 | (m1 << 16));
+        if (m)
+            return i + __builtin_ctz(m) / sizeof(T);
+    }
+    return mismatch_scalar(a, b, n, i);
+}
+
+template <typename T>
+HX_SIMD_TARGET("avx2")
+size_t mismatch_avx2(const T* a, const T* b, size_t n)
+{
+    const size_t w = 32 / sizeof(T);
+    size_t i = 0;
+    for ( ; i + 2 * w <= n; i += 2 * w) {
+        unsigned m0 = eq_mask(_mm256_loadu_si256((const __m256i*) (a + i)),
+            _mm256_loadu_si256((const __m256i*) (b + i)), lane_kind<T>());
+        unsigned m1 = eq_mask(_mm256_loadu_si256((const __m256i*) (a + i + w)),
+            _mm256_loadu_si256((const __m256i*) (b + i + w)), lane_kind<T>());
+        unsigned long long m = ~(m0 | ((unsigned long long) m1 << 32));
+        if (m)
+            return i + __builtin_ctzll(m) / sizeof(T);
+    }
+    return mismatch_scalar(a, b, n, i);
+}
+
+template <typename T>
+HX_SIMD_TARGET("avx512f,avx512bw")
+size_t mismatch_avx512(const T* a, const T* b, size_t n)
+{
+    typedef decltype(eq_mask(__m512i(), __m512i(), lane_kind<T>())) mask_type;
+    const size_t w = 64 / sizeof(T);
+    const mask_type all = mask_type(~0ull >> (64 - w));
+    size_t i = 0;
+    for ( ; i + 2 * w <= n; i += 2 * w) {
+        mask_type m0 = eq_mask(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i), lane_kind<T>());
+        mask_type m1 = eq_mask(_mm512_loadu_si512(a + i + w), _mm512_loadu_si512(b + i + w), lane_kind<T>());
+        if (m0 != all)
+            return i + __builtin_ctzll(~m0 & all);
+        if (m1 != all)
+            return i + w + __builtin_ctzll(~m1 & all);
+    }
+    return mismatch_scalar(a, b, n, i);
+}
+
+/**
+ * find_first_of kernels: or the compare masks of a vector with each of the
+ * broadcast needles (m <= find_first_of_max_needles).
+ */
+template <typename T>
+HX_SIMD_TARGET("sse2")
+size_t find_first_of_sse2(const T* p, size_t n, const T* s, size_t m)
+{
+    const size_t w = 16 / sizeof(T);
+    __m128i needle[find_first_of_max_needles];
+    for (size_t k = 0; k < m; ++k)
+        needle[k] = broadcast128(bits_of(s[k]));
+    size_t i = 0;
+    for ( ; i + w <= n; i += w) {
+        __m128i x = _mm_loadu_si128((const __m128i*) (p + i));
+        unsigned hit = 0;
+        for (size_t k = 0; k < m; ++k)
+            hit |= eq_mask(x, needle[k], lane_kind<T>());
+        if (hit)
+            return i + __builtin_ctz(hit) / sizeof(T);
+    }
+    return find_first_of_scalar(p, n, i, s, m);
+}
+
+template <typename T>
+HX_SIMD_TARGET("avx2")
+size_t find_first_of_avx2(const T* p, size_t n, const T* s, size_t m)
+{
+    const size_t w = 32 / sizeof(T);
+    __m256i needle[find_first_of_max_needles];
+    for (size_t k = 0; k < m; ++k)
+        needle[k] = broadcast256(bits_of(s[k]));
+    size_t i = 0;
+    for ( ; i + w <= n; i += w) {
+        __m256i x = _mm256_loadu_si256((const __m256i*) (p + i));
+        unsigned hit = 0;
+        for (size_t k = 0; k < m; ++k)
+            hit |= eq_mask(x, needle[k], lane_kind<T>());
+        if (hit)
+            return i + __builtin_ctz(hit) / sizeof(T);
+    }
+    return find_first_of_scalar(p, n, i, s, m);
+}
+
+template <typename T>
+HX_SIMD_TARGET("avx512f,avx512bw")
+size_t find_first_of_avx512(const T* p, size_t n, const T* s, size_t m)
+{
+    typedef decltype(eq_mask(__m512i(), __m512i(), lane_kind<T>())) mask_type;
+    const size_t w = 64 / sizeof(T);
+    __m512i needle[find_first_of_max_needles];
+    for (size_t k = 0; k < m; ++k)
+        needle[k] = broadcast512(bits_of(s[k]));
+    size_t i = 0;
+    for ( ; i + w <= n; i += w) {
+        __m512i x = _mm512_loadu_si512(p + i);
+        mask_type hit = 0;
+        for (size_t k = 0; k < m; ++k)
+            hit |= eq_mask(x, needle[k], lane_kind<T>());
+        if (hit)
+            return i + __builtin_ctzll(hit);
+    }
+    return find_first_of_scalar(p, n, i, s, m);
+}
+
+/**
+ * search kernels (2 <= m <= n): a position is a candidate when both its
+ * element and the one m-1 further on match the first and the last element
+ * of s, which one compare of each of two vectors tests for a whole vector
+ * of positions; only candidates are compared in full.
+ */
+template <typename T>
+HX_SIMD_TARGET("sse2")
+size_t search_sse2(const T* p, size_t n, const T* s, size_t m)
+{
+    const size_t w = 16 / sizeof(T);
+    const unsigned lane = (1u << sizeof(T)) - 1;
+    const __m128i first = broadcast128(bits_of(s[0]));
+    const __m128i last = broadcast128(bits_of(s[m - 1]));
+    size_t i = 0;
+    for ( ; i + w + m - 1 <= n; i += w) {
+        unsigned c = eq_mask(_mm_loadu_si128((const __m128i*) (p + i)), first, lane_kind<T>()) &
+            eq_mask(_mm_loadu_si128((const __m128i*) (p + i + m - 1)), last, lane_kind<T>());
+        while (c) {
+            unsigned bit = __builtin_ctz(c);
+            size_t j = i + bit / sizeof(T);
+            if (mismatch_scalar(p + j + 1, s + 1, m - 2, 0) == m - 2)
+                return j;
+            c &= ~(lane << bit);
+        }
+    }
+    return search_scalar(p, n, i, s, m);
+}
+
+template <typename T>
+HX_SIMD_TARGET("avx2")
+size_t search_avx2(const T* p, size_t n, const T* s, size_t m)
+{
+    const size_t w = 32 / sizeof(T);
+    const unsigned lane = (1u << sizeof(T)) - 1;
+    const __m256i first = broadcast256(bits_of(s[0]));
+    const __m256i last = broadcast256(bits_of(s[m - 1]));
+    size_t i = 0;
+    for ( ; i + w + m - 1 <= n; i += w) {
+        unsigned c = eq_mask(_mm256_loadu_si256((const __m256i*) (p + i)), first, lane_kind<T>()) &
+            eq_mask(_mm256_loadu_si256((const __m256i*) (p + i + m - 1)), last, lane_kind<T>());
+        while (c) {
+            unsigned bit = __builtin_ctz(c);
+            size_t j = i + bit / sizeof(T);
+            if (mismatch_scalar(p + j + 1, s + 1, m - 2, 0) == m - 2)
+                return j;
+            c &= ~(lane << bit);
+        }
+    }
+    return search_scalar(p, n, i, s, m);
+}
+
+template <typename T>
+HX_SIMD_TARGET("avx512f,avx512bw")
+size_t search_avx512(const T* p, size_t n, const T* s, size_t m)
+{
+    typedef decltype(eq_mask(__m512i(), __m512i(), lane_kind<T>())) mask_type;
+    const size_t w = 64 / sizeof(T);
+    const __m512i first = broadcast512(bits_of(s[0]));
+    const __m512i last = broadcast512(bits_of(s[m - 1]));
+    size_t i = 0;
+    for ( ; i + w + m - 1 <= n; i += w) {
+        mask_type c = eq_mask(_mm512_loadu_si512(p + i), first, lane_kind<T>()) &
+            eq_mask(_mm512_loadu_si512(p + i + m - 1), last, lane_kind<T>());
+        while (c) {
+            size_t j = i + __builtin_ctzll(c);
+            if (mismatch_scalar(p + j + 1, s + 1, m - 2, 0) == m - 2)
+                return j;
+            c &= c - 1;
+        }
+    }
+    return search_scalar(p, n, i, s, m);
+}
+
+#endif  // HX_SIMD_X86
+
+/**
+ * First i with p[i] == value, or n.
+ */
+template <typename T>
+size_t find(const T* p, size_t n, T value)
+{
+#ifdef HX_SIMD_X86
+    switch (active_isa()) {
+    case avx512: return find_avx512(p, n, value);
+    case avx2: return find_avx2(p, n, value);
+    case sse2: return find_sse2(p, n, value);
+    default: break;
+    }
+#endif
+    return find_scalar(p, n, 0, value);
+}
+
+/**
+ * Number of i with p[i] == value.
+ */
+template <typename T>
+size_t count(const T* p, size_t n, T value)
+{
+#ifdef HX_SIMD_X86
+    switch (active_isa()) {
+    case avx512: return count_avx512(p, n, value);
+    case avx2: return count_avx2(p, n, value);
+    case sse2: return count_sse2(p, n, value);
+    default: break;
+    }
+#endif
+    return count_scalar(p, n, 0, value);
+}
+
+/**
+ * First i with !(a[i] == b[i]), or n.
+ */
+template <typename T>
+size_t mismatch(const T* a, const T* b, size_t n)
+{
+#ifdef HX_SIMD_X86
+    switch (active_isa()) {
+    case avx512: return mismatch_avx512(a, b, n);
+    case avx2: return mismatch_avx2(a, b, n);
+    case sse2: return mismatch_sse2(a, b, n);
+    default: break;
+    }
+#endif
+    return mismatch_scalar(a, b, n, 0);
+}
+
+/**
+ * First i with p[i] equal to one of s[0] ... s[m-1], or n.
+ */
+template <typename T>
+size_t find_first_of(const T* p, size_t n, const T* s, size_t m)
+{
+#ifdef HX_SIMD_X86
+    if (m <= find_first_of_max_needles) {
+        switch (active_isa()) {
+        case avx512: return find_first_of_avx512(p, n, s, m);
+        case avx2: return find_first_of_avx2(p, n, s, m);
+        case sse2: return find_first_of_sse2(p, n, s, m);
+        default: break;
+        }
+    }
+#endif
+    return find_first_of_scalar(p, n, 0, s, m);
+}
+
+/**
+ * First i where s[0] ... s[m-1] occurs in p[0] ... p[n-1], or n; 0 if m
+ * is 0.
+ */
+template <typename T>
+size_t search(const T* p, size_t n, const T* s, size_t m)
+{
+    if (m == 0)
+        return 0;
+    if (m > n)
+        return n;
+    if (m == 1)
+        return simd::find(p, n, s[0]);
+#ifdef HX_SIMD_X86
+    switch (active_isa()) {
+    case avx512: return search_avx512(p, n, s, m);
+    case avx2: return search_avx2(p, n, s, m);
+    case sse2: return search_sse2(p, n, s, m);
+    default: break;
+    }
+#endif
+    return search_scalar(p, n, 0, s, m);
+}
+
+/**
+ * Adds x to the compensated sum s + c. This is Neumaier's variant of Kahan
+ * summation: the rounding error of s + x is recovered from whichever of
+ * the two is larger, so it also holds when x outgrows the running sum.
+ */
+template <typename T>
+inline void neumaier_add(T& s, T& c, const T& x)
+{
+    using std::abs;
+    T t = s + x;
+    if (abs(s) >= abs(x))
+        c += (s - t) + x;
+    else
+        c += (x - t) + s;
+    s = t;
+}
+
+/**
+ * The summation kernels keep sum_lane_bytes / sizeof(T) running sums
+ * (lanes), element i going to lane i % lanes, held in vectors of VB bytes.
+ * The lanes do not depend on VB, so every instruction set rounds the same
+ * way and returns the same result.
+ */
+const size_t sum_lane_bytes = 128;
+
+/**
+ * Pairwise sum of p[0] ... p[n-1]. Each lane adds up 16 rows into a block,
+ * the blocks are merged like a binary counter (level l holds the sum of 2^l
+ * blocks) and the lanes are merged as a tree at the end, so the rounding
+ * error grows with log(n) rather than n.
+ */
+template <size_t VB, typename T>
+inline __attribute__((always_inline))
+T sum_pairwise_lanes(const T* p, size_t n)
+{
+    typedef T vec __attribute__((vector_size(VB)));
+    const size_t k = sum_lane_bytes / VB;   // vectors per row
+    const size_t w = VB / sizeof(T);        // lanes per vector
+    const size_t rows = 16;
+
+    vec level[64][k];
+    vec acc[k];
+    size_t blocks = 0;
+    size_t i = 0;
+    for ( ; n - i >= rows * k * w; ++blocks) {
+#pragma GCC unroll 16
+        for (size_t j = 0; j < k; ++j, i += w)
+            memcpy(&acc[j], p + i, VB);
+        for (size_t r = 1; r < rows; ++r) {
+#pragma GCC unroll 16
+            for (size_t j = 0; j < k; ++j, i += w) {
+                vec x;
+                memcpy(&x, p + i, VB);
+                acc[j] += x;
+            }
+        }
+
+        size_t l = 0;
+        for ( ; blocks & (size_t(1) << l); ++l) {
+            for (size_t j = 0; j < k; ++j)
+                acc[j] = level[l][j] + acc[j];
+        }
+        for (size_t j = 0; j < k; ++j)
+            level[l][j] = acc[j];
+    }
+
+    for (size_t j = 0; j < k; ++j)
+        acc[j] = vec{};
+    for ( ; n - i >= k * w; ) {
+        for (size_t j = 0; j < k; ++j, i += w) {
+            vec x;
+            memcpy(&x, p + i, VB);
+            acc[j] += x;
+        }
+    }
+    for (size_t l = 0; blocks >> l; ++l) {
+        if (blocks & (size_t(1) << l)) {
+            for (size_t j = 0; j < k; ++j)
+                acc[j] = level[l][j] + acc[j];
+        }
+    }
+
+    for (size_t h = k / 2; h > 0; h /= 2) {
+        for (size_t j = 0; j < h; ++j)
+            acc[j] += acc[j + h];
+    }
+    T lane[w];
+    memcpy(lane, &acc[0], VB);
+    for (size_t h = w / 2; h > 0; h /= 2) {
+        for (size_t j = 0; j < h; ++j)
+            lane[j] += lane[j + h];
+    }
+
+    T sum = lane[0];
+    for ( ; i < n; ++i)     // less than a row left
+        sum += p[i];
+    return sum;
+}
+
+/**
+ * Compensated sum of init, p[0] ... p[n-1]. Each lane recovers the
+ * rounding error of s + x with Knuth's branch free two-sum, which gives
+ * the same exact error as neumaier_add without comparing magnitudes;
+ * the lanes are then added up with neumaier_add.
+ */
+template <size_t VB, typename T>
+inline __attribute__((always_inline))
+T sum_neumaier_lanes(const T* p, size_t n, T init)
+{
+    typedef T vec __attribute__((vector_size(VB)));
+    const size_t k = sum_lane_bytes / VB;
+    const size_t w = VB / sizeof(T);
+
+    vec s[k], c[k];
+    for (size_t j = 0; j < k; ++j)
+        s[j] = c[j] = vec{};
+    size_t i = 0;
+    for ( ; n - i >= k * w; i += k * w) {
+#pragma GCC unroll 16
+        for (size_t j = 0; j < k; ++j) {
+            vec x;
+            memcpy(&x, p + i + j * w, VB);
+            vec t = s[j] + x;
+            vec z = t - s[j];
+            c[j] += (s[j] - (t - z)) + (x - z);
+            s[j] = t;
+        }
+    }
+
+    T rs = init, rc = T();
+    for (size_t j = 0; j < k; ++j) {
+        for (size_t l = 0; l < w; ++l)
+            neumaier_add(rs, rc, T(s[j][l]));
+    }
+    for ( ; i < n; ++i)
+        neumaier_add(rs, rc, p[i]);
+    for (size_t j = 0; j < k; ++j) {
+        for (size_t l = 0; l < w; ++l)
+            rc += c[j][l];
+    }
+    return std::isfinite(rc) ? rs + rc : rs;    // an infinity makes the correction nan
+}
+
+#ifdef HX_SIMD_X86
+
+template <typename T>
+HX_SIMD_TARGET("sse2")
+T sum_pairwise_sse2(const T* p, size_t n)
+{
+    return sum_pairwise_lanes<16>(p, n);
+}
+
+template <typename T>
+HX_SIMD_TARGET("avx2")
+T sum_pairwise_avx2(const T* p, size_t n)
+{
+    return sum_pairwise_lanes<32>(p, n);
+}
+
+template <typename T>
+HX_SIMD_TARGET("avx512f,avx512bw")
+T sum_pairwise_avx512(const T* p, size_t n)
+{
+    return sum_pairwise_lanes<64>(p, n);
+}
+
+template <typename T>
+HX_SIMD_TARGET("sse2")
+T sum_neumaier_sse2(const T* p, size_t n, T init)
+{
+    return sum_neumaier_lanes<16>(p, n, init);
+}
+
+template <typename T>
+HX_SIMD_TARGET("avx2")
+T sum_neumaier_avx2(const T* p, size_t n, T init)
+{
+    return sum_neumaier_lanes<32>(p, n, init);
+}
+
+template <typename T>
+HX_SIMD_TARGET("avx512f,avx512bw")
+T sum_neumaier_avx512(const T* p, size_t n, T init)
+{
+    return sum_neumaier_lanes<64>(p, n, init);
+}
+
+#endif  // HX_SIMD_X86
+
+/**
+ * Pairwise sum of a float or double array.
+ */
+template <typename T>
+T sum_pairwise(const T* p, size_t n)
+{
+#ifdef HX_SIMD_X86
+    switch (active_isa()) {
+    case avx512: return sum_pairwise_avx512(p, n);
+    case avx2: return sum_pairwise_avx2(p, n);
+    case sse2: return sum_pairwise_sse2(p, n);
+    default: break;
+    }
+#endif
+    return sum_pairwise_lanes<sizeof(T)>(p, n);
+}
+
+/**
+ * Compensated sum of init and a float or double array.
+ */
+template <typename T>
+T sum_neumaier(const T* p, size_t n, T init)
+{
+#ifdef HX_SIMD_X86
+    switch (active_isa()) {
+    case avx512: return sum_neumaier_avx512(p, n, init);
+    case avx2: return sum_neumaier_avx2(p, n, init);
+    case sse2: return sum_neumaier_sse2(p, n, init);
+    default: break;
+    }
+#endif
+    return sum_neumaier_lanes<sizeof(T)>(p, n, init);
+}
+
+}   // namespace simd
+}   // namespace Hx
@@ -0,0 +1,171 @@
+// Strong scaling of the parallel policy overloads against the sequential
+// std algorithm; see "bench.hpp" for the options. The argument is the
+// number of threads of the policy, 1, 2, 4, ... up to max threads (the
+// "std" rows ignore it, so that every thread count has its baseline).
+// all_of, any_of, none_of and adjacent_find scan the whole range (no
+// match), accumulate sums it.
+// usage: bench_scaling [--size=ELEMENTS] [--threads=MAX] [bench options]
+//     (default 1e9 ints, hardware_concurrency)
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <vector>
+#include "execution.hpp"
+#include "all_of.hpp"
+#include "any_of.hpp"
+#include "none_of.hpp"
+#include "adjacent_find.hpp"
+#include "accumulate.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+long size = 1000000000;
+
+// shared by all the benchmarks, built on first use
+const std::vector<int>& data()
+{
+    static std::vector<int> v;
+    if (v.empty()) {
+        v.resize(size);
+        for (long i = 0; i < size; i++)
+            v[i] = int(i & 0x3fffffff);
+    }
+    return v;
+}
+
+// function objects, like the lambdas of real code: a function pointer
+// keeps the predicate from being inlined into the kernels
+struct is_nonnegative {
+    bool operator()(int x) const { return x >= 0; }
+};
+
+struct is_negative {
+    bool operator()(int x) const { return x < 0; }
+};
+
+const is_nonnegative pos = is_nonnegative();
+const is_negative neg = is_negative();
+
+void all_of_std(state& st)
+{
+    const std::vector<int>& v = data();
+    while (st.keep_running())
+        do_not_optimize(std::all_of(v.begin(), v.end(), pos));
+    st.set_bytes_per_iteration(size * sizeof(int));
+}
+
+void all_of_hx(state& st)
+{
+    const std::vector<int>& v = data();
+    Hx::execution::parallel_policy policy(st.arg());
+    while (st.keep_running())
+        do_not_optimize(Hx::all_of(policy, v.begin(), v.end(), pos));
+    st.set_bytes_per_iteration(size * sizeof(int));
+}
+
+void any_of_std(state& st)
+{
+    const std::vector<int>& v = data();
+    while (st.keep_running())
+        do_not_optimize(std::any_of(v.begin(), v.end(), neg));
+    st.set_bytes_per_iteration(size * sizeof(int));
+}
+
+void any_of_hx(state& st)
+{
+    const std::vector<int>& v = data();
+    Hx::execution::parallel_policy policy(st.arg());
+    while (st.keep_running())
+        do_not_optimize(Hx::any_of(policy, v.begin(), v.end(), neg));
+    st.set_bytes_per_iteration(size * sizeof(int));
+}
+
+void none_of_std(state& st)
+{
+    const std::vector<int>& v = data();
+    while (st.keep_running())
+        do_not_optimize(std::none_of(v.begin(), v.end(), neg));
+    st.set_bytes_per_iteration(size * sizeof(int));
+}
+
+void none_of_hx(state& st)
+{
+    const std::vector<int>& v = data();
+    Hx::execution::parallel_policy policy(st.arg());
+    while (st.keep_running())
+        do_not_optimize(Hx::none_of(policy, v.begin(), v.end(), neg));
+    st.set_bytes_per_iteration(size * sizeof(int));
+}
+
+void adjacent_find_std(state& st)
+{
+    const std::vector<int>& v = data();
+    while (st.keep_running())
+        do_not_optimize(std::adjacent_find(v.begin(), v.end()));
+    st.set_bytes_per_iteration(size * sizeof(int));
+}
+
+void adjacent_find_hx(state& st)
+{
+    const std::vector<int>& v = data();
+    Hx::execution::parallel_policy policy(st.arg());
+    while (st.keep_running())
+        do_not_optimize(Hx::adjacent_find(policy, v.begin(), v.end()));
+    st.set_bytes_per_iteration(size * sizeof(int));
+}
+
+void accumulate_std(state& st)
+{
+    const std::vector<int>& v = data();
+    while (st.keep_running())
+        do_not_optimize(std::accumulate(v.begin(), v.end(), 0LL));
+    st.set_bytes_per_iteration(size * sizeof(int));
+}
+
+void accumulate_hx(state& st)
+{
+    const std::vector<int>& v = data();
+    Hx::execution::parallel_policy policy(st.arg());
+    while (st.keep_running())
+        do_not_optimize(Hx::accumulate(policy, v.begin(), v.end(), 0LL));
+    st.set_bytes_per_iteration(size * sizeof(int));
+}
+
+int main(int argc, char* argv[])
+{
+    // takes out the options of its own, leaves the rest to the suite
+    long max_threads = Hx::thread::hardware_concurrency();
+    int n = 1;
+    for (int i = 1; i < argc; i++) {
+        if (!strncmp(argv[i], "--size=", 7))
+            size = atol(argv[i] + 7);
+        else if (!strncmp(argv[i], "--threads=", 10))
+            max_threads = atol(argv[i] + 10);
+        else
+            argv[n++] = argv[i];
+    }
+    argc = n;
+    if (max_threads < 1)
+        max_threads = 1;
+
+    std::vector<long> threads;
+    for (long t = 1; t < max_threads; t *= 2)
+        threads.push_back(t);
+    threads.push_back(max_threads);
+
+    Hx::bench::suite s("scaling");
+    s.add("all_of", "std", all_of_std).args(threads);
+    s.add("all_of", "Hx", all_of_hx).args(threads);
+    s.add("any_of", "std", any_of_std).args(threads);
+    s.add("any_of", "Hx", any_of_hx).args(threads);
+    s.add("none_of", "std", none_of_std).args(threads);
+    s.add("none_of", "Hx", none_of_hx).args(threads);
+    s.add("adjacent_find", "std", adjacent_find_std).args(threads);
+    s.add("adjacent_find", "Hx", adjacent_find_hx).args(threads);
+    s.add("accumulate", "std", accumulate_std).args(threads);
+    s.add("accumulate", "Hx", accumulate_hx).args(threads);
+    return s.run(argc, argv);
+}
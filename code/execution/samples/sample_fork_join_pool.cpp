@@ -0,0 +1,25 @@
+// fork_join_pool::run example
+#include <iostream>             // std::cout
+#include <vector>               // std::vector
+#include "fork_join_pool.hpp"   // Hx::execution::fork_join_pool
+
+int main () {
+  std::vector<int> squares(8);
+
+  // fn(i) runs once for every i in [0, 8), on up to 8 threads
+  Hx::execution::fork_join_pool::instance().run(squares.size(), [&](unsigned i) {
+    squares[i] = i * i;
+  });
+
+  std::cout << "squares:";
+  for (int x: squares) std::cout << ' ' << x;
+  std::cout << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+squares: 0 1 4 9 16 25 36 49
+*/
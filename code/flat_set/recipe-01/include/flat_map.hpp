@@ -0,0 +1,599 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_FLAT_MAP_INC
+#define MINI_STL_FLAT_MAP_INC
+
+#include "vector.hpp"
+#include "flat_search.hpp"
+
+#include <cassert>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <algorithm>
+#include <initializer_list>
+
+namespace Hx {
+
+/**
+ * Flat maps are associative containers that store key/value pairs with unique
+ * keys in a sorted contiguous container (Hx::vector by default).
+ *
+ * Unlike map, the stored value_type is std::pair<Key, T> (not pair<const Key, T>),
+ * because the elements must be move-assignable to be shifted around in the
+ * underlying container. Modifying a key through an iterator breaks the ordering.
+ */
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Container = Hx::vector<std::pair<Key, T>>>
+class flat_map {
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef std::pair<Key, T> value_type;
+    typedef Compare key_compare;
+    typedef Container container_type;
+    typedef typename container_type::allocator_type allocator_type;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef typename container_type::pointer pointer;
+    typedef typename container_type::const_pointer const_pointer;
+    typedef typename container_type::iterator iterator;
+    typedef typename container_type::const_iterator const_iterator;
+    typedef typename container_type::reverse_iterator reverse_iterator;
+    typedef typename container_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename container_type::difference_type difference_type;
+    typedef typename container_type::size_type size_type;
+
+    /**
+     * Compares two elements by their keys.
+     */
+    class value_compare {
+        friend class flat_map;
+    protected:
+        Compare comp;
+        value_compare(Compare c): comp(c) {}
+    public:
+        bool operator()(const value_type& x, const value_type& y) const
+        {
+            return comp(x.first, y.first);
+        }
+    };
+
+private:
+    // compares an element with a bare key, in either order
+    struct key_value_compare {
+        const Compare& comp;
+        bool operator()(const value_type& x, const key_type& k) const { return comp(x.first, k); }
+        bool operator()(const key_type& k, const value_type& x) const { return comp(k, x.first); }
+    };
+
+    Compare less_;
+    container_type cont_;
+
+public:
+    /**
+     * empty container constructors (default constructor)
+     * Constructs an empty container, with no elements.
+     */
+    flat_map(): flat_map(key_compare(), allocator_type()) {}
+
+    explicit flat_map(const key_compare& comp,
+                      const allocator_type& alloc = allocator_type()):
+        less_(comp), cont_(alloc) {}
+
+    explicit flat_map(const allocator_type& alloc): flat_map(key_compare(), alloc) {}
+
+    /**
+     * container constructors
+     * Adopts the elements of cont, sorting them by key and removing duplicate keys
+     * (the first of equivalent elements is kept).
+     * The sorted_unique version trusts cont to be sorted and unique already.
+     */
+    explicit flat_map(container_type cont, const key_compare& comp = key_compare()):
+        less_(comp), cont_(std::move(cont))
+    {
+        sort_unique(cont_.begin());
+    }
+
+    flat_map(sorted_unique_t, container_type cont, const key_compare& comp = key_compare()):
+        less_(comp), cont_(std::move(cont))
+    {
+        assert(is_sorted_unique(cont_.begin(), cont_.end()));
+    }
+
+    /**
+     *  range constructor
+     *  Constructs a container with as many elements as the range [first,last),
+     *  with each element emplace-constructed from its corresponding element in that range.
+     */
+    template <typename InputIterator>
+    flat_map(InputIterator first, InputIterator last,
+             const key_compare& comp = key_compare(),
+             const allocator_type& alloc = allocator_type()): less_(comp), cont_(alloc)
+    {
+        insert(first, last);
+    }
+
+    template <typename InputIterator>
+    flat_map(InputIterator first, InputIterator last,
+             const allocator_type& alloc): flat_map(first, last, key_compare(), alloc) {}
+
+    template <typename InputIterator>
+    flat_map(sorted_unique_t, InputIterator first, InputIterator last,
+             const key_compare& comp = key_compare(),
+             const allocator_type& alloc = allocator_type()): less_(comp), cont_(alloc)
+    {
+        insert(sorted_unique, first, last);
+    }
+
+    /**
+     * initializer list constructor
+     * Constructs a container with a copy of each of the elements in il.
+     */
+    flat_map(std::initializer_list<value_type> il,
+             const key_compare& comp = key_compare(),
+             const allocator_type& alloc = allocator_type()): flat_map(il.begin(), il.end(), comp, alloc) {}
+
+    flat_map(std::initializer_list<value_type> il, const allocator_type& alloc): flat_map(il, key_compare(), alloc) {}
+
+    /**
+     * copy/move constructors
+     */
+    flat_map(const flat_map& x) = default;
+
+    flat_map(const flat_map& x, const allocator_type& alloc): less_(x.less_), cont_(x.cont_, alloc) {}
+
+    flat_map(flat_map&& x) = default;
+
+    flat_map(flat_map&& x, const allocator_type& alloc): less_(std::move(x.less_)), cont_(std::move(x.cont_), alloc) {}
+
+    /**
+     * Copy container content
+     * Assigns new contents to the container, replacing its current content.
+     */
+    flat_map& operator=(const flat_map& x) = default;
+
+    flat_map& operator=(flat_map&& x) = default;
+
+    flat_map& operator=(std::initializer_list<value_type> il)
+    {
+        flat_map(il, less_).swap(*this);
+        return *this;
+    }
+
+    /**
+     * Iterators
+     */
+    iterator begin() noexcept { return cont_.begin(); }
+    const_iterator begin() const noexcept { return cont_.begin(); }
+    iterator end() noexcept { return cont_.end(); }
+    const_iterator end() const noexcept { return cont_.end(); }
+    const_iterator cbegin() const noexcept { return cont_.cbegin(); }
+    const_iterator cend() const noexcept { return cont_.cend(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    /**
+     * Capacity
+     */
+    bool empty() const noexcept { return cont_.empty(); }
+    size_type size() const noexcept { return cont_.size(); }
+    size_type max_size() const noexcept { return cont_.max_size(); }
+    size_type capacity() const noexcept { return cont_.capacity(); }
+    void reserve(size_type n) { cont_.reserve(n); }
+    void shrink_to_fit() { cont_.shrink_to_fit(); }
+
+    /**
+     * Access element
+     * If k matches the key of an element in the container, the function returns a reference to its mapped value.
+     * operator[] inserts a value-initialized element when k is missing, at throws std::out_of_range.
+     */
+    mapped_type& operator[](const key_type& k)
+    {
+        return try_emplace(k).first->second;
+    }
+
+    mapped_type& operator[](key_type&& k)
+    {
+        return try_emplace(std::move(k)).first->second;
+    }
+
+    mapped_type& at(const key_type& k)
+    {
+        iterator it = find(k);
+        if (it == end())
+            throw std::out_of_range("flat_map::at");
+        return it->second;
+    }
+
+    const mapped_type& at(const key_type& k) const
+    {
+        const_iterator it = find(k);
+        if (it == end())
+            throw std::out_of_range("flat_map::at");
+        return it->second;
+    }
+
+    /**
+     * Insert elements
+     * Extends the container by inserting new elements, effectively increasing the container size by the number of elements inserted.
+     */
+    std::pair<iterator, bool> insert(const value_type& val)
+    {
+        iterator pos = lower_bound(val.first);
+        if (pos != end() && !less_(val.first, pos->first))
+            return std::make_pair(pos, false);
+        return std::make_pair(cont_.insert(pos, val), true);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& val)
+    {
+        iterator pos = lower_bound(val.first);
+        if (pos != end() && !less_(val.first, pos->first))
+            return std::make_pair(pos, false);
+        return std::make_pair(cont_.insert(pos, std::move(val)), true);
+    }
+
+    iterator insert(const_iterator position, const value_type& val)
+    {
+        if (hint_fits(position, val.first))
+            return cont_.insert(position, val);
+        return insert(val).first;
+    }
+
+    iterator insert(const_iterator position, value_type&& val)
+    {
+        if (hint_fits(position, val.first))
+            return cont_.insert(position, std::move(val));
+        return insert(std::move(val)).first;
+    }
+
+    /**
+     * Range insertion appends, sorts the appended part and merges: O(n + m log m).
+     */
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        size_type n = size();
+        while (first != last) {
+            cont_.push_back(*first++);
+        }
+        sort_unique(cont_.begin()+n);
+    }
+
+    /**
+     * Bulk insertion of a range sorted by unique keys: one O(n + m) merge pass.
+     * Elements whose key is already present are skipped.
+     */
+    template <typename InputIterator>
+    void insert(sorted_unique_t, InputIterator first, InputIterator last)
+    {
+        if (first == last)
+            return;
+
+        if (empty() || less_((cont_.end()-1)->first, (*first).first)) {   // pure append
+            while (first != last) {
+                cont_.push_back(*first++);
+            }
+            return;
+        }
+
+        container_type merged(cont_.get_allocator());
+        flat_reserve(merged, size(), first, last);
+
+        iterator it = cont_.begin();
+        iterator end = cont_.end();
+        while (it != end && first != last) {
+            if (less_(it->first, (*first).first)) {
+                merged.push_back(std::move(*it++));
+            } else if (less_((*first).first, it->first)) {
+                merged.push_back(*first++);
+            } else {    // equivalent keys, keep the old element
+                merged.push_back(std::move(*it++));
+                ++first;
+            }
+        }
+        while (it != end) {
+            merged.push_back(std::move(*it++));
+        }
+        while (first != last) {
+            merged.push_back(*first++);
+        }
+        cont_.swap(merged);
+    }
+
+    void insert(std::initializer_list<value_type> il)
+    {
+        insert(il.begin(), il.end());
+    }
+
+    void insert(sorted_unique_t, std::initializer_list<value_type> il)
+    {
+        insert(sorted_unique, il.begin(), il.end());
+    }
+
+    /**
+     * Insert or assign
+     * Assigns obj to the element with key k if it exists, inserts it otherwise.
+     */
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj)
+    {
+        iterator pos = lower_bound(k);
+        if (pos != end() && !less_(k, pos->first)) {
+            pos->second = std::forward<M>(obj);
+            return std::make_pair(pos, false);
+        }
+        return std::make_pair(cont_.insert(pos, value_type(k, std::forward<M>(obj))), true);
+    }
+
+    /**
+     * Construct and insert element
+     * Inserts a new element in the flat_map if its key is unique.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+
+    template <typename... Args>
+    iterator emplace_hint(const_iterator position, Args&&... args)
+    {
+        return insert(position, value_type(std::forward<Args>(args)...));
+    }
+
+    /**
+     * Try to emplace
+     * Does nothing if the key already exists; the mapped value is only
+     * constructed from args when a new element is inserted.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& k, Args&&... args)
+    {
+        iterator pos = lower_bound(k);
+        if (pos != end() && !less_(k, pos->first))
+            return std::make_pair(pos, false);
+        return std::make_pair(cont_.insert(pos, value_type(std::piecewise_construct,
+            std::forward_as_tuple(k), std::forward_as_tuple(std::forward<Args>(args)...))), true);
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(key_type&& k, Args&&... args)
+    {
+        iterator pos = lower_bound(k);
+        if (pos != end() && !less_(k, pos->first))
+            return std::make_pair(pos, false);
+        return std::make_pair(cont_.insert(pos, value_type(std::piecewise_construct,
+            std::forward_as_tuple(std::move(k)), std::forward_as_tuple(std::forward<Args>(args)...))), true);
+    }
+
+    /**
+     * Erase elements
+     * Removes from the flat_map container either a single element or a range of elements ([first,last)).
+     */
+    iterator erase(const_iterator position)
+    {
+        assert(position != end());
+        return cont_.erase(position);
+    }
+
+    size_type erase(const key_type& k)
+    {
+        iterator it = find(k);
+        if (it == end())
+            return 0;
+        erase(it);
+        return 1;
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        if (first == last)
+            return begin() + (last - cbegin());
+        return cont_.erase(first, last);
+    }
+
+    /**
+     * Swap content
+     */
+    void swap(flat_map& x)
+    {
+        using std::swap;
+        swap(less_, x.less_);
+        cont_.swap(x.cont_);
+    }
+
+    /**
+     * Clear content
+     */
+    void clear() noexcept
+    {
+        cont_.clear();
+    }
+
+    /**
+     * Extract / replace the underlying container
+     * extract leaves *this empty; replace requires cont to be sorted and unique.
+     */
+    container_type extract()
+    {
+        container_type cont(std::move(cont_));
+        cont_.clear();
+        return cont;
+    }
+
+    void replace(container_type&& cont)
+    {
+        assert(is_sorted_unique(cont.begin(), cont.end()));
+        cont_ = std::move(cont);
+    }
+
+    /**
+     * Observers
+     */
+    key_compare key_comp() const
+    {
+        return less_;
+    }
+
+    value_compare value_comp() const
+    {
+        return value_compare(less_);
+    }
+
+    /**
+     * Operations
+     */
+    iterator find(const key_type& k)
+    {
+        iterator it = lower_bound(k);
+        return (it != end() && !less_(k, it->first)) ? it : end();
+    }
+
+    const_iterator find(const key_type& k) const
+    {
+        const_iterator it = lower_bound(k);
+        return (it != end() && !less_(k, it->first)) ? it : end();
+    }
+
+    size_type count(const key_type& k) const
+    {
+        return find(k) == end() ? 0 : 1;
+    }
+
+    iterator lower_bound(const key_type& k)
+    {
+        return flat_lower_bound(cont_.begin(), cont_.end(), k, key_value_compare{less_});
+    }
+
+    const_iterator lower_bound(const key_type& k) const
+    {
+        return flat_lower_bound(cont_.begin(), cont_.end(), k, key_value_compare{less_});
+    }
+
+    iterator upper_bound(const key_type& k)
+    {
+        return flat_upper_bound(cont_.begin(), cont_.end(), k, key_value_compare{less_});
+    }
+
+    const_iterator upper_bound(const key_type& k) const
+    {
+        return flat_upper_bound(cont_.begin(), cont_.end(), k, key_value_compare{less_});
+    }
+
+    std::pair<iterator,iterator> equal_range(const key_type& k)
+    {
+        iterator it = lower_bound(k);
+        if (it != end() && !less_(k, it->first))
+            return std::make_pair(it, it+1);
+        return std::make_pair(it, it);
+    }
+
+    std::pair<const_iterator,const_iterator> equal_range(const key_type& k) const
+    {
+        const_iterator it = lower_bound(k);
+        if (it != end() && !less_(k, it->first))
+            return std::make_pair(it, it+1);
+        return std::make_pair(it, it);
+    }
+
+    /**
+     * Get allocator
+     */
+    allocator_type get_allocator() const noexcept
+    {
+        return cont_.get_allocator();
+    }
+
+private:
+    bool hint_fits(const_iterator position, const key_type& k) const
+    {
+        return (position == end() || less_(k, position->first)) &&
+               (position == begin() || less_((position-1)->first, k));
+    }
+
+    template <typename Iterator>
+    bool is_sorted_unique(Iterator first, Iterator last) const
+    {
+        return std::adjacent_find(first, last,
+            [this](const value_type& a, const value_type& b) { return !less_(a.first, b.first); }) == last;
+    }
+
+    // sort [mid, end()) by key, merge it into the sorted prefix and drop
+    // elements with duplicate keys (stable, so the first one wins)
+    void sort_unique(iterator mid)
+    {
+        iterator first = cont_.begin();
+        iterator last = cont_.end();
+        value_compare comp(less_);
+        std::stable_sort(mid, last, comp);
+        std::inplace_merge(first, mid, last, comp);
+        last = std::unique(first, last,
+            [this](const value_type& a, const value_type& b) { return !less_(a.first, b.first); });
+        if (last != cont_.end())
+            cont_.erase(last, cont_.end());
+    }
+};
+
+template <typename Key, typename T, typename Compare, typename Container>
+inline
+bool operator==(const flat_map<Key, T, Compare, Container> &lhs, const flat_map<Key, T, Compare, Container> &rhs)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Key, typename T, typename Compare, typename Container>
+inline
+bool operator!=(const flat_map<Key, T, Compare, Container> &lhs, const flat_map<Key, T, Compare, Container> &rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename T, typename Compare, typename Container>
+inline
+bool operator<(const flat_map<Key, T, Compare, Container> &lhs, const flat_map<Key, T, Compare, Container> &rhs)
+{
+    return std::lexicographical_compare(lhs.begin(), lhs.end(),
+        rhs.begin(), rhs.end());
+}
+
+template <typename Key, typename T, typename Compare, typename Container>
+inline
+bool operator>(const flat_map<Key, T, Compare, Container> &lhs, const flat_map<Key, T, Compare, Container> &rhs)
+{
+    return (rhs < lhs);
+}
+
+template <typename Key, typename T, typename Compare, typename Container>
+inline
+bool operator<=(const flat_map<Key, T, Compare, Container> &lhs, const flat_map<Key, T, Compare, Container> &rhs)
+{
+    return !(lhs > rhs);
+}
+
+template <typename Key, typename T, typename Compare, typename Container>
+inline
+bool operator>=(const flat_map<Key, T, Compare, Container> &lhs, const flat_map<Key, T, Compare, Container> &rhs)
+{
+    return !(lhs < rhs);
+}
+
+template <typename Key, typename T, typename Compare, typename Container>
+inline
+void swap(flat_map<Key, T, Compare, Container> &x, flat_map<Key, T, Compare, Container> &y)
+{
+    x.swap(y);
+}
+
+} // namespace Hx
+
+#endif // MINI_STL_FLAT_MAP_INC
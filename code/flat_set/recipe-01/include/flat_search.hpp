@@ -0,0 +1,100 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_FLAT_SEARCH_INC
+#define MINI_STL_FLAT_SEARCH_INC
+
+#include <iterator>
+#include <algorithm>
+
+namespace Hx {
+
+/**
+ * Tag type for bulk insertion of a range that is already sorted and
+ * free of duplicates (with respect to the container's comparison).
+ */
+struct sorted_unique_t { explicit sorted_unique_t() = default; };
+
+constexpr sorted_unique_t sorted_unique{};
+
+/**
+ * Branchless lower bound on a random access range.
+ * The loop body only selects between two bases (compiled to a cmov), so the
+ * search costs log2(n) predictable iterations instead of log2(n) mispredicted
+ * branches. comp(elem, val) must return true if elem goes before val.
+ */
+template <typename RandomAccessIterator, typename T, typename Compare>
+RandomAccessIterator flat_lower_bound(RandomAccessIterator first,
+        RandomAccessIterator last, const T& val, Compare comp)
+{
+#ifdef USE_STD_LOWER_BOUND
+    return std::lower_bound(first, last, val, comp);
+#else
+    typename std::iterator_traits<RandomAccessIterator>::difference_type n = last - first;
+    if (n == 0)
+        return last;
+
+    RandomAccessIterator base = first;
+    while (n > 1) {
+        auto half = n / 2;
+        base = comp(base[half], val) ? base + half : base;
+        n -= half;
+    }
+    return base + (comp(*base, val) ? 1 : 0);
+#endif
+}
+
+/**
+ * Branchless upper bound on a random access range.
+ * comp(val, elem) must return true if val goes before elem.
+ */
+template <typename RandomAccessIterator, typename T, typename Compare>
+RandomAccessIterator flat_upper_bound(RandomAccessIterator first,
+        RandomAccessIterator last, const T& val, Compare comp)
+{
+#ifdef USE_STD_LOWER_BOUND
+    return std::upper_bound(first, last, val, comp);
+#else
+    typename std::iterator_traits<RandomAccessIterator>::difference_type n = last - first;
+    if (n == 0)
+        return last;
+
+    RandomAccessIterator base = first;
+    while (n > 1) {
+        auto half = n / 2;
+        base = !comp(val, base[half]) ? base + half : base;
+        n -= half;
+    }
+    return base + (!comp(val, *base) ? 1 : 0);
+#endif
+}
+
+/**
+ * Reserves room in c for n elements plus those of [first, last), when the
+ * range can be measured without consuming it (forward iterators or
+ * better); a single-pass range is left alone.
+ */
+template <typename Container, typename InputIterator>
+void flat_reserve(Container& c, typename Container::size_type n,
+        InputIterator first, InputIterator last, std::input_iterator_tag)
+{
+    (void) c; (void) n; (void) first; (void) last;
+}
+
+template <typename Container, typename ForwardIterator>
+void flat_reserve(Container& c, typename Container::size_type n,
+        ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+{
+    c.reserve(n + std::distance(first, last));
+}
+
+template <typename Container, typename InputIterator>
+void flat_reserve(Container& c, typename Container::size_type n, InputIterator first, InputIterator last)
+{
+    flat_reserve(c, n, first, last, typename std::iterator_traits<InputIterator>::iterator_category());
+}
+
+}   // namespace Hx
+
+#endif // MINI_STL_FLAT_SEARCH_INC
@@ -0,0 +1,568 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_FLAT_SET_INC
+#define MINI_STL_FLAT_SET_INC
+
+#include "vector.hpp"
+#include "flat_search.hpp"
+
+#include <cassert>
+#include <functional>
+#include <utility>
+#include <algorithm>
+#include <initializer_list>
+
+namespace Hx {
+
+/**
+ * Flat sets are containers that store unique elements following a specific
+ * order, like set, but keep them in a sorted contiguous container instead of
+ * a node tree: lookups touch far fewer cache lines, while insertion and
+ * erasure of a single element cost O(n) element moves.
+ */
+template <typename Key, typename Compare = std::less<Key>,
+          typename KeyContainer = Hx::vector<Key>>
+class flat_set {
+public:
+    typedef Key key_type;
+    typedef Key value_type;
+    typedef Compare key_compare;
+    typedef Compare value_compare;
+    typedef KeyContainer container_type;
+    typedef typename container_type::allocator_type allocator_type;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef typename container_type::const_pointer pointer;
+    typedef typename container_type::const_pointer const_pointer;
+    typedef typename container_type::const_iterator iterator;
+    typedef typename container_type::const_iterator const_iterator;
+    typedef typename container_type::const_reverse_iterator reverse_iterator;
+    typedef typename container_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename container_type::difference_type difference_type;
+    typedef typename container_type::size_type size_type;
+
+private:
+    Compare less_;
+    container_type cont_;
+
+public:
+    /**
+     * empty container constructors (default constructor)
+     * Constructs an empty container, with no elements.
+     */
+    flat_set(): flat_set(key_compare(), allocator_type()) {}
+
+    explicit flat_set(const key_compare& comp,
+                      const allocator_type& alloc = allocator_type()):
+        less_(comp), cont_(alloc) {}
+
+    explicit flat_set(const allocator_type& alloc): flat_set(key_compare(), alloc) {}
+
+    /**
+     * container constructors
+     * Adopts the elements of cont, sorting them and removing duplicates.
+     * The sorted_unique version trusts cont to be sorted and unique already.
+     */
+    explicit flat_set(container_type cont, const key_compare& comp = key_compare()):
+        less_(comp), cont_(std::move(cont))
+    {
+        sort_unique(cont_.begin());
+    }
+
+    flat_set(sorted_unique_t, container_type cont, const key_compare& comp = key_compare()):
+        less_(comp), cont_(std::move(cont))
+    {
+        assert(is_sorted_unique(cont_.begin(), cont_.end()));
+    }
+
+    /**
+     *  range constructor
+     *  Constructs a container with as many elements as the range [first,last),
+     *  with each element emplace-constructed from its corresponding element in that range.
+     */
+    template <typename InputIterator>
+    flat_set(InputIterator first, InputIterator last,
+             const key_compare& comp = key_compare(),
+             const allocator_type& alloc = allocator_type()): less_(comp), cont_(alloc)
+    {
+        insert(first, last);
+    }
+
+    template <typename InputIterator>
+    flat_set(InputIterator first, InputIterator last,
+             const allocator_type& alloc): flat_set(first, last, key_compare(), alloc) {}
+
+    template <typename InputIterator>
+    flat_set(sorted_unique_t, InputIterator first, InputIterator last,
+             const key_compare& comp = key_compare(),
+             const allocator_type& alloc = allocator_type()): less_(comp), cont_(alloc)
+    {
+        insert(sorted_unique, first, last);
+    }
+
+    /**
+     * initializer list constructor
+     * Constructs a container with a copy of each of the elements in il.
+     */
+    flat_set(std::initializer_list<value_type> il,
+             const key_compare& comp = key_compare(),
+             const allocator_type& alloc = allocator_type()): flat_set(il.begin(), il.end(), comp, alloc) {}
+
+    flat_set(std::initializer_list<value_type> il, const allocator_type& alloc): flat_set(il, key_compare(), alloc) {}
+
+    /**
+     * copy constructor (and copying with allocator)
+     * Constructs a container with a copy of each of the elements in x.
+     */
+    flat_set(const flat_set& x) = default;
+
+    flat_set(const flat_set& x, const allocator_type& alloc): less_(x.less_), cont_(x.cont_, alloc) {}
+
+    /**
+     * move constructor (and moving with allocator)
+     * Constructs a container that acquires the elements of x.
+     */
+    flat_set(flat_set&& x) = default;
+
+    flat_set(flat_set&& x, const allocator_type& alloc): less_(std::move(x.less_)), cont_(std::move(x.cont_), alloc) {}
+
+    /**
+     * Copy container content
+     * Assigns new contents to the container, replacing its current content.
+     */
+    flat_set& operator=(const flat_set& x) = default;
+
+    flat_set& operator=(flat_set&& x) = default;
+
+    flat_set& operator=(std::initializer_list<value_type> il)
+    {
+        flat_set(il, less_).swap(*this);
+        return *this;
+    }
+
+    /**
+     * Return iterator to beginning
+     * Returns an iterator referring to the first element in the flat_set container.
+     */
+    iterator begin() noexcept { return cont_.begin(); }
+    const_iterator begin() const noexcept { return cont_.begin(); }
+
+    /**
+     * Return iterator to end
+     * Returns an iterator referring to the past-the-end element in the flat_set container.
+     */
+    iterator end() noexcept { return cont_.end(); }
+    const_iterator end() const noexcept { return cont_.end(); }
+
+    /**
+     * Return const_iterator to beginning/end
+     */
+    const_iterator cbegin() const noexcept { return cont_.cbegin(); }
+    const_iterator cend() const noexcept { return cont_.cend(); }
+
+    /**
+     * Return reverse iterator to reverse beginning/end
+     */
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    /**
+     * Test whether container is empty
+     * Returns whether the flat_set container is empty (i.e. whether its size is 0).
+     */
+    bool empty() const noexcept { return cont_.empty(); }
+
+    /**
+     * Return container size
+     * Returns the number of elements in the flat_set container.
+     */
+    size_type size() const noexcept { return cont_.size(); }
+
+    /**
+     * Return maximum size
+     * Returns the maximum number of elements that the flat_set container can hold.
+     */
+    size_type max_size() const noexcept { return cont_.max_size(); }
+
+    /**
+     * Request a change in capacity / shrink to fit
+     * Forwarded to the underlying container.
+     */
+    size_type capacity() const noexcept { return cont_.capacity(); }
+    void reserve(size_type n) { cont_.reserve(n); }
+    void shrink_to_fit() { cont_.shrink_to_fit(); }
+
+    /**
+     * Insert element
+     * Extends the container by inserting new elements, effectively increasing the container size by the number of elements inserted.
+     */
+    std::pair<iterator, bool> insert(const value_type& val)
+    {
+        iterator pos = lower_bound(val);
+        if (pos != end() && !less_(val, *pos))
+            return std::make_pair(pos, false);
+        return std::make_pair(iterator(cont_.insert(pos, val)), true);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& val)
+    {
+        iterator pos = lower_bound(val);
+        if (pos != end() && !less_(val, *pos))
+            return std::make_pair(pos, false);
+        return std::make_pair(iterator(cont_.insert(pos, std::move(val))), true);
+    }
+
+    /**
+     * The hint is used when val belongs right before position, which makes
+     * inserting an already sorted sequence O(1) search per element.
+     */
+    iterator insert(const_iterator position, const value_type& val)
+    {
+        if (hint_fits(position, val))
+            return cont_.insert(position, val);
+        return insert(val).first;
+    }
+
+    iterator insert(const_iterator position, value_type&& val)
+    {
+        if (hint_fits(position, val))
+            return cont_.insert(position, std::move(val));
+        return insert(std::move(val)).first;
+    }
+
+    /**
+     * Range insertion appends the new elements, sorts only the appended part,
+     * then merges it with the old elements: O(n + m log m).
+     */
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        size_type n = size();
+        while (first != last) {
+            cont_.push_back(*first++);
+        }
+        sort_unique(cont_.begin()+n);
+    }
+
+    /**
+     * Bulk insertion of a range that is already sorted and unique: a single
+     * O(n + m) merge pass into fresh storage, skipping keys already present.
+     */
+    template <typename InputIterator>
+    void insert(sorted_unique_t, InputIterator first, InputIterator last)
+    {
+        if (first == last)
+            return;
+
+        if (empty() || less_(back(), *first)) { // pure append
+            while (first != last) {
+                assert(empty() || less_(back(), *first));
+                cont_.push_back(*first++);
+            }
+            return;
+        }
+
+        container_type merged(cont_.get_allocator());
+        flat_reserve(merged, size(), first, last);
+
+        typename container_type::iterator it = cont_.begin();
+        typename container_type::iterator end = cont_.end();
+        while (it != end && first != last) {
+            if (less_(*it, *first)) {
+                merged.push_back(std::move(*it++));
+            } else if (less_(*first, *it)) {
+                merged.push_back(*first++);
+            } else {    // equivalent, keep the old element
+                merged.push_back(std::move(*it++));
+                ++first;
+            }
+        }
+        while (it != end) {
+            merged.push_back(std::move(*it++));
+        }
+        while (first != last) {
+            merged.push_back(*first++);
+        }
+        cont_.swap(merged);
+    }
+
+    void insert(std::initializer_list<value_type> il)
+    {
+        insert(il.begin(), il.end());
+    }
+
+    void insert(sorted_unique_t, std::initializer_list<value_type> il)
+    {
+        insert(sorted_unique, il.begin(), il.end());
+    }
+
+    /**
+     * Erase elements
+     * Removes from the flat_set container either a single element or a range of elements ([first,last)).
+     */
+    iterator erase(const_iterator position)
+    {
+        assert(position != end());
+        return cont_.erase(position);
+    }
+
+    size_type erase(const value_type& val)
+    {
+        iterator it = find(val);
+        if (it == end())
+            return 0;
+        erase(it);
+        return 1;
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        if (first == last)
+            return last;
+        return cont_.erase(first, last);
+    }
+
+    /**
+     * Swap content
+     * Exchanges the content of the container by the content of x, which is another flat_set of the same type. Sizes may differ.
+     */
+    void swap(flat_set& x)
+    {
+        using std::swap;
+        swap(less_, x.less_);
+        cont_.swap(x.cont_);
+    }
+
+    /**
+     * Clear content
+     * Removes all elements from the flat_set container (which are destroyed), leaving the container with a size of 0.
+     */
+    void clear() noexcept
+    {
+        cont_.clear();
+    }
+
+    /**
+     * Extract / replace the underlying container
+     * extract leaves *this empty; replace requires cont to be sorted and unique.
+     */
+    container_type extract()
+    {
+        container_type cont(std::move(cont_));
+        cont_.clear();
+        return cont;
+    }
+
+    void replace(container_type&& cont)
+    {
+        assert(is_sorted_unique(cont.begin(), cont.end()));
+        cont_ = std::move(cont);
+    }
+
+    /**
+     * Construct and insert element
+     * Inserts a new element in the flat_set, if unique. This new element is constructed using args as the arguments for its construction.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+
+    template <typename... Args>
+    iterator emplace_hint(const_iterator position, Args&&... args)
+    {
+        return insert(position, value_type(std::forward<Args>(args)...));
+    }
+
+    /**
+     * Return comparison object
+     * Returns a copy of the comparison object used by the container.
+     */
+    key_compare key_comp() const
+    {
+        return less_;
+    }
+
+    value_compare value_comp() const
+    {
+        return less_;
+    }
+
+    /**
+     * Get iterator to element
+     * Searches the container for an element equivalent to val and returns an iterator to it if found,
+     * otherwise it returns an iterator to flat_set::end.
+     */
+    iterator find(const value_type& val)
+    {
+        iterator it = lower_bound(val);
+        return (it != end() && !less_(val, *it)) ? it : end();
+    }
+
+    const_iterator find(const value_type& val) const
+    {
+        const_iterator it = lower_bound(val);
+        return (it != end() && !less_(val, *it)) ? it : end();
+    }
+
+    /**
+     * Count elements with a specific value
+     * Searches the container for elements equivalent to val and returns the number of matches.
+     */
+    size_type count(const value_type& val) const
+    {
+        return find(val) == end() ? 0 : 1;
+    }
+
+    /**
+     * Return iterator to lower bound
+     * Returns an iterator pointing to the first element in the container which is not considered to go before val.
+     */
+    iterator lower_bound(const value_type& val)
+    {
+        return flat_lower_bound(cont_.cbegin(), cont_.cend(), val, less_);
+    }
+
+    const_iterator lower_bound(const value_type& val) const
+    {
+        return flat_lower_bound(cont_.cbegin(), cont_.cend(), val, less_);
+    }
+
+    /**
+     * Return iterator to upper bound
+     * Returns an iterator pointing to the first element in the container which is considered to go after val.
+     */
+    iterator upper_bound(const value_type& val)
+    {
+        return flat_upper_bound(cont_.cbegin(), cont_.cend(), val, less_);
+    }
+
+    const_iterator upper_bound(const value_type& val) const
+    {
+        return flat_upper_bound(cont_.cbegin(), cont_.cend(), val, less_);
+    }
+
+    /**
+     * Get range of equal elements
+     * Because all elements in a flat_set container are unique, the range returned will contain a single element at most.
+     */
+    std::pair<iterator,iterator> equal_range(const value_type& val)
+    {
+        iterator it = lower_bound(val);
+        if (it != end() && !less_(val, *it))
+            return std::make_pair(it, it+1);
+        return std::make_pair(it, it);
+    }
+
+    std::pair<const_iterator,const_iterator> equal_range(const value_type& val) const
+    {
+        const_iterator it = lower_bound(val);
+        if (it != end() && !less_(val, *it))
+            return std::make_pair(it, it+1);
+        return std::make_pair(it, it);
+    }
+
+    /**
+     * Get allocator
+     * Returns a copy of the allocator object associated with the underlying container.
+     */
+    allocator_type get_allocator() const noexcept
+    {
+        return cont_.get_allocator();
+    }
+
+private:
+    const value_type& back() const
+    {
+        return *(cont_.end()-1);
+    }
+
+    bool hint_fits(const_iterator position, const value_type& val) const
+    {
+        return (position == end() || less_(val, *position)) &&
+               (position == begin() || less_(*(position-1), val));
+    }
+
+    template <typename Iterator>
+    bool is_sorted_unique(Iterator first, Iterator last) const
+    {
+        return std::adjacent_find(first, last,
+            [this](const value_type& a, const value_type& b) { return !less_(a, b); }) == last;
+    }
+
+    // sort [mid, end()), merge it into the sorted prefix [begin(), mid)
+    // and drop duplicates
+    void sort_unique(typename container_type::iterator mid)
+    {
+        typename container_type::iterator first = cont_.begin();
+        typename container_type::iterator last = cont_.end();
+        std::sort(mid, last, less_);
+        std::inplace_merge(first, mid, last, less_);
+        last = std::unique(first, last,
+            [this](const value_type& a, const value_type& b) { return !less_(a, b); });
+        if (last != cont_.end())
+            cont_.erase(last, cont_.end());
+    }
+};
+
+template <typename Key, typename Compare, typename KeyContainer>
+inline
+bool operator==(const flat_set<Key, Compare, KeyContainer> &lhs, const flat_set<Key, Compare, KeyContainer> &rhs)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+inline
+bool operator!=(const flat_set<Key, Compare, KeyContainer> &lhs, const flat_set<Key, Compare, KeyContainer> &rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+inline
+bool operator<(const flat_set<Key, Compare, KeyContainer> &lhs, const flat_set<Key, Compare, KeyContainer> &rhs)
+{
+    return std::lexicographical_compare(lhs.begin(), lhs.end(),
+        rhs.begin(), rhs.end());
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+inline
+bool operator>(const flat_set<Key, Compare, KeyContainer> &lhs, const flat_set<Key, Compare, KeyContainer> &rhs)
+{
+    return (rhs < lhs);
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+inline
+bool operator<=(const flat_set<Key, Compare, KeyContainer> &lhs, const flat_set<Key, Compare, KeyContainer> &rhs)
+{
+    return !(lhs > rhs);
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+inline
+bool operator>=(const flat_set<Key, Compare, KeyContainer> &lhs, const flat_set<Key, Compare, KeyContainer> &rhs)
+{
+    return !(lhs < rhs);
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+inline
+void swap(flat_set<Key, Compare, KeyContainer> &x, flat_set<Key, Compare, KeyContainer> &y)
+{
+    x.swap(y);
+}
+
+} // namespace Hx
+
+#endif // MINI_STL_FLAT_SET_INC
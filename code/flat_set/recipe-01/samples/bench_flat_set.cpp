@@ -0,0 +1,96 @@
+// Hx::flat_set and Hx::set against std::set; see "bench.hpp" for the options.
+#include <set>
+#include <vector>
+#include "set.hpp"
+#include "flat_set.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+// n distinct keys in pseudo random order
+std::vector<int> make_keys(long n)
+{
+    std::vector<int> keys(n);
+    for (long i = 0; i < n; i++)
+        keys[i] = int((i * 2654435761u) % 4294967291u);
+    return keys;
+}
+
+template <typename Set>
+void build(state& st)
+{
+    std::vector<int> keys = make_keys(st.arg());
+    while (st.keep_running()) {
+        Set s(keys.begin(), keys.end());
+        do_not_optimize(s);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+template <typename Set>
+void find(state& st)
+{
+    std::vector<int> keys = make_keys(st.arg());
+    Set s(keys.begin(), keys.end());
+    while (st.keep_running()) {
+        size_t found = 0;
+        for (size_t i = 0; i < keys.size(); i++)
+            found += (s.find(keys[i]) != s.end());
+        do_not_optimize(found);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+// half of the probes hit, half miss
+template <typename Set>
+void lookup(state& st)
+{
+    const long n = st.arg();
+    std::vector<int> keys = make_keys(2*n);
+    Set s(keys.begin(), keys.begin()+n);
+    std::vector<int> probes(2*n);
+    for (long i = 0; i < n; i++) {
+        probes[2*i] = keys[i];
+        probes[2*i+1] = keys[n+i];
+    }
+    while (st.keep_running()) {
+        size_t found = 0;
+        for (size_t i = 0; i < probes.size(); i++)
+            found += (s.find(probes[i]) != s.end());
+        do_not_optimize(found);
+    }
+    st.set_items_per_iteration(2*n);
+}
+
+template <typename Set>
+void iterate(state& st)
+{
+    std::vector<int> keys = make_keys(st.arg());
+    Set s(keys.begin(), keys.end());
+    while (st.keep_running()) {
+        int sum = 0;
+        for (auto it = s.begin(); it != s.end(); ++it)
+            sum += *it;
+        do_not_optimize(sum);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("flat_set");
+    s.add("build", "std", build<std::set<int>>).args({1000, 100000});
+    s.add("build", "Hx_set", build<Hx::set<int>>).args({1000, 100000});
+    s.add("build", "Hx_flat_set", build<Hx::flat_set<int>>).args({1000, 100000});
+    s.add("find", "std", find<std::set<int>>).args({1000, 100000});
+    s.add("find", "Hx_set", find<Hx::set<int>>).args({1000, 100000});
+    s.add("find", "Hx_flat_set", find<Hx::flat_set<int>>).args({1000, 100000});
+    s.add("lookup", "std", lookup<std::set<int>>).args({1000, 100000, 1000000});
+    s.add("lookup", "Hx_set", lookup<Hx::set<int>>).args({1000, 100000, 1000000});
+    s.add("lookup", "Hx_flat_set", lookup<Hx::flat_set<int>>).args({1000, 100000, 1000000});
+    s.add("iterate", "std", iterate<std::set<int>>).args({1000, 100000});
+    s.add("iterate", "Hx_set", iterate<Hx::set<int>>).args({1000, 100000});
+    s.add("iterate", "Hx_flat_set", iterate<Hx::flat_set<int>>).args({1000, 100000});
+    return s.run(argc, argv);
+}
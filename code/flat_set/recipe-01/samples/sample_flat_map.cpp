@@ -0,0 +1,44 @@
+// flat_map::operator[]/at/try_emplace
+#include <iostream>
+#include <string>
+#include "flat_map.hpp"
+
+int main ()
+{
+  Hx::flat_map<char,std::string> mymap;
+
+  mymap['a']="an element";
+  mymap['b']="another element";
+  mymap['c']=mymap['b'];
+  mymap.try_emplace('a', "ignored");
+  mymap.insert_or_assign('d', "inserted");
+
+  std::cout << "mymap['a'] is " << mymap['a'] << '\n';
+  std::cout << "mymap['b'] is " << mymap['b'] << '\n';
+  std::cout << "mymap['c'] is " << mymap.at('c') << '\n';
+  std::cout << "mymap['d'] is " << mymap.at('d') << '\n';
+  std::cout << "mymap['e'] is " << mymap['e'] << '\n';
+
+  std::cout << "mymap now contains " << mymap.size() << " elements.\n";
+
+  for (auto it=mymap.begin(); it!=mymap.end(); ++it)
+    std::cout << it->first << " => " << it->second << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+mymap['a'] is an element
+mymap['b'] is another element
+mymap['c'] is another element
+mymap['d'] is inserted
+mymap['e'] is 
+mymap now contains 5 elements.
+a => an element
+b => another element
+c => another element
+d => inserted
+e => 
+*/
@@ -0,0 +1,34 @@
+// flat_set::insert/find/erase
+#include <iostream>
+#include "flat_set.hpp"
+
+int main ()
+{
+  Hx::flat_set<int> myset {50, 20, 40, 10, 30, 20};
+  Hx::flat_set<int>::iterator it;
+
+  myset.insert(25);
+  myset.insert(myset.end(), 60);                  // hint: appended without searching
+
+  it=myset.find(20);
+  myset.erase (it);
+  myset.erase (40);
+
+  std::cout << "myset contains:";
+  for (it=myset.begin(); it!=myset.end(); ++it)
+    std::cout << ' ' << *it;
+  std::cout << '\n';
+
+  std::cout << "count(30): " << myset.count(30) << '\n';
+  std::cout << "count(40): " << myset.count(40) << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+myset contains: 10 25 30 50 60
+count(30): 1
+count(40): 0
+*/
@@ -0,0 +1,76 @@
+// memory per element: Hx::flat_set vs Hx::set vs std::set
+#include <cstddef>
+#include <cstdio>
+#include <set>
+#include <vector>
+#include "vector.hpp"
+#include "set.hpp"
+#include "flat_set.hpp"
+
+static size_t g_allocated = 0;
+
+// counts the bytes currently held by a container
+template <typename T>
+struct counting_allocator {
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind { typedef counting_allocator<U> other; };
+
+    counting_allocator() = default;
+
+    template <typename U>
+    counting_allocator(const counting_allocator<U>&) {}
+
+    T* allocate(size_t n)
+    {
+        g_allocated += n * sizeof(T);
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n)
+    {
+        g_allocated -= n * sizeof(T);
+        ::operator delete(p);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const counting_allocator<T>&, const counting_allocator<U>&) { return true; }
+
+template <typename T, typename U>
+bool operator!=(const counting_allocator<T>&, const counting_allocator<U>&) { return false; }
+
+typedef Hx::flat_set<int, std::less<int>, Hx::vector<int, counting_allocator<int>>> hx_flat_set;
+typedef Hx::set<int, std::less<int>, counting_allocator<int>> hx_set;
+typedef std::set<int, std::less<int>, counting_allocator<int>> std_set;
+
+template <typename Set>
+void footprint(const char* name, const std::vector<int>& keys)
+{
+    size_t before = g_allocated;
+    Set s;
+    s.insert(keys.begin(), keys.end());
+    size_t bytes = g_allocated - before;
+    printf("%-14s %8zu keys %6.1f bytes/elem\n", name, s.size(), (double) bytes / keys.size());
+}
+
+int main()
+{
+    for (size_t n: {1000u, 100000u, 1000000u}) {
+        std::vector<int> keys(n);
+        for (size_t i = 0; i < n; i++)
+            keys[i] = int((i * 2654435761u) % 4294967291u);
+
+        footprint<hx_flat_set>("Hx::flat_set", keys);
+        footprint<hx_set>("Hx::set", keys);
+        footprint<std_set>("std::set", keys);
+    }
+    return 0;
+}
@@ -0,0 +1,36 @@
+// flat_set::insert(sorted_unique, first, last)
+#include <iostream>
+#include <vector>
+#include "flat_set.hpp"
+
+int main ()
+{
+  Hx::flat_set<int> myset {10, 20, 30, 40};
+
+  // already sorted and unique: merged in a single pass,
+  // keys already in the set are skipped
+  std::vector<int> sorted {5, 20, 25, 45, 50};
+  myset.insert(Hx::sorted_unique, sorted.begin(), sorted.end());
+
+  std::cout << "myset contains:";
+  for (int x: myset)
+    std::cout << ' ' << x;
+  std::cout << '\n';
+
+  // unsorted input: appended, sorted and merged
+  myset.insert({35, 1, 35, 15});
+
+  std::cout << "myset contains:";
+  for (int x: myset)
+    std::cout << ' ' << x;
+  std::cout << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+myset contains: 5 10 20 25 30 40 45 50
+myset contains: 1 5 10 15 20 25 30 35 40 45 50
+*/
@@ -0,0 +1,32 @@
+// flat_set::lower_bound/upper_bound
+#include <iostream>
+#include "flat_set.hpp"
+
+int main ()
+{
+  Hx::flat_set<int> myset;
+  Hx::flat_set<int>::iterator itlow,itup;
+
+  for (int i=1; i<10; i++) myset.insert(i*10); // 10 20 30 40 50 60 70 80 90
+
+  itlow=myset.lower_bound (30);                //       ^
+  itup=myset.upper_bound (60);                 //                   ^
+
+  myset.erase(itlow,itup);                     // 10 20 70 80 90
+
+  std::cout << "myset contains:";
+  for (Hx::flat_set<int>::iterator it=myset.begin(); it!=myset.end(); ++it)
+    std::cout << ' ' << *it;
+  std::cout << '\n';
+
+  std::pair<Hx::flat_set<int>::const_iterator,Hx::flat_set<int>::const_iterator> ret;
+  ret = myset.equal_range(75);
+  std::cout << "equal_range(75) is empty, both bounds point to: " << *ret.first << '\n';
+
+  return 0;
+}
+
+/*
+myset contains: 10 20 70 80 90
+equal_range(75) is empty, both bounds point to: 80
+*/
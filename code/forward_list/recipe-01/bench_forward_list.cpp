@@ -0,0 +1,94 @@
+// Hx::forward_list and Hx::unrolled_forward_list against std::forward_list;
+// see "bench.hpp" for the options.
+#include <forward_list>
+#include <random>
+#include <vector>
+#include "forward_list.hpp"
+#include "unrolled_forward_list.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+template <typename List>
+void push_front(state& st)
+{
+    long n = st.arg();
+    while (st.keep_running()) {
+        List l;
+        for (long i = 0; i < n; i++)
+            l.push_front(int(i));
+        do_not_optimize(l);
+    }
+    st.set_items_per_iteration(n);
+}
+
+template <typename List>
+void build(List& l, long n)
+{
+    for (long i = 0; i < n; i++)
+        l.push_front(int(i));
+}
+
+// an Hx::forward_list whose list order is unrelated to the allocation
+// order of its nodes, i.e. one that has been through a lot of
+// insert_after churn
+struct shuffled_list: Hx::forward_list<int> {};
+
+void build(shuffled_list& l, long n)
+{
+    std::mt19937 gen(12345);
+    std::vector<shuffled_list::iterator> its;
+    its.reserve(n+1);
+    its.push_back(l.before_begin());
+    for (long i = 0; i < n; i++) {
+        std::uniform_int_distribution<size_t> pick(0, its.size()-1);
+        its.push_back(l.insert_after(its[pick(gen)], int(i)));
+    }
+}
+
+template <typename List>
+void iterate(state& st)
+{
+    List l;
+    build(l, st.arg());
+    while (st.keep_running()) {
+        int sum = 0;
+        for (auto it = l.begin(); it != l.end(); ++it)
+            sum += *it;
+        do_not_optimize(sum);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+template <typename List>
+void insert_erase_after(state& st)
+{
+    List l;
+    build(l, st.arg());
+    while (st.keep_running()) {
+        for (auto it = l.begin(); it != l.end(); ++it)
+            it = l.insert_after(it, -1);
+        for (auto it = l.begin(); it != l.end(); ++it)
+            l.erase_after(it);
+        do_not_optimize(l);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("forward_list");
+    s.add("push_front", "std", push_front<std::forward_list<int>>).args({1000, 100000});
+    s.add("push_front", "Hx", push_front<Hx::forward_list<int>>).args({1000, 100000});
+    s.add("push_front", "Hx_unrolled", push_front<Hx::unrolled_forward_list<int>>).args({1000, 100000});
+    s.add("iterate", "std", iterate<std::forward_list<int>>).args({1000, 100000});
+    s.add("iterate", "Hx", iterate<Hx::forward_list<int>>).args({1000, 100000});
+    s.add("iterate", "Hx_shuffled", iterate<shuffled_list>).args({1000, 100000});
+    s.add("iterate", "Hx_unrolled", iterate<Hx::unrolled_forward_list<int>>).args({1000, 100000});
+    s.add("insert_erase_after", "std", insert_erase_after<std::forward_list<int>>).args({1000, 100000});
+    s.add("insert_erase_after", "Hx", insert_erase_after<Hx::forward_list<int>>).args({1000, 100000});
+    s.add("insert_erase_after", "Hx_shuffled", insert_erase_after<shuffled_list>).args({1000, 100000});
+    s.add("insert_erase_after", "Hx_unrolled", insert_erase_after<Hx::unrolled_forward_list<int>>).args({1000, 100000});
+    return s.run(argc, argv);
+}
@@ -0,0 +1,60 @@
+// unrolled_forward_list: insert_after, erase_after and splice_after
+#include <iostream>
+#include <array>
+#include "unrolled_forward_list.hpp"
+
+typedef Hx::unrolled_forward_list<int, std::allocator<int>, 4> ilist;   // 4 elements per chunk
+
+void print(const char* name, const ilist& lst)
+{
+  std::cout << name << " contains:";
+  for (const int& x: lst) std::cout << ' ' << x;
+  std::cout << '\n';
+}
+
+int main ()
+{
+  std::array<int,3> myarray = { 11, 22, 33 };
+  ilist mylist;
+  ilist::iterator it;
+
+  it = mylist.insert_after ( mylist.before_begin(), 10 );          // 10
+  it = mylist.insert_after ( it, 2, 20 );                          // 10 20 20
+  it = mylist.insert_after ( it, myarray.begin(), myarray.end() ); // 10 20 20 11 22 33
+  it = mylist.begin();
+  it = mylist.insert_after ( it, {1,2,3} );                        // 10 1 2 3 20 20 11 22 33
+  print("mylist", mylist);
+
+  it = mylist.begin();
+  it = mylist.erase_after(it);                                     // 10 2 3 20 20 11 22 33
+  ++it; ++it;                                                      // 10 2 3 20 ...
+                                                                   //        ^
+  it = mylist.erase_after(it, mylist.end());                       // 10 2 3 20
+  print("mylist", mylist);
+
+  ilist first = { 1, 2, 3 };
+  ilist second = { 10, 20, 30 };
+
+  it = first.begin();                                              // points to the 1
+
+  first.splice_after ( first.before_begin(), second );             // first: 10 20 30 1 2 3
+  second.splice_after ( second.before_begin(), first, first.begin(), it);
+                                                                   // first: 10 1 2 3
+                                                                   // second: 20 30
+  first.splice_after ( first.before_begin(), second, second.begin() );
+                                                                   // first: 30 10 1 2 3
+                                                                   // second: 20
+  print("first", first);
+  print("second", second);
+
+  return 0;
+}
+
+/*
+Output:
+
+mylist contains: 10 1 2 3 20 20 11 22 33
+mylist contains: 10 2 3 20
+first contains: 30 10 1 2 3
+second contains: 20
+*/
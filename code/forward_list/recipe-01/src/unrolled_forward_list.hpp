@@ -0,0 +1,1022 @@
+// -*- C++ -*-
+// HeXu's
+// 2026 Oct
+
+#ifndef MINI_STL_UNROLLED_FORWARD_LIST_INC
+#define MINI_STL_UNROLLED_FORWARD_LIST_INC
+
+#include "singly_linked_list.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <limits>
+#include <functional>
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+
+namespace Hx {
+
+/**
+ * Chunk header shared by the head of the list and the element chunks.
+ * The head is a chunk_base with count == 0, so an iterator can step off
+ * before_begin() exactly like it steps off the last element of a chunk.
+ */
+struct unrolled_forward_list_chunk_base: public singly_linked::list_node_t {
+    size_t count = 0;
+};
+
+/**
+ * A helper node class for unrolled_forward_list.
+ * Holds up to N elements in uninitialized storage; only the first count
+ * slots are constructed. Chunks in a list are never empty.
+ */
+template <typename T, size_t N>
+struct unrolled_forward_list_chunk: public unrolled_forward_list_chunk_base {
+    // raw storage buffer for N objects of type T
+    struct alignas(alignof(T)) { char data[sizeof(T) * N]; } storage;
+
+    T* valptr(size_t i) noexcept
+    {
+        return static_cast<T*>(static_cast<void*>(&storage)) + i;
+    }
+
+    const T* valptr(size_t i) const noexcept
+    {
+        return static_cast<const T*>(static_cast<const void*>(&storage)) + i;
+    }
+};
+
+/**
+ * Default number of elements per chunk: about four cache lines of payload,
+ * but never less than 4 elements.
+ */
+template <typename T>
+struct unrolled_forward_list_default_chunk_size {
+    static const size_t value = (sizeof(T) * 4 <= 256) ? 256 / sizeof(T) : 4;
+};
+
+#include "unrolled_forward_list_iterator.hpp"
+
+/**
+ * Unrolled forward list
+ * A forward_list that packs up to N elements into each node, so that
+ * traversal touches one node per N elements instead of one per element.
+ *
+ * insert_after, erase_after and splice_after keep the forward_list
+ * semantics (position, return value, resulting order), but since elements
+ * live in arrays they may be moved inside or between chunks:
+ * - insert_after / emplace_after invalidate iterators to the elements that
+ *   followed position in the same chunk;
+ * - erase_after invalidates iterators to the elements following position;
+ * - splice_after relinks whole chunks, so only the elements sharing a chunk
+ *   with position, first or last are moved.
+ * Iterators to position itself and to the elements before it stay valid.
+ */
+template <typename T, typename Alloc = std::allocator<T>,
+    size_t N = unrolled_forward_list_default_chunk_size<T>::value>
+class unrolled_forward_list {
+    static_assert(N > 0, "unrolled_forward_list chunk size must be positive");
+
+public:
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef typename allocator_type::reference reference;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef typename allocator_type::pointer pointer;
+    typedef typename allocator_type::const_pointer const_pointer;
+    typedef unrolled_forward_list_iterator<T, N> iterator;
+    typedef unrolled_forward_list_const_iterator<T, N> const_iterator;
+    typedef typename iterator::difference_type difference_type;
+    typedef size_t size_type;
+
+    static const size_type chunk_size = N;
+
+private:
+    typedef singly_linked::list_node_t link_type;
+    typedef unrolled_forward_list_chunk_base chunk_base;
+    typedef unrolled_forward_list_chunk<T, N> chunk_type;
+    typedef typename
+        allocator_type::template rebind<chunk_type>::other chunk_alloc_type;
+
+    chunk_alloc_type chunk_alloc_;
+    chunk_base head_;
+
+public:
+    /**
+     * empty container constructor (default constructor)
+     * Constructs an empty container, with no elements.
+     */
+    unrolled_forward_list(): unrolled_forward_list(allocator_type()) {}
+
+    explicit unrolled_forward_list(const allocator_type& alloc): chunk_alloc_(alloc) {}
+
+    /**
+     * fill constructor
+     * Constructs a container with n elements. Each element is a copy of val
+     * (if provided).
+     */
+    explicit unrolled_forward_list(size_type n):
+        unrolled_forward_list(n, value_type(), allocator_type()) {}
+
+    unrolled_forward_list(size_type n, const value_type& val,
+        const allocator_type& alloc = allocator_type()): chunk_alloc_(alloc)
+    {
+        try
+        {
+            fill(n, val);
+        }
+        catch (...)
+        {
+            finalize();
+            throw;
+        }
+    }
+
+    /**
+     * range constructor
+     * Constructs a container with as many elements as the range [first,last),
+     * with each element emplace-constructed from its corresponding element
+     * in that range, in the same order.
+     */
+    template <typename InputIterator, typename = typename
+        std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    unrolled_forward_list(InputIterator first, InputIterator last,
+        const allocator_type& alloc = allocator_type()): chunk_alloc_(alloc)
+    {
+        try
+        {
+            copy_from(first, last);
+        }
+        catch (...)
+        {
+            finalize();
+            throw;
+        }
+    }
+
+    /**
+     * copy constructor (and copying with allocator)
+     * Constructs a container with a copy of each of the elements in x,
+     * in the same order.
+     */
+    unrolled_forward_list(const unrolled_forward_list& x):
+        unrolled_forward_list(x, x.get_allocator()) {}
+
+    unrolled_forward_list(const unrolled_forward_list& x, const allocator_type& alloc)
+        : chunk_alloc_(alloc)
+    {
+        try
+        {
+            copy_from(x.begin(), x.end());
+        }
+        catch (...)
+        {
+            finalize();
+            throw;
+        }
+    }
+
+    /**
+     * move constructor (and moving with allocator)
+     * Constructs a container that acquires the elements of x.
+     * x is left in an unspecified but valid state.
+     */
+    unrolled_forward_list(unrolled_forward_list&& x): chunk_alloc_(std::move(x.chunk_alloc_))
+    {
+        head_.next = x.head_.next;
+        x.head_.next = nullptr;
+    }
+
+    unrolled_forward_list(unrolled_forward_list&& x, const allocator_type& alloc):
+        chunk_alloc_(alloc)
+    {
+        try
+        {
+            copy_from(std::make_move_iterator(x.begin()), std::make_move_iterator(x.end()));
+        }
+        catch (...)
+        {
+            finalize();
+            throw;
+        }
+        x.clear();
+    }
+
+    /**
+     * initializer list constructor
+     * Constructs a container with a copy of each of the elements in il,
+     * in the same order.
+     */
+    unrolled_forward_list(std::initializer_list<value_type> il,
+        const allocator_type& alloc = allocator_type()):
+        unrolled_forward_list(il.begin(), il.end(), alloc) {}
+
+    /**
+     * List destructor
+     * Destroys the container object.
+     */
+    ~unrolled_forward_list() { finalize(); }
+
+    /**
+     * Assign content
+     * Assigns new contents to the container, replacing its current contents.
+     */
+    unrolled_forward_list& operator=(const unrolled_forward_list& x)
+    {
+        if (this == &x)
+            return *this;
+
+        copy_from(x.begin(), x.end());
+        return *this;
+    }
+
+    unrolled_forward_list& operator=(unrolled_forward_list&& x)
+    {
+        if (this == &x)
+            return *this;
+
+        this->swap(x);
+        return *this;
+    }
+
+    unrolled_forward_list& operator=(std::initializer_list<value_type> il)
+    {
+        copy_from(il.begin(), il.end());
+        return *this;
+    }
+
+    /**
+     * Return iterator to before beginning
+     * Returns an iterator pointing to the position before the first element
+     * in the container.
+     */
+    iterator before_begin() noexcept { return iterator(&head_, 0); }
+    const_iterator before_begin() const noexcept { return const_iterator(&head_, 0); }
+
+    /**
+     * Return iterator to beginning
+     * Returns an iterator pointing to the first element in the container.
+     */
+    iterator begin() noexcept { return iterator(head_.next, 0); }
+    const_iterator begin() const noexcept { return const_iterator(head_.next, 0); }
+
+    /**
+     * Return iterator to end
+     * Returns an iterator referring to the past-the-end element
+     * in the container.
+     */
+    iterator end() noexcept { return iterator(nullptr, 0); }
+    const_iterator end() const noexcept { return const_iterator(nullptr, 0); }
+
+    const_iterator cbefore_begin() const noexcept { return before_begin(); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    /**
+     * Test whether container is empty
+     * Returns a bool value indicating whether the container is empty,
+     * i.e. whether its size is 0.
+     */
+    bool empty() const noexcept { return head_.next == nullptr; }
+
+    size_type max_size() const noexcept
+    {
+        return std::numeric_limits<size_type>::max();
+    }
+
+    /**
+     * Access first element
+     * Returns a reference to the first element in the container.
+     */
+    reference front()
+    {
+        assert(!empty());
+        return *begin();
+    }
+
+    const_reference front() const
+    {
+        assert(!empty());
+        return *begin();
+    }
+
+    /**
+     * Assign content
+     * Assigns new contents to the container, replacing its current contents,
+     * and modifying its size accordingly.
+     */
+    template <typename InputIterator, typename = typename
+        std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    void assign(InputIterator first, InputIterator last)
+    {
+        copy_from(first, last);
+    }
+
+    void assign(size_type n, const value_type& val)
+    {
+        fill(n, val);
+    }
+
+    void assign(std::initializer_list<value_type> il)
+    {
+        copy_from(il.begin(), il.end());
+    }
+
+    /**
+     * Construct and insert element at beginning
+     * Inserts a new element at the beginning of the list, right before its
+     * current first element.
+     */
+    template <typename... Args>
+    void emplace_front(Args&&... args)
+    {
+        emplace_after(&head_, 0, std::forward<Args>(args)...);
+    }
+
+    /**
+     * Insert element at beginning
+     * Inserts a new element at the beginning of the list, right before its
+     * current first element.
+     * The content of val is copied (or moved) to the inserted element.
+     */
+    void push_front(const value_type& val)
+    {
+        emplace_after(&head_, 0, val);
+    }
+
+    void push_front(value_type&& val)
+    {
+        emplace_after(&head_, 0, std::move(val));
+    }
+
+    /**
+     * Delete first element
+     * Removes the first element in the container,
+     * effectively reducing its size by one.
+     */
+    void pop_front()
+    {
+        assert(!empty());
+        erase_after(&head_, 0);
+    }
+
+    /**
+     * Construct and insert element
+     * The container is extended by inserting a new element after the element
+     * at position. This new element is constructed in place using args
+     * as the arguments for its construction.
+     */
+    template <typename... Args>
+    iterator emplace_after(const_iterator position, Args&&... args)
+    {
+        return emplace_after((link_type*) position.link, position.idx,
+            std::forward<Args>(args)...);
+    }
+
+    /**
+     * Insert elements
+     * The container is extended by inserting new elements after
+     * the element at position.
+     */
+    iterator insert_after(const_iterator position, const value_type& val)
+    {
+        return emplace_after((link_type*) position.link, position.idx, val);
+    }
+
+    iterator insert_after(const_iterator position, value_type&& val)
+    {
+        return emplace_after((link_type*) position.link, position.idx, std::move(val));
+    }
+
+    iterator insert_after(const_iterator position, size_type n,
+        const value_type& val)
+    {
+        iterator current((link_type*) position.link, position.idx);
+        for (size_type i = 0; i < n; ++i) {
+            current = emplace_after(current.link, current.idx, val);
+        }
+        return current;
+    }
+
+    template <typename InputIterator, typename = typename
+        std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    iterator insert_after(const_iterator position, InputIterator first,
+        InputIterator last)
+    {
+        iterator current((link_type*) position.link, position.idx);
+        for ( ; first != last; ++first) {
+            current = emplace_after(current.link, current.idx, *first);
+        }
+        return current;
+    }
+
+    iterator insert_after(const_iterator position,
+        std::initializer_list<value_type> il)
+    {
+        return insert_after(position, il.begin(), il.end());
+    }
+
+    /**
+     * Erase elements
+     * Removes from the container either a single element
+     * (the one after position) or a range of elements ((position,last))
+     */
+    iterator erase_after(const_iterator position)
+    {
+        return erase_after((link_type*) position.link, position.idx);
+    }
+
+    iterator erase_after(const_iterator position, const_iterator last)
+    {
+        link_type* link = (link_type*) position.link;
+        link_type* nil = (link_type*) last.link;
+        size_type keep = std::min(position.idx + 1, count_of(link));
+
+        if (link == nil) {  // (position, last) inside one chunk
+            erase_in_chunk(as_chunk(link), keep, last.idx);
+        } else {
+            if (keep < count_of(link))
+                erase_in_chunk(as_chunk(link), keep, count_of(link));
+            while (link->next != nil) {
+                destroy_chunk(list_delete_after(link));
+            }
+            if (nil != nullptr)
+                erase_in_chunk(as_chunk(nil), 0, last.idx);
+        }
+
+        if (link != &head_)
+            coalesce(as_chunk(link));
+        return make_iterator(link, keep);
+    }
+
+    /**
+     * Swap content
+     * Exchanges the content of the container by the content of x,
+     * which is another unrolled_forward_list object of the same type.
+     * Sizes may differ.
+     */
+    void swap(unrolled_forward_list& x)
+    {
+        std::swap(head_.next, x.head_.next);
+        std::swap(chunk_alloc_, x.chunk_alloc_);
+    }
+
+    /**
+     * Change size
+     * Resizes the container to contain n elements.
+     */
+    void resize(size_type n)
+    {
+        resize(n, value_type());
+    }
+
+    void resize(size_type n, const value_type& val)
+    {
+        iterator prev = before_begin();
+        iterator cur = begin();
+        for ( ; cur != end() && n > 0; --n) {
+            prev = cur;
+            ++cur;
+        }
+        if (cur == end()) {
+            insert_after(prev, n, val);
+        } else {
+            erase_after(prev, end());
+        }
+    }
+
+    /**
+     * Clear content
+     * Removes all elements from the container (which are destroyed),
+     * and leaving the container with a size of 0.
+     */
+    void clear() noexcept
+    {
+        finalize();
+    }
+
+    /**
+     * Transfer elements from another list
+     * Transfers elements from x into the container inserting them after
+     * the element pointed by position.
+     */
+    void splice_after(const_iterator position, unrolled_forward_list& x)
+    {
+        splice_after((link_type*) position.link, position.idx, &x.head_, 0, nullptr, 0);
+    }
+
+    void splice_after(const_iterator position, unrolled_forward_list&& x)
+    {
+        splice_after((link_type*) position.link, position.idx, &x.head_, 0, nullptr, 0);
+    }
+
+    void splice_after(const_iterator position, unrolled_forward_list& x,
+        const_iterator i)
+    {
+        const_iterator last = i;
+        ++last;
+        if (position == i || position == last)
+            return;
+        ++last;
+        splice_after(position, x, i, last);
+    }
+
+    void splice_after(const_iterator position, unrolled_forward_list&& x,
+        const_iterator i)
+    {
+        splice_after(position, x, i);
+    }
+
+    void splice_after(const_iterator position, unrolled_forward_list& x,
+        const_iterator first, const_iterator last)
+    {
+        splice_after((link_type*) position.link, position.idx,
+            (link_type*) first.link, first.idx, (link_type*) last.link, last.idx);
+    }
+
+    void splice_after(const_iterator position, unrolled_forward_list&& x,
+        const_iterator first, const_iterator last)
+    {
+        splice_after(position, x, first, last);
+    }
+
+    /**
+     * Remove elements with specific value
+     * Removes from the container all the elements that compare equal to val.
+     */
+    void remove(const value_type& val)
+    {
+        remove_if([&val](const value_type& x) { return x == val; });
+    }
+
+    /**
+     * Remove elements fulfilling condition
+     * Removes from the container all the elements for which Predicate pred
+     * returns true. The survivors are compacted towards the front, so the
+     * chunks stay full.
+     */
+    template <typename Predicate>
+    void remove_if(Predicate pred)
+    {
+        iterator kept = before_begin();
+        iterator dst = begin();
+        for (iterator src = begin(); src != end(); ++src) {
+            if (pred(*src))
+                continue;
+            if (dst != src)
+                *dst = std::move(*src);
+            kept = dst++;
+        }
+        erase_after(kept, end());
+    }
+
+    /**
+     * Remove duplicate values
+     * removes all but the first element from every consecutive group of
+     * equal elements in the container.
+     */
+    void unique()
+    {
+        unique(std::equal_to<value_type>());
+    }
+
+    template <typename BinaryPredicate>
+    void unique(BinaryPredicate binary_pred)
+    {
+        if (empty())
+            return;
+
+        iterator kept = begin();
+        iterator src = kept;
+        for (++src; src != end(); ++src) {
+            if (binary_pred(*kept, *src))
+                continue;
+            if (++kept != src)
+                *kept = std::move(*src);
+        }
+        erase_after(kept, end());
+    }
+
+    /**
+     * Merge sorted lists
+     * Merges x into the list at their respective ordered positions
+     * (both containers shall already be ordered). The elements are moved
+     * into freshly packed chunks.
+     */
+    void merge(unrolled_forward_list& x)
+    {
+        merge(x, std::less<value_type>());
+    }
+
+    template <typename Compare>
+    void merge(unrolled_forward_list& x, Compare comp)
+    {
+        if (this == &x)
+            return;
+
+        unrolled_forward_list tmp(get_allocator());
+        iterator tail = tmp.before_begin();
+        iterator a = begin(), b = x.begin();
+        while (a != end() && b != x.end()) {
+            if (comp(*b, *a)) {
+                tail = tmp.emplace_after(tail, std::move(*b++));
+            } else {
+                tail = tmp.emplace_after(tail, std::move(*a++));
+            }
+        }
+        for ( ; a != end(); ++a)
+            tail = tmp.emplace_after(tail, std::move(*a));
+        for ( ; b != x.end(); ++b)
+            tail = tmp.emplace_after(tail, std::move(*b));
+
+        swap(tmp);
+        x.clear();
+    }
+
+    void merge(unrolled_forward_list&& x)
+    {
+        merge(x, std::less<value_type>());
+    }
+
+    template <typename Compare>
+    void merge(unrolled_forward_list&& x, Compare comp)
+    {
+        merge(x, comp);
+    }
+
+    /**
+     * Sort elements in container
+     * Sorts the elements in the list. Equivalent elements keep their
+     * relative order.
+     */
+    void sort()
+    {
+        sort(std::less<value_type>());
+    }
+
+    template <typename Compare>
+    void sort(Compare comp)
+    {
+        std::vector<value_type> buf(std::make_move_iterator(begin()),
+            std::make_move_iterator(end()));
+        std::stable_sort(buf.begin(), buf.end(), comp);
+        std::move(buf.begin(), buf.end(), begin());
+    }
+
+    /**
+     * Reverse the order of elements
+     * Reverses the order of the elements in the container.
+     */
+    void reverse() noexcept
+    {
+        list_reverse_after(&head_);
+        for (link_type* link = head_.next; link != nullptr; link = link->next) {
+            chunk_type* chunk = as_chunk(link);
+            std::reverse(chunk->valptr(0), chunk->valptr(chunk->count));
+        }
+    }
+
+    /**
+     * Get allocator
+     * Returns a copy of the allocator object associated with the container.
+     */
+    allocator_type get_allocator() const noexcept
+    {
+        return allocator_type(chunk_alloc_);
+    }
+
+private:
+    static chunk_type* as_chunk(link_type* link)
+    {
+        return static_cast<chunk_type*>(static_cast<chunk_base*>(link));
+    }
+
+    static size_type count_of(const link_type* link)
+    {
+        return static_cast<const chunk_base*>(link)->count;
+    }
+
+    // iterator to slot i of link, stepping to the next chunk if i is past its end
+    static iterator make_iterator(link_type* link, size_type i)
+    {
+        if (i >= count_of(link))
+            return iterator(link->next, 0);
+        return iterator(link, i);
+    }
+
+    chunk_type* create_chunk()
+    {
+        chunk_type* chunk = chunk_alloc_.allocate(1);
+        new (chunk) chunk_type;
+        return chunk;
+    }
+
+    void put_chunk(chunk_type* chunk)
+    {
+        chunk_alloc_.deallocate(chunk, 1);
+    }
+
+    void destroy_chunk(link_type* link)
+    {
+        chunk_type* chunk = as_chunk(link);
+        for (size_type i = 0; i < chunk->count; ++i) {
+            chunk->valptr(i)->~T();
+        }
+        put_chunk(chunk);
+    }
+
+    // move src[from, src->count) to the end of dst
+    static void move_elements(chunk_type* src, size_type from, chunk_type* dst)
+    {
+        assert(dst->count + (src->count - from) <= N);
+        for (size_type i = from; i < src->count; ++i) {
+            new (dst->valptr(dst->count)) T(std::move(*src->valptr(i)));
+            ++dst->count;
+            src->valptr(i)->~T();
+        }
+        src->count = from;
+    }
+
+    // destroy chunk[first, last), sliding the rest of the chunk down
+    static void erase_in_chunk(chunk_type* chunk, size_type first, size_type last)
+    {
+        if (first == last)
+            return;
+
+        T* p = chunk->valptr(0);
+        std::move(p + last, p + chunk->count, p + first);
+        for (size_type i = chunk->count - (last - first); i < chunk->count; ++i) {
+            p[i].~T();
+        }
+        chunk->count -= last - first;
+    }
+
+    // construct an element at slot j of a chunk that is not full
+    template <typename... Args>
+    static void emplace_in_chunk(chunk_type* chunk, size_type j, Args&&... args)
+    {
+        assert(chunk->count < N && j <= chunk->count);
+        T* p = chunk->valptr(0);
+        if (j == chunk->count) {
+            new (p + j) T(std::forward<Args>(args)...);
+        } else {
+            value_type tmp(std::forward<Args>(args)...);
+            new (p + chunk->count) T(std::move(p[chunk->count - 1]));
+            std::move_backward(p + j, p + chunk->count - 1, p + chunk->count);
+            p[j] = std::move(tmp);
+        }
+        ++chunk->count;
+    }
+
+    // pull the next chunk into a half empty chunk when both fit in one
+    void coalesce(chunk_type* chunk)
+    {
+        if (chunk->next == nullptr || chunk->count >= N / 2)
+            return;
+
+        chunk_type* next = as_chunk(chunk->next);
+        if (chunk->count + next->count > N)
+            return;
+
+        move_elements(next, 0, chunk);
+        list_delete_after(chunk);
+        put_chunk(next);
+    }
+
+    // split link so that slot i is its last element
+    void cut_after(link_type* link, size_type i)
+    {
+        if (i + 1 >= count_of(link))
+            return;
+
+        chunk_type* chunk = create_chunk();
+        move_elements(as_chunk(link), i + 1, chunk);
+        list_insert_after(link, chunk);
+    }
+
+    // fix up an iterator into link after cut_after(link, keep - 1)
+    static void follow_cut(link_type*& it_link, size_type& it_idx,
+        link_type* link, size_type keep)
+    {
+        if (it_link == link && it_idx >= keep) {
+            it_link = link->next;
+            it_idx -= keep;
+        }
+    }
+
+    template <typename... Args>
+    iterator emplace_after(link_type* link, size_type i, Args&&... args)
+    {
+        chunk_type* chunk;
+        size_type j;
+        if (link == &head_) {
+            chunk = empty() ? nullptr : as_chunk(head_.next);
+            j = 0;
+        } else {
+            chunk = as_chunk(link);
+            j = i + 1;
+        }
+
+        if (chunk == nullptr || chunk->count == N) {
+            if (chunk == nullptr || j == 0 || j == N) {
+                // nothing to shift: start a new chunk after link (or chunk)
+                chunk_type* fresh = create_chunk();
+                try
+                {
+                    new (fresh->valptr(0)) T(std::forward<Args>(args)...);
+                }
+                catch (...)
+                {
+                    put_chunk(fresh);
+                    throw;
+                }
+                fresh->count = 1;
+                list_insert_after(j == N ? chunk : link, fresh);
+                return iterator(fresh, 0);
+            }
+            cut_after(chunk, j - 1);
+        }
+
+        emplace_in_chunk(chunk, j, std::forward<Args>(args)...);
+        return iterator(chunk, j);
+    }
+
+    iterator erase_after(link_type* link, size_type i)
+    {
+        chunk_type* chunk;
+        size_type k;
+        if (i + 1 >= count_of(link)) {
+            assert(link->next != nullptr);
+            chunk = as_chunk(link->next);
+            k = 0;
+        } else {
+            chunk = as_chunk(link);
+            k = i + 1;
+        }
+
+        erase_in_chunk(chunk, k, k + 1);
+        if (chunk->count == 0) {
+            list_delete_after(link);
+            put_chunk(chunk);
+            return iterator(link->next, 0);
+        }
+
+        coalesce(chunk);
+        return make_iterator(chunk, k);
+    }
+
+    void splice_after(link_type* position, size_type pos_idx,
+        link_type* before, size_type before_idx, link_type* last, size_type last_idx)
+    {
+        iterator first(before, before_idx);
+        if (++first == iterator(last, last_idx))
+            return;
+
+        // tail: the last element of (before, last)
+        link_type* tail = last;
+        size_type tail_idx = last_idx - 1;
+        if (last_idx == 0) {
+            tail = before;
+            while (tail->next != last) {
+                tail = tail->next;
+            }
+            tail_idx = count_of(tail) - 1;
+        }
+
+        // make the range start and end on chunk boundaries
+        cut_after(before, before_idx);
+        follow_cut(tail, tail_idx, before, before_idx + 1);
+        follow_cut(position, pos_idx, before, before_idx + 1);
+        cut_after(tail, tail_idx);
+        follow_cut(position, pos_idx, tail, tail_idx + 1);
+
+        // unlink [head, tail] and relink it after position
+        link_type* head = before->next;
+        before->next = tail->next;
+        cut_after(position, pos_idx);
+        tail->next = position->next;
+        position->next = head;
+    }
+
+    void finalize()
+    {
+        while (head_.next != nullptr) {
+            destroy_chunk(list_delete_after(&head_));
+        }
+    }
+
+    void fill(size_type n, const value_type& val)
+    {
+        iterator prev = before_begin();
+        iterator cur = begin();
+        for ( ; cur != end() && n > 0; --n) {
+            *cur = val;
+            prev = cur;
+            ++cur;
+        }
+
+        if (cur == end()) {    // size() < n
+            insert_after(prev, n, val);
+        } else {    // size() > n
+            erase_after(prev, end());
+        }
+    }
+
+    template <typename InputIterator>
+    void copy_from(InputIterator first, InputIterator last)
+    {
+        iterator prev = before_begin();
+        iterator cur = begin();
+        for ( ; cur != end() && first != last; ++first) {
+            *cur = *first;
+            prev = cur;
+            ++cur;
+        }
+
+        if (cur == end()) {    // size() < distance(first, last)
+            insert_after(prev, first, last);
+        } else {    // size() > distance(first, last)
+            erase_after(prev, end());
+        }
+    }
+};
+
+template <typename T, typename Alloc, size_t N>
+const typename unrolled_forward_list<T, Alloc, N>::size_type
+unrolled_forward_list<T, Alloc, N>::chunk_size;
+
+/**
+ * Relational operators for unrolled_forward_list
+ * Performs the appropriate comparison operation between the containers
+ * lhs and rhs.
+ */
+template <typename T, typename Alloc, size_t N>
+inline
+bool operator==(const unrolled_forward_list<T, Alloc, N>& lhs,
+    const unrolled_forward_list<T, Alloc, N>& rhs)
+{
+    auto i = lhs.begin(), j = rhs.begin();
+    for ( ; i != lhs.end() && j != rhs.end(); ++i, ++j) {
+        if (!(*i == *j))
+            return false;
+    }
+    return i == lhs.end() && j == rhs.end();
+}
+
+template <typename T, typename Alloc, size_t N>
+inline
+bool operator!=(const unrolled_forward_list<T, Alloc, N>& lhs,
+    const unrolled_forward_list<T, Alloc, N>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename T, typename Alloc, size_t N>
+inline
+bool operator<(const unrolled_forward_list<T, Alloc, N>& lhs,
+    const unrolled_forward_list<T, Alloc, N>& rhs)
+{
+    return std::lexicographical_compare(lhs.begin(), lhs.end(),
+        rhs.begin(), rhs.end());
+}
+
+template <typename T, typename Alloc, size_t N>
+inline
+bool operator>(const unrolled_forward_list<T, Alloc, N>& lhs,
+    const unrolled_forward_list<T, Alloc, N>& rhs)
+{
+    return (rhs < lhs);
+}
+
+template <typename T, typename Alloc, size_t N>
+inline
+bool operator<=(const unrolled_forward_list<T, Alloc, N>& lhs,
+    const unrolled_forward_list<T, Alloc, N>& rhs)
+{
+    return !(lhs > rhs);
+}
+
+template <typename T, typename Alloc, size_t N>
+inline
+bool operator>=(const unrolled_forward_list<T, Alloc, N>& lhs,
+    const unrolled_forward_list<T, Alloc, N>& rhs)
+{
+    return !(lhs < rhs);
+}
+
+/**
+ * Exchange contents of unrolled_forward_lists
+ */
+template <typename T, typename Alloc, size_t N>
+inline
+void swap(unrolled_forward_list<T, Alloc, N>& x, unrolled_forward_list<T, Alloc, N>& y)
+{
+    return x.swap(y);
+}
+
+} // namespace Hx
+
+#endif // MINI_STL_UNROLLED_FORWARD_LIST_INC
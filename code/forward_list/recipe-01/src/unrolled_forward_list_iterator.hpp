@@ -0,0 +1,178 @@
+/**
+ * A unrolled_forward_list::iterator.
+ * Refers to element idx of the chunk at link. before_begin() refers to the
+ * (empty) head chunk, end() is a null link.
+ * All the functions are op overloads.
+ */
+template <typename T, size_t N>
+struct unrolled_forward_list_iterator {
+    typedef singly_linked::list_node_t link_type;
+    link_type* link;
+    size_t idx;
+
+    typedef T value_type;
+    typedef T* pointer;
+    typedef T& reference;
+    typedef ptrdiff_t difference_type;
+    typedef std::forward_iterator_tag iterator_category;
+
+    typedef unrolled_forward_list_iterator<T, N> this_type;
+    typedef unrolled_forward_list_chunk_base chunk_base;
+    typedef unrolled_forward_list_chunk<T, N> chunk_type;
+
+    unrolled_forward_list_iterator(): link(nullptr), idx(0) {}
+
+    unrolled_forward_list_iterator(link_type* link_, size_t idx_): link(link_), idx(idx_) {}
+
+    reference operator*() const
+    {
+        assert(link != nullptr);
+        return *static_cast<chunk_type*>(link)->valptr(idx);
+    }
+
+    pointer operator->() const
+    {
+        assert(link != nullptr);
+        return static_cast<chunk_type*>(link)->valptr(idx);
+    }
+
+    this_type& operator++()
+    {
+        next();
+        return *this;
+    }
+
+    this_type operator++(int)
+    {
+        this_type tmp(*this);
+        next();
+        return tmp;
+    }
+
+    bool operator==(const this_type& other) const
+    {
+        return (this->link == other.link && this->idx == other.idx);
+    }
+
+    bool operator!=(const this_type& other) const
+    {
+        return !(*this == other);
+    }
+
+    void next()
+    {
+        assert(link != nullptr);
+        if (++idx >= static_cast<chunk_base*>(link)->count) {
+            link = link->next;
+            idx = 0;
+        }
+    }
+};
+
+/**
+ * A unrolled_forward_list::const_iterator.
+ * All the functions are op overloads.
+ */
+template <typename T, size_t N>
+struct unrolled_forward_list_const_iterator {
+    typedef const singly_linked::list_node_t link_type;
+    link_type* link;
+    size_t idx;
+
+    typedef T value_type;
+    typedef const T* pointer;
+    typedef const T& reference;
+    typedef ptrdiff_t difference_type;
+    typedef std::forward_iterator_tag iterator_category;
+
+    typedef unrolled_forward_list_const_iterator<T, N> this_type;
+    typedef const unrolled_forward_list_chunk_base chunk_base;
+    typedef const unrolled_forward_list_chunk<T, N> chunk_type;
+    typedef unrolled_forward_list_iterator<T, N> iterator;
+
+    unrolled_forward_list_const_iterator(): link(nullptr), idx(0) {}
+
+    unrolled_forward_list_const_iterator(link_type* link_, size_t idx_): link(link_), idx(idx_) {}
+
+    unrolled_forward_list_const_iterator(const iterator& iter): link(iter.link), idx(iter.idx) {}
+
+    reference operator*() const
+    {
+        assert(link != nullptr);
+        return *static_cast<chunk_type*>(link)->valptr(idx);
+    }
+
+    pointer operator->() const
+    {
+        assert(link != nullptr);
+        return static_cast<chunk_type*>(link)->valptr(idx);
+    }
+
+    this_type& operator++()
+    {
+        next();
+        return *this;
+    }
+
+    this_type operator++(int)
+    {
+        this_type tmp(*this);
+        next();
+        return tmp;
+    }
+
+    bool operator==(const this_type& other) const
+    {
+        return (this->link == other.link && this->idx == other.idx);
+    }
+
+    bool operator!=(const this_type& other) const
+    {
+        return !(*this == other);
+    }
+
+    void next()
+    {
+        assert(link != nullptr);
+        if (++idx >= static_cast<chunk_base*>(link)->count) {
+            link = link->next;
+            idx = 0;
+        }
+    }
+};
+
+/**
+ * Unrolled forward list iterator equality comparison.
+ */
+template <typename T, size_t N>
+inline
+bool operator==(const unrolled_forward_list_iterator<T, N>& x,
+    const unrolled_forward_list_const_iterator<T, N>& y)
+{
+    return (x.link == y.link && x.idx == y.idx);
+}
+
+template <typename T, size_t N>
+inline
+bool operator==(const unrolled_forward_list_const_iterator<T, N>& x,
+    const unrolled_forward_list_iterator<T, N>& y)
+{
+    return (x.link == y.link && x.idx == y.idx);
+}
+
+template <typename T, size_t N>
+inline
+bool operator!=(const unrolled_forward_list_iterator<T, N>& x,
+    const unrolled_forward_list_const_iterator<T, N>& y)
+{
+    return !(x == y);
+}
+
+template <typename T, size_t N>
+inline
+bool operator!=(const unrolled_forward_list_const_iterator<T, N>& x,
+    const unrolled_forward_list_iterator<T, N>& y)
+{
+    return !(x == y);
+}
+
@@ -0,0 +1,91 @@
+// Hx::bind against std::bind; see "bench.hpp" for the options.
+// A bound call should cost what the plain call does, so the rows show
+// whether the argument tuple and the placeholder lookup fold away.
+#include <functional>
+#include "bind.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+int add3(int a, int b, int c) { return a + b * c; }
+
+struct accumulator {
+    int total = 0;
+    int add(int x) { return total += x; }
+};
+
+struct std_bind {
+    static auto free(int k) -> decltype(std::bind(&add3, std::placeholders::_2, k, std::placeholders::_1))
+    {
+        return std::bind(&add3, std::placeholders::_2, k, std::placeholders::_1);
+    }
+    static auto member(accumulator* a) -> decltype(std::bind(&accumulator::add, a, std::placeholders::_1))
+    {
+        return std::bind(&accumulator::add, a, std::placeholders::_1);
+    }
+};
+
+struct hx_bind {
+    static auto free(int k) -> decltype(Hx::bind(&add3, Hx::placeholders::_2, k, Hx::placeholders::_1))
+    {
+        return Hx::bind(&add3, Hx::placeholders::_2, k, Hx::placeholders::_1);
+    }
+    static auto member(accumulator* a) -> decltype(Hx::bind(&accumulator::add, a, Hx::placeholders::_1))
+    {
+        return Hx::bind(&accumulator::add, a, Hx::placeholders::_1);
+    }
+};
+
+void plain_free(state& st)
+{
+    const long n = st.arg();
+    int k = 3;
+    while (st.keep_running()) {
+        int sum = 0;
+        for (long i = 0; i < n; i++)
+            sum += add3(int(i), k, sum);
+        do_not_optimize(sum);
+    }
+    st.set_items_per_iteration(n);
+}
+
+template <typename Bind>
+void call_free(state& st)
+{
+    const long n = st.arg();
+    auto f = Bind::free(3);
+    while (st.keep_running()) {
+        int sum = 0;
+        for (long i = 0; i < n; i++)
+            sum += f(sum, int(i));
+        do_not_optimize(sum);
+    }
+    st.set_items_per_iteration(n);
+}
+
+template <typename Bind>
+void call_member(state& st)
+{
+    const long n = st.arg();
+    accumulator a;
+    auto f = Bind::member(&a);
+    while (st.keep_running()) {
+        int sum = 0;
+        for (long i = 0; i < n; i++)
+            sum += f(int(i));
+        do_not_optimize(sum);
+    }
+    st.set_items_per_iteration(n);
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("bind");
+    s.add("call_free", "plain", plain_free).args({1000});
+    s.add("call_free", "std", call_free<std_bind>).args({1000});
+    s.add("call_free", "Hx", call_free<hx_bind>).args({1000});
+    s.add("call_member", "std", call_member<std_bind>).args({1000});
+    s.add("call_member", "Hx", call_member<hx_bind>).args({1000});
+    return s.run(argc, argv);
+}
@@ -2,6 +2,7 @@
 
 #include <utility>  // for std::forward
 #include <type_traits>
+#include <cstddef>   // for std::nullptr_t
 
 namespace Hx {
 
@@ -97,7 +98,7 @@ public:
     // constructs
     function() noexcept {}
 
-    function (nullptr_t fn) noexcept {}
+    function (std::nullptr_t fn) noexcept {}
 
     function(R (*func)(Args...)) : 
         invoker_(new function_ptr_invoker<R,Args...>(func)) {}
@@ -117,7 +118,7 @@ public:
     }
 
     // assign operator
-    function& operator=(nullptr_t fn) {
+    function& operator=(std::nullptr_t fn) {
         delete invoker_;
         invoker_ = nullptr;
         return *this;
@@ -0,0 +1,77 @@
+// Hx::function against std::function; see "bench.hpp" for the options.
+// The call rows go through n wrappers of the same target, so they time the
+// indirect call and nothing else. This recipe's Hx::function has no
+// copy constructor of its own (the implicit one shares the invoker), so
+// there is no copy row and the wrappers are built in place.
+#include <functional>
+#include <vector>
+#include "function.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+int twice(int x) { return 2 * x; }
+
+struct std_fn {
+    template <typename S> using function = std::function<S>;
+};
+
+struct hx_fn {
+    template <typename S> using function = Hx::function<S>;
+};
+
+template <typename Fn>
+void construct(state& st)
+{
+    int k = 3;
+    while (st.keep_running()) {
+        typename Fn::template function<int(int)> f([k](int x) { return k * x; });
+        do_not_optimize(f);
+    }
+}
+
+template <typename Fn>
+void call_pointer(state& st)
+{
+    std::vector<typename Fn::template function<int(int)>> v;
+    v.reserve(st.arg());
+    for (long i = 0; i < st.arg(); i++)
+        v.emplace_back(&twice);
+    while (st.keep_running()) {
+        int sum = 0;
+        for (size_t i = 0; i < v.size(); i++)
+            sum += v[i](int(i));
+        do_not_optimize(sum);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+template <typename Fn>
+void call_lambda(state& st)
+{
+    int k = 3;
+    std::vector<typename Fn::template function<int(int)>> v;
+    v.reserve(st.arg());
+    for (long i = 0; i < st.arg(); i++)
+        v.emplace_back([k](int x) { return k * x; });
+    while (st.keep_running()) {
+        int sum = 0;
+        for (size_t i = 0; i < v.size(); i++)
+            sum += v[i](int(i));
+        do_not_optimize(sum);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("function");
+    s.add("construct", "std", construct<std_fn>);
+    s.add("construct", "Hx", construct<hx_fn>);
+    s.add("call_pointer", "std", call_pointer<std_fn>).args({1000});
+    s.add("call_pointer", "Hx", call_pointer<hx_fn>).args({1000});
+    s.add("call_lambda", "std", call_lambda<std_fn>).args({1000});
+    s.add("call_lambda", "Hx", call_lambda<hx_fn>).args({1000});
+    return s.run(argc, argv);
+}
@@ -0,0 +1,89 @@
+// Hx::invoke against std::invoke; see "bench.hpp" for the options.
+// The dispatch is all compile time, so each row should match the plain
+// call it stands for.
+#include <functional>
+#include <vector>
+#include "invoke.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+struct point {
+    int x;
+    int y;
+    int dot(int k) const { return k * (x + y); }
+};
+
+struct std_invoke {
+    template <typename F, typename... Args>
+    static decltype(auto) call(F&& f, Args&&... args)
+    {
+        return std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+    }
+};
+
+struct hx_invoke {
+    template <typename F, typename... Args>
+    static decltype(auto) call(F&& f, Args&&... args)
+    {
+        return Hx::invoke(std::forward<F>(f), std::forward<Args>(args)...);
+    }
+};
+
+template <typename Invoke>
+void member_function(state& st)
+{
+    std::vector<point> v(st.arg());
+    for (size_t i = 0; i < v.size(); i++)
+        v[i] = point{int(i), int(i) + 1};
+    while (st.keep_running()) {
+        int sum = 0;
+        for (size_t i = 0; i < v.size(); i++)
+            sum += Invoke::call(&point::dot, v[i], 3);
+        do_not_optimize(sum);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+template <typename Invoke>
+void member_object(state& st)
+{
+    std::vector<point> v(st.arg());
+    for (size_t i = 0; i < v.size(); i++)
+        v[i] = point{int(i), int(i) + 1};
+    while (st.keep_running()) {
+        int sum = 0;
+        for (size_t i = 0; i < v.size(); i++)
+            sum += Invoke::call(&point::y, &v[i]);
+        do_not_optimize(sum);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+template <typename Invoke>
+void reference_wrapper(state& st)
+{
+    std::vector<point> v(st.arg());
+    for (size_t i = 0; i < v.size(); i++)
+        v[i] = point{int(i), int(i) + 1};
+    while (st.keep_running()) {
+        int sum = 0;
+        for (size_t i = 0; i < v.size(); i++)
+            sum += Invoke::call(&point::dot, std::cref(v[i]), 3);
+        do_not_optimize(sum);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("invoke");
+    s.add("member_function", "std", member_function<std_invoke>).args({1000});
+    s.add("member_function", "Hx", member_function<hx_invoke>).args({1000});
+    s.add("member_object", "std", member_object<std_invoke>).args({1000});
+    s.add("member_object", "Hx", member_object<hx_invoke>).args({1000});
+    s.add("reference_wrapper", "std", reference_wrapper<std_invoke>).args({1000});
+    s.add("reference_wrapper", "Hx", reference_wrapper<hx_invoke>).args({1000});
+    return s.run(argc, argv);
+}
@@ -0,0 +1,77 @@
+// Hx::list against std::list; see "bench.hpp" for the options.
+#include <list>
+#include "list.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+template <typename List>
+void push_back(state& st)
+{
+    long n = st.arg();
+    while (st.keep_running()) {
+        List l;
+        for (long i = 0; i < n; i++)
+            l.push_back(int(i));
+        do_not_optimize(l);
+    }
+    st.set_items_per_iteration(n);
+}
+
+template <typename List>
+void iterate(state& st)
+{
+    List l(st.arg(), 1);
+    while (st.keep_running()) {
+        int sum = 0;
+        for (auto it = l.begin(); it != l.end(); ++it)
+            sum += *it;
+        do_not_optimize(sum);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+template <typename List>
+void sort(state& st)
+{
+    List src;
+    unsigned x = 12345;
+    for (long i = 0; i < st.arg(); i++) {
+        x = x * 1103515245 + 12345;
+        src.push_back(int(x >> 8));
+    }
+    while (st.keep_running()) {
+        st.pause_timing();
+        List l(src);
+        st.resume_timing();
+        l.sort();
+        do_not_optimize(l);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+template <typename List>
+void splice(state& st)
+{
+    List a(st.arg(), 1), b;
+    while (st.keep_running()) {
+        b.splice(b.end(), a);
+        a.splice(a.end(), b);
+        do_not_optimize(a);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("list");
+    s.add("push_back", "std", push_back<std::list<int>>).args({1000, 100000});
+    s.add("push_back", "Hx", push_back<Hx::list<int>>).args({1000, 100000});
+    s.add("iterate", "std", iterate<std::list<int>>).args({1000, 100000});
+    s.add("iterate", "Hx", iterate<Hx::list<int>>).args({1000, 100000});
+    s.add("sort", "std", sort<std::list<int>>).args({1000, 10000});
+    s.add("sort", "Hx", sort<Hx::list<int>>).args({1000, 10000});
+    s.add("splice", "std", splice<std::list<int>>).args({1000});
+    s.add("splice", "Hx", splice<Hx::list<int>>).args({1000});
+    return s.run(argc, argv);
+}
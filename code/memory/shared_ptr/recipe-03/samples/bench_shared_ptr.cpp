@@ -0,0 +1,107 @@
+// Hx::shared_ptr against std::shared_ptr; see "bench.hpp" for the options.
+#include <memory>
+#include <vector>
+#include "shared_ptr.hpp"
+#include "weak_ptr.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+struct std_ptr {
+    template <typename T> using shared_ptr = std::shared_ptr<T>;
+    template <typename T> using weak_ptr = std::weak_ptr<T>;
+    template <typename T> static std::shared_ptr<T> make(int x) { return std::make_shared<T>(x); }
+};
+
+struct hx_ptr {
+    template <typename T> using shared_ptr = Hx::shared_ptr<T>;
+    template <typename T> using weak_ptr = Hx::weak_ptr<T>;
+    template <typename T> static Hx::shared_ptr<T> make(int x) { return Hx::make_shared<T>(x); }
+};
+
+template <typename Ptr>
+void construct(state& st)
+{
+    while (st.keep_running()) {
+        typename Ptr::template shared_ptr<int> p(new int(42));
+        do_not_optimize(p);
+    }
+}
+
+template <typename Ptr>
+void make_shared(state& st)
+{
+    while (st.keep_running()) {
+        auto p = Ptr::template make<int>(42);
+        do_not_optimize(p);
+    }
+}
+
+template <typename Ptr>
+void copy(state& st)
+{
+    auto p = Ptr::template make<int>(42);
+    while (st.keep_running()) {
+        typename Ptr::template shared_ptr<int> q(p);
+        do_not_optimize(q);
+    }
+}
+
+template <typename Ptr>
+void assign(state& st)
+{
+    auto p = Ptr::template make<int>(1);
+    auto q = Ptr::template make<int>(2);
+    typename Ptr::template shared_ptr<int> r;
+    while (st.keep_running()) {
+        r = p;
+        do_not_optimize(r);
+        r = q;
+        do_not_optimize(r);
+    }
+}
+
+template <typename Ptr>
+void weak_lock(state& st)
+{
+    auto p = Ptr::template make<int>(42);
+    typename Ptr::template weak_ptr<int> w(p);
+    while (st.keep_running()) {
+        auto q = w.lock();
+        do_not_optimize(q);
+    }
+}
+
+template <typename Ptr>
+void dereference(state& st)
+{
+    std::vector<typename Ptr::template shared_ptr<int>> v;
+    for (long i = 0; i < st.arg(); i++)
+        v.push_back(Ptr::template make<int>(int(i)));
+    while (st.keep_running()) {
+        int sum = 0;
+        for (size_t i = 0; i < v.size(); i++)
+            sum += *v[i];
+        do_not_optimize(sum);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("shared_ptr");
+    s.add("construct", "std", construct<std_ptr>);
+    s.add("construct", "Hx", construct<hx_ptr>);
+    s.add("make_shared", "std", make_shared<std_ptr>);
+    s.add("make_shared", "Hx", make_shared<hx_ptr>);
+    s.add("copy", "std", copy<std_ptr>);
+    s.add("copy", "Hx", copy<hx_ptr>);
+    s.add("assign", "std", assign<std_ptr>);
+    s.add("assign", "Hx", assign<hx_ptr>);
+    s.add("weak_lock", "std", weak_lock<std_ptr>);
+    s.add("weak_lock", "Hx", weak_lock<hx_ptr>);
+    s.add("dereference", "std", dereference<std_ptr>).args({1000});
+    s.add("dereference", "Hx", dereference<hx_ptr>).args({1000});
+    return s.run(argc, argv);
+}
@@ -0,0 +1,94 @@
+// Hx::unique_ptr against std::unique_ptr; see "bench.hpp" for the options.
+// Both should cost what a raw pointer does: the rows show whether the
+// wrapper gets in the way of inlining.
+#include <memory>
+#include <utility>
+#include <vector>
+#include "unique_ptr.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+struct std_ptr {
+    template <typename T> using unique_ptr = std::unique_ptr<T>;
+    // std::make_unique is C++14
+    template <typename T> static std::unique_ptr<T> make(int x) { return std::unique_ptr<T>(new T(x)); }
+};
+
+struct hx_ptr {
+    template <typename T> using unique_ptr = Hx::unique_ptr<T>;
+    template <typename T> static Hx::unique_ptr<T> make(int x) { return Hx::make_unique<T>(x); }
+};
+
+template <typename Ptr>
+void construct(state& st)
+{
+    while (st.keep_running()) {
+        typename Ptr::template unique_ptr<int> p(new int(42));
+        do_not_optimize(p);
+    }
+}
+
+template <typename Ptr>
+void make_unique(state& st)
+{
+    while (st.keep_running()) {
+        auto p = Ptr::template make<int>(42);
+        do_not_optimize(p);
+    }
+}
+
+template <typename Ptr>
+void move(state& st)
+{
+    auto p = Ptr::template make<int>(42);
+    typename Ptr::template unique_ptr<int> q;
+    while (st.keep_running()) {
+        q = std::move(p);
+        do_not_optimize(q);
+        p = std::move(q);
+        do_not_optimize(p);
+    }
+}
+
+template <typename Ptr>
+void reset(state& st)
+{
+    typename Ptr::template unique_ptr<int> p;
+    while (st.keep_running()) {
+        p.reset(new int(42));
+        do_not_optimize(p);
+    }
+}
+
+template <typename Ptr>
+void dereference(state& st)
+{
+    std::vector<typename Ptr::template unique_ptr<int>> v;
+    for (long i = 0; i < st.arg(); i++)
+        v.push_back(Ptr::template make<int>(int(i)));
+    while (st.keep_running()) {
+        int sum = 0;
+        for (size_t i = 0; i < v.size(); i++)
+            sum += *v[i];
+        do_not_optimize(sum);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("unique_ptr");
+    s.add("construct", "std", construct<std_ptr>);
+    s.add("construct", "Hx", construct<hx_ptr>);
+    s.add("make_unique", "std", make_unique<std_ptr>);
+    s.add("make_unique", "Hx", make_unique<hx_ptr>);
+    s.add("move", "std", move<std_ptr>);
+    s.add("move", "Hx", move<hx_ptr>);
+    s.add("reset", "std", reset<std_ptr>);
+    s.add("reset", "Hx", reset<hx_ptr>);
+    s.add("dereference", "std", dereference<std_ptr>).args({1000});
+    s.add("dereference", "Hx", dereference<hx_ptr>).args({1000});
+    return s.run(argc, argv);
+}
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <iterator>
+#include <vector>
+#include "parallel_backend.hpp"
+
 namespace Hx {
 
 template <typename InputIterator, typename T>
@@ -19,5 +23,60 @@ T accumulate(InputIterator first, InputIterator last, T init,
     return init;
 }
 
+// init + *first, as in the overload without binary_op
+struct accumulate_plus {
+    template <typename T, typename U>
+    T operator()(const T& a, const U& b) const { return a + b; }
+};
+
+/**
+ * Policy overloads. Under par/par_unseq every thread folds one contiguous
+ * chunk and the partial results are folded in chunk order, so binary_op
+ * must be associative (as for reduce); the result is then the same as the
+ * sequential one, up to floating-point rounding.
+ */
+template <typename ExecutionPolicy, typename InputIterator, typename T, typename BinaryOperatiron>
+T accumulate(std::input_iterator_tag, ExecutionPolicy& policy,
+        InputIterator first, InputIterator last, T init,
+        BinaryOperatiron binary_op)
+{
+    return Hx::accumulate(first, last, init, binary_op);
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename T, typename BinaryOperatiron>
+T accumulate(std::random_access_iterator_tag, ExecutionPolicy& policy,
+        RandomAccessIterator first, RandomAccessIterator last, T init,
+        BinaryOperatiron binary_op)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::difference_type size_type;
+    size_type n = last - first;
+    unsigned k = execution::chunk_count(policy, n);
+    if (k <= 1)
+        return Hx::accumulate(first, last, init, binary_op);
+
+    std::vector<T> partial(k, init);
+    execution::for_each_chunk(policy, n, [&](unsigned c, size_type lo, size_type hi) {
+        partial[c] = Hx::accumulate(first + lo + 1, first + hi, T(first[lo]), binary_op);
+    });
+    return Hx::accumulate(partial.begin(), partial.end(), init, binary_op);
+}
+
+template <typename ExecutionPolicy, typename InputIterator, typename T, typename BinaryOperatiron>
+typename execution::enable_if_execution_policy<ExecutionPolicy, T>::type
+accumulate(ExecutionPolicy&& policy, InputIterator first, InputIterator last, T init,
+        BinaryOperatiron binary_op)
+{
+    return Hx::accumulate(typename std::iterator_traits<InputIterator>::iterator_category(),
+        policy, first, last, init, binary_op);
+}
+
+template <typename ExecutionPolicy, typename InputIterator, typename T>
+typename execution::enable_if_execution_policy<ExecutionPolicy, T>::type
+accumulate(ExecutionPolicy&& policy, InputIterator first, InputIterator last, T init)
+{
+    return Hx::accumulate(typename std::iterator_traits<InputIterator>::iterator_category(),
+        policy, first, last, init, accumulate_plus());
+}
+
 }   // Hx
 
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <iterator>
+#include <type_traits>
+#include "simd_backend.hpp"
+
+namespace Hx {
+
+/**
+ * Accumulate values in range with compensated summation
+ * Returns init plus the sum of the elements in [first,last), carrying the
+ * rounding error of every addition in a second accumulator (Neumaier's
+ * improvement of Kahan summation). The error stays within a few ulps of
+ * the exact sum whatever the length of the range. Contiguous float and
+ * double ranges summed into the same type run a vectorized kernel at
+ * memory speed; its result does not depend on the instruction set it
+ * runs on.
+ */
+template <typename InputIterator, typename T>
+T accumulate_kahan(std::false_type, InputIterator first, InputIterator last, T init)
+{
+    T c = T();
+    for ( ; first != last; ++first)
+        simd::neumaier_add(init, c, T(*first));
+    return init + c;
+}
+
+template <typename RandomAccessIterator, typename T>
+T accumulate_kahan(std::true_type, RandomAccessIterator first, RandomAccessIterator last, T init)
+{
+    if (first == last)
+        return init;
+
+    return simd::sum_neumaier(simd::address_of(first), last - first, init);
+}
+
+template <typename InputIterator, typename T>
+T accumulate_kahan(InputIterator first, InputIterator last, T init)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    return Hx::accumulate_kahan(std::integral_constant<bool,
+            simd::is_vectorizable<InputIterator>::value &&
+            std::is_floating_point<T>::value && std::is_same<value_type, T>::value>(),
+        first, last, init);
+}
+
+}   // Hx
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include "simd_backend.hpp"
+
+namespace Hx {
+
+/**
+ * Accumulate values in range by pairwise summation
+ * Returns init plus the sum of the elements in [first,last), added up as a
+ * balanced tree instead of left to right, so the rounding error grows with
+ * log(last-first) rather than with last-first. Contiguous float and double
+ * ranges summed into the same type run a vectorized kernel at memory speed;
+ * its result does not depend on the instruction set it runs on.
+ */
+template <typename InputIterator, typename T>
+T accumulate_pairwise(std::false_type, InputIterator first, InputIterator last, T init)
+{
+    const size_t block = 128;
+
+    // levels[l] holds the sum of 2^l blocks while bit l of blocks is set
+    std::vector<T> levels;
+    size_t blocks = 0;
+    for ( ; first != last; ++blocks) {
+        T sum = *first;
+        ++first;
+        for (size_t i = 1; i < block && first != last; ++i, ++first)
+            sum = sum + *first;
+
+        size_t l = 0;
+        for ( ; blocks & (size_t(1) << l); ++l)
+            sum = levels[l] + sum;
+        if (l == levels.size())
+            levels.push_back(sum);
+        else
+            levels[l] = sum;
+    }
+    if (blocks == 0)
+        return init;
+
+    size_t l = 0;
+    while (!(blocks & (size_t(1) << l)))
+        ++l;
+    T sum = levels[l];
+    for (++l; blocks >> l; ++l) {
+        if (blocks & (size_t(1) << l))
+            sum = levels[l] + sum;
+    }
+    return init + sum;
+}
+
+template <typename RandomAccessIterator, typename T>
+T accumulate_pairwise(std::true_type, RandomAccessIterator first, RandomAccessIterator last, T init)
+{
+    if (first == last)
+        return init;
+
+    return init + simd::sum_pairwise(simd::address_of(first), last - first);
+}
+
+template <typename InputIterator, typename T>
+T accumulate_pairwise(InputIterator first, InputIterator last, T init)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    return Hx::accumulate_pairwise(std::integral_constant<bool,
+            simd::is_vectorizable<InputIterator>::value &&
+            std::is_floating_point<T>::value && std::is_same<value_type, T>::value>(),
+        first, last, init);
+}
+
+}   // Hx
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <functional>
+#include <iterator>
+#include "parallel_backend.hpp"
+
+namespace Hx {
+
+/**
+ * Exclusive scan
+ * Writes to the range beginning at d_first the running generalized sums
+ * of [first,last) seeded with init: the i-th output is binary_op applied
+ * to init and the first i elements, so the i-th input is not included.
+ * binary_op must be associative. d_first may be equal to first.
+ * Returns an iterator past the last element written.
+ */
+template <typename InputTag, typename OutputTag, typename ExecutionPolicy,
+    typename InputIterator, typename OutputIterator, typename T, typename BinaryOperation>
+OutputIterator exclusive_scan(InputTag, OutputTag, ExecutionPolicy& policy,
+        InputIterator first, InputIterator last, OutputIterator d_first,
+        T init, BinaryOperation binary_op)
+{
+    for ( ; first != last; ++first, ++d_first) {
+        T x = *first;
+        *d_first = init;
+        init = binary_op(init, x);
+    }
+    return d_first;
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2,
+    typename T, typename BinaryOperation>
+RandomAccessIterator2 exclusive_scan(std::random_access_iterator_tag, std::random_access_iterator_tag,
+        ExecutionPolicy& policy, RandomAccessIterator1 first, RandomAccessIterator1 last,
+        RandomAccessIterator2 d_first, T init, BinaryOperation binary_op)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator1>::difference_type size_type;
+    size_type n = last - first;
+    execution::scan(policy, n, init, binary_op,
+        [first](size_type i) -> T { return first[i]; },
+        [d_first](size_type i, const T& v) { d_first[i] = v; }, false);
+    return d_first + n;
+}
+
+template <typename InputIterator, typename OutputIterator, typename T, typename BinaryOperation>
+OutputIterator exclusive_scan(InputIterator first, InputIterator last, OutputIterator d_first,
+        T init, BinaryOperation binary_op)
+{
+    return Hx::exclusive_scan(typename std::iterator_traits<InputIterator>::iterator_category(),
+        typename std::iterator_traits<OutputIterator>::iterator_category(),
+        execution::seq, first, last, d_first, init, binary_op);
+}
+
+template <typename InputIterator, typename OutputIterator, typename T>
+OutputIterator exclusive_scan(InputIterator first, InputIterator last, OutputIterator d_first,
+        T init)
+{
+    return Hx::exclusive_scan(first, last, d_first, init, std::plus<T>());
+}
+
+template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2,
+    typename T, typename BinaryOperation>
+typename execution::enable_if_execution_policy<ExecutionPolicy, ForwardIterator2>::type
+exclusive_scan(ExecutionPolicy&& policy, ForwardIterator1 first, ForwardIterator1 last,
+        ForwardIterator2 d_first, T init, BinaryOperation binary_op)
+{
+    return Hx::exclusive_scan(typename std::iterator_traits<ForwardIterator1>::iterator_category(),
+        typename std::iterator_traits<ForwardIterator2>::iterator_category(),
+        policy, first, last, d_first, init, binary_op);
+}
+
+template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2, typename T>
+typename execution::enable_if_execution_policy<ExecutionPolicy, ForwardIterator2>::type
+exclusive_scan(ExecutionPolicy&& policy, ForwardIterator1 first, ForwardIterator1 last,
+        ForwardIterator2 d_first, T init)
+{
+    return Hx::exclusive_scan(typename std::iterator_traits<ForwardIterator1>::iterator_category(),
+        typename std::iterator_traits<ForwardIterator2>::iterator_category(),
+        policy, first, last, d_first, init, std::plus<T>());
+}
+
+}   // namespace Hx
+
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <functional>
+#include <iterator>
+#include "parallel_backend.hpp"
+
+namespace Hx {
+
+/**
+ * Inclusive scan
+ * Writes to the range beginning at d_first the running generalized sums
+ * of [first,last): the i-th output is binary_op applied to init (if
+ * given) and the first i+1 elements. binary_op must be associative.
+ * d_first may be equal to first. Returns an iterator past the last
+ * element written.
+ */
+template <typename InputTag, typename OutputTag, typename ExecutionPolicy,
+    typename InputIterator, typename OutputIterator, typename BinaryOperation, typename T>
+OutputIterator inclusive_scan(InputTag, OutputTag, ExecutionPolicy& policy,
+        InputIterator first, InputIterator last, OutputIterator d_first,
+        BinaryOperation binary_op, T init)
+{
+    for ( ; first != last; ++first, ++d_first) {
+        init = binary_op(init, *first);
+        *d_first = init;
+    }
+    return d_first;
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2,
+    typename BinaryOperation, typename T>
+RandomAccessIterator2 inclusive_scan(std::random_access_iterator_tag, std::random_access_iterator_tag,
+        ExecutionPolicy& policy, RandomAccessIterator1 first, RandomAccessIterator1 last,
+        RandomAccessIterator2 d_first, BinaryOperation binary_op, T init)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator1>::difference_type size_type;
+    size_type n = last - first;
+    execution::scan(policy, n, init, binary_op,
+        [first](size_type i) -> T { return first[i]; },
+        [d_first](size_type i, const T& v) { d_first[i] = v; }, true);
+    return d_first + n;
+}
+
+// without init: the first element seeds the scan
+template <typename InputTag, typename OutputTag, typename ExecutionPolicy,
+    typename InputIterator, typename OutputIterator, typename BinaryOperation>
+OutputIterator inclusive_scan(InputTag input_tag, OutputTag output_tag, ExecutionPolicy& policy,
+        InputIterator first, InputIterator last, OutputIterator d_first,
+        BinaryOperation binary_op)
+{
+    if (first == last)
+        return d_first;
+
+    typename std::iterator_traits<InputIterator>::value_type init = *first;
+    *d_first = init;
+    return Hx::inclusive_scan(input_tag, output_tag, policy,
+        ++first, last, ++d_first, binary_op, init);
+}
+
+template <typename InputIterator, typename OutputIterator, typename BinaryOperation, typename T>
+OutputIterator inclusive_scan(InputIterator first, InputIterator last, OutputIterator d_first,
+        BinaryOperation binary_op, T init)
+{
+    return Hx::inclusive_scan(typename std::iterator_traits<InputIterator>::iterator_category(),
+        typename std::iterator_traits<OutputIterator>::iterator_category(),
+        execution::seq, first, last, d_first, binary_op, init);
+}
+
+template <typename InputIterator, typename OutputIterator, typename BinaryOperation>
+OutputIterator inclusive_scan(InputIterator first, InputIterator last, OutputIterator d_first,
+        BinaryOperation binary_op)
+{
+    return Hx::inclusive_scan(typename std::iterator_traits<InputIterator>::iterator_category(),
+        typename std::iterator_traits<OutputIterator>::iterator_category(),
+        execution::seq, first, last, d_first, binary_op);
+}
+
+template <typename InputIterator, typename OutputIterator>
+OutputIterator inclusive_scan(InputIterator first, InputIterator last, OutputIterator d_first)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    return Hx::inclusive_scan(first, last, d_first, std::plus<value_type>());
+}
+
+template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2,
+    typename BinaryOperation, typename T>
+typename execution::enable_if_execution_policy<ExecutionPolicy, ForwardIterator2>::type
+inclusive_scan(ExecutionPolicy&& policy, ForwardIterator1 first, ForwardIterator1 last,
+        ForwardIterator2 d_first, BinaryOperation binary_op, T init)
+{
+    return Hx::inclusive_scan(typename std::iterator_traits<ForwardIterator1>::iterator_category(),
+        typename std::iterator_traits<ForwardIterator2>::iterator_category(),
+        policy, first, last, d_first, binary_op, init);
+}
+
+template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2,
+    typename BinaryOperation>
+typename execution::enable_if_execution_policy<ExecutionPolicy, ForwardIterator2>::type
+inclusive_scan(ExecutionPolicy&& policy, ForwardIterator1 first, ForwardIterator1 last,
+        ForwardIterator2 d_first, BinaryOperation binary_op)
+{
+    return Hx::inclusive_scan(typename std::iterator_traits<ForwardIterator1>::iterator_category(),
+        typename std::iterator_traits<ForwardIterator2>::iterator_category(),
+        policy, first, last, d_first, binary_op);
+}
+
+template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2>
+typename execution::enable_if_execution_policy<ExecutionPolicy, ForwardIterator2>::type
+inclusive_scan(ExecutionPolicy&& policy, ForwardIterator1 first, ForwardIterator1 last,
+        ForwardIterator2 d_first)
+{
+    typedef typename std::iterator_traits<ForwardIterator1>::value_type value_type;
+    return Hx::inclusive_scan(typename std::iterator_traits<ForwardIterator1>::iterator_category(),
+        typename std::iterator_traits<ForwardIterator2>::iterator_category(),
+        policy, first, last, d_first, std::plus<value_type>());
+}
+
+}   // namespace Hx
+
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <functional>
+#include <iterator>
+#include "parallel_backend.hpp"
+
+namespace Hx {
+
+/**
+ * Reduce range
+ * Returns the generalized sum of init and the elements in [first,last).
+ * Unlike accumulate the elements may be grouped and reordered, so
+ * binary_op must be associative and commutative. On random access ranges
+ * this allows a multi-accumulator inner loop that the compiler can
+ * vectorize, and the policy overloads split the range over threads.
+ */
+template <typename ExecutionPolicy, typename InputIterator, typename T, typename BinaryOperation>
+T reduce(std::input_iterator_tag, ExecutionPolicy& policy,
+        InputIterator first, InputIterator last, T init,
+        BinaryOperation binary_op)
+{
+    for ( ; first != last; ++first)
+        init = binary_op(init, *first);
+    return init;
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename T, typename BinaryOperation>
+T reduce(std::random_access_iterator_tag, ExecutionPolicy& policy,
+        RandomAccessIterator first, RandomAccessIterator last, T init,
+        BinaryOperation binary_op)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::difference_type size_type;
+    return execution::reduce(policy, last - first, init, binary_op,
+        [first](size_type i) -> T { return first[i]; });
+}
+
+template <typename InputIterator, typename T, typename BinaryOperation>
+T reduce(InputIterator first, InputIterator last, T init, BinaryOperation binary_op)
+{
+    return Hx::reduce(typename std::iterator_traits<InputIterator>::iterator_category(),
+        execution::seq, first, last, init, binary_op);
+}
+
+template <typename InputIterator, typename T>
+T reduce(InputIterator first, InputIterator last, T init)
+{
+    return Hx::reduce(first, last, init, std::plus<T>());
+}
+
+template <typename InputIterator>
+typename std::iterator_traits<InputIterator>::value_type
+reduce(InputIterator first, InputIterator last)
+{
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    return Hx::reduce(first, last, value_type(), std::plus<value_type>());
+}
+
+template <typename ExecutionPolicy, typename ForwardIterator, typename T, typename BinaryOperation>
+typename execution::enable_if_execution_policy<ExecutionPolicy, T>::type
+reduce(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, T init,
+        BinaryOperation binary_op)
+{
+    return Hx::reduce(typename std::iterator_traits<ForwardIterator>::iterator_category(),
+        policy, first, last, init, binary_op);
+}
+
+template <typename ExecutionPolicy, typename ForwardIterator, typename T>
+typename execution::enable_if_execution_policy<ExecutionPolicy, T>::type
+reduce(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, T init)
+{
+    return Hx::reduce(typename std::iterator_traits<ForwardIterator>::iterator_category(),
+        policy, first, last, init, std::plus<T>());
+}
+
+template <typename ExecutionPolicy, typename ForwardIterator>
+typename execution::enable_if_execution_policy<ExecutionPolicy,
+    typename std::iterator_traits<ForwardIterator>::value_type>::type
+reduce(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last)
+{
+    typedef typename std::iterator_traits<ForwardIterator>::value_type value_type;
+    return Hx::reduce(typename std::iterator_traits<ForwardIterator>::iterator_category(),
+        policy, first, last, value_type(), std::plus<value_type>());
+}
+
+}   // namespace Hx
+
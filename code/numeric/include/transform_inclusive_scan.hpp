@@ -0,0 +1,107 @@
+#pragma once
+
+#include <iterator>
+#include <type_traits>
+#include "parallel_backend.hpp"
+
+namespace Hx {
+
+/**
+ * Transform inclusive scan
+ * As inclusive_scan, but each element is first transformed by unary_op.
+ * Under par/par_unseq unary_op may be called more than once per element.
+ */
+template <typename InputTag, typename OutputTag, typename ExecutionPolicy,
+    typename InputIterator, typename OutputIterator,
+    typename BinaryOperation, typename UnaryOperation, typename T>
+OutputIterator transform_inclusive_scan(InputTag, OutputTag, ExecutionPolicy& policy,
+        InputIterator first, InputIterator last, OutputIterator d_first,
+        BinaryOperation binary_op, UnaryOperation unary_op, T init)
+{
+    for ( ; first != last; ++first, ++d_first) {
+        init = binary_op(init, unary_op(*first));
+        *d_first = init;
+    }
+    return d_first;
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2,
+    typename BinaryOperation, typename UnaryOperation, typename T>
+RandomAccessIterator2 transform_inclusive_scan(std::random_access_iterator_tag,
+        std::random_access_iterator_tag, ExecutionPolicy& policy,
+        RandomAccessIterator1 first, RandomAccessIterator1 last, RandomAccessIterator2 d_first,
+        BinaryOperation binary_op, UnaryOperation unary_op, T init)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator1>::difference_type size_type;
+    size_type n = last - first;
+    execution::scan(policy, n, init, binary_op,
+        [first, &unary_op](size_type i) -> T { return unary_op(first[i]); },
+        [d_first](size_type i, const T& v) { d_first[i] = v; }, true);
+    return d_first + n;
+}
+
+// without init: the first transformed element seeds the scan
+template <typename InputTag, typename OutputTag, typename ExecutionPolicy,
+    typename InputIterator, typename OutputIterator,
+    typename BinaryOperation, typename UnaryOperation>
+OutputIterator transform_inclusive_scan(InputTag input_tag, OutputTag output_tag,
+        ExecutionPolicy& policy, InputIterator first, InputIterator last, OutputIterator d_first,
+        BinaryOperation binary_op, UnaryOperation unary_op)
+{
+    if (first == last)
+        return d_first;
+
+    typename std::decay<decltype(unary_op(*first))>::type init = unary_op(*first);
+    *d_first = init;
+    return Hx::transform_inclusive_scan(input_tag, output_tag, policy,
+        ++first, last, ++d_first, binary_op, unary_op, init);
+}
+
+template <typename InputIterator, typename OutputIterator,
+    typename BinaryOperation, typename UnaryOperation, typename T>
+OutputIterator transform_inclusive_scan(InputIterator first, InputIterator last,
+        OutputIterator d_first, BinaryOperation binary_op, UnaryOperation unary_op, T init)
+{
+    return Hx::transform_inclusive_scan(
+        typename std::iterator_traits<InputIterator>::iterator_category(),
+        typename std::iterator_traits<OutputIterator>::iterator_category(),
+        execution::seq, first, last, d_first, binary_op, unary_op, init);
+}
+
+template <typename InputIterator, typename OutputIterator,
+    typename BinaryOperation, typename UnaryOperation>
+OutputIterator transform_inclusive_scan(InputIterator first, InputIterator last,
+        OutputIterator d_first, BinaryOperation binary_op, UnaryOperation unary_op)
+{
+    return Hx::transform_inclusive_scan(
+        typename std::iterator_traits<InputIterator>::iterator_category(),
+        typename std::iterator_traits<OutputIterator>::iterator_category(),
+        execution::seq, first, last, d_first, binary_op, unary_op);
+}
+
+template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2,
+    typename BinaryOperation, typename UnaryOperation, typename T>
+typename execution::enable_if_execution_policy<ExecutionPolicy, ForwardIterator2>::type
+transform_inclusive_scan(ExecutionPolicy&& policy, ForwardIterator1 first, ForwardIterator1 last,
+        ForwardIterator2 d_first, BinaryOperation binary_op, UnaryOperation unary_op, T init)
+{
+    return Hx::transform_inclusive_scan(
+        typename std::iterator_traits<ForwardIterator1>::iterator_category(),
+        typename std::iterator_traits<ForwardIterator2>::iterator_category(),
+        policy, first, last, d_first, binary_op, unary_op, init);
+}
+
+template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2,
+    typename BinaryOperation, typename UnaryOperation>
+typename execution::enable_if_execution_policy<ExecutionPolicy, ForwardIterator2>::type
+transform_inclusive_scan(ExecutionPolicy&& policy, ForwardIterator1 first, ForwardIterator1 last,
+        ForwardIterator2 d_first, BinaryOperation binary_op, UnaryOperation unary_op)
+{
+    return Hx::transform_inclusive_scan(
+        typename std::iterator_traits<ForwardIterator1>::iterator_category(),
+        typename std::iterator_traits<ForwardIterator2>::iterator_category(),
+        policy, first, last, d_first, binary_op, unary_op);
+}
+
+}   // namespace Hx
+
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <functional>
+#include <iterator>
+#include "parallel_backend.hpp"
+
+namespace Hx {
+
+// a * b, for the default transform of the two-range transform_reduce
+struct transform_reduce_multiplies {
+    template <typename T, typename U>
+    auto operator()(const T& a, const U& b) const -> decltype(a * b) { return a * b; }
+};
+
+/**
+ * Transform and reduce range
+ * Applies transform_op to each element of [first,last) (or to each pair of
+ * elements of [first1,last1) and the range beginning at first2) and
+ * reduces the results together with init using reduce_op. reduce_op must
+ * be associative and commutative, as for reduce.
+ */
+template <typename ExecutionPolicy, typename InputIterator, typename T,
+    typename BinaryReductionOp, typename UnaryTransformOp>
+T transform_reduce(std::input_iterator_tag, ExecutionPolicy& policy,
+        InputIterator first, InputIterator last, T init,
+        BinaryReductionOp reduce_op, UnaryTransformOp transform_op)
+{
+    for ( ; first != last; ++first)
+        init = reduce_op(init, transform_op(*first));
+    return init;
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator, typename T,
+    typename BinaryReductionOp, typename UnaryTransformOp>
+T transform_reduce(std::random_access_iterator_tag, ExecutionPolicy& policy,
+        RandomAccessIterator first, RandomAccessIterator last, T init,
+        BinaryReductionOp reduce_op, UnaryTransformOp transform_op)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator>::difference_type size_type;
+    return execution::reduce(policy, last - first, init, reduce_op,
+        [first, &transform_op](size_type i) -> T { return transform_op(first[i]); });
+}
+
+template <typename ExecutionPolicy, typename InputIterator1, typename InputIterator2, typename T,
+    typename BinaryReductionOp, typename BinaryTransformOp>
+T transform_reduce(std::input_iterator_tag, std::input_iterator_tag, ExecutionPolicy& policy,
+        InputIterator1 first1, InputIterator1 last1,
+        InputIterator2 first2, T init, BinaryReductionOp reduce_op, BinaryTransformOp transform_op)
+{
+    for ( ; first1 != last1; ++first1, ++first2)
+        init = reduce_op(init, transform_op(*first1, *first2));
+    return init;
+}
+
+template <typename ExecutionPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2,
+    typename T, typename BinaryReductionOp, typename BinaryTransformOp>
+T transform_reduce(std::random_access_iterator_tag, std::random_access_iterator_tag, ExecutionPolicy& policy,
+        RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+        RandomAccessIterator2 first2, T init, BinaryReductionOp reduce_op, BinaryTransformOp transform_op)
+{
+    typedef typename std::iterator_traits<RandomAccessIterator1>::difference_type size_type;
+    return execution::reduce(policy, last1 - first1, init, reduce_op,
+        [first1, first2, &transform_op](size_type i) -> T { return transform_op(first1[i], first2[i]); });
+}
+
+template <typename InputIterator1, typename InputIterator2, typename T,
+    typename BinaryReductionOp, typename BinaryTransformOp>
+T transform_reduce(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init,
+        BinaryReductionOp reduce_op, BinaryTransformOp transform_op)
+{
+    return Hx::transform_reduce(typename std::iterator_traits<InputIterator1>::iterator_category(),
+        typename std::iterator_traits<InputIterator2>::iterator_category(),
+        execution::seq, first1, last1, first2, init, reduce_op, transform_op);
+}
+
+template <typename InputIterator1, typename InputIterator2, typename T>
+T transform_reduce(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, T init)
+{
+    return Hx::transform_reduce(first1, last1, first2, init,
+        std::plus<T>(), transform_reduce_multiplies());
+}
+
+template <typename InputIterator, typename T, typename BinaryReductionOp, typename UnaryTransformOp>
+T transform_reduce(InputIterator first, InputIterator last, T init,
+        BinaryReductionOp reduce_op, UnaryTransformOp transform_op)
+{
+    return Hx::transform_reduce(typename std::iterator_traits<InputIterator>::iterator_category(),
+        execution::seq, first, last, init, reduce_op, transform_op);
+}
+
+template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2, typename T,
+    typename BinaryReductionOp, typename BinaryTransformOp>
+typename execution::enable_if_execution_policy<ExecutionPolicy, T>::type
+transform_reduce(ExecutionPolicy&& policy, ForwardIterator1 first1, ForwardIterator1 last1,
+        ForwardIterator2 first2, T init, BinaryReductionOp reduce_op, BinaryTransformOp transform_op)
+{
+    return Hx::transform_reduce(typename std::iterator_traits<ForwardIterator1>::iterator_category(),
+        typename std::iterator_traits<ForwardIterator2>::iterator_category(),
+        policy, first1, last1, first2, init, reduce_op, transform_op);
+}
+
+template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2, typename T>
+typename execution::enable_if_execution_policy<ExecutionPolicy, T>::type
+transform_reduce(ExecutionPolicy&& policy, ForwardIterator1 first1, ForwardIterator1 last1,
+        ForwardIterator2 first2, T init)
+{
+    return Hx::transform_reduce(typename std::iterator_traits<ForwardIterator1>::iterator_category(),
+        typename std::iterator_traits<ForwardIterator2>::iterator_category(),
+        policy, first1, last1, first2, init,
+        std::plus<T>(), transform_reduce_multiplies());
+}
+
+template <typename ExecutionPolicy, typename ForwardIterator, typename T,
+    typename BinaryReductionOp, typename UnaryTransformOp>
+typename execution::enable_if_execution_policy<ExecutionPolicy, T>::type
+transform_reduce(ExecutionPolicy&& policy, ForwardIterator first, ForwardIterator last, T init,
+        BinaryReductionOp reduce_op, UnaryTransformOp transform_op)
+{
+    return Hx::transform_reduce(typename std::iterator_traits<ForwardIterator>::iterator_category(),
+        policy, first, last, init, reduce_op, transform_op);
+}
+
+}   // namespace Hx
+
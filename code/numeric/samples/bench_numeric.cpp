@@ -0,0 +1,136 @@
+// Hx numeric algorithms against their std counterparts; see "bench.hpp" for the options.
+// std::reduce and std::inclusive_scan are C++17, so the std baselines of
+// reduce and inclusive_scan are std::accumulate and std::partial_sum.
+#include <vector>
+#include <numeric>
+#include "execution.hpp"
+#include "accumulate.hpp"
+#include "accumulate_pairwise.hpp"
+#include "accumulate_kahan.hpp"
+#include "reduce.hpp"
+#include "inclusive_scan.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+using Hx::bench::clobber_memory;
+
+template <typename T>
+std::vector<T> make_data(long n)
+{
+    std::vector<T> v(n);
+    for (long i = 0; i < n; i++)
+        v[i] = T(i % 1000) / T(7);
+    return v;
+}
+
+template <typename T>
+void accumulate_std(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        T sum = std::accumulate(v.begin(), v.end(), T());
+        do_not_optimize(sum);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(T));
+}
+
+template <typename T>
+void accumulate_hx(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        T sum = Hx::accumulate(v.begin(), v.end(), T());
+        do_not_optimize(sum);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(T));
+}
+
+template <typename T>
+void accumulate_pairwise_hx(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        T sum = Hx::accumulate_pairwise(v.begin(), v.end(), T());
+        do_not_optimize(sum);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(T));
+}
+
+template <typename T>
+void accumulate_kahan_hx(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        T sum = Hx::accumulate_kahan(v.begin(), v.end(), T());
+        do_not_optimize(sum);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(T));
+}
+
+template <typename T>
+void reduce_hx(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        T sum = Hx::reduce(v.begin(), v.end(), T());
+        do_not_optimize(sum);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(T));
+}
+
+template <typename T>
+void reduce_par_unseq_hx(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        T sum = Hx::reduce(Hx::execution::par_unseq, v.begin(), v.end(), T());
+        do_not_optimize(sum);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(T));
+}
+
+template <typename T>
+void partial_sum_std(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    std::vector<T> out(v.size());
+    while (st.keep_running()) {
+        std::partial_sum(v.begin(), v.end(), out.begin());
+        clobber_memory();
+    }
+    st.set_bytes_per_iteration(2 * st.arg() * sizeof(T));
+}
+
+template <typename T>
+void inclusive_scan_hx(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    std::vector<T> out(v.size());
+    while (st.keep_running()) {
+        Hx::inclusive_scan(v.begin(), v.end(), out.begin());
+        clobber_memory();
+    }
+    st.set_bytes_per_iteration(2 * st.arg() * sizeof(T));
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("numeric");
+    s.add("accumulate<int>", "std", accumulate_std<int>).args({1 << 10, 1 << 22});
+    s.add("accumulate<int>", "Hx", accumulate_hx<int>).args({1 << 10, 1 << 22});
+    s.add("accumulate<float>", "std", accumulate_std<float>).args({1 << 10, 1 << 22});
+    s.add("accumulate<float>", "Hx", accumulate_hx<float>).args({1 << 10, 1 << 22});
+    s.add("accumulate<float>", "Hx_pairwise", accumulate_pairwise_hx<float>).args({1 << 10, 1 << 22});
+    s.add("accumulate<float>", "Hx_kahan", accumulate_kahan_hx<float>).args({1 << 10, 1 << 22});
+    s.add("accumulate<double>", "std", accumulate_std<double>).args({1 << 10, 1 << 22});
+    s.add("accumulate<double>", "Hx", accumulate_hx<double>).args({1 << 10, 1 << 22});
+    s.add("accumulate<double>", "Hx_pairwise", accumulate_pairwise_hx<double>).args({1 << 10, 1 << 22});
+    s.add("accumulate<double>", "Hx_kahan", accumulate_kahan_hx<double>).args({1 << 10, 1 << 22});
+    s.add("reduce<double>", "std", accumulate_std<double>).args({1 << 10, 1 << 22});
+    s.add("reduce<double>", "Hx", reduce_hx<double>).args({1 << 10, 1 << 22});
+    s.add("reduce<double>", "Hx_par_unseq", reduce_par_unseq_hx<double>).args({1 << 10, 1 << 22});
+    s.add("inclusive_scan<int>", "std", partial_sum_std<int>).args({1 << 10, 1 << 22});
+    s.add("inclusive_scan<int>", "Hx", inclusive_scan_hx<int>).args({1 << 10, 1 << 22});
+    return s.run(argc, argv);
+}
@@ -0,0 +1,161 @@
+// Hx::reduce, transform_reduce and inclusive_scan against the C++17 std
+// algorithms, sequenced and parallel; see "bench.hpp" for the options.
+#include <execution>
+#include <numeric>
+#include <vector>
+#include "execution.hpp"
+#include "reduce.hpp"
+#include "transform_reduce.hpp"
+#include "inclusive_scan.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+using Hx::bench::clobber_memory;
+
+template <typename T>
+std::vector<T> make_data(long n)
+{
+    std::vector<T> v(n);
+    for (long i = 0; i < n; i++)
+        v[i] = T(i % 7);
+    return v;
+}
+
+template <typename T>
+void reduce_std(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        T sum = std::reduce(v.begin(), v.end());
+        do_not_optimize(sum);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(T));
+}
+
+template <typename T>
+void reduce_hx(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        T sum = Hx::reduce(v.begin(), v.end());
+        do_not_optimize(sum);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(T));
+}
+
+template <typename T>
+void reduce_par_std(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        T sum = std::reduce(std::execution::par, v.begin(), v.end());
+        do_not_optimize(sum);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(T));
+}
+
+template <typename T>
+void reduce_par_hx(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        T sum = Hx::reduce(Hx::execution::par, v.begin(), v.end());
+        do_not_optimize(sum);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(T));
+}
+
+template <typename T>
+void transform_reduce_std(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        T sum = std::transform_reduce(v.begin(), v.end(), v.begin(), T());
+        do_not_optimize(sum);
+    }
+    st.set_bytes_per_iteration(2 * st.arg() * sizeof(T));
+}
+
+template <typename T>
+void transform_reduce_hx(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    while (st.keep_running()) {
+        T sum = Hx::transform_reduce(v.begin(), v.end(), v.begin(), T());
+        do_not_optimize(sum);
+    }
+    st.set_bytes_per_iteration(2 * st.arg() * sizeof(T));
+}
+
+template <typename T>
+void inclusive_scan_std(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    std::vector<T> out(v.size());
+    while (st.keep_running()) {
+        std::inclusive_scan(v.begin(), v.end(), out.begin());
+        clobber_memory();
+    }
+    st.set_bytes_per_iteration(2 * st.arg() * sizeof(T));
+}
+
+template <typename T>
+void inclusive_scan_hx(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    std::vector<T> out(v.size());
+    while (st.keep_running()) {
+        Hx::inclusive_scan(v.begin(), v.end(), out.begin());
+        clobber_memory();
+    }
+    st.set_bytes_per_iteration(2 * st.arg() * sizeof(T));
+}
+
+template <typename T>
+void inclusive_scan_par_std(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    std::vector<T> out(v.size());
+    while (st.keep_running()) {
+        std::inclusive_scan(std::execution::par, v.begin(), v.end(), out.begin());
+        clobber_memory();
+    }
+    st.set_bytes_per_iteration(2 * st.arg() * sizeof(T));
+}
+
+template <typename T>
+void inclusive_scan_par_hx(state& st)
+{
+    std::vector<T> v = make_data<T>(st.arg());
+    std::vector<T> out(v.size());
+    while (st.keep_running()) {
+        Hx::inclusive_scan(Hx::execution::par, v.begin(), v.end(), out.begin());
+        clobber_memory();
+    }
+    st.set_bytes_per_iteration(2 * st.arg() * sizeof(T));
+}
+
+template <typename T>
+void add(Hx::bench::suite& s, const std::string& type)
+{
+    s.add("reduce<" + type + ">", "std", reduce_std<T>).args({1 << 10, 1 << 22});
+    s.add("reduce<" + type + ">", "Hx", reduce_hx<T>).args({1 << 10, 1 << 22});
+    s.add("reduce<" + type + ">", "std_par", reduce_par_std<T>).args({1 << 10, 1 << 22});
+    s.add("reduce<" + type + ">", "Hx_par", reduce_par_hx<T>).args({1 << 10, 1 << 22});
+    s.add("transform_reduce<" + type + ">", "std", transform_reduce_std<T>).args({1 << 10, 1 << 22});
+    s.add("transform_reduce<" + type + ">", "Hx", transform_reduce_hx<T>).args({1 << 10, 1 << 22});
+    s.add("inclusive_scan<" + type + ">", "std", inclusive_scan_std<T>).args({1 << 10, 1 << 22});
+    s.add("inclusive_scan<" + type + ">", "Hx", inclusive_scan_hx<T>).args({1 << 10, 1 << 22});
+    s.add("inclusive_scan<" + type + ">", "std_par", inclusive_scan_par_std<T>).args({1 << 10, 1 << 22});
+    s.add("inclusive_scan<" + type + ">", "Hx_par", inclusive_scan_par_hx<T>).args({1 << 10, 1 << 22});
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("reduce");
+    add<int>(s, "int");
+    add<float>(s, "float");
+    add<double>(s, "double");
+    return s.run(argc, argv);
+}
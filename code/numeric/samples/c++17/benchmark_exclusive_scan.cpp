@@ -0,0 +1,29 @@
+// exclusive_scan example
+#include <iostream>     // std::cout
+#include <iterator>     // std::ostream_iterator
+#include <vector>       // std::vector
+#include <functional>   // std::multiplies
+#include <execution>    // std::execution::par
+#include <numeric>      // std::exclusive_scan
+
+int main () {
+	std::vector<int> data = {3, 1, 4, 1, 5, 9, 2, 6};
+
+	std::cout << "exclusive sum: ";
+	std::exclusive_scan(data.begin(), data.end(),
+		std::ostream_iterator<int>(std::cout, " "), 0);
+
+	std::cout << "\nexclusive product: ";
+	std::exclusive_scan(std::execution::par, data.begin(), data.end(),
+		std::ostream_iterator<int>(std::cout, " "), 1, std::multiplies<int>());
+	std::cout << '\n';
+
+	return 0;
+}
+
+/*
+Output:
+
+exclusive sum: 0 3 4 8 9 14 23 25 
+exclusive product: 1 3 3 12 12 60 540 1080 
+*/
@@ -0,0 +1,35 @@
+// inclusive_scan example
+#include <iostream>     // std::cout
+#include <iterator>     // std::ostream_iterator
+#include <vector>       // std::vector
+#include <functional>   // std::multiplies
+#include <execution>    // std::execution::par
+#include <numeric>      // std::inclusive_scan
+
+int main () {
+	std::vector<int> data = {3, 1, 4, 1, 5, 9, 2, 6};
+
+	std::cout << "inclusive sum: ";
+	std::inclusive_scan(data.begin(), data.end(),
+		std::ostream_iterator<int>(std::cout, " "));
+
+	std::cout << "\ninclusive product: ";
+	std::inclusive_scan(std::execution::par, data.begin(), data.end(),
+		std::ostream_iterator<int>(std::cout, " "), std::multiplies<int>());
+
+	std::cout << "\nin place, starting at 100: ";
+	std::inclusive_scan(std::execution::par, data.begin(), data.end(), data.begin(),
+		std::plus<int>(), 100);
+	for (int x: data) std::cout << x << ' ';
+	std::cout << '\n';
+
+	return 0;
+}
+
+/*
+Output:
+
+inclusive sum: 3 4 8 9 14 23 25 31 
+inclusive product: 3 3 12 12 60 540 1080 6480 
+in place, starting at 100: 103 104 108 109 114 123 125 131 
+*/
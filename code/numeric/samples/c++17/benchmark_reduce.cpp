@@ -0,0 +1,28 @@
+// reduce example
+#include <iostream>     // std::cout
+#include <vector>       // std::vector
+#include <execution>    // std::execution::par
+#include <numeric>      // std::accumulate, std::reduce
+
+int main () {
+	std::vector<double> v(10000007, 0.5);
+
+	std::cout << std::fixed;
+	std::cout << "accumulate: " << std::accumulate(v.begin(), v.end(), 0.0) << '\n';
+	std::cout << "reduce: " << std::reduce(v.begin(), v.end()) << '\n';
+	std::cout << "reduce (par): " << std::reduce(std::execution::par, v.begin(), v.end()) << '\n';
+
+	int numbers[] = {1,2,3,4,5};
+	std::cout << "product: " << std::reduce(numbers, numbers+5, 1, [](int a, int b) { return a*b; }) << '\n';
+
+	return 0;
+}
+
+/*
+Output:
+
+accumulate: 5000003.500000
+reduce: 5000003.500000
+reduce (par): 5000003.500000
+product: 120
+*/
@@ -0,0 +1,32 @@
+// transform_inclusive_scan example
+#include <iostream>     // std::cout
+#include <iterator>     // std::ostream_iterator
+#include <vector>       // std::vector
+#include <functional>   // std::plus
+#include <execution>    // std::execution::par
+#include <numeric>      // std::transform_inclusive_scan
+
+int main () {
+	std::vector<int> data = {3, 1, 4, 1, 5, 9, 2, 6};
+	auto times_10 = [](int x) { return x * 10; };
+
+	std::cout << "10 times inclusive sum: ";
+	std::transform_inclusive_scan(data.begin(), data.end(),
+		std::ostream_iterator<int>(std::cout, " "), std::plus<int>(), times_10);
+
+	std::cout << "\n10 times inclusive sum, starting at 1000: ";
+	std::vector<int> out(data.size());
+	std::transform_inclusive_scan(std::execution::par, data.begin(), data.end(), out.begin(),
+		std::plus<int>(), times_10, 1000);
+	for (int x: out) std::cout << x << ' ';
+	std::cout << '\n';
+
+	return 0;
+}
+
+/*
+Output:
+
+10 times inclusive sum: 30 40 80 90 140 230 250 310 
+10 times inclusive sum, starting at 1000: 1030 1040 1080 1090 1140 1230 1250 1310 
+*/
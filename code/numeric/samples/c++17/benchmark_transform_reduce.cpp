@@ -0,0 +1,28 @@
+// transform_reduce example
+#include <iostream>     // std::cout
+#include <vector>       // std::vector
+#include <functional>   // std::plus
+#include <execution>    // std::execution::par_unseq
+#include <numeric>      // std::transform_reduce
+
+int main () {
+	std::vector<double> xvalues(10007, 1.0), yvalues(10007, 1.0);
+
+	double result = std::transform_reduce(std::execution::par_unseq,
+		xvalues.begin(), xvalues.end(), yvalues.begin(), 0.0);
+	std::cout << "inner product: " << result << '\n';
+
+	std::vector<int> v = {1,2,3,4,5};
+	int sum_of_squares = std::transform_reduce(v.begin(), v.end(), 0,
+		std::plus<int>(), [](int x) { return x*x; });
+	std::cout << "sum of squares: " << sum_of_squares << '\n';
+
+	return 0;
+}
+
+/*
+Output:
+
+inner product: 10007
+sum of squares: 55
+*/
@@ -0,0 +1,33 @@
+// accumulate_kahan example
+#include <iostream>     // std::cout, std::fixed
+#include <iomanip>      // std::setprecision
+#include <vector>       // std::vector
+#include "accumulate.hpp"       // accumulate
+#include "accumulate_kahan.hpp" // accumulate_kahan
+
+int main () {
+	std::vector<double> v(10000000, 0.1);
+	double cancel[] = {1e100, 1.0, -1e100};
+
+	std::cout << std::fixed << std::setprecision(10);
+	std::cout << "accumulate: " << Hx::accumulate(v.begin(), v.end(), 0.0) << '\n';
+	std::cout << "accumulate_kahan: " << Hx::accumulate_kahan(v.begin(), v.end(), 0.0) << '\n';
+
+	std::cout << "1e100 + 1 - 1e100 (accumulate): " << Hx::accumulate(cancel, cancel+3, 0.0) << '\n';
+	std::cout << "1e100 + 1 - 1e100 (accumulate_kahan): " << Hx::accumulate_kahan(cancel, cancel+3, 0.0) << '\n';
+
+	float floats[] = {1e8f, 1.0f, 1.0f, 1.0f, 1.0f};
+	std::cout << "1e8 + 4 ones in double: " << Hx::accumulate_kahan(floats, floats+5, 0.0) << '\n';
+
+	return 0;
+}
+
+/*
+Output:
+
+accumulate: 999999.9998389754
+accumulate_kahan: 1000000.0000000000
+1e100 + 1 - 1e100 (accumulate): 0.0000000000
+1e100 + 1 - 1e100 (accumulate_kahan): 1.0000000000
+1e8 + 4 ones in double: 100000004.0000000000
+*/
@@ -0,0 +1,33 @@
+// accumulate_pairwise example
+#include <iostream>     // std::cout, std::fixed
+#include <vector>       // std::vector
+#include <list>         // std::list
+#include "accumulate.hpp"           // accumulate
+#include "accumulate_pairwise.hpp"  // accumulate_pairwise
+
+int main () {
+	std::vector<float> v(10000000, 0.1f);
+	std::list<float> l(1000000, 0.1f);
+
+	std::cout << std::fixed;
+	std::cout << "accumulate: " << Hx::accumulate(v.begin(), v.end(), 0.0f) << '\n';
+	std::cout << "accumulate_pairwise: " << Hx::accumulate_pairwise(v.begin(), v.end(), 0.0f) << '\n';
+
+	std::cout << "accumulate (list): " << Hx::accumulate(l.begin(), l.end(), 0.0f) << '\n';
+	std::cout << "accumulate_pairwise (list): " << Hx::accumulate_pairwise(l.begin(), l.end(), 0.0f) << '\n';
+
+	int numbers[] = {10,20,30};
+	std::cout << "ints: " << Hx::accumulate_pairwise(numbers, numbers+3, 100) << '\n';
+
+	return 0;
+}
+
+/*
+Output:
+
+accumulate: 1087937.000000
+accumulate_pairwise: 1000000.125000
+accumulate (list): 100958.343750
+accumulate_pairwise (list): 100000.093750
+ints: 160
+*/
@@ -0,0 +1,39 @@
+// accumulate with execution policies
+#include <iostream>     // std::cout
+#include <vector>       // std::vector
+#include <functional>   // std::multiplies
+#include "execution.hpp"       // Hx::execution::seq/par/par_unseq
+#include "accumulate.hpp"      // accumulate
+
+int main () {
+	std::vector<long long> numbers(1000000);
+	for (size_t i = 0; i < numbers.size(); i++) numbers[i] = i + 1;
+
+	std::cout << "sequenced: ";
+	std::cout << Hx::accumulate(Hx::execution::seq, numbers.begin(), numbers.end(), 0LL);
+	std::cout << '\n';
+
+	std::cout << "parallel: ";
+	std::cout << Hx::accumulate(Hx::execution::par, numbers.begin(), numbers.end(), 0LL);
+	std::cout << '\n';
+
+	std::cout << "parallel on 4 threads: ";
+	std::cout << Hx::accumulate(Hx::execution::par(4), numbers.begin(), numbers.end(), 0LL);
+	std::cout << '\n';
+
+	std::vector<int> small = {1,2,3,4,5};
+	std::cout << "using functional's multiplies: ";
+	std::cout << Hx::accumulate(Hx::execution::par_unseq, small.begin(), small.end(), 1, std::multiplies<int>());
+	std::cout << '\n';
+
+	return 0;
+}
+
+/*
+Output:
+
+sequenced: 500000500000
+parallel: 500000500000
+parallel on 4 threads: 500000500000
+using functional's multiplies: 120
+*/
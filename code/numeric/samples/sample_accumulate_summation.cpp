@@ -0,0 +1,58 @@
+// relative error of Hx::accumulate_pairwise and Hx::accumulate_kahan
+// against the plain Hx::accumulate loop, in float and double;
+// bench_numeric has their throughput
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "accumulate.hpp"
+#include "accumulate_pairwise.hpp"
+#include "accumulate_kahan.hpp"
+
+template <typename T>
+void report(const char* name, T result, long double exact)
+{
+    long double err = std::fabs(result - exact) / std::fabs(exact);
+    printf("  %-32s rel. error %9.2Le\n", name, err);
+}
+
+template <typename T>
+void errors(const char* type, const char* data, const std::vector<T>& v)
+{
+    // long double compensated sum: exact to well below the float and double errors
+    long double exact = Hx::accumulate_kahan(v.begin(), v.end(), 0.0L);
+    printf("%s, %s, sum %.17Lg\n", type, data, exact);
+
+    report("accumulate", Hx::accumulate(v.begin(), v.end(), T()), exact);
+    report("accumulate (long double)", Hx::accumulate(v.begin(), v.end(), 0.0L), exact);
+    report("accumulate_pairwise", Hx::accumulate_pairwise(v.begin(), v.end(), T()), exact);
+    report("accumulate_kahan", Hx::accumulate_kahan(v.begin(), v.end(), T()), exact);
+}
+
+template <typename T>
+void errors(const char* type, size_t n)
+{
+    std::mt19937_64 rng(2026);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    std::vector<T> v(n);
+
+    for (size_t i = 0; i < n; i++)
+        v[i] = T(uniform(rng));
+    errors(type, "uniform [0,1)", v);
+
+    // mixed signs and magnitudes: the sum is much smaller than the terms
+    for (size_t i = 0; i < n; i++)
+        v[i] = T((uniform(rng) - 0.5) * std::pow(10.0, int(rng() % 8)));
+    errors(type, "+-[0,1e7)", v);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = (argc > 1) ? strtoull(argv[1], NULL, 10) : (1u << 24);
+
+    printf("%zu elements, %s kernels\n", n, Hx::simd::isa_name(Hx::simd::active_isa()));
+    errors<float>("float", n);
+    errors<double>("double", n);
+    return 0;
+}
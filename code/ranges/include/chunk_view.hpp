@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include "view.hpp"
+
+namespace Hx {
+
+/**
+ * A view cut into subranges of size elements, the last one possibly
+ * shorter. The chunks refer to the view's elements, nothing is copied.
+ */
+template <typename View>
+class chunk_view: public view_base {
+    typedef typename range_iterator<const View>::type base_iterator;
+    typedef typename std::iterator_traits<base_iterator>::difference_type difference_type;
+
+    View base_;
+    difference_type size_;
+
+public:
+    class iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef subrange<base_iterator> value_type;
+        typedef typename chunk_view::difference_type difference_type;
+        typedef void pointer;
+        typedef subrange<base_iterator> reference;
+
+        iterator(): current_(), last_(), size_(0) {}
+        iterator(base_iterator current, base_iterator last, difference_type size):
+            current_(current), last_(last), size_(size) {}
+
+        reference operator*() const
+        {
+            return reference(current_, Hx::next_bounded(current_, size_, last_));
+        }
+
+        iterator& operator++() { current_ = Hx::next_bounded(current_, size_, last_); return *this; }
+        iterator operator++(int) { iterator tmp(*this); ++*this; return tmp; }
+
+        friend bool operator==(const iterator& a, const iterator& b) { return a.current_ == b.current_; }
+        friend bool operator!=(const iterator& a, const iterator& b) { return !(a.current_ == b.current_); }
+
+    private:
+        base_iterator current_;
+        base_iterator last_;
+        difference_type size_;
+    };
+
+    chunk_view(View base, difference_type size): base_(std::move(base)), size_(std::max<difference_type>(size, 1)) {}
+
+    const View& base() const { return base_; }
+
+    iterator begin() const { return iterator(base_.begin(), base_.end(), size_); }
+    iterator end() const { return iterator(base_.end(), base_.end(), size_); }
+};
+
+namespace views {
+
+struct chunk_adaptor {
+    ptrdiff_t size;
+};
+
+/**
+ * chunk(range, size), or range | chunk(size)
+ */
+template <typename Range>
+chunk_view<all_t<Range>> chunk(Range&& range, ptrdiff_t size)
+{
+    return chunk_view<all_t<Range>>(views::all(std::forward<Range>(range)), size);
+}
+
+inline chunk_adaptor chunk(ptrdiff_t size)
+{
+    chunk_adaptor adaptor = { size };
+    return adaptor;
+}
+
+template <typename Range>
+auto operator|(Range&& range, chunk_adaptor adaptor)
+    -> decltype(views::chunk(std::forward<Range>(range), adaptor.size))
+{
+    return views::chunk(std::forward<Range>(range), adaptor.size);
+}
+
+}   // namespace views
+
+}   // namespace Hx
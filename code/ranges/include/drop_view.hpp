@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include "view.hpp"
+
+namespace Hx {
+
+/**
+ * A view without its first count elements (empty if it has fewer). The
+ * iterators are the view's own; begin() steps over the dropped elements,
+ * in O(1) over a random access view.
+ */
+template <typename View>
+class drop_view: public view_base {
+    typedef typename range_iterator<const View>::type base_iterator;
+    typedef typename std::iterator_traits<base_iterator>::difference_type difference_type;
+
+    View base_;
+    difference_type count_;
+
+public:
+    typedef base_iterator iterator;
+
+    drop_view(View base, difference_type count): base_(std::move(base)), count_(std::max<difference_type>(count, 0)) {}
+
+    const View& base() const { return base_; }
+    difference_type count() const { return count_; }
+
+    iterator begin() const { return Hx::next_bounded(base_.begin(), count_, base_.end()); }
+    iterator end() const { return base_.end(); }
+};
+
+template <typename View>
+drop_view<View> make_drop_view(View base, ptrdiff_t count)
+{
+    return drop_view<View>(std::move(base), count);
+}
+
+/**
+ * drop(n) of drop(m) is drop(n + m).
+ */
+template <typename View>
+drop_view<View> make_drop_view(drop_view<View> base, ptrdiff_t count)
+{
+    return drop_view<View>(base.base(), base.count() + std::max<ptrdiff_t>(count, 0));
+}
+
+namespace views {
+
+struct drop_adaptor {
+    ptrdiff_t count;
+};
+
+/**
+ * drop(range, count), or range | drop(count)
+ */
+template <typename Range>
+auto drop(Range&& range, ptrdiff_t count)
+    -> decltype(Hx::make_drop_view(views::all(std::forward<Range>(range)), count))
+{
+    return Hx::make_drop_view(views::all(std::forward<Range>(range)), count);
+}
+
+inline drop_adaptor drop(ptrdiff_t count)
+{
+    drop_adaptor adaptor = { count };
+    return adaptor;
+}
+
+template <typename Range>
+auto operator|(Range&& range, drop_adaptor adaptor)
+    -> decltype(views::drop(std::forward<Range>(range), adaptor.count))
+{
+    return views::drop(std::forward<Range>(range), adaptor.count);
+}
+
+}   // namespace views
+
+}   // namespace Hx
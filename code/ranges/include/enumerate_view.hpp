@@ -0,0 +1,79 @@
+#pragma once
+
+#include <iterator>
+#include <utility>
+#include "view.hpp"
+
+namespace Hx {
+
+/**
+ * The pairs (i, x[i]) of the elements of a view and their index. The
+ * pairs hold the view's references, so assigning to p.second writes
+ * through.
+ */
+template <typename View>
+class enumerate_view: public view_base {
+    typedef typename range_iterator<const View>::type base_iterator;
+    typedef std::iterator_traits<base_iterator> base_traits;
+
+    View base_;
+
+public:
+    class iterator {
+    public:
+        typedef typename common_category<typename base_traits::iterator_category,
+            std::forward_iterator_tag>::type iterator_category;
+        typedef typename base_traits::difference_type difference_type;
+        typedef std::pair<difference_type, typename base_traits::value_type> value_type;
+        typedef void pointer;
+        typedef std::pair<difference_type, typename base_traits::reference> reference;
+
+        iterator(): current_(), index_(0) {}
+        iterator(base_iterator current, difference_type index): current_(current), index_(index) {}
+
+        reference operator*() const { return reference(index_, *current_); }
+
+        iterator& operator++() { ++current_; ++index_; return *this; }
+        iterator operator++(int) { iterator tmp(*this); ++*this; return tmp; }
+
+        friend bool operator==(const iterator& a, const iterator& b) { return a.current_ == b.current_; }
+        friend bool operator!=(const iterator& a, const iterator& b) { return !(a.current_ == b.current_); }
+
+    private:
+        base_iterator current_;
+        difference_type index_;
+    };
+
+    explicit enumerate_view(View base): base_(std::move(base)) {}
+
+    const View& base() const { return base_; }
+
+    iterator begin() const { return iterator(base_.begin(), 0); }
+    iterator end() const { return iterator(base_.end(), 0); }
+};
+
+namespace views {
+
+/**
+ * enumerate(range), or range | enumerate
+ */
+struct enumerate_adaptor {
+    template <typename Range>
+    enumerate_view<all_t<Range>> operator()(Range&& range) const
+    {
+        return enumerate_view<all_t<Range>>(views::all(std::forward<Range>(range)));
+    }
+};
+
+constexpr enumerate_adaptor enumerate{};
+
+template <typename Range>
+auto operator|(Range&& range, enumerate_adaptor adaptor)
+    -> decltype(adaptor(std::forward<Range>(range)))
+{
+    return adaptor(std::forward<Range>(range));
+}
+
+}   // namespace views
+
+}   // namespace Hx
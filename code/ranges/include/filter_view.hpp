@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include "view.hpp"
+
+namespace Hx {
+
+/**
+ * The elements of a view for which pred is true. begin() searches for the
+ * first one, so it is not O(1); iterators are forward at most.
+ */
+template <typename View, typename Predicate>
+class filter_view: public view_base {
+    typedef typename range_iterator<const View>::type base_iterator;
+    typedef std::iterator_traits<base_iterator> base_traits;
+
+    View base_;
+    Predicate pred_;
+
+public:
+    class iterator: public iterator_adaptor<iterator, base_iterator,
+            typename common_category<typename base_traits::iterator_category, std::forward_iterator_tag>::type,
+            typename base_traits::value_type, typename base_traits::reference> {
+        typedef iterator_adaptor<iterator, base_iterator,
+            typename common_category<typename base_traits::iterator_category, std::forward_iterator_tag>::type,
+            typename base_traits::value_type, typename base_traits::reference> base_type;
+
+        const filter_view* parent_;
+
+    public:
+        iterator(): parent_(nullptr) {}
+        iterator(const filter_view* parent, base_iterator current): base_type(current), parent_(parent) {}
+
+        typename base_traits::reference operator*() const { return *this->current_; }
+
+        iterator& operator++()
+        {
+            this->current_ = std::find_if(++this->current_, parent_->base_.end(), parent_->pred_);
+            return *this;
+        }
+
+        iterator operator++(int) { iterator tmp(*this); ++*this; return tmp; }
+    };
+
+    filter_view(View base, Predicate pred): base_(std::move(base)), pred_(std::move(pred)) {}
+
+    const View& base() const { return base_; }
+    const Predicate& pred() const { return pred_; }
+
+    iterator begin() const { return iterator(this, std::find_if(base_.begin(), base_.end(), pred_)); }
+    iterator end() const { return iterator(this, base_.end()); }
+};
+
+/**
+ * pred1(x) && pred2(x)
+ */
+template <typename Predicate1, typename Predicate2>
+struct and_predicate {
+    Predicate1 pred1;
+    Predicate2 pred2;
+
+    template <typename T>
+    bool operator()(T&& x) const { return pred1(x) && pred2(x); }
+};
+
+template <typename View, typename Predicate>
+filter_view<View, Predicate> make_filter_view(View base, Predicate pred)
+{
+    return filter_view<View, Predicate>(std::move(base), std::move(pred));
+}
+
+/**
+ * A filter of a filter is one filter with both predicates, which skips
+ * each rejected element in one pass.
+ */
+template <typename View, typename Predicate1, typename Predicate2>
+filter_view<View, and_predicate<Predicate1, Predicate2>>
+make_filter_view(filter_view<View, Predicate1> base, Predicate2 pred)
+{
+    and_predicate<Predicate1, Predicate2> both = { base.pred(), std::move(pred) };
+    return filter_view<View, and_predicate<Predicate1, Predicate2>>(base.base(), std::move(both));
+}
+
+namespace views {
+
+template <typename Predicate>
+struct filter_adaptor {
+    Predicate pred;
+};
+
+/**
+ * filter(range, pred), or range | filter(pred)
+ */
+template <typename Range, typename Predicate>
+auto filter(Range&& range, Predicate pred)
+    -> decltype(Hx::make_filter_view(views::all(std::forward<Range>(range)), std::move(pred)))
+{
+    return Hx::make_filter_view(views::all(std::forward<Range>(range)), std::move(pred));
+}
+
+template <typename Predicate>
+filter_adaptor<Predicate> filter(Predicate pred)
+{
+    filter_adaptor<Predicate> adaptor = { std::move(pred) };
+    return adaptor;
+}
+
+template <typename Range, typename Predicate>
+auto operator|(Range&& range, const filter_adaptor<Predicate>& adaptor)
+    -> decltype(views::filter(std::forward<Range>(range), adaptor.pred))
+{
+    return views::filter(std::forward<Range>(range), adaptor.pred);
+}
+
+}   // namespace views
+
+}   // namespace Hx
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include "view.hpp"
+
+namespace Hx {
+
+/**
+ * The integers first, first + 1, ... up to (not including) last.
+ */
+template <typename T>
+class iota_view: public view_base {
+    T first_;
+    T last_;
+
+public:
+    class iterator: public iterator_adaptor<iterator, T, std::random_access_iterator_tag, T, T, ptrdiff_t> {
+        typedef iterator_adaptor<iterator, T, std::random_access_iterator_tag, T, T, ptrdiff_t> base_type;
+
+    public:
+        iterator() {}
+        explicit iterator(T value): base_type(value) {}
+
+        T operator*() const { return this->current_; }
+    };
+
+    iota_view(): first_(), last_() {}
+    iota_view(T first, T last): first_(first), last_(last < first ? first : last) {}
+
+    iterator begin() const { return iterator(first_); }
+    iterator end() const { return iterator(last_); }
+    size_t size() const { return size_t(last_) - size_t(first_); }
+};
+
+namespace views {
+
+/**
+ * iota(first, last) counts from first up to last; iota(first) counts up
+ * to the largest T, to be cut short by take.
+ */
+template <typename T>
+iota_view<T> iota(T first, T last)
+{
+    return iota_view<T>(first, last);
+}
+
+template <typename T>
+iota_view<T> iota(T first)
+{
+    return iota_view<T>(first, std::numeric_limits<T>::max());
+}
+
+}   // namespace views
+
+}   // namespace Hx
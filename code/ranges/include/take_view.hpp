@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "view.hpp"
+
+namespace Hx {
+
+/**
+ * Iterator of a take_view over a view that is not random access: counts
+ * down the elements left, and compares equal to the end once the count
+ * or the view runs out.
+ */
+template <typename Iterator>
+class take_iterator {
+public:
+    typedef typename common_category<typename std::iterator_traits<Iterator>::iterator_category,
+        std::forward_iterator_tag>::type iterator_category;
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+    typedef typename std::iterator_traits<Iterator>::difference_type difference_type;
+    typedef typename std::iterator_traits<Iterator>::pointer pointer;
+    typedef typename std::iterator_traits<Iterator>::reference reference;
+
+    take_iterator(): current_(), last_(), count_(0) {}
+    take_iterator(Iterator current, Iterator last, difference_type count):
+        current_(current), last_(last), count_(count) {}
+
+    reference operator*() const { return *current_; }
+
+    take_iterator& operator++() { ++current_; --count_; return *this; }
+    take_iterator operator++(int) { take_iterator tmp(*this); ++*this; return tmp; }
+
+    bool at_end() const { return count_ == 0 || current_ == last_; }
+
+    friend bool operator==(const take_iterator& a, const take_iterator& b)
+    {
+        return (a.at_end() || b.at_end()) ? a.at_end() == b.at_end() : a.current_ == b.current_;
+    }
+
+    friend bool operator!=(const take_iterator& a, const take_iterator& b) { return !(a == b); }
+
+private:
+    Iterator current_;
+    Iterator last_;
+    difference_type count_;
+};
+
+/**
+ * The first count elements of a view (all of them if it has fewer). Over
+ * a random access view the iterators are the view's own.
+ */
+template <typename View>
+class take_view: public view_base {
+    typedef typename range_iterator<const View>::type base_iterator;
+    typedef typename std::iterator_traits<base_iterator>::difference_type difference_type;
+
+    View base_;
+    difference_type count_;
+
+    base_iterator begin(std::true_type) const { return base_.begin(); }
+    base_iterator end(std::true_type) const { return Hx::next_bounded(base_.begin(), count_, base_.end()); }
+    take_iterator<base_iterator> begin(std::false_type) const
+    {
+        return take_iterator<base_iterator>(base_.begin(), base_.end(), count_);
+    }
+    take_iterator<base_iterator> end(std::false_type) const
+    {
+        return take_iterator<base_iterator>(base_.end(), base_.end(), 0);
+    }
+
+public:
+    typedef typename std::conditional<is_random_access_iterator<base_iterator>::value,
+        base_iterator, take_iterator<base_iterator>>::type iterator;
+
+    take_view(View base, difference_type count): base_(std::move(base)), count_(std::max<difference_type>(count, 0)) {}
+
+    const View& base() const { return base_; }
+    difference_type count() const { return count_; }
+
+    iterator begin() const { return begin(is_random_access_iterator<base_iterator>()); }
+    iterator end() const { return end(is_random_access_iterator<base_iterator>()); }
+};
+
+template <typename View>
+take_view<View> make_take_view(View base, ptrdiff_t count)
+{
+    return take_view<View>(std::move(base), count);
+}
+
+/**
+ * take(n) of take(m) is take(min(n, m)).
+ */
+template <typename View>
+take_view<View> make_take_view(take_view<View> base, ptrdiff_t count)
+{
+    return take_view<View>(base.base(), std::min<ptrdiff_t>(base.count(), count));
+}
+
+namespace views {
+
+struct take_adaptor {
+    ptrdiff_t count;
+};
+
+/**
+ * take(range, count), or range | take(count)
+ */
+template <typename Range>
+auto take(Range&& range, ptrdiff_t count)
+    -> decltype(Hx::make_take_view(views::all(std::forward<Range>(range)), count))
+{
+    return Hx::make_take_view(views::all(std::forward<Range>(range)), count);
+}
+
+inline take_adaptor take(ptrdiff_t count)
+{
+    take_adaptor adaptor = { count };
+    return adaptor;
+}
+
+template <typename Range>
+auto operator|(Range&& range, take_adaptor adaptor)
+    -> decltype(views::take(std::forward<Range>(range), adaptor.count))
+{
+    return views::take(std::forward<Range>(range), adaptor.count);
+}
+
+}   // namespace views
+
+}   // namespace Hx
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "view.hpp"
+
+namespace Hx {
+
+/**
+ * fun(x) for every element x of a view, computed on dereference. The
+ * iterators keep the category of the view's (up to random access).
+ */
+template <typename View, typename Function>
+class transform_view: public view_base {
+    typedef typename range_iterator<const View>::type base_iterator;
+    typedef std::iterator_traits<base_iterator> base_traits;
+    typedef decltype(std::declval<const Function&>()(*std::declval<base_iterator>())) result_type;
+
+    View base_;
+    Function fun_;
+
+public:
+    class iterator: public iterator_adaptor<iterator, base_iterator,
+            typename common_category<typename base_traits::iterator_category, std::random_access_iterator_tag>::type,
+            typename std::decay<result_type>::type, result_type> {
+        typedef iterator_adaptor<iterator, base_iterator,
+            typename common_category<typename base_traits::iterator_category, std::random_access_iterator_tag>::type,
+            typename std::decay<result_type>::type, result_type> base_type;
+
+        const transform_view* parent_;
+
+    public:
+        iterator(): parent_(nullptr) {}
+        iterator(const transform_view* parent, base_iterator current): base_type(current), parent_(parent) {}
+
+        result_type operator*() const { return parent_->fun_(*this->current_); }
+    };
+
+    transform_view(View base, Function fun): base_(std::move(base)), fun_(std::move(fun)) {}
+
+    const View& base() const { return base_; }
+    const Function& fun() const { return fun_; }
+
+    iterator begin() const { return iterator(this, base_.begin()); }
+    iterator end() const { return iterator(this, base_.end()); }
+};
+
+/**
+ * fun2(fun1(x))
+ */
+template <typename Function1, typename Function2>
+struct composed_function {
+    Function1 fun1;
+    Function2 fun2;
+
+    template <typename T>
+    auto operator()(T&& x) const -> decltype(fun2(fun1(std::forward<T>(x))))
+    {
+        return fun2(fun1(std::forward<T>(x)));
+    }
+};
+
+template <typename View, typename Function>
+transform_view<View, Function> make_transform_view(View base, Function fun)
+{
+    return transform_view<View, Function>(std::move(base), std::move(fun));
+}
+
+/**
+ * A transform of a transform is one transform with the composed function.
+ */
+template <typename View, typename Function1, typename Function2>
+transform_view<View, composed_function<Function1, Function2>>
+make_transform_view(transform_view<View, Function1> base, Function2 fun)
+{
+    composed_function<Function1, Function2> both = { base.fun(), std::move(fun) };
+    return transform_view<View, composed_function<Function1, Function2>>(base.base(), std::move(both));
+}
+
+namespace views {
+
+template <typename Function>
+struct transform_adaptor {
+    Function fun;
+};
+
+/**
+ * transform(range, fun), or range | transform(fun)
+ */
+template <typename Range, typename Function>
+auto transform(Range&& range, Function fun)
+    -> decltype(Hx::make_transform_view(views::all(std::forward<Range>(range)), std::move(fun)))
+{
+    return Hx::make_transform_view(views::all(std::forward<Range>(range)), std::move(fun));
+}
+
+template <typename Function>
+transform_adaptor<Function> transform(Function fun)
+{
+    transform_adaptor<Function> adaptor = { std::move(fun) };
+    return adaptor;
+}
+
+template <typename Range, typename Function>
+auto operator|(Range&& range, const transform_adaptor<Function>& adaptor)
+    -> decltype(views::transform(std::forward<Range>(range), adaptor.fun))
+{
+    return views::transform(std::forward<Range>(range), adaptor.fun);
+}
+
+}   // namespace views
+
+}   // namespace Hx
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace Hx {
+
+/**
+ * Base class of the views
+ * A view is a range that is cheap to copy: it refers to the elements of
+ * another range, or computes them, instead of holding them. The begin()
+ * and end() of a view are const and may be called any number of times.
+ */
+struct view_base {};
+
+template <typename T>
+struct is_view: std::is_base_of<view_base, typename std::decay<T>::type> {};
+
+template <typename Range>
+struct range_iterator {
+    typedef decltype(std::begin(std::declval<Range&>())) type;
+};
+
+template <typename Range>
+struct range_traits: std::iterator_traits<typename range_iterator<Range>::type> {};
+
+/**
+ * The weaker of two iterator categories.
+ */
+template <typename Category1, typename Category2>
+struct common_category: std::conditional<std::is_base_of<Category1, Category2>::value,
+    Category1, Category2> {};
+
+template <typename Iterator>
+struct is_random_access_iterator: std::is_base_of<std::random_access_iterator_tag,
+    typename std::iterator_traits<Iterator>::iterator_category> {};
+
+/**
+ * Advances it by n, but not past last; O(1) for random access iterators.
+ */
+template <typename Iterator, typename Distance>
+Iterator next_bounded(Iterator it, Distance n, Iterator last, std::true_type)
+{
+    return (last - it > n) ? it + n : last;
+}
+
+template <typename Iterator, typename Distance>
+Iterator next_bounded(Iterator it, Distance n, Iterator last, std::false_type)
+{
+    for ( ; n > 0 && it != last; --n)
+        ++it;
+    return it;
+}
+
+template <typename Iterator, typename Distance>
+Iterator next_bounded(Iterator it, Distance n, Iterator last)
+{
+    return Hx::next_bounded(it, n, last, is_random_access_iterator<Iterator>());
+}
+
+/**
+ * Iterator pair
+ * Makes [first, last) a view, e.g. to pipe it into the adaptors.
+ */
+template <typename Iterator>
+class subrange: public view_base {
+    Iterator first_;
+    Iterator last_;
+
+public:
+    subrange(): first_(), last_() {}
+    subrange(Iterator first, Iterator last): first_(first), last_(last) {}
+
+    Iterator begin() const { return first_; }
+    Iterator end() const { return last_; }
+    bool empty() const { return first_ == last_; }
+};
+
+template <typename Iterator>
+subrange<Iterator> make_subrange(Iterator first, Iterator last)
+{
+    return subrange<Iterator>(first, last);
+}
+
+/**
+ * View of all the elements of a range that outlives it.
+ */
+template <typename Range>
+class ref_view: public view_base {
+    Range* range_;
+
+public:
+    explicit ref_view(Range& range): range_(&range) {}
+
+    typename range_iterator<Range>::type begin() const { return std::begin(*range_); }
+    typename range_iterator<Range>::type end() const { return std::end(*range_); }
+};
+
+/**
+ * View that owns a range moved into it, for a temporary container at the
+ * start of a pipeline. Its elements are read-only.
+ */
+template <typename Range>
+class owning_view: public view_base {
+    Range range_;
+
+public:
+    explicit owning_view(Range&& range): range_(std::move(range)) {}
+
+    typename range_iterator<const Range>::type begin() const { return std::begin(range_); }
+    typename range_iterator<const Range>::type end() const { return std::end(range_); }
+};
+
+namespace views {
+
+/**
+ * A view of range: a copy of it if it is a view already, a ref_view if it
+ * is an lvalue, an owning_view if it is an rvalue.
+ */
+template <typename Range>
+typename std::enable_if<is_view<Range>::value, typename std::decay<Range>::type>::type
+all(Range&& range)
+{
+    return std::forward<Range>(range);
+}
+
+template <typename Range>
+typename std::enable_if<!is_view<Range>::value && std::is_lvalue_reference<Range>::value,
+    ref_view<typename std::remove_reference<Range>::type>>::type
+all(Range&& range)
+{
+    return ref_view<typename std::remove_reference<Range>::type>(range);
+}
+
+template <typename Range>
+typename std::enable_if<!is_view<Range>::value && !std::is_lvalue_reference<Range>::value,
+    owning_view<Range>>::type
+all(Range&& range)
+{
+    return owning_view<Range>(std::move(range));
+}
+
+}   // namespace views
+
+template <typename Range>
+using all_t = decltype(views::all(std::declval<Range>()));
+
+/**
+ * Base class of the view iterators that wrap one iterator (or counter)
+ * of type Base: every operator but operator* moves or compares the Base.
+ * Derived only provides operator*, and the operators that differ.
+ */
+template <typename Derived, typename Base, typename Category, typename Value, typename Reference,
+          typename Difference = typename std::iterator_traits<Base>::difference_type>
+class iterator_adaptor {
+public:
+    typedef Category iterator_category;
+    typedef Value value_type;
+    typedef Difference difference_type;
+    typedef void pointer;
+    typedef Reference reference;
+
+    iterator_adaptor(): current_() {}
+    explicit iterator_adaptor(Base current): current_(current) {}
+
+    const Base& base() const { return current_; }
+
+    Derived& operator++() { ++current_; return derived(); }
+    Derived operator++(int) { Derived tmp(derived()); ++current_; return tmp; }
+    Derived& operator--() { --current_; return derived(); }
+    Derived operator--(int) { Derived tmp(derived()); --current_; return tmp; }
+
+    Derived& operator+=(difference_type n) { current_ += n; return derived(); }
+    Derived& operator-=(difference_type n) { current_ -= n; return derived(); }
+    Derived operator+(difference_type n) const { Derived tmp(derived()); tmp += n; return tmp; }
+    Derived operator-(difference_type n) const { Derived tmp(derived()); tmp -= n; return tmp; }
+    difference_type operator-(const Derived& other) const { return distance(current_, other.base(), std::is_arithmetic<Base>()); }
+    reference operator[](difference_type n) const { return *(derived() + n); }
+
+    friend Derived operator+(difference_type n, const Derived& it) { return it + n; }
+    friend bool operator==(const Derived& a, const Derived& b) { return a.base() == b.base(); }
+    friend bool operator!=(const Derived& a, const Derived& b) { return !(a.base() == b.base()); }
+    friend bool operator<(const Derived& a, const Derived& b) { return a.base() < b.base(); }
+    friend bool operator>(const Derived& a, const Derived& b) { return b.base() < a.base(); }
+    friend bool operator<=(const Derived& a, const Derived& b) { return !(b.base() < a.base()); }
+    friend bool operator>=(const Derived& a, const Derived& b) { return !(a.base() < b.base()); }
+
+protected:
+    // a counter is converted before subtracting: iota(first) ends at the
+    // largest T, which minus a negative first overflows in T
+    static difference_type distance(const Base& a, const Base& b, std::true_type) { return difference_type(a) - difference_type(b); }
+    static difference_type distance(const Base& a, const Base& b, std::false_type) { return difference_type(a - b); }
+
+    Derived& derived() { return static_cast<Derived&>(*this); }
+    const Derived& derived() const { return static_cast<const Derived&>(*this); }
+
+    Base current_;
+};
+
+}   // namespace Hx
@@ -0,0 +1,21 @@
+#pragma once
+
+/**
+ * Lazy views with pipe syntax, e.g.
+ *
+ *     auto r = v | Hx::views::filter(is_odd) | Hx::views::transform(square) | Hx::views::take(10);
+ *     Hx::accumulate(r.begin(), r.end(), 0);
+ *
+ * Every stage wraps the one before it: iterating r walks v once, and
+ * nothing is stored on the way. Adjacent filters, adjacent transforms,
+ * adjacent takes and adjacent drops fuse into a single stage.
+ */
+#include "view.hpp"
+#include "iota_view.hpp"
+#include "filter_view.hpp"
+#include "transform_view.hpp"
+#include "take_view.hpp"
+#include "drop_view.hpp"
+#include "chunk_view.hpp"
+#include "zip_view.hpp"
+#include "enumerate_view.hpp"
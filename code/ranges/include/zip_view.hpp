@@ -0,0 +1,77 @@
+#pragma once
+
+#include <iterator>
+#include <utility>
+#include "view.hpp"
+
+namespace Hx {
+
+/**
+ * The pairs (x1[i], x2[i]) of the elements of two views, as long as the
+ * shorter one. The pairs hold the views' references, so assigning to
+ * p.first or p.second writes through.
+ */
+template <typename View1, typename View2>
+class zip_view: public view_base {
+    typedef typename range_iterator<const View1>::type base_iterator1;
+    typedef typename range_iterator<const View2>::type base_iterator2;
+    typedef std::iterator_traits<base_iterator1> base_traits1;
+    typedef std::iterator_traits<base_iterator2> base_traits2;
+
+    View1 base1_;
+    View2 base2_;
+
+public:
+    /**
+     * Equal to another iterator as soon as either of its two iterators
+     * is: the end of the zip is where the shorter view ends.
+     */
+    class iterator {
+    public:
+        typedef typename common_category<
+            typename common_category<typename base_traits1::iterator_category,
+                typename base_traits2::iterator_category>::type,
+            std::forward_iterator_tag>::type iterator_category;
+        typedef std::pair<typename base_traits1::value_type, typename base_traits2::value_type> value_type;
+        typedef typename base_traits1::difference_type difference_type;
+        typedef void pointer;
+        typedef std::pair<typename base_traits1::reference, typename base_traits2::reference> reference;
+
+        iterator(): current1_(), current2_() {}
+        iterator(base_iterator1 current1, base_iterator2 current2): current1_(current1), current2_(current2) {}
+
+        reference operator*() const { return reference(*current1_, *current2_); }
+
+        iterator& operator++() { ++current1_; ++current2_; return *this; }
+        iterator operator++(int) { iterator tmp(*this); ++*this; return tmp; }
+
+        friend bool operator==(const iterator& a, const iterator& b)
+        {
+            return a.current1_ == b.current1_ || a.current2_ == b.current2_;
+        }
+
+        friend bool operator!=(const iterator& a, const iterator& b) { return !(a == b); }
+
+    private:
+        base_iterator1 current1_;
+        base_iterator2 current2_;
+    };
+
+    zip_view(View1 base1, View2 base2): base1_(std::move(base1)), base2_(std::move(base2)) {}
+
+    iterator begin() const { return iterator(base1_.begin(), base2_.begin()); }
+    iterator end() const { return iterator(base1_.end(), base2_.end()); }
+};
+
+namespace views {
+
+template <typename Range1, typename Range2>
+zip_view<all_t<Range1>, all_t<Range2>> zip(Range1&& range1, Range2&& range2)
+{
+    return zip_view<all_t<Range1>, all_t<Range2>>(
+        views::all(std::forward<Range1>(range1)), views::all(std::forward<Range2>(range2)));
+}
+
+}   // namespace views
+
+}   // namespace Hx
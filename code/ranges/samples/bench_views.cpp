@@ -0,0 +1,116 @@
+// A 5-stage pipeline (filter, transform, filter, transform, take) summed
+// with Hx::accumulate, over Hx::vector and Hx::list; see "bench.hpp" for
+// the options. "eager" stores every stage in a new Hx::vector, "views"
+// chains the lazy Hx::views, and "loop" is the same pipeline written by
+// hand as one loop.
+#include <random>
+#include "vector.hpp"
+#include "list.hpp"
+#include "views.hpp"
+#include "accumulate.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+struct is_odd {
+    bool operator()(long x) const { return x % 2 != 0; }
+};
+
+struct times_three_plus_one {
+    long operator()(long x) const { return 3 * x + 1; }
+};
+
+struct not_multiple_of_five {
+    bool operator()(long x) const { return x % 5 != 0; }
+};
+
+struct half {
+    long operator()(long x) const { return x / 2; }
+};
+
+template <typename Container>
+Container make_data(long n)
+{
+    std::mt19937 gen(n);
+    Container c;
+    for (long i = 0; i < n; i++)
+        c.push_back(long(gen() % 1000));
+    return c;
+}
+
+template <typename Container>
+long eager(const Container& c, long count)
+{
+    Hx::vector<long> a;
+    for (typename Container::const_iterator it = c.begin(); it != c.end(); ++it) {
+        if (is_odd()(*it))
+            a.push_back(*it);
+    }
+    Hx::vector<long> b;
+    for (size_t i = 0; i < a.size(); i++)
+        b.push_back(times_three_plus_one()(a[i]));
+    Hx::vector<long> d;
+    for (size_t i = 0; i < b.size(); i++) {
+        if (not_multiple_of_five()(b[i]))
+            d.push_back(b[i]);
+    }
+    Hx::vector<long> e;
+    for (size_t i = 0; i < d.size(); i++)
+        e.push_back(half()(d[i]));
+    Hx::vector<long> f(e.begin(), e.begin() + std::min<long>(count, e.size()));
+    return Hx::accumulate(f.begin(), f.end(), 0L);
+}
+
+template <typename Container>
+long lazy(const Container& c, long count)
+{
+    auto r = c
+        | Hx::views::filter(is_odd())
+        | Hx::views::transform(times_three_plus_one())
+        | Hx::views::filter(not_multiple_of_five())
+        | Hx::views::transform(half())
+        | Hx::views::take(count);
+    return Hx::accumulate(r.begin(), r.end(), 0L);
+}
+
+template <typename Container>
+long loop(const Container& c, long count)
+{
+    long sum = 0;
+    for (typename Container::const_iterator it = c.begin(); it != c.end() && count > 0; ++it) {
+        if (!is_odd()(*it))
+            continue;
+        long x = times_three_plus_one()(*it);
+        if (!not_multiple_of_five()(x))
+            continue;
+        sum += half()(x);
+        --count;
+    }
+    return sum;
+}
+
+template <typename Container, long (*Pipeline)(const Container&, long)>
+void run(state& st)
+{
+    Container c = make_data<Container>(st.arg());
+    while (st.keep_running())
+        do_not_optimize(Pipeline(c, st.arg() / 4));
+    st.set_items_per_iteration(st.arg());
+}
+
+template <typename Container>
+void add(Hx::bench::suite& s, const char* name)
+{
+    s.add(name, "eager", run<Container, eager<Container>>).args({1 << 10, 1 << 20});
+    s.add(name, "views", run<Container, lazy<Container>>).args({1 << 10, 1 << 20});
+    s.add(name, "loop", run<Container, loop<Container>>).args({1 << 10, 1 << 20});
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("views");
+    add<Hx::vector<long>>(s, "pipeline<vector>");
+    add<Hx::list<long>>(s, "pipeline<list>");
+    return s.run(argc, argv);
+}
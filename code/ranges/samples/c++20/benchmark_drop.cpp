@@ -0,0 +1,27 @@
+// drop view example
+#include <iostream>         // std::cout
+#include <vector>           // std::vector
+#include <ranges>           // std::views::drop
+
+int main () {
+  std::vector<int> myvector {10,20,30,40,50};
+
+  std::cout << "without the first two:";
+  for (int x : myvector | std::views::drop(2))
+    std::cout << ' ' << x;
+  std::cout << '\n';
+
+  std::cout << "without the first six:";
+  for (int x : myvector | std::views::drop(6))
+    std::cout << ' ' << x;
+  std::cout << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+without the first two: 30 40 50
+without the first six:
+*/
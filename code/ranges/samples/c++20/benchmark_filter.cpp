@@ -0,0 +1,30 @@
+// filter view example
+#include <iostream>         // std::cout
+#include <vector>           // std::vector
+#include <ranges>           // std::views::filter
+
+bool IsOdd (int i) { return ((i%2)==1); }
+
+int main () {
+  std::vector<int> myvector {1,2,3,4,5,6,7,8,9};
+
+  std::cout << "odd elements:";
+  for (int x : myvector | std::views::filter(IsOdd))
+    std::cout << ' ' << x;
+  std::cout << '\n';
+
+  // two filters in a row are fused into one:
+  std::cout << "odd elements above 4:";
+  for (int x : myvector | std::views::filter(IsOdd) | std::views::filter([](int i) { return i>4; }))
+    std::cout << ' ' << x;
+  std::cout << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+odd elements: 1 3 5 7 9
+odd elements above 4: 5 7 9
+*/
@@ -0,0 +1,44 @@
+// views pipeline example
+#include <iostream>         // std::cout
+#include <vector>           // std::vector
+#include <list>             // std::list
+#include <ranges>           // std::views
+#include <algorithm>        // std::find
+#include <numeric>          // std::accumulate
+
+int main () {
+  std::vector<int> myvector;
+  for (int i=1; i<=20; i++) myvector.push_back(i);
+
+  // squares of the odd elements, without the first, at most five:
+  auto r = myvector
+         | std::views::filter([](int i) { return i%2==1; })
+         | std::views::transform([](int i) { return i*i; })
+         | std::views::drop(1)
+         | std::views::take(5)
+         | std::views::common;
+
+  std::cout << "r:";
+  for (int x : r)
+    std::cout << ' ' << x;
+  std::cout << '\n';
+
+  // views work with the iterator-pair algorithms:
+  std::cout << "sum: " << std::accumulate(r.begin(), r.end(), 0) << '\n';
+  std::cout << "49 found: " << (std::find(r.begin(), r.end(), 49) != r.end()) << '\n';
+
+  // a temporary container is moved into the view:
+  auto big = std::list<int>{3,1,4,1,5,9,2,6} | std::views::filter([](int i) { return i>3; });
+  std::cout << "sum of big elements: " << std::accumulate(big.begin(), big.end(), 0) << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+r: 9 25 49 81 121
+sum: 285
+49 found: 1
+sum of big elements: 24
+*/
@@ -0,0 +1,33 @@
+// take view example
+#include <iostream>         // std::cout
+#include <list>             // std::list
+#include <ranges>           // std::views::iota, std::views::take
+
+int main () {
+  std::list<int> mylist {10,20,30,40,50};
+
+  std::cout << "first three:";
+  for (int x : mylist | std::views::take(3))
+    std::cout << ' ' << x;
+  std::cout << '\n';
+
+  std::cout << "first ten:";
+  for (int x : mylist | std::views::take(10))
+    std::cout << ' ' << x;
+  std::cout << '\n';
+
+  std::cout << "first five squares:";
+  for (int x : std::views::iota(1) | std::views::take(5))
+    std::cout << ' ' << x*x;
+  std::cout << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+first three: 10 20 30
+first ten: 10 20 30 40 50
+first five squares: 1 4 9 16 25
+*/
@@ -0,0 +1,28 @@
+// transform view example
+#include <iostream>         // std::cout
+#include <vector>           // std::vector
+#include <ranges>           // std::views::transform
+
+int op_increase (int i) { return ++i; }
+
+int main () {
+  std::vector<int> foo {10,20,30,40,50};
+
+  std::cout << "foo incremented:";
+  for (int x : foo | std::views::transform(op_increase))
+    std::cout << ' ' << x;
+  std::cout << '\n';
+
+  // the iterators are random access, like those of foo:
+  auto r = foo | std::views::transform(op_increase) | std::views::transform([](int i) { return i*2; });
+  std::cout << "size: " << (r.end()-r.begin()) << ", last: " << r.begin()[4] << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+foo incremented: 11 21 31 41 51
+size: 5, last: 102
+*/
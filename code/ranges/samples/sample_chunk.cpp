@@ -0,0 +1,25 @@
+// chunk view example
+#include <iostream>         // std::cout
+#include "vector.hpp"       // Hx::vector
+#include "chunk_view.hpp"   // Hx::views::chunk
+
+int main () {
+  Hx::vector<int> myvector {1,2,3,4,5,6,7,8};
+
+  for (auto chunk : myvector | Hx::views::chunk(3)) {
+    std::cout << '[';
+    for (int x : chunk)
+      std::cout << ' ' << x;
+    std::cout << " ]\n";
+  }
+
+  return 0;
+}
+
+/*
+Output:
+
+[ 1 2 3 ]
+[ 4 5 6 ]
+[ 7 8 ]
+*/
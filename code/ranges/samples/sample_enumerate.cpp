@@ -0,0 +1,22 @@
+// enumerate view example
+#include <iostream>             // std::cout
+#include "vector.hpp"           // Hx::vector
+#include "enumerate_view.hpp"   // Hx::views::enumerate
+
+int main () {
+  Hx::vector<char> letters {'A','B','C','D'};
+
+  for (auto p : letters | Hx::views::enumerate)
+    std::cout << p.first << ": " << p.second << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+0: A
+1: B
+2: C
+3: D
+*/
@@ -0,0 +1,22 @@
+// iota view example
+#include <iostream>         // std::cout
+#include "iota_view.hpp"    // Hx::views::iota
+
+int main () {
+  std::cout << "iota(1,10):";
+  for (int i : Hx::views::iota(1,10))
+    std::cout << ' ' << i;
+  std::cout << '\n';
+
+  Hx::iota_view<int> r = Hx::views::iota(0,5);
+  std::cout << "r[3] = " << r.begin()[3] << ", size = " << r.size() << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+iota(1,10): 1 2 3 4 5 6 7 8 9
+r[3] = 3, size = 5
+*/
@@ -0,0 +1,43 @@
+// views pipeline example
+#include <iostream>         // std::cout
+#include "vector.hpp"       // Hx::vector
+#include "list.hpp"         // Hx::list
+#include "views.hpp"        // Hx::views
+#include "find.hpp"         // Hx::find
+#include "accumulate.hpp"   // Hx::accumulate
+
+int main () {
+  Hx::vector<int> myvector;
+  for (int i=1; i<=20; i++) myvector.push_back(i);
+
+  // squares of the odd elements, without the first, at most five:
+  auto r = myvector
+         | Hx::views::filter([](int i) { return i%2==1; })
+         | Hx::views::transform([](int i) { return i*i; })
+         | Hx::views::drop(1)
+         | Hx::views::take(5);
+
+  std::cout << "r:";
+  for (int x : r)
+    std::cout << ' ' << x;
+  std::cout << '\n';
+
+  // views work with the iterator-pair algorithms:
+  std::cout << "sum: " << Hx::accumulate(r.begin(), r.end(), 0) << '\n';
+  std::cout << "49 found: " << (Hx::find(r.begin(), r.end(), 49) != r.end()) << '\n';
+
+  // a temporary container is moved into the view:
+  auto big = Hx::list<int>{3,1,4,1,5,9,2,6} | Hx::views::filter([](int i) { return i>3; });
+  std::cout << "sum of big elements: " << Hx::accumulate(big.begin(), big.end(), 0) << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+r: 9 25 49 81 121
+sum: 285
+49 found: 1
+sum of big elements: 24
+*/
@@ -0,0 +1,42 @@
+// take view example
+#include <iostream>         // std::cout
+#include <iterator>         // std::distance
+#include "list.hpp"         // Hx::list
+#include "iota_view.hpp"    // Hx::views::iota
+#include "take_view.hpp"    // Hx::views::take
+
+int main () {
+  Hx::list<int> mylist {10,20,30,40,50};
+
+  std::cout << "first three:";
+  for (int x : mylist | Hx::views::take(3))
+    std::cout << ' ' << x;
+  std::cout << '\n';
+
+  std::cout << "first ten:";
+  for (int x : mylist | Hx::views::take(10))
+    std::cout << ' ' << x;
+  std::cout << '\n';
+
+  std::cout << "first five squares:";
+  for (int x : Hx::views::iota(1) | Hx::views::take(5))
+    std::cout << ' ' << x*x;
+  std::cout << '\n';
+
+  std::cout << "from -10:";
+  auto neg = Hx::views::iota(-10) | Hx::views::take(5);
+  for (int x : neg)
+    std::cout << ' ' << x;
+  std::cout << " (" << std::distance(neg.begin(), neg.end()) << " elements)\n";
+
+  return 0;
+}
+
+/*
+Output:
+
+first three: 10 20 30
+first ten: 10 20 30 40 50
+first five squares: 1 4 9 16 25
+from -10: -10 -9 -8 -7 -6 (5 elements)
+*/
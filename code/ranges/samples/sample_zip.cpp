@@ -0,0 +1,34 @@
+// zip view example
+#include <iostream>         // std::cout
+#include <string>           // std::string
+#include "vector.hpp"       // Hx::vector
+#include "list.hpp"         // Hx::list
+#include "zip_view.hpp"     // Hx::views::zip
+
+int main () {
+  Hx::vector<std::string> names {"one","two","three","four"};
+  Hx::list<int> numbers {1,2,3};
+
+  for (auto p : Hx::views::zip(names, numbers))
+    std::cout << p.first << " = " << p.second << '\n';
+
+  // the pairs hold references:
+  for (auto p : Hx::views::zip(names, numbers))
+    p.second *= 10;
+
+  std::cout << "numbers:";
+  for (int x : numbers)
+    std::cout << ' ' << x;
+  std::cout << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+one = 1
+two = 2
+three = 3
+numbers: 10 20 30
+*/
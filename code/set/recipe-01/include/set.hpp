@@ -378,7 +378,7 @@ public:
     size_type erase(const value_type& val)
     {
         iterator it = find(val);
-        if (it = end())
+        if (it == end())
             return 0;
         erase(it);
         return 1;
@@ -176,16 +176,16 @@ bool tree_is_empty(const tree_t* tree)
  *        b   c             a   b
  */
 inline
-void tree_left_rotate(tree_t *tree, tree_node_t* x)
+void subtree_left_rotate(tree_node_t** root, tree_node_t* nil, tree_node_t* x)
 {
     tree_node_t* y = x->right;
     x->right = y->left;
-    if (y->left != &tree->nil) {
+    if (y->left != nil) {
         y->left->parent = x;
     }
     y->parent = x->parent;
-    if (x->parent == &tree->nil) {      // x是根节点
-        tree->root = y;
+    if (x->parent == nil) {             // x是根节点
+        *root = y;
     } else if (x == x->parent->left) {  // x是左子树
         x->parent->left = y;
     } else {                            // x是右子树
@@ -194,6 +194,12 @@ void tree_left_rotate(tree_t *tree, tree_node_t* x)
     y->left = x;
     x->parent = y;
 }
+
+inline
+void tree_left_rotate(tree_t *tree, tree_node_t* x)
+{
+    subtree_left_rotate(&tree->root, &tree->nil, x);
+}
     
 /**
  * 在节点x上做右旋
@@ -206,16 +212,16 @@ void tree_left_rotate(tree_t *tree, tree_node_t* x)
  *      a   b                 b   c
  */
 inline
-void tree_right_rotate(tree_t *tree, tree_node_t* x)
+void subtree_right_rotate(tree_node_t** root, tree_node_t* nil, tree_node_t* x)
 {
     tree_node_t* y = x->left;
     x->left = y->right;
-    if (y->right != &tree->nil) {
+    if (y->right != nil) {
         y->right->parent = x;
     }
     y->parent = x->parent;
-    if (x->parent == &tree->nil) {      // x是根节点
-        tree->root = y;
+    if (x->parent == nil) {             // x是根节点
+        *root = y;
     } else if (x == x->parent->left) {  // x是左子树
         x->parent->left = y;
     } else {                            // x是右子树
@@ -225,6 +231,12 @@ void tree_right_rotate(tree_t *tree, tree_node_t* x)
     x->parent = y;
 }
 
+inline
+void tree_right_rotate(tree_t *tree, tree_node_t* x)
+{
+    subtree_right_rotate(&tree->root, &tree->nil, x);
+}
+
 /**
  * 插入节点后恢复搜索树的红黑性质
  * ()  -> 红色节点
@@ -263,8 +275,9 @@ void tree_right_rotate(tree_t *tree, tree_node_t* x)
  *    /   \
  *   a     b
  */
+// 子树版本: 根节点由*root给出, 修复结束后根节点可能为红色, 由调用者处理
 inline
-void tree_insert_fixup(tree_t *tree, tree_node_t* z) 
+void subtree_insert_fixup(tree_node_t** root, tree_node_t* nil, tree_node_t* z) 
 {
     tree_node_t* y = NULL;
     while (z->parent->color == kRed) {
@@ -278,11 +291,11 @@ void tree_insert_fixup(tree_t *tree, tree_node_t* z)
             } else{
                 if (z == z->parent->right) {
                     z = z->parent;                 // Case 2
-                    tree_left_rotate(tree, z);     // Case 2
+                    subtree_left_rotate(root, nil, z);         // Case 2
                 }
                 z->parent->color = kBlack;                  // Case 3
                 z->parent->parent->color = kRed;            // Case 3
-                tree_right_rotate(tree, z->parent->parent); // Case 3
+                subtree_right_rotate(root, nil, z->parent->parent); // Case 3
             }
         } else {                                        // z的父节点为右子数
             y = z->parent->parent->left;
@@ -294,14 +307,20 @@ void tree_insert_fixup(tree_t *tree, tree_node_t* z)
             } else {
                 if (z == z->parent->left) {
                     z = z->parent;                 // Case 2
-                    tree_right_rotate(tree, z);    // Case 2
+                    subtree_right_rotate(root, nil, z);        // Case 2
                 }
                 z->parent->color = kBlack;                  // Case 3
                 z->parent->parent->color = kRed;            // Case 3
-                tree_left_rotate(tree, z->parent->parent);  // Case 3
+                subtree_left_rotate(root, nil, z->parent->parent);  // Case 3
             }
         }
     }
+}
+
+inline
+void tree_insert_fixup(tree_t *tree, tree_node_t* z) 
+{
+    subtree_insert_fixup(&tree->root, &tree->nil, z);
     tree->root->color = kBlack;
 }
 
@@ -541,6 +560,172 @@ void tree_delete(tree_t* tree, tree_node_t* z)
         tree_delete_fixup(tree, x);
 }
 
+/**
+ * 以下是基于join的整树操作, 参考 Blelloch, Ferizovic, Sun,
+ * "Just Join for Parallel Ordered Sets".
+ *
+ * 这些函数作用于独立的子树: 子树由根节点指针和黑高(bh)表示,
+ * 根节点为黑色(空树为nil, 黑高为0), 根节点的parent为nil.
+ * 所有子树共享同一个nil哨兵节点, 这些函数只读nil而从不修改它,
+ * 因此对互不相交的子树可以并发调用.
+ */
+
+// 返回以x为根的子树的黑高(不计nil)
+inline
+int tree_black_height(const tree_node_t* nil, const tree_node_t* x)
+{
+    int bh = 0;
+    for ( ; x != nil; x = x->left) {
+        if (x->color == kBlack)
+            ++bh;
+    }
+    return bh;
+}
+
+// 把x的孩子x->left(x->right)拆为独立子树, 根节点涂黑, 返回其黑高
+// bh为x所在子树的黑高(x为黑色的根)
+inline
+tree_node_t* tree_expose_child(tree_node_t* nil, tree_node_t* c, int bh, int* c_bh)
+{
+    if (c == nil) {
+        *c_bh = 0;
+        return nil;
+    }
+
+    c->parent = nil;
+    if (c->color == kRed) {
+        c->color = kBlack;
+        *c_bh = bh;
+    } else {
+        *c_bh = bh-1;
+    }
+    return c;
+}
+
+/**
+ * 以节点k连接子树l和r, 要求l中所有节点 < k < r中所有节点,
+ * 返回新子树的根, 新子树的黑高存入*bh.
+ * 时间复杂度O(|bh(l) - bh(r)| + 1).
+ *
+ * 若bh(l) > bh(r), 沿l的右脊下降到黑高等于bh(r)的黑色节点c,
+ * 用红色的k替换c, c成为k的左孩子, r成为k的右孩子, 然后做插入修复:
+ *
+ *            l                         l
+ *           / \                       /  *          .   .        =====>       .   .
+ *               \                          *                c                        (k)
+ *               / \                      /    *                                       c     r
+ */
+inline
+tree_node_t* tree_join(tree_node_t* nil, tree_node_t* l, int l_bh,
+        tree_node_t* k, tree_node_t* r, int r_bh, int* bh)
+{
+    if (l_bh == r_bh) {
+        k->parent = nil;
+        k->left = l;
+        k->right = r;
+        k->color = kBlack;
+        if (l != nil) l->parent = k;
+        if (r != nil) r->parent = k;
+        *bh = l_bh+1;
+        return k;
+    }
+
+    tree_node_t* root = NULL;
+    tree_node_t* p = NULL;
+    tree_node_t* c = NULL;
+    int h = 0;
+    if (l_bh > r_bh) {      // 沿l的右脊下降
+        root = l;
+        *bh = l_bh;
+        p = nil;
+        c = l;
+        h = l_bh;
+        while (h > r_bh || c->color == kRed) {
+            p = c;
+            c = c->right;
+            if (c->color == kBlack)
+                --h;
+        }
+        p->right = k;
+        k->left = c;
+        k->right = r;
+    } else {                // 沿r的左脊下降
+        root = r;
+        *bh = r_bh;
+        p = nil;
+        c = r;
+        h = r_bh;
+        while (h > l_bh || c->color == kRed) {
+            p = c;
+            c = c->left;
+            if (c->color == kBlack)
+                --h;
+        }
+        p->left = k;
+        k->left = l;
+        k->right = c;
+    }
+    k->parent = p;
+    k->color = kRed;
+    if (k->left != nil) k->left->parent = k;
+    if (k->right != nil) k->right->parent = k;
+
+    subtree_insert_fixup(&root, nil, k);
+    if (root->color == kRed) {
+        root->color = kBlack;
+        ++*bh;
+    }
+    return root;
+}
+
+/**
+ * 从子树t中摘下最大节点(返回值), 剩余部分的根存入*rest, 黑高存入*rest_bh.
+ * 时间复杂度O(log n).
+ */
+inline
+tree_node_t* tree_split_last(tree_node_t* nil, tree_node_t* t, int t_bh,
+        tree_node_t** rest, int* rest_bh)
+{
+    assert(t != nil);
+    int l_bh = 0, r_bh = 0;
+    tree_node_t* l = tree_expose_child(nil, t->left, t_bh, &l_bh);
+    tree_node_t* r = tree_expose_child(nil, t->right, t_bh, &r_bh);
+    if (r == nil) {
+        *rest = l;
+        *rest_bh = l_bh;
+        return t;
+    }
+
+    tree_node_t* r_rest = NULL;
+    int r_rest_bh = 0;
+    tree_node_t* last = tree_split_last(nil, r, r_bh, &r_rest, &r_rest_bh);
+    *rest = tree_join(nil, l, l_bh, t, r_rest, r_rest_bh, rest_bh);
+    return last;
+}
+
+/**
+ * 连接子树l和r(l中所有节点 < r中所有节点), 不需要中间节点.
+ * 时间复杂度O(log n).
+ */
+inline
+tree_node_t* tree_join2(tree_node_t* nil, tree_node_t* l, int l_bh,
+        tree_node_t* r, int r_bh, int* bh)
+{
+    if (l == nil) {
+        *bh = r_bh;
+        return r;
+    }
+    if (r == nil) {
+        *bh = l_bh;
+        return l;
+    }
+
+    tree_node_t* l_rest = NULL;
+    int l_rest_bh = 0;
+    tree_node_t* k = tree_split_last(nil, l, l_bh, &l_rest, &l_rest_bh);
+    return tree_join(nil, l_rest, l_rest_bh, k, r, r_bh, bh);
+}
+
 #ifdef __cplusplus
 } // namespace red_black
 } // namespace Hx
@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <limits>
+#include <future>
 #include <initializer_list>
 
 namespace Hx {
@@ -37,6 +38,7 @@ struct set_node: public red_black::tree_node_t {
 
 #include "set_iterator.hpp"
 #include "set_reverse_iterator.hpp"
+#include "set_node_handle.hpp"
 
 /**
  * Sets are containers that store unique elements following a specific order.
@@ -68,7 +70,9 @@ public:
     typedef set_const_reverse_iterator<const value_type> const_reverse_iterator;
     typedef ptrdiff_t difference_type;
     typedef size_t size_type;
-    typedef set_node<value_type> node_type;
+    typedef set_node<value_type> value_node_type;
+    typedef set_node_handle<value_type, node_alloc_type> node_type;
+    typedef set_insert_return_type<iterator, node_type> insert_return_type;
 
     /**
      * empty container constructors (default constructor)
@@ -312,7 +316,7 @@ public:
      */
     size_type max_size() const noexcept
     {
-        return std::numeric_limits<size_type>::max() / sizeof(node_type);
+        return std::numeric_limits<size_type>::max() / sizeof(value_node_type);
     }
 
     /**
@@ -362,6 +366,31 @@ public:
         insert(il.begin(), il.end());
     }
 
+    /**
+     * The node handle versions link the node owned by nh into the tree: no
+     * allocation and no copy of the value. If an equivalent element already
+     * exists, nh is left untouched (returned back in insert_return_type::node).
+     * nh must come from a set with an equal allocator.
+     */
+    insert_return_type insert(node_type&& nh)
+    {
+        if (nh.empty())
+            return insert_return_type{end(), false, node_type()};
+
+        assert(nh.alloc_ == node_alloc_);
+        std::pair<link_type*, bool> ret = insert(tree_, nh.ptr_);
+        if (ret.second) {
+            nh.release();
+            return insert_return_type{iterator(tree_, ret.first), true, node_type()};
+        }
+        return insert_return_type{iterator(tree_, ret.first), false, std::move(nh)};
+    }
+
+    iterator insert(const_iterator position, node_type&& nh)
+    {
+        return insert(std::move(nh)).position;
+    }
+
     /**
      * Erase elements
      * Removes from the set container either a single element or a range of elements ([first,last)).
@@ -380,7 +409,7 @@ public:
     size_type erase(const value_type& val)
     {
         iterator it = find(val);
-        if (it = end())
+        if (it == end())
             return 0;
         erase(it);
         return 1;
@@ -395,6 +424,56 @@ public:
         return iterator(tree_, last.link);
     }
 
+    /**
+     * Extract node
+     * Unlinks the node containing the element at position (or equivalent to val)
+     * and returns a node handle owning it; the node is not deallocated.
+     */
+    node_type extract(const_iterator position)
+    {
+        assert(position != end());
+        link_type *node = position.link;
+        tree_delete(tree_, node);
+        return node_type(static_cast<value_node_type*>(node), node_alloc_);
+    }
+
+    node_type extract(const value_type& val)
+    {
+        iterator it = find(val);
+        if (it == end())
+            return node_type();
+        return extract(it);
+    }
+
+    /**
+     * Splice nodes from another container
+     * Moves every node of source whose value is not already present in *this,
+     * relinking the nodes instead of reallocating them.
+     * Both sets must use equal allocators.
+     */
+    void merge(set& source)
+    {
+        if (this == &source)
+            return;
+
+        assert(node_alloc_ == source.node_alloc_);
+        tree_type* src = source.tree_;
+        link_type* link = tree_minimum(src, src->root);
+        while (link != &src->nil) {
+            link_type* next = tree_successor(src, link);
+            if (find(tree_, get_value(link)) == &tree_->nil) {
+                tree_delete(src, link);
+                insert(tree_, link);
+            }
+            link = next;
+        }
+    }
+
+    void merge(set&& source)
+    {
+        merge(source);
+    }
+
     /**
      * Swap content
      * Exchanges the content of the container by the content of x, which is another set of the same type. Sizes may differ.
@@ -471,6 +550,24 @@ public:
         return iterator(tree_, find(tree_, val));
     }
 
+    /**
+     * Heterogeneous versions: only available when key_compare::is_transparent
+     * names a type, in which case x may be any type comparable with value_type
+     * (e.g. a string_view probe against std::string elements, without building
+     * a temporary std::string).
+     */
+    template <typename K, typename C = key_compare, typename = typename C::is_transparent>
+    const_iterator find(const K& x) const
+    {
+        return const_iterator(tree_, find(tree_, x));
+    }
+
+    template <typename K, typename C = key_compare, typename = typename C::is_transparent>
+    iterator find(const K& x)
+    {
+        return iterator(tree_, find(tree_, x));
+    }
+
     /**
      * Count elements with a specific value
      * Searches the container for elements equivalent to val and returns the number of matches.
@@ -480,6 +577,12 @@ public:
         return find(tree_, val) == &tree_->nil ? 0 : 1;
     }
 
+    template <typename K, typename C = key_compare, typename = typename C::is_transparent>
+    size_type count(const K& x) const
+    {
+        return find(tree_, x) == &tree_->nil ? 0 : 1;
+    }
+
     /**
      * Return iterator to lower bound
      * Returns an iterator pointing to the first element in the container which is not considered to go before val (i.e., either it is equivalent or goes after).
@@ -494,6 +597,18 @@ public:
         return const_iterator(tree_, lower_bound(tree_, val));
     }
 
+    template <typename K, typename C = key_compare, typename = typename C::is_transparent>
+    iterator lower_bound(const K& x)
+    {
+        return iterator(tree_, lower_bound(tree_, x));
+    }
+
+    template <typename K, typename C = key_compare, typename = typename C::is_transparent>
+    const_iterator lower_bound(const K& x) const
+    {
+        return const_iterator(tree_, lower_bound(tree_, x));
+    }
+
     /**
      * Return iterator to upper bound
      * Returns an iterator pointing to the first element in the container which is considered to go after val.
@@ -508,6 +623,18 @@ public:
         return const_iterator(tree_, upper_bound(tree_, val));
     }
 
+    template <typename K, typename C = key_compare, typename = typename C::is_transparent>
+    iterator upper_bound(const K& x)
+    {
+        return iterator(tree_, upper_bound(tree_, x));
+    }
+
+    template <typename K, typename C = key_compare, typename = typename C::is_transparent>
+    const_iterator upper_bound(const K& x) const
+    {
+        return const_iterator(tree_, upper_bound(tree_, x));
+    }
+
     /**
      * Get range of equal elements
      * Returns the bounds of a range that includes all the elements in the container that are equivalent to val.
@@ -526,6 +653,103 @@ public:
         return std::make_pair(const_iterator(tree_, ret.first), const_iterator(tree_, ret.second));
     }
 
+    template <typename K, typename C = key_compare, typename = typename C::is_transparent>
+    std::pair<iterator,iterator> equal_range(const K& x)
+    {
+        auto ret = equal_range(tree_, x);
+        return std::make_pair(iterator(tree_, ret.first), iterator(tree_, ret.second));
+    }
+
+    template <typename K, typename C = key_compare, typename = typename C::is_transparent>
+    std::pair<const_iterator,const_iterator> equal_range(const K& x) const
+    {
+        auto ret = equal_range(tree_, x);
+        return std::make_pair(const_iterator(tree_, ret.first), const_iterator(tree_, ret.second));
+    }
+
+    /**
+     * Union / intersection / difference with another set
+     * Replaces the content with (*this | x), (*this & x) or (*this - x), using
+     * the join/split primitives of the red-black tree: no node is allocated,
+     * nodes of x are relinked into *this (or destroyed), and the work is
+     * O(m log(n/m + 1)) for sets of sizes m <= n, instead of O(m log n) for
+     * element-by-element insertion.
+     *
+     * The rvalue versions consume x (left empty); the const versions work on a copy of x.
+     * The two sub-problems of every step are independent: with threads > 1 the
+     * top log2(threads) levels of the recursion run in parallel.
+     * Both sets must use equal allocators.
+     */
+    void set_union(set&& x, unsigned threads = 1)
+    {
+        if (this == &x)
+            return;
+
+        link_type* nil = &tree_->nil;
+        link_type* t2 = adopt(x);
+        int bh = 0;
+        link_type* root = union_tree(nil, tree_->root, tree_black_height(nil, tree_->root),
+            t2, tree_black_height(nil, t2), fork_depth(threads), &bh);
+        set_root(root);
+    }
+
+    void set_union(const set& x, unsigned threads = 1)
+    {
+        if (this == &x)
+            return;
+
+        set tmp(x, get_allocator());
+        set_union(std::move(tmp), threads);
+    }
+
+    void set_intersection(set&& x, unsigned threads = 1)
+    {
+        if (this == &x)
+            return;
+
+        link_type* nil = &tree_->nil;
+        link_type* t2 = adopt(x);
+        int bh = 0;
+        link_type* root = intersection_tree(nil, tree_->root, tree_black_height(nil, tree_->root),
+            t2, tree_black_height(nil, t2), fork_depth(threads), &bh);
+        set_root(root);
+    }
+
+    void set_intersection(const set& x, unsigned threads = 1)
+    {
+        if (this == &x)
+            return;
+
+        set tmp(x, get_allocator());
+        set_intersection(std::move(tmp), threads);
+    }
+
+    void set_difference(set&& x, unsigned threads = 1)
+    {
+        if (this == &x) {
+            clear();
+            return;
+        }
+
+        link_type* nil = &tree_->nil;
+        link_type* t2 = adopt(x);
+        int bh = 0;
+        link_type* root = difference_tree(nil, tree_->root, tree_black_height(nil, tree_->root),
+            t2, tree_black_height(nil, t2), fork_depth(threads), &bh);
+        set_root(root);
+    }
+
+    void set_difference(const set& x, unsigned threads = 1)
+    {
+        if (this == &x) {
+            clear();
+            return;
+        }
+
+        set tmp(x, get_allocator());
+        set_difference(std::move(tmp), threads);
+    }
+
     /**
      * Get allocator
      * Returns a copy of the allocator object associated with the set.
@@ -538,15 +762,15 @@ public:
 private:
     const value_type& get_value(link_type* node) const
     {
-        return *static_cast<node_type*>(node)->valptr();
+        return *static_cast<value_node_type*>(node)->valptr();
     }
 
-    node_type* get_node()
+    value_node_type* get_node()
     {
         return node_alloc_.allocate(1);
     }
 
-    void put_node(node_type* node)
+    void put_node(value_node_type* node)
     {
         node_alloc_.deallocate(node, 1);
     }
@@ -554,7 +778,7 @@ private:
     template <typename ...Args>
     link_type* create_node(Args&&... args)
     {
-        node_type* node = get_node();
+        value_node_type* node = get_node();
         tree_node_init(node);
         try
         {
@@ -570,7 +794,7 @@ private:
 
     void destroy_node(link_type* link)
     {
-        node_type* node = static_cast<node_type*>(link);
+        value_node_type* node = static_cast<value_node_type*>(link);
         node->valptr()->~T();
         node_alloc_.deallocate(node, 1);
     }
@@ -629,11 +853,12 @@ private:
         return std::make_pair(z, true);
     }
 
-    link_type* find(tree_type* tree, const value_type& val) const 
+    template <typename K>
+    link_type* find(tree_type* tree, const K& val) const 
     {
         link_type* x = tree->root;
         while (x != &tree->nil) {
-            const value_type& x_val = *static_cast<node_type*>(x)->valptr();
+            const value_type& x_val = *static_cast<value_node_type*>(x)->valptr();
             if (less_(val, x_val)) {        // val < x->val
                 x = x->left;
             } else if (less_(x_val, val)) { // x->val < val
@@ -645,7 +870,8 @@ private:
         return x;
     }
 
-    link_type* lower_bound(tree_type* tree, const value_type& val) const 
+    template <typename K>
+    link_type* lower_bound(tree_type* tree, const K& val) const 
     {
         link_type* y = &tree->nil;
         link_type* x = tree->root;
@@ -661,14 +887,15 @@ private:
             }
         }
 
-        if (less_(get_value(y), val)) {
+        if (y != &tree->nil && less_(get_value(y), val)) {
             return tree_successor(tree, y);
         } else {
             return y;
         }
     }
 
-    link_type* upper_bound(tree_type* tree, const value_type& val) const 
+    template <typename K>
+    link_type* upper_bound(tree_type* tree, const K& val) const 
     {
         link_type* y = &tree->nil;
         link_type* x = tree->root;
@@ -684,14 +911,15 @@ private:
             }
         }
 
-        if (less_(get_value(y), val)) {
+        if (y != &tree->nil && less_(get_value(y), val)) {
             return tree_successor(tree, y);
         } else {
             return y;
         }
     }
 
-    std::pair<link_type*,link_type*> equal_range(tree_type* tree, const value_type& val) const
+    template <typename K>
+    std::pair<link_type*,link_type*> equal_range(tree_type* tree, const K& val) const
     {
         link_type* y = &tree->nil;
         link_type* x = tree->root;
@@ -707,7 +935,7 @@ private:
             }
         }
 
-        if (less_(get_value(y), val)) {
+        if (y != &tree->nil && less_(get_value(y), val)) {
             link_type *z = tree_successor(tree, y);
             return std::make_pair(z, z);
         } else {
@@ -715,6 +943,185 @@ private:
         }
     }
 
+    // relink every node of x to this tree's nil, leaving x empty,
+    // returns the root of x's nodes as a subtree of this tree
+    link_type* adopt(set& x)
+    {
+        link_type* root = x.tree_->root;
+        adopt_tree(root, &x.tree_->nil, &tree_->nil);
+        if (root != &x.tree_->nil) {
+            root->parent = &tree_->nil;
+        } else {
+            root = &tree_->nil;
+        }
+        x.tree_->root = &x.tree_->nil;
+        return root;
+    }
+
+    void adopt_tree(link_type* root, link_type* old_nil, link_type* new_nil)
+    {
+        if (root == old_nil)
+            return;
+
+        if (root->left == old_nil) root->left = new_nil; else adopt_tree(root->left, old_nil, new_nil);
+        if (root->right == old_nil) root->right = new_nil; else adopt_tree(root->right, old_nil, new_nil);
+    }
+
+    void set_root(link_type* root)
+    {
+        tree_->root = root;
+        if (root != &tree_->nil) {
+            root->parent = &tree_->nil;
+            root->color = red_black::tree_node_color_t::kBlack;
+        }
+    }
+
+    static int fork_depth(unsigned threads)
+    {
+        int depth = 0;
+        while (depth < 16 && (1u << depth) < threads)
+            ++depth;
+        return depth;
+    }
+
+    /**
+     * Split subtree t by val into l (< val) and r (> val),
+     * returns the node equivalent to val (detached) or nullptr.
+     */
+    link_type* split_tree(link_type* nil, link_type* t, int t_bh, const value_type& val,
+            link_type** l, int* l_bh, link_type** r, int* r_bh)
+    {
+        if (t == nil) {
+            *l = *r = nil;
+            *l_bh = *r_bh = 0;
+            return nullptr;
+        }
+
+        int a_bh = 0, b_bh = 0;
+        link_type* a = tree_expose_child(nil, t->left, t_bh, &a_bh);
+        link_type* b = tree_expose_child(nil, t->right, t_bh, &b_bh);
+        const value_type& t_val = get_value(t);
+        if (less_(val, t_val)) {            // val < t->val
+            link_type* m = nullptr;
+            int m_bh = 0;
+            link_type* found = split_tree(nil, a, a_bh, val, l, l_bh, &m, &m_bh);
+            *r = tree_join(nil, m, m_bh, t, b, b_bh, r_bh);
+            return found;
+        } else if (less_(t_val, val)) {     // t->val < val
+            link_type* m = nullptr;
+            int m_bh = 0;
+            link_type* found = split_tree(nil, b, b_bh, val, &m, &m_bh, r, r_bh);
+            *l = tree_join(nil, a, a_bh, t, m, m_bh, l_bh);
+            return found;
+        } else {    // val == t->val
+            *l = a; *l_bh = a_bh;
+            *r = b; *r_bh = b_bh;
+            return t;
+        }
+    }
+
+    // run f1 and f2, in parallel if depth > 0
+    template <typename F1, typename F2>
+    static void fork_join(int depth, F1 f1, F2 f2)
+    {
+        if (depth > 0) {
+            std::future<void> left = std::async(std::launch::async, f1);
+            f2();
+            left.get();
+        } else {
+            f1();
+            f2();
+        }
+    }
+
+    link_type* union_tree(link_type* nil, link_type* t1, int t1_bh,
+            link_type* t2, int t2_bh, int depth, int* bh)
+    {
+        if (t1 == nil) {
+            *bh = t2_bh;
+            return t2;
+        }
+        if (t2 == nil) {
+            *bh = t1_bh;
+            return t1;
+        }
+
+        int l1_bh = 0, r1_bh = 0, l2_bh = 0, r2_bh = 0;
+        link_type* l1 = tree_expose_child(nil, t1->left, t1_bh, &l1_bh);
+        link_type* r1 = tree_expose_child(nil, t1->right, t1_bh, &r1_bh);
+        link_type* l2 = nullptr;
+        link_type* r2 = nullptr;
+        link_type* dup = split_tree(nil, t2, t2_bh, get_value(t1), &l2, &l2_bh, &r2, &r2_bh);
+        if (dup) destroy_node(dup);
+
+        link_type* l = nullptr;
+        link_type* r = nullptr;
+        int l_bh = 0, r_bh = 0;
+        fork_join(depth,
+            [&]() { l = union_tree(nil, l1, l1_bh, l2, l2_bh, depth-1, &l_bh); },
+            [&]() { r = union_tree(nil, r1, r1_bh, r2, r2_bh, depth-1, &r_bh); });
+        return tree_join(nil, l, l_bh, t1, r, r_bh, bh);
+    }
+
+    link_type* intersection_tree(link_type* nil, link_type* t1, int t1_bh,
+            link_type* t2, int t2_bh, int depth, int* bh)
+    {
+        if (t1 == nil || t2 == nil) {
+            destroy_tree(t1, nil);
+            destroy_tree(t2, nil);
+            *bh = 0;
+            return nil;
+        }
+
+        int l1_bh = 0, r1_bh = 0, l2_bh = 0, r2_bh = 0;
+        link_type* l1 = tree_expose_child(nil, t1->left, t1_bh, &l1_bh);
+        link_type* r1 = tree_expose_child(nil, t1->right, t1_bh, &r1_bh);
+        link_type* l2 = nullptr;
+        link_type* r2 = nullptr;
+        link_type* dup = split_tree(nil, t2, t2_bh, get_value(t1), &l2, &l2_bh, &r2, &r2_bh);
+
+        link_type* l = nullptr;
+        link_type* r = nullptr;
+        int l_bh = 0, r_bh = 0;
+        fork_join(depth,
+            [&]() { l = intersection_tree(nil, l1, l1_bh, l2, l2_bh, depth-1, &l_bh); },
+            [&]() { r = intersection_tree(nil, r1, r1_bh, r2, r2_bh, depth-1, &r_bh); });
+        if (dup) {
+            destroy_node(dup);
+            return tree_join(nil, l, l_bh, t1, r, r_bh, bh);
+        } else {
+            destroy_node(t1);
+            return tree_join2(nil, l, l_bh, r, r_bh, bh);
+        }
+    }
+
+    link_type* difference_tree(link_type* nil, link_type* t1, int t1_bh,
+            link_type* t2, int t2_bh, int depth, int* bh)
+    {
+        if (t1 == nil || t2 == nil) {
+            destroy_tree(t2, nil);
+            *bh = t1_bh;
+            return t1;
+        }
+
+        int l1_bh = 0, r1_bh = 0, l2_bh = 0, r2_bh = 0;
+        link_type* l2 = tree_expose_child(nil, t2->left, t2_bh, &l2_bh);
+        link_type* r2 = tree_expose_child(nil, t2->right, t2_bh, &r2_bh);
+        link_type* l1 = nullptr;
+        link_type* r1 = nullptr;
+        link_type* found = split_tree(nil, t1, t1_bh, get_value(t2), &l1, &l1_bh, &r1, &r1_bh);
+        if (found) destroy_node(found);
+        destroy_node(t2);
+
+        link_type* l = nullptr;
+        link_type* r = nullptr;
+        int l_bh = 0, r_bh = 0;
+        fork_join(depth,
+            [&]() { l = difference_tree(nil, l1, l1_bh, l2, l2_bh, depth-1, &l_bh); },
+            [&]() { r = difference_tree(nil, r1, r1_bh, r2, r2_bh, depth-1, &r_bh); });
+        return tree_join2(nil, l, l_bh, r, r_bh, bh);
+    }
+
     link_type* clone_tree(tree_type* tree, link_type* root, link_type* new_nil) 
     {
         if (root == &tree->nil)
@@ -733,7 +1140,7 @@ private:
             right = clone_tree(tree, root->right, new_nil);
 
             // clone root node
-            node = create_node(*static_cast<const node_type*>(root)->valptr());
+            node = create_node(*static_cast<const value_node_type*>(root)->valptr());
             node->color = root->color;
             node->parent = new_nil;
             tree_set_left_child(node, left);
@@ -768,7 +1175,7 @@ private:
             right = move_tree(tree, root->right, new_nil);
 
             // move root node
-            node = create_node(std::move(*static_cast<const node_type*>(root)->valptr()));
+            node = create_node(std::move(*static_cast<const value_node_type*>(root)->valptr()));
             node->color = root->color;
             node->parent = new_nil;
             tree_set_left_child(node, left);
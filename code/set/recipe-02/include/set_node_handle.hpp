@@ -0,0 +1,102 @@
+/**
+ * A set::node_type.
+ * Owns a node extracted from a set, so that it can be re-inserted into
+ * another set (or the same one) without reallocating or copying the value.
+ */
+template <typename T, typename NodeAlloc>
+class set_node_handle {
+    typedef set_node<T> node_type;
+
+    node_type* ptr_ = nullptr;
+    NodeAlloc alloc_;
+
+public:
+    typedef T value_type;
+    typedef typename NodeAlloc::template rebind<T>::other allocator_type;
+
+    set_node_handle() = default;
+
+    set_node_handle(set_node_handle&& nh) noexcept: ptr_(nh.ptr_), alloc_(std::move(nh.alloc_))
+    {
+        nh.ptr_ = nullptr;
+    }
+
+    set_node_handle& operator=(set_node_handle&& nh)
+    {
+        if (this == &nh)
+            return *this;
+
+        reset();
+        ptr_ = nh.ptr_;
+        alloc_ = std::move(nh.alloc_);
+        nh.ptr_ = nullptr;
+        return *this;
+    }
+
+    ~set_node_handle()
+    {
+        reset();
+    }
+
+    bool empty() const noexcept
+    {
+        return ptr_ == nullptr;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return ptr_ != nullptr;
+    }
+
+    value_type& value() const
+    {
+        assert(!empty());
+        return *ptr_->valptr();
+    }
+
+    allocator_type get_allocator() const
+    {
+        return allocator_type(alloc_);
+    }
+
+    void swap(set_node_handle& nh)
+    {
+        using std::swap;
+        swap(ptr_, nh.ptr_);
+        swap(alloc_, nh.alloc_);
+    }
+
+private:
+    template <typename, typename, typename> friend class set;
+
+    set_node_handle(node_type* ptr, const NodeAlloc& alloc): ptr_(ptr), alloc_(alloc) {}
+
+    node_type* release() noexcept
+    {
+        node_type* ptr = ptr_;
+        ptr_ = nullptr;
+        return ptr;
+    }
+
+    void reset()
+    {
+        if (ptr_ == nullptr)
+            return;
+
+        allocator_type alloc(alloc_);
+        std::allocator_traits<allocator_type>::destroy(alloc, ptr_->valptr());
+        std::allocator_traits<NodeAlloc>::deallocate(alloc_, ptr_, 1);
+        ptr_ = nullptr;
+    }
+};
+
+/**
+ * Return type of set::insert(node_type&&).
+ */
+template <typename Iterator, typename NodeType>
+struct set_insert_return_type {
+    Iterator position;
+    bool inserted;
+    NodeType node;
+};
+
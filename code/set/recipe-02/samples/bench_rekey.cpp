@@ -0,0 +1,59 @@
+// Re-keying every element of a set: erase + insert (one free and one
+// allocation per element) against extract + insert(node_type&&), which
+// reuses the node ("Hx_extract"); see "bench.hpp" for the options. The
+// argument is the number of elements; every iteration moves all of them
+// n keys up, so that re-keyed elements never collide with pending ones.
+#include <set>
+#include "set.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+template <typename Set>
+void erase_insert(state& st)
+{
+    const long n = st.arg();
+    Set s;
+    for (long i = 0; i < n; i++)
+        s.insert(i);
+    long base = 0;
+    while (st.keep_running()) {
+        for (long i = base; i < base+n; i++) {
+            s.erase(s.find(i));
+            s.insert(i+n);
+        }
+        base += n;
+    }
+    do_not_optimize(s);
+    st.set_items_per_iteration(n);
+}
+
+void extract_insert(state& st)
+{
+    typedef Hx::set<long> set_type;
+    const long n = st.arg();
+    set_type s;
+    for (long i = 0; i < n; i++)
+        s.insert(i);
+    long base = 0;
+    while (st.keep_running()) {
+        for (long i = base; i < base+n; i++) {
+            set_type::node_type nh = s.extract(i);
+            nh.value() = i+n;
+            s.insert(std::move(nh));
+        }
+        base += n;
+    }
+    do_not_optimize(s);
+    st.set_items_per_iteration(n);
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("rekey");
+    s.add("rekey", "std", erase_insert<std::set<long>>).args({1000, 100000});
+    s.add("rekey", "Hx", erase_insert<Hx::set<long>>).args({1000, 100000});
+    s.add("rekey", "Hx_extract", extract_insert).args({1000, 100000});
+    return s.run(argc, argv);
+}
@@ -0,0 +1,87 @@
+// Hx::set against std::set; see "bench.hpp" for the options.
+#include <set>
+#include <vector>
+#include "set.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+// n distinct keys in pseudo random order
+std::vector<int> make_keys(long n)
+{
+    std::vector<int> keys(n);
+    for (long i = 0; i < n; i++)
+        keys[i] = int((i * 2654435761u) % 4294967291u);
+    return keys;
+}
+
+template <typename Set>
+void insert(state& st)
+{
+    std::vector<int> keys = make_keys(st.arg());
+    while (st.keep_running()) {
+        Set s;
+        for (size_t i = 0; i < keys.size(); i++)
+            s.insert(keys[i]);
+        do_not_optimize(s);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+template <typename Set>
+void find(state& st)
+{
+    std::vector<int> keys = make_keys(st.arg());
+    Set s(keys.begin(), keys.end());
+    while (st.keep_running()) {
+        size_t found = 0;
+        for (size_t i = 0; i < keys.size(); i++)
+            found += (s.find(keys[i]) != s.end());
+        do_not_optimize(found);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+template <typename Set>
+void iterate(state& st)
+{
+    std::vector<int> keys = make_keys(st.arg());
+    Set s(keys.begin(), keys.end());
+    while (st.keep_running()) {
+        int sum = 0;
+        for (auto it = s.begin(); it != s.end(); ++it)
+            sum += *it;
+        do_not_optimize(sum);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+template <typename Set>
+void erase(state& st)
+{
+    std::vector<int> keys = make_keys(st.arg());
+    while (st.keep_running()) {
+        st.pause_timing();
+        Set s(keys.begin(), keys.end());
+        st.resume_timing();
+        for (size_t i = 0; i < keys.size(); i++)
+            s.erase(keys[i]);
+        do_not_optimize(s);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("set");
+    s.add("insert", "std", insert<std::set<int>>).args({1000, 100000});
+    s.add("insert", "Hx", insert<Hx::set<int>>).args({1000, 100000});
+    s.add("find", "std", find<std::set<int>>).args({1000, 100000});
+    s.add("find", "Hx", find<Hx::set<int>>).args({1000, 100000});
+    s.add("iterate", "std", iterate<std::set<int>>).args({1000, 100000});
+    s.add("iterate", "Hx", iterate<Hx::set<int>>).args({1000, 100000});
+    s.add("erase", "std", erase<std::set<int>>).args({1000, 100000});
+    s.add("erase", "Hx", erase<Hx::set<int>>).args({1000, 100000});
+    return s.run(argc, argv);
+}
@@ -0,0 +1,111 @@
+// The join-based bulk operations of Hx::set against element-by-element
+// insert and erase; see "bench.hpp" for the options. A set of 100000 keys
+// takes the argument's number of keys in and out again: "add" times
+// putting them in, "remove" taking them out, and the other half of every
+// iteration is not timed. The keys added are odd and those of the big set
+// even, so that every iteration leaves the big set as it found it.
+#include <vector>
+#include "set.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+typedef Hx::set<long> set_type;
+
+const long big_size = 100000;
+
+// n distinct keys in pseudo random order, all even or all odd
+std::vector<long> make_keys(long n, long parity)
+{
+    std::vector<long> keys(n);
+    for (long i = 0; i < n; i++)
+        keys[i] = 2 * long((i * 2654435761u) % 4294967291u) + parity;
+    return keys;
+}
+
+struct fixture {
+    std::vector<long> big_keys = make_keys(big_size, 0);
+    std::vector<long> small_keys;
+    set_type big;
+    set_type small;
+
+    explicit fixture(long m): small_keys(make_keys(m, 1)),
+        big(big_keys.begin(), big_keys.end()), small(small_keys.begin(), small_keys.end()) {}
+};
+
+void add_insert(state& st)
+{
+    fixture f(st.arg());
+    while (st.keep_running()) {
+        f.big.insert(f.small.begin(), f.small.end());
+        st.pause_timing();
+        f.big.set_difference(f.small);
+        st.resume_timing();
+    }
+    do_not_optimize(f.big);
+    st.set_items_per_iteration(st.arg());
+}
+
+template <unsigned Threads>
+void add_union(state& st)
+{
+    fixture f(st.arg());
+    while (st.keep_running()) {
+        st.pause_timing();
+        set_type x(f.small);
+        st.resume_timing();
+        f.big.set_union(std::move(x), Threads);
+        st.pause_timing();
+        f.big.set_difference(f.small);
+        st.resume_timing();
+    }
+    do_not_optimize(f.big);
+    st.set_items_per_iteration(st.arg());
+}
+
+void remove_erase(state& st)
+{
+    fixture f(st.arg());
+    f.big.set_union(f.small);
+    while (st.keep_running()) {
+        for (auto it = f.small.begin(); it != f.small.end(); ++it) {
+            auto pos = f.big.find(*it);
+            if (pos != f.big.end())
+                f.big.erase(pos);
+        }
+        st.pause_timing();
+        f.big.set_union(f.small);
+        st.resume_timing();
+    }
+    do_not_optimize(f.big);
+    st.set_items_per_iteration(st.arg());
+}
+
+void remove_difference(state& st)
+{
+    fixture f(st.arg());
+    f.big.set_union(f.small);
+    while (st.keep_running()) {
+        st.pause_timing();
+        set_type x(f.small);
+        st.resume_timing();
+        f.big.set_difference(std::move(x));
+        st.pause_timing();
+        f.big.set_union(f.small);
+        st.resume_timing();
+    }
+    do_not_optimize(f.big);
+    st.set_items_per_iteration(st.arg());
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("set_operations");
+    s.add("add", "insert", add_insert).args({100000, 10000, 1000, 100});
+    s.add("add", "set_union", add_union<1>).args({100000, 10000, 1000, 100});
+    s.add("add", "set_union/4", add_union<4>).args({100000, 10000, 1000, 100});
+    s.add("remove", "erase", remove_erase).args({100000, 10000, 1000, 100});
+    s.add("remove", "set_difference", remove_difference).args({100000, 10000, 1000, 100});
+    return s.run(argc, argv);
+}
@@ -0,0 +1,74 @@
+// String-keyed lookups with string_view probes: materializing a
+// std::string per probe against transparent lookup (the "_transparent"
+// impls, with std::less<>); see "bench.hpp" for the options.
+#include <functional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "set.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+// n keys, longer than the small string buffer so that every temporary
+// std::string allocates, and a probe for each of them viewing a shared
+// buffer in another order
+struct fixture {
+    std::vector<std::string> keys;
+    std::string buffer;
+    std::vector<std::string_view> probes;
+
+    explicit fixture(size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+            keys.push_back("telemetry/host-" + std::to_string(i * 7919 % n) + "/cpu");
+        std::vector<std::pair<size_t, size_t>> spans;
+        for (size_t i = 0; i < n; i++) {
+            const std::string& k = keys[(i * 31) % n];
+            spans.push_back({buffer.size(), k.size()});
+            buffer += k;
+        }
+        for (auto& s: spans)
+            probes.push_back(std::string_view(buffer).substr(s.first, s.second));
+    }
+};
+
+template <typename Set>
+void find_string(state& st)
+{
+    fixture f(st.arg());
+    Set s(f.keys.begin(), f.keys.end());
+    while (st.keep_running()) {
+        size_t found = 0;
+        for (auto p: f.probes)
+            found += s.count(std::string(p));
+        do_not_optimize(found);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+template <typename Set>
+void find_transparent(state& st)
+{
+    fixture f(st.arg());
+    Set s(f.keys.begin(), f.keys.end());
+    while (st.keep_running()) {
+        size_t found = 0;
+        for (auto p: f.probes)
+            found += s.count(p);
+        do_not_optimize(found);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("find_string_view");
+    s.add("find", "std", find_string<std::set<std::string>>).args({1000, 100000});
+    s.add("find", "std_transparent", find_transparent<std::set<std::string, std::less<>>>).args({1000, 100000});
+    s.add("find", "Hx", find_string<Hx::set<std::string>>).args({1000, 100000});
+    s.add("find", "Hx_transparent", find_transparent<Hx::set<std::string, std::less<>>>).args({1000, 100000});
+    return s.run(argc, argv);
+}
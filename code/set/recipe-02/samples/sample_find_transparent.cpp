@@ -0,0 +1,43 @@
+// set::find with a transparent comparator
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "set.hpp"
+
+// compares std::string and C strings without converting either side
+struct string_less {
+  typedef void is_transparent;
+
+  bool operator() (const std::string& a, const std::string& b) const { return a < b; }
+  bool operator() (const std::string& a, const char* b) const { return a.compare(b) < 0; }
+  bool operator() (const char* a, const std::string& b) const { return b.compare(a) > 0; }
+};
+
+int main ()
+{
+  Hx::set<std::string, string_less> myset {"apple", "banana", "cherry", "durian"};
+
+  const char* probes[] = {"banana", "blueberry", "durian"};
+  for (const char* p: probes) {
+    // no temporary std::string is built for the lookup
+    auto it = myset.find(p);
+    std::cout << p << (it != myset.end() ? " found" : " not found") << '\n';
+  }
+
+  std::cout << "count(\"cherry\"): " << myset.count("cherry") << '\n';
+  std::cout << "lower_bound(\"c\"): " << *myset.lower_bound("c") << '\n';
+  std::cout << "upper_bound(\"cherry\"): " << *myset.upper_bound("cherry") << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+banana found
+blueberry not found
+durian found
+count("cherry"): 1
+lower_bound("c"): cherry
+upper_bound("cherry"): durian
+*/
@@ -0,0 +1,46 @@
+// set::set_union/set_intersection/set_difference
+#include <iostream>
+#include "set.hpp"
+
+template <typename Set>
+void print(const char* name, const Set& s)
+{
+  std::cout << name << " contains:";
+  for (auto it=s.begin(); it!=s.end(); ++it)
+    std::cout << ' ' << *it;
+  std::cout << '\n';
+}
+
+int main ()
+{
+  Hx::set<int> first {5,10,15,20,25};
+  Hx::set<int> second {10,20,30,40,50};
+
+  Hx::set<int> u(first);
+  u.set_union(second);            // second is copied
+  print("union", u);
+
+  Hx::set<int> i(first);
+  i.set_intersection(second);
+  print("intersection", i);
+
+  Hx::set<int> d(first);
+  d.set_difference(second);
+  print("difference", d);
+
+  first.set_union(std::move(second), 2);    // nodes of second are relinked, 2 threads
+  print("first", first);
+  print("second", second);
+
+  return 0;
+}
+
+/*
+Output:
+
+union contains: 5 10 15 20 25 30 40 50
+intersection contains: 10 20
+difference contains: 5 15 25
+first contains: 5 10 15 20 25 30 40 50
+second contains:
+*/
@@ -1 +1 @@
-../../../forward_list/recipe-01/include/singly_linked_list.hpp
\ No newline at end of file
+../../../forward_list/recipe-01/src/singly_linked_list.hpp
\ No newline at end of file
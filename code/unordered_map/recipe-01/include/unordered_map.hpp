@@ -9,6 +9,7 @@
 #include <memory>
 #include <limits>
 #include <functional>
+#include <stdexcept>
 #include <initializer_list>
 
 namespace Hx {
@@ -37,6 +38,7 @@ struct unordered_map_node: public singly_linked::list_node_t {
 
 #include "unordered_map_local_iterator.hpp"
 #include "unordered_map_iterator.hpp"
+#include "unordered_map_node_handle.hpp"
 
 /**
  * Unordered Map
@@ -51,9 +53,9 @@ template <typename Key, typename T,
 class unordered_map {
     typedef singly_linked::list_t bucket_type;
     typedef singly_linked::list_node_t link_type;
-    typedef unordered_map_node<std::pair<const Key, T>> node_type;
+    typedef unordered_map_node<std::pair<const Key, T>> value_node_type;
     typedef typename Alloc::template rebind<bucket_type>::other bucket_alloc_type;
-    typedef typename Alloc::template rebind<node_type>::other node_alloc_type;
+    typedef typename Alloc::template rebind<value_node_type>::other node_alloc_type;
 
     Hash hash_;                     // hash function
     Pred equal_;                    // equal fucntion
@@ -82,6 +84,8 @@ public:
     typedef unordered_map_const_iterator<value_type> const_iterator;
     typedef unordered_map_local_iterator<value_type> local_iterator;
     typedef unordered_map_const_local_iterator<value_type> const_local_iterator;
+    typedef unordered_map_node_handle<key_type, mapped_type, node_alloc_type> node_type;
+    typedef unordered_map_insert_return_type<iterator, node_type> insert_return_type;
 
     typedef size_t size_type;
     typedef ptrdiff_t difference_type;
@@ -303,7 +307,7 @@ public:
      */
     size_type max_size() const noexcept
     {
-        return std::numeric_limits<size_type>::max() / sizeof(node_type);
+        return std::numeric_limits<size_type>::max() / sizeof(value_node_type);
     }
 
     /**
@@ -495,6 +499,35 @@ public:
         return cend();
     }
 
+    /**
+     * Heterogeneous versions: only available when both hasher::is_transparent 
+     * and key_equal::is_transparent name types, in which case k may be any 
+     * type that hashes and compares equal consistently with key_type 
+     * (e.g. a string_view probe against std::string keys, without building 
+     * a temporary std::string).
+     */
+    template <typename K, typename H = hasher, typename P = key_equal,
+        typename = typename H::is_transparent, typename = typename P::is_transparent>
+    iterator find(const K& k)
+    {
+        bucket_type* bucket = buckets_+bucket_index(hash_(k));
+        link_type* link = find_before(bucket, k);
+        if (link == nullptr)
+            return end();
+        return iterator(bucket, buckets_+bucket_count_, link->next);
+    }
+
+    template <typename K, typename H = hasher, typename P = key_equal,
+        typename = typename H::is_transparent, typename = typename P::is_transparent>
+    const_iterator find(const K& k) const
+    {
+        bucket_type* bucket = buckets_+bucket_index(hash_(k));
+        link_type* link = find_before(bucket, k);
+        if (link == nullptr)
+            return cend();
+        return const_iterator(bucket, buckets_+bucket_count_, link->next);
+    }
+
     /**
      * Count elements with a specific key
      * Searches the container for elements whose key is k and 
@@ -514,6 +547,14 @@ public:
         return n;
     }
 
+    template <typename K, typename H = hasher, typename P = key_equal,
+        typename = typename H::is_transparent, typename = typename P::is_transparent>
+    size_type count(const K& k) const
+    {
+        bucket_type* bucket = buckets_+bucket_index(hash_(k));
+        return find_before(bucket, k) == nullptr ? 0 : 1;
+    }
+
     /**
      * Get range of elements with specific key
      * Returns the bounds of a range that includes all the elements 
@@ -552,6 +593,28 @@ public:
         return std::make_pair(cend(), cend());
     }
 
+    template <typename K, typename H = hasher, typename P = key_equal,
+        typename = typename H::is_transparent, typename = typename P::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K& k)
+    {
+        iterator lower = find(k);
+        iterator upper(lower);
+        if (lower != end())
+            upper.next();
+        return std::make_pair(lower, upper);
+    }
+
+    template <typename K, typename H = hasher, typename P = key_equal,
+        typename = typename H::is_transparent, typename = typename P::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K& k) const
+    {
+        const_iterator lower = find(k);
+        const_iterator upper(lower);
+        if (lower != cend())
+            upper.next();
+        return std::make_pair(lower, upper);
+    }
+
     /**
      * Construct and insert element
      * Inserts a new element in the unordered_map if its key is unique. 
@@ -637,6 +700,39 @@ public:
         insert(il.begin(), il.end());
     }
 
+    /**
+     * The node handle versions link the node owned by nh into its bucket: 
+     * no allocation and no copy of the element. If an element with an 
+     * equivalent key already exists, nh is returned back untouched in 
+     * insert_return_type::node. nh must come from a container with an
+     * equal allocator.
+     */
+    insert_return_type insert(node_type&& nh)
+    {
+        if (nh.empty())
+            return insert_return_type{end(), false, node_type()};
+
+        assert(nh.alloc_ == node_alloc_);
+        const key_type& k = nh.key();
+        bucket_type* bucket = buckets_+bucket_index(hash_(k));
+        link_type* link = list_before_head(bucket);
+        while (link->next != nullptr) {
+            if (equal_(get_key(link->next), k)) {
+                return insert_return_type{
+                    iterator(bucket, buckets_+bucket_count_, link->next), false, std::move(nh)};
+            }
+            link = link->next;
+        }
+        list_insert_after(link, nh.release());
+        return insert_return_type{
+            iterator(bucket, buckets_+bucket_count_, link->next), true, node_type()};
+    }
+
+    iterator insert(const_iterator hint, node_type&& nh)
+    {
+        return insert(std::move(nh)).position;
+    }
+
     /**
      * Erase elements
      * Removes from the unordered_map container a single element 
@@ -683,6 +779,70 @@ public:
         return iterator((bucket_type*) last.pos, (bucket_type*) last.end, (link_type*) last.link);
     }
 
+    /**
+     * Extract node
+     * Unlinks the node containing the element at position (or with key k) 
+     * from its bucket and returns a node handle owning it.
+     */
+    node_type extract(const_iterator position)
+    {
+        assert(position.pos != nullptr && position.link != nullptr);
+        link_type* link = list_before_head((bucket_type*) position.pos);
+        while (link->next != position.link) {
+            assert(link->next != nullptr);
+            link = link->next;
+        }
+        link_type* node = list_delete_after(link);
+        return node_type(static_cast<value_node_type*>(node), node_alloc_);
+    }
+
+    node_type extract(const key_type& k)
+    {
+        bucket_type* bucket = buckets_+bucket_index(hash_(k));
+        link_type* link = list_before_head(bucket);
+        while (link->next != nullptr) {
+            if (equal_(get_key(link->next), k)) {
+                link_type* node = list_delete_after(link);
+                return node_type(static_cast<value_node_type*>(node), node_alloc_);
+            }
+            link = link->next;
+        }
+        return node_type();
+    }
+
+    /**
+     * Splice nodes from another container
+     * Moves every node of source whose key is not already present in *this,
+     * relinking the nodes instead of reallocating them.
+     * Both containers must use equal allocators.
+     */
+    void merge(unordered_map& source)
+    {
+        if (this == &source)
+            return;
+
+        assert(node_alloc_ == source.node_alloc_);
+        bucket_type* pos = source.buckets_;
+        bucket_type* last = source.buckets_+source.bucket_count_;
+        for ( ; pos != last; ++pos) {
+            link_type* link = list_before_head(pos);
+            while (link->next != nullptr) {
+                const key_type& k = get_key(link->next);
+                bucket_type* bucket = buckets_+bucket_index(hash_(k));
+                if (find_before(bucket, k) != nullptr) {
+                    link = link->next;
+                } else {
+                    list_insert_after(list_before_head(bucket), list_delete_after(link));
+                }
+            }
+        }
+    }
+
+    void merge(unordered_map&& source)
+    {
+        merge(source);
+    }
+
     /**
      * Clear content
      * All the elements in the unordered_map container are dropped: 
@@ -892,6 +1052,20 @@ private:
         return bucket_index(hash_val, bucket_count_);
     }
 
+    // returns the node before the element with key k in bucket, or nullptr
+    template <typename K>
+    link_type* find_before(bucket_type* bucket, const K& k) const
+    {
+        link_type* link = list_before_head(bucket);
+        while (link->next != nullptr) {
+            if (equal_(get_key(link->next), k)) {
+                return link;
+            }
+            link = link->next;
+        }
+        return nullptr;
+    }
+
     void copy_from(const unordered_map& ump)
     {
         bucket_type* first = ump.buckets_; 
@@ -904,7 +1078,7 @@ private:
             link_type* link = list_head(pos);
             link_type* dest_link = list_before_head(bucket);
             while (link != nullptr) {
-                node_type* node = static_cast<node_type*>(link);
+                value_node_type* node = static_cast<value_node_type*>(link);
                 list_insert_after(dest_link, create_node(*node->valptr()));
                 link = link->next;
                 dest_link = dest_link->next;
@@ -924,7 +1098,7 @@ private:
             link_type* link = list_head(pos);
             link_type* dest_link = list_before_head(bucket);
             while (link != nullptr) {
-                node_type* node = static_cast<node_type*>(link);
+                value_node_type* node = static_cast<value_node_type*>(link);
                 list_insert_after(dest_link, create_node(std::move(*node->valptr())));
                 link = link->next;
                 dest_link = dest_link->next;
@@ -978,12 +1152,12 @@ private:
         return true;
     }
 
-    node_type* get_node()
+    value_node_type* get_node()
     {
         return node_alloc_.allocate(1);
     }
 
-    void put_node(node_type* node)
+    void put_node(value_node_type* node)
     {
         node_alloc_.deallocate(node, 1);
     }
@@ -991,7 +1165,7 @@ private:
     template <typename... Args>
     link_type* create_node(Args&&... args)
     {
-        node_type* node = get_node();
+        value_node_type* node = get_node();
         try
         {
             allocator_type(node_alloc_).construct(
@@ -1012,7 +1186,7 @@ private:
     
         void operator ()(link_type* link)
         {
-            node_type* node = static_cast<node_type*>(link);
+            value_node_type* node = static_cast<value_node_type*>(link);
             allocator_type(*node_alloc).destroy(node->valptr());
             node_alloc->deallocate(node, 1);
         }
@@ -1025,19 +1199,19 @@ private:
 
     static const key_type& get_key(const link_type* link)
     {
-        const node_type* node = static_cast<const node_type*>(link);
+        const value_node_type* node = static_cast<const value_node_type*>(link);
         return node->valptr()->first;
     }
 
     static mapped_type& get_mapped(link_type* link)
     {
-        node_type* node = static_cast<node_type*>(link);
+        value_node_type* node = static_cast<value_node_type*>(link);
         return node->valptr()->second;
     }
 
     static const mapped_type& get_mapped(const link_type* link)
     {
-        const node_type* node = static_cast<const node_type*>(link);
+        const value_node_type* node = static_cast<const value_node_type*>(link);
         return node->valptr()->second;
     }
 
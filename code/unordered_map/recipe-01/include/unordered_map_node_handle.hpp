@@ -0,0 +1,114 @@
+/**
+ * A unordered_map::node_type.
+ * Owns a node extracted from an unordered_map, so that it can be re-inserted
+ * (possibly under a new key) without reallocating or copying the element.
+ */
+template <typename Key, typename T, typename NodeAlloc>
+class unordered_map_node_handle {
+    typedef unordered_map_node<std::pair<const Key, T>> node_type;
+
+    node_type* ptr_ = nullptr;
+    NodeAlloc alloc_;
+
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef typename NodeAlloc::template rebind<std::pair<const Key, T>>::other allocator_type;
+
+    unordered_map_node_handle() = default;
+
+    unordered_map_node_handle(unordered_map_node_handle&& nh) noexcept: 
+        ptr_(nh.ptr_), alloc_(std::move(nh.alloc_))
+    {
+        nh.ptr_ = nullptr;
+    }
+
+    unordered_map_node_handle& operator=(unordered_map_node_handle&& nh)
+    {
+        if (this == &nh)
+            return *this;
+
+        reset();
+        ptr_ = nh.ptr_;
+        alloc_ = std::move(nh.alloc_);
+        nh.ptr_ = nullptr;
+        return *this;
+    }
+
+    ~unordered_map_node_handle()
+    {
+        reset();
+    }
+
+    bool empty() const noexcept
+    {
+        return ptr_ == nullptr;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return ptr_ != nullptr;
+    }
+
+    /**
+     * The key is stored as const in the container; it may only be
+     * modified while the node is owned by the handle.
+     */
+    key_type& key() const
+    {
+        assert(!empty());
+        return const_cast<key_type&>(ptr_->valptr()->first);
+    }
+
+    mapped_type& mapped() const
+    {
+        assert(!empty());
+        return ptr_->valptr()->second;
+    }
+
+    allocator_type get_allocator() const
+    {
+        return allocator_type(alloc_);
+    }
+
+    void swap(unordered_map_node_handle& nh)
+    {
+        using std::swap;
+        swap(ptr_, nh.ptr_);
+        swap(alloc_, nh.alloc_);
+    }
+
+private:
+    template <typename, typename, typename, typename, typename> friend class unordered_map;
+
+    unordered_map_node_handle(node_type* ptr, const NodeAlloc& alloc): ptr_(ptr), alloc_(alloc) {}
+
+    node_type* release() noexcept
+    {
+        node_type* ptr = ptr_;
+        ptr_ = nullptr;
+        return ptr;
+    }
+
+    void reset()
+    {
+        if (ptr_ == nullptr)
+            return;
+
+        allocator_type alloc(alloc_);
+        std::allocator_traits<allocator_type>::destroy(alloc, ptr_->valptr());
+        std::allocator_traits<NodeAlloc>::deallocate(alloc_, ptr_, 1);
+        ptr_ = nullptr;
+    }
+};
+
+/**
+ * Return type of unordered_map::insert(node_type&&).
+ */
+template <typename Iterator, typename NodeType>
+struct unordered_map_insert_return_type {
+    Iterator position;
+    bool inserted;
+    NodeType node;
+};
+
@@ -0,0 +1,68 @@
+// Re-keying every entry of an unordered_map: erase + emplace with the
+// moved value (one free and one allocation per entry) against extract +
+// insert(node_type&&), which reuses the node ("Hx_extract"); see
+// "bench.hpp" for the options. The argument is the number of entries;
+// every iteration moves all of them n keys up, so that re-keyed entries
+// never collide with pending ones.
+#include <string>
+#include <unordered_map>
+#include "unordered_map.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+template <typename Map>
+void fill(Map& m, long n)
+{
+    for (long i = 0; i < n; i++)
+        m.emplace(i, "value-" + std::to_string(i));
+}
+
+template <typename Map>
+void erase_emplace(state& st)
+{
+    const long n = st.arg();
+    Map m(2*n);
+    fill(m, n);
+    long base = 0;
+    while (st.keep_running()) {
+        for (long i = base; i < base+n; i++) {
+            auto it = m.find(i);
+            std::string value = std::move(it->second);
+            m.erase(it);
+            m.emplace(i+n, std::move(value));
+        }
+        base += n;
+    }
+    do_not_optimize(m);
+    st.set_items_per_iteration(n);
+}
+
+void extract_insert(state& st)
+{
+    typedef Hx::unordered_map<long, std::string> map_type;
+    const long n = st.arg();
+    map_type m(2*n);
+    fill(m, n);
+    long base = 0;
+    while (st.keep_running()) {
+        for (long i = base; i < base+n; i++) {
+            map_type::node_type nh = m.extract(i);
+            nh.key() = i+n;
+            m.insert(std::move(nh));
+        }
+        base += n;
+    }
+    do_not_optimize(m);
+    st.set_items_per_iteration(n);
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("rekey");
+    s.add("rekey", "std", erase_emplace<std::unordered_map<long, std::string>>).args({1000, 100000});
+    s.add("rekey", "Hx", erase_emplace<Hx::unordered_map<long, std::string>>).args({1000, 100000});
+    s.add("rekey", "Hx_extract", extract_insert).args({1000, 100000});
+    return s.run(argc, argv);
+}
@@ -0,0 +1,89 @@
+// Hx::unordered_map against std::unordered_map; see "bench.hpp" for the options.
+#include <unordered_map>
+#include <vector>
+#include "unordered_map.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+// n distinct keys in pseudo random order
+std::vector<int> make_keys(long n)
+{
+    std::vector<int> keys(n);
+    for (long i = 0; i < n; i++)
+        keys[i] = int((i * 2654435761u) % 4294967291u);
+    return keys;
+}
+
+template <typename Map>
+void insert(state& st)
+{
+    std::vector<int> keys = make_keys(st.arg());
+    while (st.keep_running()) {
+        Map m;
+        for (size_t i = 0; i < keys.size(); i++)
+            m.insert(std::make_pair(keys[i], int(i)));
+        do_not_optimize(m);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+template <typename Map>
+void find(state& st)
+{
+    std::vector<int> keys = make_keys(st.arg());
+    Map m;
+    for (size_t i = 0; i < keys.size(); i++)
+        m.insert(std::make_pair(keys[i], int(i)));
+    while (st.keep_running()) {
+        size_t found = 0;
+        for (size_t i = 0; i < keys.size(); i++)
+            found += (m.find(keys[i]) != m.end());
+        do_not_optimize(found);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+template <typename Map>
+void find_miss(state& st)
+{
+    std::vector<int> keys = make_keys(st.arg());
+    Map m;
+    for (size_t i = 0; i < keys.size(); i++)
+        m.insert(std::make_pair(keys[i], int(i)));
+    while (st.keep_running()) {
+        size_t found = 0;
+        for (size_t i = 0; i < keys.size(); i++)
+            found += (m.find(~keys[i]) != m.end());
+        do_not_optimize(found);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+template <typename Map>
+void operator_index(state& st)
+{
+    std::vector<int> keys = make_keys(st.arg());
+    while (st.keep_running()) {
+        Map m;
+        for (size_t i = 0; i < keys.size(); i++)
+            m[keys[i % 64]]++;
+        do_not_optimize(m);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("unordered_map");
+    s.add("insert", "std", insert<std::unordered_map<int, int>>).args({1000, 10000});
+    s.add("insert", "Hx", insert<Hx::unordered_map<int, int>>).args({1000, 10000});
+    s.add("find", "std", find<std::unordered_map<int, int>>).args({1000, 10000});
+    s.add("find", "Hx", find<Hx::unordered_map<int, int>>).args({1000, 10000});
+    s.add("find_miss", "std", find_miss<std::unordered_map<int, int>>).args({1000, 10000});
+    s.add("find_miss", "Hx", find_miss<Hx::unordered_map<int, int>>).args({1000, 10000});
+    s.add("operator_index", "std", operator_index<std::unordered_map<int, int>>).args({1000});
+    s.add("operator_index", "Hx", operator_index<Hx::unordered_map<int, int>>).args({1000});
+    return s.run(argc, argv);
+}
@@ -0,0 +1,89 @@
+// String-keyed lookups with string_view probes: materializing a
+// std::string per probe against transparent lookup (the "_transparent"
+// impl, with string_hash and std::equal_to<>); see "bench.hpp" for the
+// options. std::unordered_map has no transparent lookup before C++20.
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "unordered_map.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+// std::hash<std::string> and std::hash<std::string_view> agree on equal strings
+struct string_hash {
+    typedef void is_transparent;
+
+    size_t operator()(std::string_view s) const { return std::hash<std::string_view>()(s); }
+};
+
+// n keys, longer than the small string buffer so that every temporary
+// std::string allocates, and a probe for each of them viewing a shared
+// buffer in another order
+struct fixture {
+    std::vector<std::string> keys;
+    std::string buffer;
+    std::vector<std::string_view> probes;
+
+    explicit fixture(size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+            keys.push_back("telemetry/host-" + std::to_string(i) + "/cpu");
+        std::vector<std::pair<size_t, size_t>> spans;
+        for (size_t i = 0; i < n; i++) {
+            const std::string& k = keys[(i * 31) % n];
+            spans.push_back({buffer.size(), k.size()});
+            buffer += k;
+        }
+        for (auto& s: spans)
+            probes.push_back(std::string_view(buffer).substr(s.first, s.second));
+    }
+};
+
+template <typename Map>
+void fill(Map& m, const fixture& f)
+{
+    for (size_t i = 0; i < f.keys.size(); i++)
+        m.emplace(f.keys[i], int(i));
+}
+
+template <typename Map>
+void find_string(state& st)
+{
+    fixture f(st.arg());
+    Map m(2 * st.arg());
+    fill(m, f);
+    while (st.keep_running()) {
+        size_t found = 0;
+        for (auto p: f.probes)
+            found += m.count(std::string(p));
+        do_not_optimize(found);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+void find_transparent(state& st)
+{
+    fixture f(st.arg());
+    Hx::unordered_map<std::string, int, string_hash, std::equal_to<>> m(2 * st.arg());
+    fill(m, f);
+    while (st.keep_running()) {
+        size_t found = 0;
+        for (auto p: f.probes)
+            found += m.count(p);
+        do_not_optimize(found);
+    }
+    st.set_items_per_iteration(st.arg());
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("find_string_view");
+    s.add("find", "std", find_string<std::unordered_map<std::string, int>>).args({1000, 100000});
+    s.add("find", "Hx", find_string<Hx::unordered_map<std::string, int>>).args({1000, 100000});
+    s.add("find", "Hx_transparent", find_transparent).args({1000, 100000});
+    return s.run(argc, argv);
+}
@@ -0,0 +1,40 @@
+#include <iostream>
+#include <string>
+#include <unordered_map>
+ 
+int main()
+{
+    std::unordered_map<int, std::string> cont{{1, "one"}, {2, "two"}, {3, "three"}};
+ 
+    auto print = [&cont](int key) {
+        auto it = cont.find(key);
+        std::cout << " " << key << ":" << (it == cont.end() ? "-" : it->second);
+    };
+ 
+    std::cout << "Start:";
+    for (int k = 1; k <= 4; k++) print(k);
+    std::cout << '\n';
+ 
+    // Extract node handle and change key
+    auto nh = cont.extract(1);
+    nh.key() = 4;
+ 
+    std::cout << "After extract and before insert:";
+    for (int k = 1; k <= 4; k++) print(k);
+    std::cout << '\n';
+ 
+    // Insert node handle back
+    cont.insert(std::move(nh));
+ 
+    std::cout << "End:";
+    for (int k = 1; k <= 4; k++) print(k);
+    std::cout << '\n';
+}
+
+/*
+Output:
+
+Start: 1:one 2:two 3:three 4:-
+After extract and before insert: 1:- 2:two 3:three 4:-
+End: 1:- 2:two 3:three 4:one
+*/
@@ -0,0 +1,38 @@
+#include <iostream>
+#include <string>
+#include <map>
+#include <unordered_map>
+ 
+// print out a container, in key order
+template <class Os, class K, class V>
+Os& operator<<(Os& os, const std::unordered_map<K, V>& v) {
+    std::map<K, V> sorted(v.begin(), v.end());
+    os << '[' << v.size() << "] {";
+    bool o{};
+    for (const auto& e : sorted)
+        os << (o ? ", " : (o = 1, " ")) << e.first << ':' << e.second;
+    return os << " }\n";
+}
+ 
+int main()
+{
+    std::unordered_map<std::string, int>
+        p{ {"C", 3}, {"B", 2}, {"A", 1} }, 
+        q{ {"E", 5}, {"D", 4}, {"C", 30} };
+ 
+    std::cout << "p: " << p << "q: " << q;
+ 
+    p.merge(q);
+ 
+    std::cout << "p.merge(q);\n" << "p: " << p << "q: " << q;
+}
+
+/*
+Output:
+
+p: [3] { A:1, B:2, C:3 }
+q: [3] { C:30, D:4, E:5 }
+p.merge(q);
+p: [5] { A:1, B:2, C:3, D:4, E:5 }
+q: [1] { C:30 }
+*/
@@ -0,0 +1,57 @@
+// unordered_map::find with a transparent hasher and key_equal
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include "unordered_map.hpp"
+
+// FNV-1a over the characters, so that std::string and C strings hash alike
+struct string_hash {
+  typedef void is_transparent;
+
+  size_t operator() (const char* s, size_t n) const {
+    size_t h = 2166136261u;
+    for (size_t i = 0; i < n; i++) h = (h ^ (unsigned char) s[i]) * 16777619u;
+    return h;
+  }
+  size_t operator() (const std::string& s) const { return (*this)(s.data(), s.size()); }
+  size_t operator() (const char* s) const { return (*this)(s, strlen(s)); }
+};
+
+struct string_equal {
+  typedef void is_transparent;
+
+  bool operator() (const std::string& a, const std::string& b) const { return a == b; }
+  bool operator() (const std::string& a, const char* b) const { return a == b; }
+  bool operator() (const char* a, const std::string& b) const { return b == a; }
+};
+
+int main ()
+{
+  Hx::unordered_map<std::string,double,string_hash,string_equal> mymap = {
+     {"mom",5.4},
+     {"dad",6.1},
+     {"bro",5.9} };
+
+  const char* probes[] = {"dad", "sis"};
+  for (const char* p: probes) {
+    // no temporary std::string is built for the lookup
+    auto got = mymap.find (p);
+    if ( got == mymap.end() )
+      std::cout << p << " not found\n";
+    else
+      std::cout << got->first << " is " << got->second << '\n';
+  }
+
+  std::cout << "count(\"mom\"): " << mymap.count("mom") << '\n';
+
+  return 0;
+}
+
+/*
+Output:
+
+dad is 6.1
+sis not found
+count("mom"): 1
+*/
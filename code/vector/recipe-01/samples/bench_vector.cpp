@@ -0,0 +1,103 @@
+// Hx::vector against std::vector; see "bench.hpp" for the options.
+#include <vector>
+#include <numeric>
+#include "vector.hpp"
+#include "bench.hpp"
+
+using Hx::bench::state;
+using Hx::bench::do_not_optimize;
+
+template <typename Vector>
+void push_back(state& st)
+{
+    long n = st.arg();
+    while (st.keep_running()) {
+        Vector v;
+        for (long i = 0; i < n; i++)
+            v.push_back(int(i));
+        do_not_optimize(v.data());
+    }
+    st.set_items_per_iteration(n);
+}
+
+template <typename Vector>
+void reserve_push_back(state& st)
+{
+    long n = st.arg();
+    while (st.keep_running()) {
+        Vector v;
+        v.reserve(n);
+        for (long i = 0; i < n; i++)
+            v.push_back(int(i));
+        do_not_optimize(v.data());
+    }
+    st.set_items_per_iteration(n);
+}
+
+template <typename Vector>
+void iterate(state& st)
+{
+    Vector v(st.arg(), 1);
+    while (st.keep_running()) {
+        int sum = 0;
+        for (auto it = v.begin(); it != v.end(); ++it)
+            sum += *it;
+        do_not_optimize(sum);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(int));
+}
+
+template <typename Vector>
+void operator_index(state& st)
+{
+    Vector v(st.arg(), 1);
+    while (st.keep_running()) {
+        int sum = 0;
+        for (size_t i = 0; i < v.size(); i++)
+            sum += v[i];
+        do_not_optimize(sum);
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(int));
+}
+
+template <typename Vector>
+void copy_construct(state& st)
+{
+    Vector v(st.arg(), 1);
+    while (st.keep_running()) {
+        Vector w(v);
+        do_not_optimize(w.data());
+    }
+    st.set_bytes_per_iteration(st.arg() * sizeof(int));
+}
+
+template <typename Vector>
+void insert_front(state& st)
+{
+    long n = st.arg();
+    while (st.keep_running()) {
+        Vector v;
+        for (long i = 0; i < n; i++)
+            v.insert(v.begin(), int(i));
+        do_not_optimize(v.data());
+    }
+    st.set_items_per_iteration(n);
+}
+
+int main(int argc, char* argv[])
+{
+    Hx::bench::suite s("vector");
+    s.add("push_back", "std", push_back<std::vector<int>>).args({1000, 1000000});
+    s.add("push_back", "Hx", push_back<Hx::vector<int>>).args({1000, 1000000});
+    s.add("reserve_push_back", "std", reserve_push_back<std::vector<int>>).args({1000, 1000000});
+    s.add("reserve_push_back", "Hx", reserve_push_back<Hx::vector<int>>).args({1000, 1000000});
+    s.add("iterate", "std", iterate<std::vector<int>>).args({1000, 1000000});
+    s.add("iterate", "Hx", iterate<Hx::vector<int>>).args({1000, 1000000});
+    s.add("operator_index", "std", operator_index<std::vector<int>>).args({1000, 1000000});
+    s.add("operator_index", "Hx", operator_index<Hx::vector<int>>).args({1000, 1000000});
+    s.add("copy_construct", "std", copy_construct<std::vector<int>>).args({1000, 1000000});
+    s.add("copy_construct", "Hx", copy_construct<Hx::vector<int>>).args({1000, 1000000});
+    s.add("insert_front", "std", insert_front<std::vector<int>>).args({1000});
+    s.add("insert_front", "Hx", insert_front<Hx::vector<int>>).args({1000});
+    return s.run(argc, argv);
+}